@@ -0,0 +1,149 @@
+/*!
+ * Copyright (c) 2021 SWTube. All rights reserved.
+ * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
+ */
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "Benchmark.h"
+
+import cave.Core.Algorithms;
+
+/*
+ * RadixSort and the SortSmall sorting network are measured against std::sort, the Eytzinger and branchless binary searches
+ * against std::lower_bound on the same sorted array.
+ */
+
+namespace CaveBenchmark
+{
+	namespace
+	{
+		/* SortSmall sorts arrays of this many keys, one after the other */
+		constexpr size_t SMALL_SORT_COUNT = 16ul;
+	}
+
+	void benchmarkAlgorithms(size_t size, const std::vector<uint32_t>& keys)
+	{
+		std::vector<uint32_t> data(size);
+		std::vector<uint32_t> payload(size);
+		std::vector<uint64_t> wideData(size);
+		auto makeWideKeys = [&]()
+		{
+			for (size_t i = 0; i < size; ++i)
+			{
+				wideData[i] = (static_cast<uint64_t>(keys[i]) << 32ul) | keys[size - i - 1];
+			}
+		};
+
+		measure("std::sort", nullptr, "sort", size, size,
+			[&]() { data = keys; },
+			[&]() { std::sort(data.begin(), data.end()); });
+
+		measure("cave::RadixSort", "std::sort", "sort", size, size,
+			[&]() { data = keys; },
+			[&]() { cave::RadixSort(data.data(), size); });
+
+		measure("std::sort", nullptr, "sort-uint64", size, size,
+			makeWideKeys,
+			[&]() { std::sort(wideData.begin(), wideData.end()); });
+
+		measure("cave::RadixSort", "std::sort", "sort-uint64", size, size,
+			makeWideKeys,
+			[&]() { cave::RadixSort(wideData.data(), size); });
+
+		{
+			// key and payload sorted together, as std::sort has to on pairs
+			std::vector<std::pair<uint64_t, uint32_t>> pairs(size);
+			measure("std::sort", nullptr, "sort-with-payload", size, size,
+				[&]()
+				{
+					for (size_t i = 0; i < size; ++i)
+					{
+						pairs[i] = { (static_cast<uint64_t>(keys[i]) << 32ul) | keys[size - i - 1], static_cast<uint32_t>(i) };
+					}
+				},
+				[&]() { std::sort(pairs.begin(), pairs.end(), [](const auto& left, const auto& right) { return left.first < right.first; }); });
+
+			measure("cave::RadixSort", "std::sort", "sort-with-payload", size, size,
+				[&]()
+				{
+					makeWideKeys();
+					std::iota(payload.begin(), payload.end(), 0u);
+				},
+				[&]() { cave::RadixSort(wideData.data(), payload.data(), size); });
+		}
+
+		if (size >= SMALL_SORT_COUNT)
+		{
+			const size_t sortedCount = size / SMALL_SORT_COUNT * SMALL_SORT_COUNT;
+			measure("std::sort", nullptr, "sort-16", size, sortedCount,
+				[&]() { data = keys; },
+				[&]()
+				{
+					for (size_t i = 0; i < sortedCount; i += SMALL_SORT_COUNT)
+					{
+						std::sort(data.begin() + i, data.begin() + i + SMALL_SORT_COUNT);
+					}
+				});
+
+			measure("cave::SortSmall", "std::sort", "sort-16", size, sortedCount,
+				[&]() { data = keys; },
+				[&]()
+				{
+					for (size_t i = 0; i < sortedCount; i += SMALL_SORT_COUNT)
+					{
+						cave::SortSmall(data.data() + i, SMALL_SORT_COUNT);
+					}
+				});
+		}
+
+		{
+			// odd values only, half of the searches miss
+			std::vector<uint32_t> sorted(size);
+			for (size_t i = 0; i < size; ++i)
+			{
+				sorted[i] = static_cast<uint32_t>(i) * 2u + 1u;
+			}
+			const cave::EytzingerArray<uint32_t> eytzinger(sorted.data(), size);
+
+			measure("std::lower_bound", nullptr, "lower-bound", size, size,
+				[]() {},
+				[&]()
+				{
+					size_t total = 0ul;
+					for (size_t i = 0; i < size; ++i)
+					{
+						total += static_cast<size_t>(std::lower_bound(sorted.begin(), sorted.end(), keys[i]) - sorted.begin());
+					}
+					gSink = total;
+				});
+
+			measure("cave::BranchlessLowerBound", "std::lower_bound", "lower-bound", size, size,
+				[]() {},
+				[&]()
+				{
+					size_t total = 0ul;
+					for (size_t i = 0; i < size; ++i)
+					{
+						total += static_cast<size_t>(cave::BranchlessLowerBound(sorted.data(), size, keys[i]) - sorted.data());
+					}
+					gSink = total;
+				});
+
+			measure("cave::EytzingerArray", "std::lower_bound", "lower-bound", size, size,
+				[]() {},
+				[&]()
+				{
+					size_t total = 0ul;
+					for (size_t i = 0; i < size; ++i)
+					{
+						total += eytzinger.LowerBound(keys[i]);
+					}
+					gSink = total;
+				});
+		}
+	}
+}
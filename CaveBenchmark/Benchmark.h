@@ -0,0 +1,112 @@
+/*!
+ * Copyright (c) 2021 SWTube. All rights reserved.
+ * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "CoreTypes.h"
+#include "Memory/MemoryPool.h"
+
+/*
+ * The harness the benchmark of every subsystem shares: measure() adds a Result per workload, main() writes them all as JSON.
+ */
+namespace CaveBenchmark
+{
+	/* each workload is repeated until it ran at least this long, the fastest run is reported */
+	constexpr double MIN_TOTAL_SECONDS = 0.05;
+	constexpr uint32_t MIN_REPEATS = 3u;
+	constexpr uint32_t MAX_REPEATS = 1000u;
+
+	struct Result
+	{
+		const char* Container;
+		const char* Baseline;
+		const char* Workload;
+		size_t Size;
+		uint32_t Repeats;
+		double NanosecondsPerOperation;
+		/* pool allocations per operation, negative when not counted */
+		double AllocationsPerOperation = -1.0;
+	};
+
+	extern std::vector<Result> gResults;
+	extern volatile size_t gSink;
+
+	/*
+	 * Runs setup() and work() until the time budget is spent and records the fastest work() per operation.
+	 * setup() is not timed, it rebuilds the input state the workload consumes (e.g. a filled container for erase).
+	 */
+	template <typename Setup, typename Work>
+	void measure(const char* container, const char* baseline, const char* workload, size_t size, size_t operations, Setup&& setup, Work&& work)
+	{
+		double best = 0.0;
+		double total = 0.0;
+		uint32_t repeats = 0u;
+
+		while (repeats < MIN_REPEATS || (total < MIN_TOTAL_SECONDS && repeats < MAX_REPEATS))
+		{
+			setup();
+
+			auto start = std::chrono::steady_clock::now();
+			work();
+			auto end = std::chrono::steady_clock::now();
+
+			double elapsed = std::chrono::duration<double>(end - start).count();
+			best = (repeats == 0u || elapsed < best) ? elapsed : best;
+			total += elapsed;
+			++repeats;
+		}
+
+		gResults.push_back({ container, baseline, workload, size, repeats, best * 1e9 / static_cast<double>(operations) });
+	}
+
+	/*
+	 * Calls construct(i) count times outside of any timing and counts the calls that took memory from the pool.
+	 * The count goes to the last result, which measured the same construction.
+	 */
+	template <typename Construct>
+	void countAllocations(cave::MemoryPool& pool, size_t count, Construct&& construct)
+	{
+		size_t allocationCount = 0ul;
+		for (size_t i = 0; i < count; ++i)
+		{
+			size_t freeSize = pool.GetFreeMemorySize();
+			construct(i);
+			allocationCount += pool.GetFreeMemorySize() != freeSize;
+		}
+
+		gResults.back().AllocationsPerOperation = static_cast<double>(allocationCount) / static_cast<double>(count);
+	}
+
+	std::vector<uint32_t> makeShuffledKeys(size_t size);
+
+	/* ContainersBenchmark.cpp */
+	void benchmarkArray(cave::MemoryPool& pool, size_t size, std::vector<uint32_t>& keys);
+	void benchmarkHashTable(cave::MemoryPool& pool, size_t size, std::vector<uint32_t>& keys);
+	void benchmarkHashSet(cave::MemoryPool& pool, size_t size, std::vector<uint32_t>& keys);
+	void benchmarkLinkedList(cave::MemoryPool& pool, size_t size, std::vector<uint32_t>& keys);
+	void benchmarkStack(cave::MemoryPool& pool, size_t size, std::vector<uint32_t>& keys);
+	void benchmarkBitArray(cave::MemoryPool& pool, size_t size, std::vector<uint32_t>& keys);
+
+	/* StringBenchmark.cpp */
+	void benchmarkString(cave::MemoryPool& pool, size_t size);
+	void benchmarkStringSearch(cave::MemoryPool& pool, size_t size);
+	void benchmarkStringFormat(cave::MemoryPool& pool, size_t size);
+	void benchmarkSmallString(cave::MemoryPool& pool, size_t size);
+	void benchmarkCharConv(size_t size);
+	void benchmarkUnicode(size_t size);
+
+	/* ThreadBenchmark.cpp */
+	void benchmarkJobSystem(size_t size);
+	void benchmarkSynchronization(size_t size);
+	void benchmarkEpochHashMap(size_t size, std::vector<uint32_t>& keys);
+	void benchmarkParallelAlgorithms(size_t size, const std::vector<uint32_t>& keys);
+
+	/* AlgorithmsBenchmark.cpp */
+	void benchmarkAlgorithms(size_t size, const std::vector<uint32_t>& keys);
+}
@@ -0,0 +1,245 @@
+/*!
+ * Copyright (c) 2021 SWTube. All rights reserved.
+ * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
+ */
+
+#include <list>
+#include <stack>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Benchmark.h"
+
+import cave.Core.Containers.Array;
+import cave.Core.Containers.BitArray;
+import cave.Core.Containers.HashSet;
+import cave.Core.Containers.HashTable;
+import cave.Core.Containers.LinkedList;
+import cave.Core.Containers.Stack;
+
+/*
+ * Every cave container is measured next to its std equivalent with the same insert, lookup, iterate and erase workloads.
+ * HashTable and HashSet have no iterators yet, so only their std equivalents are iterated. Stack, like std::stack,
+ * only shows its top: reading every element is its erase workload.
+ */
+
+namespace CaveBenchmark
+{
+	void benchmarkArray(cave::MemoryPool& pool, size_t size, std::vector<uint32_t>& keys)
+	{
+		void* item = &keys[0];
+
+		{
+			cave::Array array(pool);
+			measure("cave::Array", "std::vector", "insert", size, size,
+				[&]() { array.Clear(); },
+				[&]() { for (size_t i = 0; i < size; ++i) { array.InsertBack(&keys[i]); } });
+
+			measure("cave::Array", "std::vector", "lookup", size, size,
+				[]() {},
+				[&]() { size_t sum = 0ul; for (size_t i = 0; i < size; ++i) { sum += *reinterpret_cast<uint32_t*>(array[keys[i]]); } gSink = sum; });
+
+			measure("cave::Array", "std::vector", "iterate", size, size,
+				[]() {},
+				[&]() { size_t sum = 0ul; for (void* value : array) { sum += *reinterpret_cast<uint32_t*>(value); } gSink = sum; });
+
+			measure("cave::Array", "std::vector", "erase", size, size,
+				[&]() { array.Clear(); for (size_t i = 0; i < size; ++i) { array.InsertBack(item); } },
+				[&]() { for (size_t i = 0; i < size; ++i) { array.DeleteBack(); } });
+		}
+
+		{
+			std::vector<void*> vector;
+			measure("std::vector", nullptr, "insert", size, size,
+				[&]() { vector.clear(); vector.shrink_to_fit(); },
+				[&]() { for (size_t i = 0; i < size; ++i) { vector.push_back(&keys[i]); } });
+
+			measure("std::vector", nullptr, "lookup", size, size,
+				[]() {},
+				[&]() { size_t sum = 0ul; for (size_t i = 0; i < size; ++i) { sum += *reinterpret_cast<uint32_t*>(vector[keys[i]]); } gSink = sum; });
+
+			measure("std::vector", nullptr, "iterate", size, size,
+				[]() {},
+				[&]() { size_t sum = 0ul; for (void* value : vector) { sum += *reinterpret_cast<uint32_t*>(value); } gSink = sum; });
+
+			measure("std::vector", nullptr, "erase", size, size,
+				[&]() { vector.assign(size, item); },
+				[&]() { for (size_t i = 0; i < size; ++i) { vector.pop_back(); } });
+		}
+	}
+
+	void benchmarkHashTable(cave::MemoryPool& pool, size_t size, std::vector<uint32_t>& keys)
+	{
+		{
+			cave::HashTable hashTable(sizeof(uint32_t), size, pool);
+			measure("cave::HashTable", "std::unordered_map", "insert", size, size,
+				[&]() { hashTable.Clear(); },
+				[&]() { for (size_t i = 0; i < size; ++i) { hashTable.Insert(&keys[i], &keys[i]); } });
+
+			measure("cave::HashTable", "std::unordered_map", "lookup", size, size,
+				[]() {},
+				[&]() { size_t hits = 0ul; for (size_t i = 0; i < size; ++i) { hits += hashTable.Find(&keys[size - i - 1]) != nullptr; } gSink = hits; });
+
+			measure("cave::HashTable", "std::unordered_map", "erase", size, size,
+				[&]() { hashTable.Clear(); for (size_t i = 0; i < size; ++i) { hashTable.Insert(&keys[i], &keys[i]); } },
+				[&]() { for (size_t i = 0; i < size; ++i) { hashTable.Erase(&keys[i]); } });
+		}
+
+		{
+			std::unordered_map<uint32_t, uint32_t*> map;
+			measure("std::unordered_map", nullptr, "insert", size, size,
+				[&]() { map = std::unordered_map<uint32_t, uint32_t*>(size); },
+				[&]() { for (size_t i = 0; i < size; ++i) { map.emplace(keys[i], &keys[i]); } });
+
+			measure("std::unordered_map", nullptr, "lookup", size, size,
+				[]() {},
+				[&]() { size_t hits = 0ul; for (size_t i = 0; i < size; ++i) { hits += map.find(keys[size - i - 1]) != map.end(); } gSink = hits; });
+
+			measure("std::unordered_map", nullptr, "iterate", size, size,
+				[]() {},
+				[&]() { size_t sum = 0ul; for (auto& pair : map) { sum += pair.first; } gSink = sum; });
+
+			measure("std::unordered_map", nullptr, "erase", size, size,
+				[&]() { map.clear(); for (size_t i = 0; i < size; ++i) { map.emplace(keys[i], &keys[i]); } },
+				[&]() { for (size_t i = 0; i < size; ++i) { map.erase(keys[i]); } });
+		}
+	}
+
+	void benchmarkHashSet(cave::MemoryPool& pool, size_t size, std::vector<uint32_t>& keys)
+	{
+		{
+			cave::HashSet hashSet(sizeof(uint32_t), size, pool);
+			measure("cave::HashSet", "std::unordered_set", "insert", size, size,
+				[&]() { hashSet.Clear(); },
+				[&]() { for (size_t i = 0; i < size; ++i) { hashSet.Insert(&keys[i]); } });
+
+			measure("cave::HashSet", "std::unordered_set", "lookup", size, size,
+				[]() {},
+				[&]() { size_t hits = 0ul; for (size_t i = 0; i < size; ++i) { hits += hashSet.Contains(&keys[size - i - 1]); } gSink = hits; });
+
+			measure("cave::HashSet", "std::unordered_set", "erase", size, size,
+				[&]() { hashSet.Clear(); for (size_t i = 0; i < size; ++i) { hashSet.Insert(&keys[i]); } },
+				[&]() { for (size_t i = 0; i < size; ++i) { hashSet.Erase(&keys[i]); } });
+		}
+
+		{
+			std::unordered_set<uint32_t> set;
+			measure("std::unordered_set", nullptr, "insert", size, size,
+				[&]() { set = std::unordered_set<uint32_t>(size); },
+				[&]() { for (size_t i = 0; i < size; ++i) { set.insert(keys[i]); } });
+
+			measure("std::unordered_set", nullptr, "lookup", size, size,
+				[]() {},
+				[&]() { size_t hits = 0ul; for (size_t i = 0; i < size; ++i) { hits += set.contains(keys[size - i - 1]); } gSink = hits; });
+
+			measure("std::unordered_set", nullptr, "iterate", size, size,
+				[]() {},
+				[&]() { size_t sum = 0ul; for (uint32_t key : set) { sum += key; } gSink = sum; });
+
+			measure("std::unordered_set", nullptr, "erase", size, size,
+				[&]() { set.clear(); for (size_t i = 0; i < size; ++i) { set.insert(keys[i]); } },
+				[&]() { for (size_t i = 0; i < size; ++i) { set.erase(keys[i]); } });
+		}
+	}
+
+	void benchmarkLinkedList(cave::MemoryPool& pool, size_t size, std::vector<uint32_t>& keys)
+	{
+		{
+			cave::LinkedList list(pool);
+			measure("cave::LinkedList", "std::list", "insert", size, size,
+				[&]() { list.Clear(); },
+				[&]() { for (size_t i = 0; i < size; ++i) { list.InsertBack(&keys[i]); } });
+
+			/* one search for the value inserted last, cost is per visited node */
+			measure("cave::LinkedList", "std::list", "lookup", size, size,
+				[]() {},
+				[&]() { size_t index = 0ul; for (void* value : list) { if (*reinterpret_cast<uint32_t*>(value) == keys[size - 1]) { break; } ++index; } gSink = index; });
+
+			measure("cave::LinkedList", "std::list", "iterate", size, size,
+				[]() {},
+				[&]() { size_t sum = 0ul; for (void* value : list) { sum += *reinterpret_cast<uint32_t*>(value); } gSink = sum; });
+
+			measure("cave::LinkedList", "std::list", "erase", size, size,
+				[&]() { list.Clear(); for (size_t i = 0; i < size; ++i) { list.InsertBack(&keys[i]); } },
+				[&]() { for (size_t i = 0; i < size; ++i) { list.DeleteFront(); } });
+		}
+
+		{
+			std::list<void*> list;
+			measure("std::list", nullptr, "insert", size, size,
+				[&]() { list.clear(); },
+				[&]() { for (size_t i = 0; i < size; ++i) { list.push_back(&keys[i]); } });
+
+			measure("std::list", nullptr, "lookup", size, size,
+				[]() {},
+				[&]() { size_t index = 0ul; for (void* value : list) { if (*reinterpret_cast<uint32_t*>(value) == keys[size - 1]) { break; } ++index; } gSink = index; });
+
+			measure("std::list", nullptr, "iterate", size, size,
+				[]() {},
+				[&]() { size_t sum = 0ul; for (void* value : list) { sum += *reinterpret_cast<uint32_t*>(value); } gSink = sum; });
+
+			measure("std::list", nullptr, "erase", size, size,
+				[&]() { list.clear(); for (size_t i = 0; i < size; ++i) { list.push_back(&keys[i]); } },
+				[&]() { for (size_t i = 0; i < size; ++i) { list.pop_front(); } });
+		}
+	}
+
+	void benchmarkStack(cave::MemoryPool& pool, size_t size, std::vector<uint32_t>& keys)
+	{
+		{
+			cave::Stack stack(pool);
+			measure("cave::Stack", "std::stack", "insert", size, size,
+				[&]() { while (!stack.IsEmpty()) { stack.Pop(); } },
+				[&]() { for (size_t i = 0; i < size; ++i) { stack.Push(&keys[i]); } });
+
+			measure("cave::Stack", "std::stack", "erase", size, size,
+				[&]() { while (!stack.IsEmpty()) { stack.Pop(); } for (size_t i = 0; i < size; ++i) { stack.Push(&keys[i]); } },
+				[&]() { size_t sum = 0ul; for (size_t i = 0; i < size; ++i) { sum += *reinterpret_cast<uint32_t*>(stack.GetTop()); stack.Pop(); } gSink = sum; });
+		}
+
+		{
+			std::stack<void*> stack;
+			measure("std::stack", nullptr, "insert", size, size,
+				[&]() { stack = std::stack<void*>(); },
+				[&]() { for (size_t i = 0; i < size; ++i) { stack.push(&keys[i]); } });
+
+			measure("std::stack", nullptr, "erase", size, size,
+				[&]() { stack = std::stack<void*>(); for (size_t i = 0; i < size; ++i) { stack.push(&keys[i]); } },
+				[&]() { size_t sum = 0ul; for (size_t i = 0; i < size; ++i) { sum += *reinterpret_cast<uint32_t*>(stack.top()); stack.pop(); } gSink = sum; });
+		}
+	}
+
+	void benchmarkBitArray(cave::MemoryPool& pool, size_t size, std::vector<uint32_t>& keys)
+	{
+		{
+			cave::BitArray bitArray(size, false, pool);
+			measure("cave::BitArray", "std::vector<bool>", "insert", size, size,
+				[&]() { bitArray.SetAll(false); },
+				[&]() { for (size_t i = 0; i < size; ++i) { bitArray.Set(keys[i], (keys[i] & 1u) != 0u); } });
+
+			measure("cave::BitArray", "std::vector<bool>", "lookup", size, size,
+				[]() {},
+				[&]() { size_t count = 0ul; for (size_t i = 0; i < size; ++i) { count += bitArray.Get(keys[i]); } gSink = count; });
+
+			measure("cave::BitArray", "std::vector<bool>", "iterate", size, size,
+				[]() {},
+				[&]() { size_t count = 0ul; for (size_t i = 0; i < size; ++i) { count += bitArray[i]; } gSink = count; });
+		}
+
+		{
+			std::vector<bool> bits(size, false);
+			measure("std::vector<bool>", nullptr, "insert", size, size,
+				[&]() { bits.assign(size, false); },
+				[&]() { for (size_t i = 0; i < size; ++i) { bits[keys[i]] = (keys[i] & 1u) != 0u; } });
+
+			measure("std::vector<bool>", nullptr, "lookup", size, size,
+				[]() {},
+				[&]() { size_t count = 0ul; for (size_t i = 0; i < size; ++i) { count += bits[keys[i]]; } gSink = count; });
+
+			measure("std::vector<bool>", nullptr, "iterate", size, size,
+				[]() {},
+				[&]() { size_t count = 0ul; for (bool bit : bits) { count += bit; } gSink = count; });
+		}
+	}
+}
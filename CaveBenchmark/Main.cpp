@@ -0,0 +1,254 @@
+/*!
+ * Copyright (c) 2021 SWTube. All rights reserved.
+ * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
+ */
+
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "CoreTypes.h"
+#include "CoreGlobals.h"
+#include "Memory/MemoryPool.h"
+#include "Benchmark.h"
+
+/*
+ * Core micro-benchmarks, one file per subsystem sharing the harness in Benchmark.h.
+ *
+ * Every cave type is measured next to the std type or the former implementation it replaces, on the same workloads.
+ * Results are written as JSON so that two builds can be diffed:
+ *
+ *   CaveBenchmark [--out <file>] [--min-size <n>] [--max-size <n>] [--filter <container substring>]
+ */
+
+namespace CaveBenchmark
+{
+	std::vector<Result> gResults;
+	volatile size_t gSink = 0ul;
+
+	std::vector<uint32_t> makeShuffledKeys(size_t size)
+	{
+		std::vector<uint32_t> keys(size);
+		for (size_t i = 0; i < size; ++i)
+		{
+			keys[i] = static_cast<uint32_t>(i);
+		}
+
+		std::mt19937 engine(0x5eed);
+		std::shuffle(keys.begin(), keys.end(), engine);
+
+		return keys;
+	}
+}
+
+using namespace CaveBenchmark;
+
+namespace
+{
+	constexpr size_t BENCHMARK_POOL_SIZE = 64ul * 1024ul * 1024ul;
+	/* the pool grows with --max-size: it hands out blocks of up to half its size, a container may need this many bytes per element */
+	constexpr size_t POOL_BYTES_PER_ELEMENT = 64ul;
+	constexpr size_t DEFAULT_MIN_SIZE = 16ul;
+	constexpr size_t DEFAULT_MAX_SIZE = 10000000ul;
+
+	struct Options
+	{
+		const char* OutputPath = nullptr;
+		const char* Filter = nullptr;
+		size_t MinSize = DEFAULT_MIN_SIZE;
+		size_t MaxSize = DEFAULT_MAX_SIZE;
+	};
+
+	bool isSelected(const Options& options, const char* container)
+	{
+		return options.Filter == nullptr || std::strstr(container, options.Filter) != nullptr;
+	}
+
+	bool parseOptions(int argc, char* argv[], Options& options)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			bool hasValue = i + 1 < argc;
+
+			if (std::strcmp(argv[i], "--out") == 0 && hasValue)
+			{
+				options.OutputPath = argv[++i];
+			}
+			else if (std::strcmp(argv[i], "--filter") == 0 && hasValue)
+			{
+				options.Filter = argv[++i];
+			}
+			else if (std::strcmp(argv[i], "--min-size") == 0 && hasValue)
+			{
+				options.MinSize = std::strtoull(argv[++i], nullptr, 10);
+			}
+			else if (std::strcmp(argv[i], "--max-size") == 0 && hasValue)
+			{
+				options.MaxSize = std::strtoull(argv[++i], nullptr, 10);
+			}
+			else
+			{
+				std::fprintf(stderr, "usage: %s [--out <file>] [--min-size <n>] [--max-size <n>] [--filter <container>]\n", argv[0]);
+				return false;
+			}
+		}
+
+		return options.MinSize > 0ul && options.MinSize <= options.MaxSize;
+	}
+
+	void writeJson(FILE* out)
+	{
+		std::fprintf(out, "{\n");
+		std::fprintf(out, "  \"schema\": 1,\n");
+#if defined(CAVE_BUILD_DEBUG)
+		std::fprintf(out, "  \"build\": \"debug\",\n");
+#elif defined(CAVE_BUILD_DEVELOPMENT)
+		std::fprintf(out, "  \"build\": \"development\",\n");
+#elif defined(CAVE_BUILD_TEST)
+		std::fprintf(out, "  \"build\": \"test\",\n");
+#else
+		std::fprintf(out, "  \"build\": \"release\",\n");
+#endif
+		std::fprintf(out, "  \"results\": [\n");
+		for (size_t i = 0; i < gResults.size(); ++i)
+		{
+			const Result& result = gResults[i];
+			std::fprintf(out, "    { \"container\": \"%s\", \"baseline\": ", result.Container);
+			if (result.Baseline != nullptr)
+			{
+				std::fprintf(out, "\"%s\"", result.Baseline);
+			}
+			else
+			{
+				std::fprintf(out, "null");
+			}
+			std::fprintf(out, ", \"workload\": \"%s\", \"size\": %llu, \"repeats\": %u, \"ns_per_op\": %.4f"
+				, result.Workload
+				, static_cast<unsigned long long>(result.Size)
+				, result.Repeats
+				, result.NanosecondsPerOperation);
+			if (result.AllocationsPerOperation >= 0.0)
+			{
+				std::fprintf(out, ", \"allocations_per_op\": %.4f", result.AllocationsPerOperation);
+			}
+			std::fprintf(out, " }%s\n", i + 1 < gResults.size() ? "," : "");
+		}
+		std::fprintf(out, "  ]\n");
+		std::fprintf(out, "}\n");
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	Options options;
+	if (!parseOptions(argc, argv, options))
+	{
+		return EXIT_FAILURE;
+	}
+
+	cave::MemoryPool pool(std::max(BENCHMARK_POOL_SIZE, std::bit_ceil(options.MaxSize) * POOL_BYTES_PER_ELEMENT));
+
+	for (size_t size = options.MinSize; size <= options.MaxSize; size = (size < options.MaxSize && size * 16ul > options.MaxSize) ? options.MaxSize : size * 16ul)
+	{
+		std::fprintf(stderr, "size %llu\n", static_cast<unsigned long long>(size));
+		std::vector<uint32_t> keys = makeShuffledKeys(size);
+
+		if (isSelected(options, "Array"))
+		{
+			benchmarkArray(pool, size, keys);
+		}
+		if (isSelected(options, "HashTable"))
+		{
+			benchmarkHashTable(pool, size, keys);
+		}
+		if (isSelected(options, "HashSet"))
+		{
+			benchmarkHashSet(pool, size, keys);
+		}
+		if (isSelected(options, "LinkedList"))
+		{
+			benchmarkLinkedList(pool, size, keys);
+		}
+		if (isSelected(options, "Stack"))
+		{
+			benchmarkStack(pool, size, keys);
+		}
+		if (isSelected(options, "BitArray"))
+		{
+			benchmarkBitArray(pool, size, keys);
+		}
+		if (isSelected(options, "String"))
+		{
+			benchmarkString(pool, size);
+		}
+		if (isSelected(options, "String search"))
+		{
+			benchmarkStringSearch(pool, size);
+		}
+		if (isSelected(options, "String format"))
+		{
+			benchmarkStringFormat(pool, size);
+		}
+		if (isSelected(options, "String WString small PooledString PooledWString"))
+		{
+			benchmarkSmallString(pool, size);
+		}
+		if (isSelected(options, "Unicode"))
+		{
+			benchmarkUnicode(size);
+		}
+		if (isSelected(options, "CharConv ToChars FromChars Format"))
+		{
+			benchmarkCharConv(size);
+		}
+		if (isSelected(options, "JobSystem"))
+		{
+			benchmarkJobSystem(size);
+		}
+		if (isSelected(options, "Mutex RwSpinLock Event Semaphore"))
+		{
+			benchmarkSynchronization(size);
+		}
+		if (isSelected(options, "EpochHashMap"))
+		{
+			benchmarkEpochHashMap(size, keys);
+		}
+		if (isSelected(options, "ParallelRadixSort ParallelMergeSort ParallelReduce ParallelInclusiveScan ParallelPartition"))
+		{
+			benchmarkParallelAlgorithms(size, keys);
+		}
+		if (isSelected(options, "RadixSort SortSmall BranchlessLowerBound EytzingerArray"))
+		{
+			benchmarkAlgorithms(size, keys);
+		}
+
+		if (size == options.MaxSize)
+		{
+			break;
+		}
+	}
+
+	FILE* out = stdout;
+	if (options.OutputPath != nullptr)
+	{
+		out = std::fopen(options.OutputPath, "w");
+		if (out == nullptr)
+		{
+			std::fprintf(stderr, "cannot open %s\n", options.OutputPath);
+			return EXIT_FAILURE;
+		}
+	}
+
+	writeJson(out);
+
+	if (out != stdout)
+	{
+		std::fclose(out);
+	}
+
+	return EXIT_SUCCESS;
+}
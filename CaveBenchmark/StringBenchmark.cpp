@@ -0,0 +1,598 @@
+/*!
+ * Copyright (c) 2021 SWTube. All rights reserved.
+ * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <cwchar>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "String/CharConv.h"
+#include "String/Format.h"
+
+import cave.Core.Memory.Memory;
+import cave.Core.String;
+import cave.Core.String.Unicode;
+
+/*
+ * String is measured next to std::string with the same insert, lookup, iterate and erase workloads.
+ * String search is measured on log lines and resource paths, String formatting on the pieces of a log line.
+ * Short String and WString construction, tag names and text labels, also counts the pool allocations per string,
+ * which the in-place buffer saves next to names too long for it. The names TagPoolTest adds and the strings of a Text
+ * are also built as PooledString, which allocates like String and WString did before the in-place buffer.
+ * UTF-8 validation and transcoding are measured on ASCII log text and on Korean dialogue.
+ * Number conversion and Format are measured against snprintf, strtoll and strtod.
+ */
+
+namespace CaveBenchmark
+{
+	namespace
+	{
+		/* substring search runs over at most this many log lines or paths */
+		constexpr size_t MAX_SEARCH_LINE_COUNT = 65536ul;
+		/* at most this many short strings are constructed per batch */
+		constexpr size_t MAX_SMALL_STRING_COUNT = 65536ul;
+		/* a single string grows to at most this many appended pieces */
+		constexpr size_t MAX_APPEND_PIECE_COUNT = 1024ul * 1024ul;
+		/* transcoded text is at most this many bytes, about a chapter of dialogue */
+		constexpr size_t MAX_TRANSCODE_BYTE_COUNT = 4ul * 1024ul * 1024ul;
+		/* numbers are converted in batches of at most this many */
+		constexpr size_t MAX_NUMBER_COUNT = 65536ul;
+
+		/*
+		 * Realistic haystacks for substring search: log lines in the LogManager format and resource paths.
+		 * Only every 64th line holds the needle, so most of the cost is rejecting a line.
+		 */
+		std::vector<std::string> makeLogLines(size_t count)
+		{
+			static const char* const channels[] = { "CORE", "CORE_STRING", "GRAPHICS", "GAMEPLAY", "RESOURCE" };
+			std::vector<std::string> lines;
+			lines.reserve(count);
+
+			char line[256];
+			for (size_t i = 0; i < count; ++i)
+			{
+				std::snprintf(line, sizeof(line), "[2021-06-%02u %02u:%02u:%02u.%03u][%s][%s] TextureManager loaded Resource/Textures/Cave/wall_%04u.png in %u ms"
+					, static_cast<uint32_t>(1u + i % 28u), static_cast<uint32_t>(i % 24u), static_cast<uint32_t>(i % 60u), static_cast<uint32_t>((i * 7u) % 60u), static_cast<uint32_t>(i % 1000u)
+					, channels[i % 5u], i % 64u == 63u ? "Error" : "Debug", static_cast<uint32_t>(i % 10000u), static_cast<uint32_t>(i % 17u));
+				lines.push_back(line);
+			}
+
+			return lines;
+		}
+
+		std::vector<std::string> makePaths(size_t count)
+		{
+			static const char* const folders[] = { "Textures/Cave", "Textures/Ui", "Sounds/Ambient", "Shaders", "Levels/Chapter1" };
+			std::vector<std::string> paths;
+			paths.reserve(count);
+
+			char path[256];
+			for (size_t i = 0; i < count; ++i)
+			{
+				std::snprintf(path, sizeof(path), "C:/Projects/Darkest-Cave/Resource/%s/%s_%04u.%s"
+					, i % 64u == 63u ? "Sprites/Player" : folders[i % 5u], i % 2u == 0u ? "asset" : "tile", static_cast<uint32_t>(i % 10000u), i % 3u == 0u ? "dds" : "png");
+				paths.push_back(path);
+			}
+
+			return paths;
+		}
+
+		/*
+		 * size bytes of UTF-8, made of whole lines so that no sequence is cut.
+		 * Dialogue is mostly Hangul, three bytes per character, with some ASCII punctuation and names.
+		 */
+		/*
+		 * String and WString before the in-place buffer: every string, however short, takes
+		 * GetSufficientCapacity<16>(length) characters from the pool and zero-fills them past the end.
+		 */
+		template <typename Char>
+		class PooledString final
+		{
+		public:
+			PooledString(const Char* s, cave::MemoryPool& pool)
+				: mPool(&pool)
+				, mLength(std::char_traits<Char>::length(s))
+				, mCapacity(cave::GetSufficientCapacity<16>(mLength))
+				, mString(reinterpret_cast<Char*>(pool.Allocate(sizeof(Char) * mCapacity)))
+			{
+				std::memcpy(mString, s, sizeof(Char) * mLength);
+				std::memset(&mString[mLength], 0, sizeof(Char) * (mCapacity - mLength));
+			}
+
+			PooledString(PooledString&& other) noexcept
+				: mPool(other.mPool)
+				, mLength(other.mLength)
+				, mCapacity(other.mCapacity)
+				, mString(other.mString)
+			{
+				other.mString = nullptr;
+			}
+
+			PooledString(const PooledString&) = delete;
+			PooledString& operator=(const PooledString&) = delete;
+			PooledString& operator=(PooledString&&) = delete;
+
+			~PooledString()
+			{
+				if (mString != nullptr)
+				{
+					mPool->Deallocate(mString, sizeof(Char) * mCapacity);
+				}
+			}
+
+		private:
+			cave::MemoryPool* mPool;
+			size_t mLength;
+			size_t mCapacity;
+			Char* mString;
+		};
+
+		std::string makeUtf8Text(size_t size, bool isDialogue)
+		{
+			// "Cave: " U+B3D9 U+AD74 U+C5D0 " " U+C624 U+C2E0 " " U+AC83 U+C744 " " U+D658 U+C601 U+D569 U+B2C8 U+B2E4 "!"
+			static const char* const dialogue = "Cave: \xEB\x8F\x99\xEA\xB5\xB4\xEC\x97\x90 \xEC\x98\xA4\xEC\x8B\xA0 \xEA\xB2\x83\xEC\x9D\x84 "
+				"\xED\x99\x98\xEC\x98\x81\xED\x95\xA9\xEB\x8B\x88\xEB\x8B\xA4!\n";
+			static const char* const log = "[2021-06-01 12:00:00.000][CORE][Debug] TextureManager loaded Resource/Textures/Cave/wall.png\n";
+
+			const char* line = isDialogue ? dialogue : log;
+			const size_t lineLength = std::strlen(line);
+
+			std::string text;
+			text.reserve(size + lineLength);
+			while (text.size() + lineLength <= size)
+			{
+				text += line;
+			}
+			text.append(size - text.size(), ' ');
+
+			return text;
+		}
+	}
+
+	void benchmarkString(cave::MemoryPool& pool, size_t size)
+	{
+		{
+			cave::String string(pool);
+			measure("cave::String", "std::string", "insert", size, size,
+				[&]() { string.Clear(); string.Shrink(); },
+				[&]() { for (size_t i = 0; i < size; ++i) { string.PushBack(static_cast<char>('a' + i % 26)); } });
+
+			/* one search for a character that only appears at the end, cost is per scanned character */
+			measure("cave::String", "std::string", "lookup", size, size,
+				[&]() { string.PopBack(); string.PushBack('#'); },
+				[&]() { gSink = string.GetIndexOf('#'); });
+
+			measure("cave::String", "std::string", "iterate", size, size,
+				[]() {},
+				[&]() { size_t sum = 0ul; for (size_t i = 0; i < size; ++i) { sum += static_cast<size_t>(string[i]); } gSink = sum; });
+
+			measure("cave::String", "std::string", "erase", size, size,
+				[&]() { string.Clear(); string.Append(size, 'a'); },
+				[&]() { for (size_t i = 0; i < size; ++i) { string.PopBack(); } });
+		}
+
+		{
+			std::string string;
+			measure("std::string", nullptr, "insert", size, size,
+				[&]() { string = std::string(); },
+				[&]() { for (size_t i = 0; i < size; ++i) { string.push_back(static_cast<char>('a' + i % 26)); } });
+
+			measure("std::string", nullptr, "lookup", size, size,
+				[&]() { string.back() = '#'; },
+				[&]() { gSink = string.find('#'); });
+
+			measure("std::string", nullptr, "iterate", size, size,
+				[]() {},
+				[&]() { size_t sum = 0ul; for (char ch : string) { sum += static_cast<size_t>(ch); } gSink = sum; });
+
+			measure("std::string", nullptr, "erase", size, size,
+				[&]() { string.assign(size, 'a'); },
+				[&]() { for (size_t i = 0; i < size; ++i) { string.pop_back(); } });
+		}
+	}
+
+	void benchmarkStringSearch(cave::MemoryPool& pool, size_t size)
+	{
+		// lines are searched one after another, larger sizes would only measure the memory bandwidth
+		const size_t count = size < MAX_SEARCH_LINE_COUNT ? size : MAX_SEARCH_LINE_COUNT;
+		const std::vector<std::string> stdLogLines = makeLogLines(count);
+		const std::vector<std::string> stdPaths = makePaths(count);
+
+		std::vector<cave::String> logLines;
+		std::vector<cave::String> paths;
+		logLines.reserve(count);
+		paths.reserve(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			logLines.emplace_back(stdLogLines[i].c_str(), pool);
+			paths.emplace_back(stdPaths[i].c_str(), pool);
+		}
+
+		measure("cave::String search", "std::string", "find-log", count, count,
+			[]() {},
+			[&]() { size_t found = 0ul; for (const cave::String& line : logLines) { found += line.GetIndexOf("[Error]") != cave::String::NPOS; } gSink = found; });
+
+		measure("cave::String search", "std::string", "find-path", count, count,
+			[]() {},
+			[&]() { size_t found = 0ul; for (const cave::String& path : paths) { found += path.Contains("/Sprites/"); } gSink = found; });
+
+		measure("cave::String search", "std::string", "rfind-path", count, count,
+			[]() {},
+			[&]() { size_t sum = 0ul; for (const cave::String& path : paths) { sum += path.GetLastIndexOf('/'); } gSink = sum; });
+
+		measure("std::string search", nullptr, "find-log", count, count,
+			[]() {},
+			[&]() { size_t found = 0ul; for (const std::string& line : stdLogLines) { found += line.find("[Error]") != std::string::npos; } gSink = found; });
+
+		measure("std::string search", nullptr, "find-path", count, count,
+			[]() {},
+			[&]() { size_t found = 0ul; for (const std::string& path : stdPaths) { found += path.find("/Sprites/") != std::string::npos; } gSink = found; });
+
+		measure("std::string search", nullptr, "rfind-path", count, count,
+			[]() {},
+			[&]() { size_t sum = 0ul; for (const std::string& path : stdPaths) { sum += path.rfind('/'); } gSink = sum; });
+	}
+
+	/*
+	 * The log formatting path: every line is put together from the channel, verbosity, file, function, line number and message.
+	 * "append-pieces" grows a single string by many small appends, which is where the growth policy shows.
+	 */
+	void benchmarkStringFormat(cave::MemoryPool& pool, size_t size)
+	{
+		const size_t lineCount = size < MAX_SEARCH_LINE_COUNT ? size : MAX_SEARCH_LINE_COUNT;
+		const size_t pieceCount = size < MAX_APPEND_PIECE_COUNT ? size : MAX_APPEND_PIECE_COUNT;
+		static const char* const lineNumbers[] = { "42", "108", "1337", "7", "256" };
+
+		measure("cave::StringBuilder", "std::string", "format-log", lineCount, lineCount,
+			[]() {},
+			[&]()
+			{
+				size_t length = 0ul;
+				cave::StringBuilder builder(pool);
+				for (size_t i = 0; i < lineCount; ++i)
+				{
+					builder.Clear();
+					builder.Append("Core/Resource/").Append("D/").Append("TextureManager.ixx").Append('/').Append("GetTexture")
+						.Append("/line:").Append(lineNumbers[i % 5u]).Append(" :\t").Append("loaded Resource/Textures/Cave/wall.png");
+					cave::String line = builder.ToString();
+					length += line.GetLength();
+				}
+				gSink = length;
+			});
+
+		measure("cave::String", "std::string", "format-log", lineCount, lineCount,
+			[]() {},
+			[&]()
+			{
+				size_t length = 0ul;
+				for (size_t i = 0; i < lineCount; ++i)
+				{
+					cave::String line(pool);
+					line += "Core/Resource/";
+					line += "D/";
+					line += "TextureManager.ixx";
+					line += '/';
+					line += "GetTexture";
+					line += "/line:";
+					line += lineNumbers[i % 5u];
+					line += " :\t";
+					line += "loaded Resource/Textures/Cave/wall.png";
+					length += line.GetLength();
+				}
+				gSink = length;
+			});
+
+		measure("cave::String", "std::string", "append-pieces", pieceCount, pieceCount,
+			[]() {},
+			[&]() { cave::String string(pool); for (size_t i = 0; i < pieceCount; ++i) { string += "piece "; } gSink = string.GetLength(); });
+
+		measure("std::string", nullptr, "format-log", lineCount, lineCount,
+			[]() {},
+			[&]()
+			{
+				size_t length = 0ul;
+				for (size_t i = 0; i < lineCount; ++i)
+				{
+					std::string line;
+					line += "Core/Resource/";
+					line += "D/";
+					line += "TextureManager.ixx";
+					line += '/';
+					line += "GetTexture";
+					line += "/line:";
+					line += lineNumbers[i % 5u];
+					line += " :\t";
+					line += "loaded Resource/Textures/Cave/wall.png";
+					length += line.length();
+				}
+				gSink = length;
+			});
+
+		measure("std::string", nullptr, "append-pieces", pieceCount, pieceCount,
+			[]() {},
+			[&]() { std::string string; for (size_t i = 0; i < pieceCount; ++i) { string += "piece "; } gSink = string.length(); });
+	}
+
+	/*
+	 * Tag names and text labels fit the in-place buffer of String and WString, resource paths do not.
+	 * Each string is kept until the batch ends, like the names of a loaded level.
+	 */
+	void benchmarkSmallString(cave::MemoryPool& pool, size_t size)
+	{
+		const size_t count = size < MAX_SMALL_STRING_COUNT ? size : MAX_SMALL_STRING_COUNT;
+		const char* const tags[] = { "Player", "Enemy", "Ground", "Ladder", "Trigger", "MainCamera", "Projectile", "Pickup" };
+
+		std::vector<std::string> tagNames;
+		std::vector<std::wstring> labels;
+		tagNames.reserve(count);
+		labels.reserve(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			char tagName[32];
+			std::snprintf(tagName, sizeof(tagName), "%s_%u", tags[i % 8u], static_cast<uint32_t>(i % 1000u));
+			tagNames.push_back(tagName);
+
+			wchar_t label[16];
+			std::swprintf(label, 16, L"HP %04u", static_cast<uint32_t>(i % 10000u));
+			labels.push_back(label);
+		}
+		const std::vector<std::string> paths = makePaths(count);
+		assert(tagNames.back().length() < cave::String::SSO_CAPACITY && labels.back().length() < cave::WString::SSO_CAPACITY);
+
+		// the names TagPoolTest adds, 1 to 20 letters and digits, from a fixed seed so that every run builds the same ones
+		const char* const alphabet = "1234567890ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+		std::mt19937 engine(0x5eed);
+		std::uniform_int_distribution<uint32_t> lengthDistribution(1u, 20u);
+		std::uniform_int_distribution<uint32_t> characterDistribution(0u, 61u);
+		std::vector<std::string> testTagNames(count);
+		for (std::string& name : testTagNames)
+		{
+			name.resize(lengthDistribution(engine));
+			for (char& ch : name)
+			{
+				ch = alphabet[characterDistribution(engine)];
+			}
+		}
+
+		// the font name and content of every Text, from the texts WindowsEngine shows
+		const wchar_t* const fontNames[] = { L"Noto Sans KR", L"\uAE30\uBCF8", L"\uBC30\uB2EC\uC758\uBBFC\uC871 \uC8FC\uC544" };
+		const wchar_t* const contents[] = { L"\uD55C\uAD6D\uC5B4", L"\uAE30\uBCF8", L"\uC774 \uAE00\uC528\uCCB4\uB294 \uBB34\uC5C7\uC77C\uAE4C?" };
+		const size_t textStringCount = 2ul * count;
+		std::vector<const wchar_t*> textStrings(textStringCount);
+		for (size_t i = 0; i < count; ++i)
+		{
+			textStrings[2ul * i] = fontNames[i % 3u];
+			textStrings[2ul * i + 1ul] = contents[(i / 3u) % 3u];
+		}
+		assert(paths.back().length() >= cave::String::SSO_CAPACITY);
+
+		{
+			std::vector<cave::String> strings;
+			strings.reserve(count);
+			measure("cave::String", "std::string", "tag-names", count, count,
+				[&]() { strings.clear(); },
+				[&]() { for (size_t i = 0; i < count; ++i) { strings.emplace_back(tagNames[i].c_str(), pool); } });
+			strings.clear();
+			countAllocations(pool, count, [&](size_t i) { strings.emplace_back(tagNames[i].c_str(), pool); });
+			strings.clear();
+
+			measure("cave::String", "std::string", "paths", count, count,
+				[&]() { strings.clear(); },
+				[&]() { for (size_t i = 0; i < count; ++i) { strings.emplace_back(paths[i].c_str(), pool); } });
+			strings.clear();
+			countAllocations(pool, count, [&](size_t i) { strings.emplace_back(paths[i].c_str(), pool); });
+		}
+
+		{
+			std::vector<cave::WString> strings;
+			strings.reserve(count);
+			measure("cave::WString", "std::wstring", "text-labels", count, count,
+				[&]() { strings.clear(); },
+				[&]() { for (size_t i = 0; i < count; ++i) { strings.emplace_back(labels[i].c_str(), pool); } });
+			strings.clear();
+			countAllocations(pool, count, [&](size_t i) { strings.emplace_back(labels[i].c_str(), pool); });
+		}
+
+		{
+			std::vector<cave::String> strings;
+			strings.reserve(count);
+			measure("cave::String", "PooledString", "tagpool-test", count, count,
+				[&]() { strings.clear(); },
+				[&]() { for (size_t i = 0; i < count; ++i) { strings.emplace_back(testTagNames[i].c_str(), pool); } });
+			strings.clear();
+			countAllocations(pool, count, [&](size_t i) { strings.emplace_back(testTagNames[i].c_str(), pool); });
+		}
+
+		{
+			std::vector<PooledString<char>> strings;
+			strings.reserve(count);
+			measure("PooledString", nullptr, "tagpool-test", count, count,
+				[&]() { strings.clear(); },
+				[&]() { for (size_t i = 0; i < count; ++i) { strings.emplace_back(testTagNames[i].c_str(), pool); } });
+			strings.clear();
+			countAllocations(pool, count, [&](size_t i) { strings.emplace_back(testTagNames[i].c_str(), pool); });
+		}
+
+		{
+			std::vector<cave::WString> strings;
+			strings.reserve(textStringCount);
+			measure("cave::WString", "PooledWString", "text", textStringCount, textStringCount,
+				[&]() { strings.clear(); },
+				[&]() { for (size_t i = 0; i < textStringCount; ++i) { strings.emplace_back(textStrings[i], pool); } });
+			strings.clear();
+			countAllocations(pool, textStringCount, [&](size_t i) { strings.emplace_back(textStrings[i], pool); });
+		}
+
+		{
+			std::vector<PooledString<wchar_t>> strings;
+			strings.reserve(textStringCount);
+			measure("PooledWString", nullptr, "text", textStringCount, textStringCount,
+				[&]() { strings.clear(); },
+				[&]() { for (size_t i = 0; i < textStringCount; ++i) { strings.emplace_back(textStrings[i], pool); } });
+			strings.clear();
+			countAllocations(pool, textStringCount, [&](size_t i) { strings.emplace_back(textStrings[i], pool); });
+		}
+
+		{
+			std::vector<std::string> strings;
+			strings.reserve(count);
+			measure("std::string", nullptr, "tag-names", count, count,
+				[&]() { strings.clear(); },
+				[&]() { for (size_t i = 0; i < count; ++i) { strings.emplace_back(tagNames[i].c_str()); } });
+
+			measure("std::string", nullptr, "paths", count, count,
+				[&]() { strings.clear(); },
+				[&]() { for (size_t i = 0; i < count; ++i) { strings.emplace_back(paths[i].c_str()); } });
+		}
+
+		{
+			std::vector<std::wstring> strings;
+			strings.reserve(count);
+			measure("std::wstring", nullptr, "text-labels", count, count,
+				[&]() { strings.clear(); },
+				[&]() { for (size_t i = 0; i < count; ++i) { strings.emplace_back(labels[i].c_str()); } });
+		}
+	}
+
+	/*
+	 * Integers are spread over all magnitudes, doubles are random values written with all their digits.
+	 * "format-log" is the message part of a log line with an integer, a float and a string argument.
+	 */
+	void benchmarkCharConv(size_t size)
+	{
+		const size_t count = size < MAX_NUMBER_COUNT ? size : MAX_NUMBER_COUNT;
+
+		std::mt19937_64 engine(0x5eed);
+		std::vector<int64_t> integers(count);
+		std::vector<double> doubles(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			integers[i] = static_cast<int64_t>(engine() >> (engine() % 64u));
+			doubles[i] = std::uniform_real_distribution<double>(-1e6, 1e6)(engine);
+		}
+
+		std::vector<std::string> integerTexts(count);
+		std::vector<std::string> doubleTexts(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			char text[cave::MAX_FLOAT_CHAR_COUNT];
+			integerTexts[i].assign(text, cave::ToChars(text, text + sizeof(text), integers[i]).End);
+			doubleTexts[i].assign(text, cave::ToChars(text, text + sizeof(text), doubles[i]).End);
+		}
+
+		char buffer[256];
+
+		measure("cave::ToChars", "snprintf", "int-to-chars", count, count,
+			[]() {},
+			[&]() { size_t length = 0ul; for (int64_t value : integers) { length += static_cast<size_t>(cave::ToChars(buffer, buffer + sizeof(buffer), value).End - buffer); } gSink = length; });
+
+		measure("cave::ToChars", "snprintf", "double-to-chars", count, count,
+			[]() {},
+			[&]() { size_t length = 0ul; for (double value : doubles) { length += static_cast<size_t>(cave::ToChars(buffer, buffer + sizeof(buffer), value).End - buffer); } gSink = length; });
+
+		measure("cave::FromChars", "strtoll", "parse-int", count, count,
+			[]() {},
+			[&]()
+			{
+				int64_t sum = 0;
+				for (const std::string& text : integerTexts)
+				{
+					int64_t value = 0;
+					cave::FromChars(text.data(), text.data() + text.size(), value);
+					sum += value;
+				}
+				gSink = static_cast<size_t>(sum);
+			});
+
+		measure("cave::FromChars", "strtod", "parse-double", count, count,
+			[]() {},
+			[&]()
+			{
+				double sum = 0.0;
+				for (const std::string& text : doubleTexts)
+				{
+					double value = 0.0;
+					cave::FromChars(text.data(), text.data() + text.size(), value);
+					sum += value;
+				}
+				gSink = static_cast<size_t>(sum);
+			});
+
+		measure("cave::Format", "snprintf", "format-log", count, count,
+			[]() {},
+			[&]()
+			{
+				size_t length = 0ul;
+				for (size_t i = 0; i < count; ++i)
+				{
+					length += cave::Format(buffer, sizeof(buffer), "loaded {} textures in {:.3f} ms from {}", integers[i], doubles[i], "Resource/Textures/Cave").Length;
+				}
+				gSink = length;
+			});
+
+		measure("snprintf", nullptr, "int-to-chars", count, count,
+			[]() {},
+			[&]() { size_t length = 0ul; for (int64_t value : integers) { length += static_cast<size_t>(std::snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(value))); } gSink = length; });
+
+		measure("snprintf", nullptr, "double-to-chars", count, count,
+			[]() {},
+			[&]() { size_t length = 0ul; for (double value : doubles) { length += static_cast<size_t>(std::snprintf(buffer, sizeof(buffer), "%.17g", value)); } gSink = length; });
+
+		measure("strtoll", nullptr, "parse-int", count, count,
+			[]() {},
+			[&]() { long long sum = 0; for (const std::string& text : integerTexts) { sum += std::strtoll(text.c_str(), nullptr, 10); } gSink = static_cast<size_t>(sum); });
+
+		measure("strtod", nullptr, "parse-double", count, count,
+			[]() {},
+			[&]() { double sum = 0.0; for (const std::string& text : doubleTexts) { sum += std::strtod(text.c_str(), nullptr); } gSink = static_cast<size_t>(sum); });
+
+		measure("snprintf", nullptr, "format-log", count, count,
+			[]() {},
+			[&]()
+			{
+				size_t length = 0ul;
+				for (size_t i = 0; i < count; ++i)
+				{
+					length += static_cast<size_t>(std::snprintf(buffer, sizeof(buffer), "loaded %lld textures in %.3f ms from %s", static_cast<long long>(integers[i]), doubles[i], "Resource/Textures/Cave"));
+				}
+				gSink = length;
+			});
+	}
+
+	void benchmarkUnicode(size_t size)
+	{
+		const size_t byteCount = size < MAX_TRANSCODE_BYTE_COUNT ? size : MAX_TRANSCODE_BYTE_COUNT;
+		const std::string ascii = makeUtf8Text(byteCount, false);
+		const std::string dialogue = makeUtf8Text(byteCount, true);
+
+		std::vector<wchar_t> wide(byteCount + 1ul);
+		std::vector<char> narrow(4ul * byteCount + 1ul);
+		const size_t dialogueWideLength = cave::GetWideLengthFromUtf8(dialogue.data(), dialogue.size());
+		cave::ConvertUtf8ToWide(dialogue.data(), dialogue.size(), wide.data());
+
+		measure("cave::Unicode", nullptr, "validate-ascii", byteCount, byteCount,
+			[]() {},
+			[&]() { gSink = cave::ValidateUtf8(ascii.data(), ascii.size()).Count; });
+
+		measure("cave::Unicode", nullptr, "validate-dialogue", byteCount, byteCount,
+			[]() {},
+			[&]() { gSink = cave::ValidateUtf8(dialogue.data(), dialogue.size()).Count; });
+
+		measure("cave::Unicode", nullptr, "utf8-to-wide-ascii", byteCount, byteCount,
+			[]() {},
+			[&]() { gSink = cave::ConvertUtf8ToWide(ascii.data(), ascii.size(), wide.data()).Count; });
+
+		measure("cave::Unicode", nullptr, "utf8-to-wide-dialogue", byteCount, byteCount,
+			[]() {},
+			[&]() { gSink = cave::ConvertUtf8ToWide(dialogue.data(), dialogue.size(), wide.data()).Count; });
+
+		measure("cave::Unicode", nullptr, "wide-to-utf8-dialogue", byteCount, dialogueWideLength,
+			[]() {},
+			[&]() { gSink = cave::ConvertWideToUtf8(wide.data(), dialogueWideLength, narrow.data()).Count; });
+	}
+}
@@ -0,0 +1,582 @@
+/*!
+ * Copyright (c) 2021 SWTube. All rights reserved.
+ * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <queue>
+#include <semaphore>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Thread/JobSystem.h"
+#include "Thread/ParallelAlgorithms.h"
+#include "Thread/Epoch.h"
+#include "Thread/Synchronization.h"
+
+/*
+ * The job system is measured on many tiny jobs against the single locked queue of std::function it replaced,
+ * and its ParallelFor on a loop split in chunks against the same queue given one job per chunk.
+ * The synchronization primitives are measured under contention and on thread-to-thread handoffs against their std equivalents.
+ * EpochHashMap, whose lookups take no lock, is measured against a std::unordered_map behind a std::shared_mutex.
+ * The parallel sort, reduce, scan and partition run on 1, 2, 4, ... threads up to the processor count, 1 being the single-threaded
+ * fallback, next to the std algorithm they replace.
+ */
+
+namespace CaveBenchmark
+{
+	namespace
+	{
+		/* at most this many jobs are run per batch */
+		constexpr size_t MAX_JOB_COUNT = 1024ul * 1024ul;
+		/* elements a parallel loop hands to one job */
+		constexpr size_t PARALLEL_FOR_GRAIN_SIZE = 1024ul;
+		/* locks are taken at most this many times per batch, spread over the threads */
+		constexpr size_t MAX_LOCK_COUNT = 1024ul * 1024ul;
+		/* at most this many handoffs between two threads per batch, each may be a context switch */
+		constexpr size_t MAX_HANDOFF_COUNT = 16384ul;
+		/* threads that contend for a lock */
+		constexpr uint32_t MAX_CONTENDING_THREAD_COUNT = 8u;
+		/* the parallel algorithms are measured on 1, 2, 4, ... threads, up to this many */
+		constexpr uint32_t MAX_SCALING_THREAD_COUNT = 64u;
+		const char* const SCALING_WORKLOADS[] = { "1-thread", "2-threads", "4-threads", "8-threads", "16-threads", "32-threads", "64-threads" };
+
+		/*
+		 * The former cave::Thread: one std::queue of std::function behind a mutex and a condition variable,
+		 * every job a shared std::packaged_task with a std::future.
+		 */
+		class LockedThreadPool final
+		{
+		public:
+			LockedThreadPool(uint32_t threadCount)
+			{
+				for (uint32_t i = 0u; i < threadCount; ++i)
+				{
+					mThreads.emplace_back([this]()
+						{
+							for (;;)
+							{
+								std::unique_lock<std::mutex> lock(mMutex);
+								mCondition.wait(lock, [this]() { return !mJobs.empty() || mbStopped; });
+								if (mbStopped && mJobs.empty())
+								{
+									return;
+								}
+
+								std::function<void()> job = std::move(mJobs.front());
+								mJobs.pop();
+								lock.unlock();
+
+								job();
+							}
+						});
+				}
+			}
+
+			~LockedThreadPool()
+			{
+				{
+					std::lock_guard<std::mutex> lock(mMutex);
+					mbStopped = true;
+				}
+				mCondition.notify_all();
+
+				for (std::thread& thread : mThreads)
+				{
+					thread.join();
+				}
+			}
+
+			template <typename Function>
+			std::future<void> Enqueue(Function&& function)
+			{
+				auto job = std::make_shared<std::packaged_task<void()>>(std::forward<Function>(function));
+				std::future<void> result = job->get_future();
+				{
+					std::lock_guard<std::mutex> lock(mMutex);
+					mJobs.push([job]() { (*job)(); });
+				}
+				mCondition.notify_one();
+
+				return result;
+			}
+
+		private:
+			std::vector<std::thread> mThreads;
+			std::queue<std::function<void()>> mJobs;
+			std::mutex mMutex;
+			std::condition_variable mCondition;
+			bool mbStopped = false;
+		};
+
+		/*
+		 * Auto-reset event out of a mutex, a condition variable and a flag, what the log thread used to wait on.
+		 */
+		class ConditionEvent final
+		{
+		public:
+			void Signal()
+			{
+				{
+					std::lock_guard<std::mutex> lock(mMutex);
+					mbSignaled = true;
+				}
+				mCondition.notify_one();
+			}
+
+			void Wait()
+			{
+				std::unique_lock<std::mutex> lock(mMutex);
+				mCondition.wait(lock, [this]() { return mbSignaled; });
+				mbSignaled = false;
+			}
+
+		private:
+			std::mutex mMutex;
+			std::condition_variable mCondition;
+			bool mbSignaled = false;
+		};
+
+		template <typename Function>
+		void runOnThreads(uint32_t threadCount, Function&& function)
+		{
+			std::vector<std::thread> threads;
+			threads.reserve(threadCount);
+			for (uint32_t i = 0u; i < threadCount; ++i)
+			{
+				threads.emplace_back(function, i);
+			}
+			for (std::thread& thread : threads)
+			{
+				thread.join();
+			}
+		}
+
+		template <typename Lock>
+		void measureLock(const char* container, const char* baseline, size_t lockCount, uint32_t threadCount)
+		{
+			Lock lock;
+			size_t counter = 0ul;
+
+			measure(container, baseline, "uncontended", lockCount, lockCount,
+				[]() {},
+				[&]()
+				{
+					for (size_t i = 0; i < lockCount; ++i)
+					{
+						std::lock_guard<Lock> guard(lock);
+						++counter;
+					}
+				});
+
+			measure(container, baseline, "contended", lockCount, lockCount,
+				[]() {},
+				[&]()
+				{
+					runOnThreads(threadCount, [&](uint32_t)
+						{
+							for (size_t i = 0; i < lockCount / threadCount; ++i)
+							{
+								std::lock_guard<Lock> guard(lock);
+								++counter;
+							}
+						});
+				});
+
+			gSink = counter;
+		}
+
+		template <typename Lock>
+		void measureSharedLock(const char* container, const char* baseline, size_t lockCount, uint32_t threadCount)
+		{
+			Lock lock;
+			size_t values[2] = { 0ul, 0ul };
+			std::atomic<size_t> readSum = 0ul;
+
+			// one write for every 15 reads
+			measure(container, baseline, "read-mostly", lockCount, lockCount,
+				[]() {},
+				[&]()
+				{
+					runOnThreads(threadCount, [&](uint32_t)
+						{
+							size_t sum = 0ul;
+							for (size_t i = 0; i < lockCount / threadCount; ++i)
+							{
+								if ((i & 15ul) == 0ul)
+								{
+									std::lock_guard<Lock> guard(lock);
+									++values[0];
+									++values[1];
+								}
+								else
+								{
+									std::shared_lock<Lock> guard(lock);
+									sum += values[0] + values[1];
+								}
+							}
+							readSum.fetch_add(sum, std::memory_order_relaxed);
+						});
+				});
+
+			gSink = readSum.load(std::memory_order_relaxed);
+		}
+
+		template <typename Event>
+		void measureHandoff(const char* container, const char* baseline, size_t handoffCount, Event& ping, Event& pong)
+		{
+			size_t value = 0ul;
+
+			// a round trip is two handoffs
+			measure(container, baseline, "ping-pong", handoffCount, handoffCount,
+				[]() {},
+				[&]()
+				{
+					std::thread thread([&]()
+						{
+							for (size_t i = 0; i < handoffCount / 2ul; ++i)
+							{
+								ping.Wait();
+								++value;
+								pong.Signal();
+							}
+						});
+					for (size_t i = 0; i < handoffCount / 2ul; ++i)
+					{
+						ping.Signal();
+						pong.Wait();
+					}
+					thread.join();
+				});
+
+			gSink = value;
+		}
+
+		template <typename Semaphore, typename Acquire, typename Release>
+		void measureSemaphore(const char* container, const char* baseline, size_t handoffCount, Semaphore& semaphore, Acquire&& acquire, Release&& release)
+		{
+			// one producer, one consumer
+			measure(container, baseline, "producer-consumer", handoffCount, handoffCount,
+				[]() {},
+				[&]()
+				{
+					std::thread consumer([&]()
+						{
+							for (size_t i = 0; i < handoffCount; ++i)
+							{
+								acquire(semaphore);
+							}
+						});
+					for (size_t i = 0; i < handoffCount; ++i)
+					{
+						release(semaphore);
+					}
+					consumer.join();
+				});
+		}
+	}
+
+	void benchmarkJobSystem(size_t size)
+	{
+		const size_t jobCount = size < MAX_JOB_COUNT ? size : MAX_JOB_COUNT;
+		// the thread that submits is left a hardware thread of its own
+		const uint32_t workerCount = std::max(std::thread::hardware_concurrency(), 2u) - 1u;
+		std::atomic<size_t> sum = 0ul;
+		auto tinyJob = [&sum]()
+			{
+				sum.fetch_add(1ul, std::memory_order_relaxed);
+			};
+		std::vector<float> values(jobCount, 1.0f);
+		auto updateValues = [&values](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; ++i)
+				{
+					values[i] = values[i] * 0.5f + 1.0f;
+				}
+			};
+
+		{
+			cave::JobSystem jobSystem(workerCount);
+
+			measure("cave::JobSystem", "LockedThreadPool", "submit-wait", jobCount, jobCount,
+				[]() {},
+				[&]()
+				{
+					cave::JobCounter counter;
+					for (size_t i = 0; i < jobCount; ++i)
+					{
+						jobSystem.Run(tinyJob, &counter);
+					}
+					jobSystem.Wait(counter);
+				});
+
+			measure("cave::JobSystem", "LockedThreadPool", "spawn-from-job", jobCount, jobCount,
+				[]() {},
+				[&]()
+				{
+					cave::JobCounter counter;
+					jobSystem.Run([&]()
+						{
+							for (size_t i = 0; i < jobCount; ++i)
+							{
+								jobSystem.Run(tinyJob, &counter);
+							}
+						}, &counter);
+					jobSystem.Wait(counter);
+				});
+
+			measure("cave::JobSystem", "LockedThreadPool", "parallel-for", jobCount, jobCount,
+				[]() {},
+				[&]()
+				{
+					jobSystem.ParallelFor(jobCount, PARALLEL_FOR_GRAIN_SIZE, updateValues);
+				});
+		}
+
+		{
+			LockedThreadPool threadPool(workerCount);
+			std::vector<std::future<void>> futures;
+			futures.reserve(jobCount);
+
+			measure("LockedThreadPool", nullptr, "submit-wait", jobCount, jobCount,
+				[&]() { futures.clear(); },
+				[&]()
+				{
+					for (size_t i = 0; i < jobCount; ++i)
+					{
+						futures.push_back(threadPool.Enqueue(tinyJob));
+					}
+					for (std::future<void>& future : futures)
+					{
+						future.wait();
+					}
+				});
+
+			measure("LockedThreadPool", nullptr, "spawn-from-job", jobCount, jobCount,
+				[&]() { futures.clear(); },
+				[&]()
+				{
+					threadPool.Enqueue([&]()
+						{
+							for (size_t i = 0; i < jobCount; ++i)
+							{
+								futures.push_back(threadPool.Enqueue(tinyJob));
+							}
+						}).wait();
+					for (std::future<void>& future : futures)
+					{
+						future.wait();
+					}
+				});
+
+			measure("LockedThreadPool", nullptr, "parallel-for", jobCount, jobCount,
+				[&]() { futures.clear(); },
+				[&]()
+				{
+					for (size_t begin = 0; begin < jobCount; begin += PARALLEL_FOR_GRAIN_SIZE)
+					{
+						const size_t end = std::min(begin + PARALLEL_FOR_GRAIN_SIZE, jobCount);
+						futures.push_back(threadPool.Enqueue([&updateValues, begin, end]() { updateValues(begin, end); }));
+					}
+					for (std::future<void>& future : futures)
+					{
+						future.wait();
+					}
+				});
+		}
+
+		gSink = sum.load(std::memory_order_relaxed) + static_cast<size_t>(values[0]);
+	}
+
+	void benchmarkSynchronization(size_t size)
+	{
+		const size_t lockCount = size < MAX_LOCK_COUNT ? size : MAX_LOCK_COUNT;
+		const size_t handoffCount = std::max(size < MAX_HANDOFF_COUNT ? size : MAX_HANDOFF_COUNT, 2ul);
+		const uint32_t threadCount = std::clamp(std::thread::hardware_concurrency(), 2u, MAX_CONTENDING_THREAD_COUNT);
+
+		measureLock<cave::Mutex>("cave::Mutex", "std::mutex", lockCount, threadCount);
+		measureLock<std::mutex>("std::mutex", nullptr, lockCount, threadCount);
+
+		measureSharedLock<cave::RwSpinLock>("cave::RwSpinLock", "std::shared_mutex", lockCount, threadCount);
+		measureSharedLock<std::shared_mutex>("std::shared_mutex", nullptr, lockCount, threadCount);
+
+		{
+			cave::Event ping(cave::eEventReset::AUTO);
+			cave::Event pong(cave::eEventReset::AUTO);
+			measureHandoff("cave::Event", "ConditionEvent", handoffCount, ping, pong);
+		}
+		{
+			ConditionEvent ping;
+			ConditionEvent pong;
+			measureHandoff("ConditionEvent", nullptr, handoffCount, ping, pong);
+		}
+
+		{
+			cave::Semaphore semaphore;
+			measureSemaphore("cave::Semaphore", "std::counting_semaphore", handoffCount, semaphore,
+				[](cave::Semaphore& target) { target.Acquire(); },
+				[](cave::Semaphore& target) { target.Release(); });
+		}
+		{
+			std::counting_semaphore<> semaphore(0);
+			measureSemaphore("std::counting_semaphore", nullptr, handoffCount, semaphore,
+				[](std::counting_semaphore<>& target) { target.acquire(); },
+				[](std::counting_semaphore<>& target) { target.release(); });
+		}
+	}
+
+	void benchmarkEpochHashMap(size_t size, std::vector<uint32_t>& keys)
+	{
+		const uint32_t threadCount = std::clamp(std::thread::hardware_concurrency(), 2u, MAX_CONTENDING_THREAD_COUNT);
+		std::atomic<size_t> hitCount = 0ul;
+
+		{
+			cave::EpochHashMap<uint32_t, uint32_t*> map;
+			for (size_t i = 0; i < size; ++i)
+			{
+				map.Insert(keys[i], &keys[i]);
+			}
+
+			measure("cave::EpochHashMap", "std::unordered_map+shared_mutex", "lookup", size, size,
+				[]() {},
+				[&]() { size_t hits = 0ul; uint32_t* value = nullptr; for (size_t i = 0; i < size; ++i) { hits += map.Find(keys[size - i - 1], value); } gSink = hits; });
+
+			measure("cave::EpochHashMap", "std::unordered_map+shared_mutex", "parallel-lookup", size, size,
+				[]() {},
+				[&]()
+				{
+					runOnThreads(threadCount, [&](uint32_t thread)
+						{
+							size_t hits = 0ul;
+							uint32_t* value = nullptr;
+							for (size_t i = thread; i < size; i += threadCount)
+							{
+								hits += map.Find(keys[i], value);
+							}
+							hitCount.fetch_add(hits, std::memory_order_relaxed);
+						});
+				});
+		}
+
+		{
+			std::unordered_map<uint32_t, uint32_t*> map(size);
+			std::shared_mutex mutex;
+			for (size_t i = 0; i < size; ++i)
+			{
+				map.emplace(keys[i], &keys[i]);
+			}
+
+			measure("std::unordered_map+shared_mutex", nullptr, "lookup", size, size,
+				[]() {},
+				[&]()
+				{
+					size_t hits = 0ul;
+					for (size_t i = 0; i < size; ++i)
+					{
+						std::shared_lock<std::shared_mutex> lock(mutex);
+						hits += map.find(keys[size - i - 1]) != map.end();
+					}
+					gSink = hits;
+				});
+
+			measure("std::unordered_map+shared_mutex", nullptr, "parallel-lookup", size, size,
+				[]() {},
+				[&]()
+				{
+					runOnThreads(threadCount, [&](uint32_t thread)
+						{
+							size_t hits = 0ul;
+							for (size_t i = thread; i < size; i += threadCount)
+							{
+								std::shared_lock<std::shared_mutex> lock(mutex);
+								hits += map.find(keys[i]) != map.end();
+							}
+							hitCount.fetch_add(hits, std::memory_order_relaxed);
+						});
+				});
+		}
+
+		gSink = hitCount.load(std::memory_order_relaxed);
+	}
+
+	void benchmarkParallelAlgorithms(size_t size, const std::vector<uint32_t>& keys)
+	{
+		std::vector<uint32_t> data(size);
+		std::vector<uint32_t> output(size);
+		std::vector<uint64_t> wideData(size);
+		auto isVisible = [](uint32_t key) { return (key & 3u) != 0u; };
+
+		measure("std::sort", nullptr, SCALING_WORKLOADS[0], size, size,
+			[&]() { data = keys; },
+			[&]() { std::sort(data.begin(), data.end()); });
+
+		measure("std::stable_sort", nullptr, SCALING_WORKLOADS[0], size, size,
+			[&]() { data = keys; },
+			[&]() { std::stable_sort(data.begin(), data.end()); });
+
+		measure("std::accumulate", nullptr, SCALING_WORKLOADS[0], size, size,
+			[]() {},
+			[&]() { gSink = std::accumulate(keys.begin(), keys.end(), 0u); });
+
+		measure("std::inclusive_scan", nullptr, SCALING_WORKLOADS[0], size, size,
+			[]() {},
+			[&]() { std::inclusive_scan(keys.begin(), keys.end(), output.begin()); });
+
+		measure("std::partition_copy", nullptr, SCALING_WORKLOADS[0], size, size,
+			[]() {},
+			[&]()
+			{
+				// into the front and, reversed, the back of one array
+				auto ends = std::partition_copy(keys.begin(), keys.end(), output.begin(), output.rbegin(), isVisible);
+				gSink = static_cast<size_t>(ends.first - output.begin());
+			});
+
+		const uint32_t maxThreadCount = std::clamp(std::thread::hardware_concurrency(), 2u, MAX_SCALING_THREAD_COUNT);
+		size_t workload = 0ul;
+		for (uint32_t threadCount = 1u; threadCount <= maxThreadCount; threadCount *= 2u, ++workload)
+		{
+			// the calling thread runs jobs while it waits, one thread fewer is started
+			std::unique_ptr<cave::JobSystem> jobSystem;
+			if (threadCount > 1u)
+			{
+				jobSystem = std::make_unique<cave::JobSystem>(threadCount - 1u);
+			}
+			const char* threads = SCALING_WORKLOADS[workload];
+
+			measure("cave::ParallelRadixSort", "std::sort", threads, size, size,
+				[&]() { data = keys; },
+				[&]() { cave::ParallelRadixSort(jobSystem.get(), data.data(), size); });
+
+			// render keys: 64 bits, most of them used
+			measure("cave::ParallelRadixSort<uint64_t>", "std::sort", threads, size, size,
+				[&]() { for (size_t i = 0; i < size; ++i) { wideData[i] = (static_cast<uint64_t>(keys[i]) << 32ul) | keys[size - i - 1]; } },
+				[&]() { cave::ParallelRadixSort(jobSystem.get(), wideData.data(), size); });
+
+			measure("cave::ParallelMergeSort", "std::stable_sort", threads, size, size,
+				[&]() { data = keys; },
+				[&]() { cave::ParallelMergeSort(jobSystem.get(), data.data(), size); });
+
+			measure("cave::ParallelReduce", "std::accumulate", threads, size, size,
+				[]() {},
+				[&]() { gSink = cave::ParallelReduce(jobSystem.get(), keys.data(), size, 0u); });
+
+			measure("cave::ParallelInclusiveScan", "std::inclusive_scan", threads, size, size,
+				[]() {},
+				[&]() { cave::ParallelInclusiveScan(jobSystem.get(), keys.data(), output.data(), size, 0u); });
+
+			measure("cave::ParallelPartition", "std::partition_copy", threads, size, size,
+				[]() {},
+				[&]() { gSink = cave::ParallelPartition(jobSystem.get(), keys.data(), output.data(), size, isVisible); });
+		}
+	}
+}
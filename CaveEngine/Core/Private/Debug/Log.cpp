@@ -3,19 +3,1669 @@
  * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
  */
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cwchar>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
+#ifdef __WIN32__
+#include <windows.h>
+#else
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+#include "lodepng.h"
+
+#include "Assertion/Assert.h"
 #include "Debug/Log.h"
+#include "Thread/Synchronization.h"
+#include "Thread/ThreadAffinity.h"
+
+#ifdef CAVE_BUILD_DEBUG
+#include <cstdio>
+#include <sstream>
+#endif // CAVE_BUILD_DEBUG
+
+namespace cave
+{
+	namespace
+	{
+		struct LogRecord
+		{
+			const char* FileName;
+			const char* FunctionName;
+			// set when Message holds the encoded arguments of this format instead of text, see encodeArguments
+			const char* Format;
+			uint32_t FormatLength;
+			int32_t LineNumber;
+			eLogChannel Channel;
+			eLogVerbosity Verbosity;
+			uint8_t ArgumentCount;
+			uint16_t Length;
+			// messages from the same call site dropped by the rate limit since the previous one
+			uint32_t SuppressedCount;
+			char Message[MAX_BUFFER + 1ul];
+		};
+
+		struct alignas(64) LogSlot
+		{
+			// position + 1 once the record at position is published, position + SLOT_COUNT once it has been consumed
+			std::atomic<size_t> Sequence;
+			LogRecord Record;
+		};
+
+		constexpr size_t SLOT_COUNT = 4096ul;
+		constexpr size_t SLOT_MASK = SLOT_COUNT - 1ul;
+		// decorated lines are collected up to this size and written with a single call
+		constexpr size_t BATCH_SIZE = 64ul * 1024ul;
+		// producers wake the log thread once per this many messages, otherwise it wakes up on its own every WAKE_INTERVAL
+		constexpr size_t WAKE_MESSAGE_COUNT = SLOT_COUNT / 4ul;
+		constexpr std::chrono::milliseconds WAKE_INTERVAL(2);
+
+		// call sites tracked by the rate limit, sites that hash to the same entry share it
+		constexpr size_t RATE_LIMIT_SITE_COUNT = 1024ul;
+		constexpr uint32_t DEFAULT_RATE_LIMIT_PER_SECOND = 100u;
+		constexpr uint32_t DEFAULT_RATE_LIMIT_BURST_COUNT = 1000u;
+		// a run of identical messages is reported at least this often
+		constexpr std::chrono::seconds REPEAT_REPORT_INTERVAL(1);
+		// lines for the log file are collected up to this size, or for FILE_WRITE_INTERVAL, unless an error is logged
+		constexpr size_t FILE_BATCH_SIZE = 1024ul * 1024ul;
+		constexpr std::chrono::seconds FILE_WRITE_INTERVAL(1);
+		constexpr uint64_t DEFAULT_MAX_FILE_SIZE = 64ull * 1024ull * 1024ull;
+		constexpr uint32_t DEFAULT_FILE_ARCHIVE_COUNT = 4u;
+		// LOG*FMT calls with more arguments are formatted by the caller
+		constexpr size_t MAX_DEFERRED_ARGUMENT_COUNT = 16ul;
+		// lines written to the console or decoded from a binary file are cut off at this length
+		constexpr size_t MAX_LINE = 2048ul;
+
+		static_assert((SLOT_COUNT & SLOT_MASK) == 0ul);
+
+		/*
+		 * Binary log file: BINARY_LOG_MAGIC, then chunks in native byte order.
+		 * STRING: id (uint32), length (uint32), characters. Defines a file, function or format name the first time it is used.
+		 * RECORD: file id, function id (uint32), line (int32), channel, verbosity (uint8), format id (uint32, 0 for text),
+		 * 		argument count (uint8), length (uint16), then the message text or the encoded arguments.
+		 */
+		constexpr char BINARY_LOG_MAGIC[8] = { 'C', 'A', 'V', 'E', 'L', 'O', 'G', '1' };
+		constexpr size_t BINARY_RECORD_HEADER_SIZE = 22ul;
+
+		enum class eBinaryChunk : uint8_t
+		{
+			STRING = 1,
+			RECORD = 2,
+		};
+
+		const char* getChannelName(eLogChannel channel)
+		{
+			switch (channel)
+			{
+			case eLogChannel::GRAPHICS:
+				return "Graphics/";
+			case eLogChannel::PHYSICS:
+				return "Physics/";
+			case eLogChannel::AUDIO:
+				return "Audio/";
+			case eLogChannel::AI:
+				return "AI/";
+			case eLogChannel::GAMEPLAY:
+				return "Gameplay/";
+			case eLogChannel::CORE:
+				return "Core/";
+			case eLogChannel::CORE_MODULE:
+				return "Core/Module/";
+			case eLogChannel::CORE_UNIT_TEST:
+				return "Core/UnitTest/";
+			case eLogChannel::CORE_MEMORY:
+				return "Core/Memory/";
+			case eLogChannel::CORE_MATH:
+				return "Core/Math/";
+			case eLogChannel::CORE_STRING:
+				return "Core/String/";
+			case eLogChannel::CORE_LOCALIZATION:
+				return "Core/Localization/";
+			case eLogChannel::CORE_PARSER:
+				return "Core/Parser/";
+			case eLogChannel::CORE_PROFILE:
+				return "Core/Profile/";
+			case eLogChannel::CORE_ENGINE_CONFIG:
+				return "Core/EngineConfig/";
+			case eLogChannel::CORE_RNG:
+				return "Core/RandomNumberGenerator/";
+			case eLogChannel::CORE_OBJECT:
+				return "Core/Object/";
+			case eLogChannel::CORE_THREAD:
+				return "Core/Thread/";
+			case eLogChannel::CORE_CONTAINER:
+				return "Core/Container/";
+			case eLogChannel::CORE_FILE_SYSTEM:
+				return "Core/FileSystem/";
+			case eLogChannel::CORE_TIMER:
+				return "Core/Timer/";
+			case eLogChannel::CORE_RESOURCE_MANAGER:
+				return "Core/ResourceManager/";
+			default:
+				assert(false);
+				return "";
+			}
+		}
+
+		const char* getVerbosityName(eLogVerbosity verbosity)
+		{
+			switch (verbosity)
+			{
+			case eLogVerbosity::Verbose:
+				return "V/";
+			case eLogVerbosity::Debug:
+				return "D/";
+			case eLogVerbosity::Info:
+				return "I/";
+			case eLogVerbosity::Warn:
+				return "W/";
+			case eLogVerbosity::Error:
+				return "E/";
+			case eLogVerbosity::Assert:
+				return "A/";
+			default:
+				assert(false);
+				return "";
+			}
+		}
+
+		char getColor(eLogVerbosity verbosity)
+		{
+			switch (verbosity)
+			{
+			case eLogVerbosity::Debug:
+				return '2';
+			case eLogVerbosity::Info:
+				return '3';
+			case eLogVerbosity::Warn:
+				return '5';
+			case eLogVerbosity::Error:
+				return '1';
+			case eLogVerbosity::Assert:
+				return '6';
+			default:
+				return '7';
+			}
+		}
+
+		/*
+		 * Encodes [s, s + length) as UTF-8 into out, stopping before a character that does not fit.
+		 * wchar_t is UTF-16 on Windows and UTF-32 elsewhere, unpaired surrogates become U+FFFD.
+		 */
+		size_t encodeUtf8(const wchar_t* s, size_t length, char* out, size_t capacity)
+		{
+			size_t count = 0ul;
+			for (size_t i = 0; i < length; ++i)
+			{
+				uint32_t codePoint = static_cast<uint32_t>(s[i]);
+				if constexpr (sizeof(wchar_t) == 2ul)
+				{
+					if (codePoint >= 0xD800u && codePoint <= 0xDBFFu && i + 1ul < length)
+					{
+						uint32_t low = static_cast<uint32_t>(s[i + 1ul]);
+						if (low >= 0xDC00u && low <= 0xDFFFu)
+						{
+							codePoint = 0x10000u + ((codePoint - 0xD800u) << 10) + (low - 0xDC00u);
+							++i;
+						}
+					}
+				}
+
+				if ((codePoint >= 0xD800u && codePoint <= 0xDFFFu) || codePoint > 0x10FFFFu)
+				{
+					codePoint = 0xFFFDu;
+				}
+
+				char bytes[4];
+				size_t byteCount = 0ul;
+				if (codePoint < 0x80u)
+				{
+					bytes[byteCount++] = static_cast<char>(codePoint);
+				}
+				else if (codePoint < 0x800u)
+				{
+					bytes[byteCount++] = static_cast<char>(0xC0u | (codePoint >> 6));
+					bytes[byteCount++] = static_cast<char>(0x80u | (codePoint & 0x3Fu));
+				}
+				else if (codePoint < 0x10000u)
+				{
+					bytes[byteCount++] = static_cast<char>(0xE0u | (codePoint >> 12));
+					bytes[byteCount++] = static_cast<char>(0x80u | ((codePoint >> 6) & 0x3Fu));
+					bytes[byteCount++] = static_cast<char>(0x80u | (codePoint & 0x3Fu));
+				}
+				else
+				{
+					bytes[byteCount++] = static_cast<char>(0xF0u | (codePoint >> 18));
+					bytes[byteCount++] = static_cast<char>(0x80u | ((codePoint >> 12) & 0x3Fu));
+					bytes[byteCount++] = static_cast<char>(0x80u | ((codePoint >> 6) & 0x3Fu));
+					bytes[byteCount++] = static_cast<char>(0x80u | (codePoint & 0x3Fu));
+				}
+
+				if (count + byteCount > capacity)
+				{
+					break;
+				}
+
+				for (size_t b = 0; b < byteCount; ++b)
+				{
+					out[count++] = bytes[b];
+				}
+			}
+
+			return count;
+		}
+
+		/*
+		 * Copies arguments into payload so they can be formatted later: a type byte followed by the value,
+		 * or by a 16 bit length and the characters for strings, which are cut to the space that is left.
+		 * Returns false when they do not fit.
+		 */
+		bool encodeArguments(const FormatArgument* arguments, size_t argumentCount, char* payload, size_t capacity, size_t& outLength)
+		{
+			if (argumentCount > MAX_DEFERRED_ARGUMENT_COUNT)
+			{
+				return false;
+			}
+
+			size_t length = 0ul;
+			auto write = [&](const void* value, size_t size)
+				{
+					if (capacity - length < size)
+					{
+						return false;
+					}
+
+					std::memcpy(payload + length, value, size);
+					length += size;
+					return true;
+				};
+
+			for (size_t i = 0; i < argumentCount; ++i)
+			{
+				const FormatArgument& argument = arguments[i];
+				uint8_t type = static_cast<uint8_t>(argument.GetType());
+				if (!write(&type, sizeof(type)))
+				{
+					return false;
+				}
+
+				bool bWritten = false;
+				switch (argument.GetType())
+				{
+				case FormatArgument::eType::BOOL:
+				case FormatArgument::eType::CHAR:
+					{
+						uint8_t value = static_cast<uint8_t>(argument.GetUint());
+						bWritten = write(&value, sizeof(value));
+					}
+					break;
+				case FormatArgument::eType::INT:
+				case FormatArgument::eType::UINT:
+					{
+						uint64_t value = argument.GetUint();
+						bWritten = write(&value, sizeof(value));
+					}
+					break;
+				case FormatArgument::eType::FLOAT:
+					{
+						float value = argument.GetFloat();
+						bWritten = write(&value, sizeof(value));
+					}
+					break;
+				case FormatArgument::eType::DOUBLE:
+					{
+						double value = argument.GetDouble();
+						bWritten = write(&value, sizeof(value));
+					}
+					break;
+				case FormatArgument::eType::STRING:
+					{
+						StringView value = argument.GetString();
+						if (capacity - length < sizeof(uint16_t))
+						{
+							return false;
+						}
+
+						size_t count = value.GetLength();
+						count = count < capacity - length - sizeof(uint16_t) ? count : capacity - length - sizeof(uint16_t);
+						count = count < UINT16_MAX ? count : UINT16_MAX;
+						uint16_t stringLength = static_cast<uint16_t>(count);
+						bWritten = write(&stringLength, sizeof(stringLength)) && write(value.GetData(), count);
+					}
+					break;
+				case FormatArgument::eType::POINTER:
+					{
+						uint64_t value = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(argument.GetPointer()));
+						bWritten = write(&value, sizeof(value));
+					}
+					break;
+				default:
+					assert(false);
+					break;
+				}
+
+				if (!bWritten)
+				{
+					return false;
+				}
+			}
+
+			outLength = length;
+			return true;
+		}
+
+		struct DecodedArguments
+		{
+			DecodedArguments()
+			{
+			}
+
+			union
+			{
+				FormatArgument Arguments[MAX_DEFERRED_ARGUMENT_COUNT];
+			};
+		};
+
+		/*
+		 * Reverse of encodeArguments. Strings point into payload. Returns false when payload is malformed.
+		 */
+		bool decodeArguments(const char* payload, size_t length, size_t argumentCount, DecodedArguments& outArguments)
+		{
+			if (argumentCount > MAX_DEFERRED_ARGUMENT_COUNT)
+			{
+				return false;
+			}
+
+			size_t offset = 0ul;
+			auto read = [&](void* value, size_t size)
+				{
+					if (length - offset < size)
+					{
+						return false;
+					}
+
+					std::memcpy(value, payload + offset, size);
+					offset += size;
+					return true;
+				};
+
+			for (size_t i = 0; i < argumentCount; ++i)
+			{
+				uint8_t type = 0u;
+				if (!read(&type, sizeof(type)))
+				{
+					return false;
+				}
+
+				FormatArgument* argument = &outArguments.Arguments[i];
+				switch (static_cast<FormatArgument::eType>(type))
+				{
+				case FormatArgument::eType::BOOL:
+				case FormatArgument::eType::CHAR:
+					{
+						uint8_t value = 0u;
+						if (!read(&value, sizeof(value)))
+						{
+							return false;
+						}
+
+						if (static_cast<FormatArgument::eType>(type) == FormatArgument::eType::BOOL)
+						{
+							std::construct_at(argument, value != 0u);
+						}
+						else
+						{
+							std::construct_at(argument, static_cast<char>(value));
+						}
+					}
+					break;
+				case FormatArgument::eType::INT:
+				case FormatArgument::eType::UINT:
+					{
+						uint64_t value = 0ull;
+						if (!read(&value, sizeof(value)))
+						{
+							return false;
+						}
+
+						if (static_cast<FormatArgument::eType>(type) == FormatArgument::eType::INT)
+						{
+							std::construct_at(argument, static_cast<int64_t>(value));
+						}
+						else
+						{
+							std::construct_at(argument, value);
+						}
+					}
+					break;
+				case FormatArgument::eType::FLOAT:
+					{
+						float value = 0.0f;
+						if (!read(&value, sizeof(value)))
+						{
+							return false;
+						}
+						std::construct_at(argument, value);
+					}
+					break;
+				case FormatArgument::eType::DOUBLE:
+					{
+						double value = 0.0;
+						if (!read(&value, sizeof(value)))
+						{
+							return false;
+						}
+						std::construct_at(argument, value);
+					}
+					break;
+				case FormatArgument::eType::STRING:
+					{
+						uint16_t stringLength = 0u;
+						if (!read(&stringLength, sizeof(stringLength)) || length - offset < stringLength)
+						{
+							return false;
+						}
+						std::construct_at(argument, StringView(payload + offset, stringLength));
+						offset += stringLength;
+					}
+					break;
+				case FormatArgument::eType::POINTER:
+					{
+						uint64_t value = 0ull;
+						if (!read(&value, sizeof(value)))
+						{
+							return false;
+						}
+						std::construct_at(argument, reinterpret_cast<const void*>(static_cast<uintptr_t>(value)));
+					}
+					break;
+				default:
+					return false;
+				}
+			}
+
+			return offset == length;
+		}
+
+		/*
+		 * The text of record, formatted into buffer when its arguments were deferred.
+		 */
+		StringView getMessage(const char* format, size_t formatLength, size_t argumentCount, const char* payload, size_t length, char* buffer, size_t bufferSize)
+		{
+			if (format == nullptr)
+			{
+				return StringView(payload, length);
+			}
+
+			DecodedArguments arguments;
+			if (!decodeArguments(payload, length, argumentCount, arguments))
+			{
+				return StringView(format, formatLength);
+			}
+
+			FormatResult result = VFormat(buffer, bufferSize, StringView(format, formatLength), arguments.Arguments, argumentCount);
+
+			return StringView(buffer, result.Length);
+		}
+
+		FormatResult formatLine(char* buffer, size_t bufferSize, bool bColor, eLogChannel channel, eLogVerbosity verbosity, StringView fileName, StringView functionName, int32_t lineNumber, StringView message)
+		{
+			if (bColor)
+			{
+				return Format(buffer, bufferSize, "\033[1;3{}m{}{}{}/{}/line:{} :\t{}\033[0m\n", getColor(verbosity), getChannelName(channel), getVerbosityName(verbosity), fileName, functionName, lineNumber, message);
+			}
+
+			return Format(buffer, bufferSize, "{}{}{}/{}/line:{} :\t{}\n", getChannelName(channel), getVerbosityName(verbosity), fileName, functionName, lineNumber, message);
+		}
+
+		/*
+		 * Writes sourcePath to archivePath as gzip and removes it. Leaves sourcePath as it is when anything fails.
+		 */
+		bool compressFile(const std::string& sourcePath, const std::string& archivePath)
+		{
+			std::vector<unsigned char> data;
+			{
+				std::ifstream source(sourcePath, std::ios::in | std::ios::binary);
+				if (!source.is_open())
+				{
+					return false;
+				}
+				data.assign(std::istreambuf_iterator<char>(source), std::istreambuf_iterator<char>());
+			}
+
+			unsigned char* compressed = nullptr;
+			size_t compressedSize = 0ul;
+			if (lodepng_deflate(&compressed, &compressedSize, data.data(), data.size(), &lodepng_default_compress_settings) != 0u)
+			{
+				std::free(compressed);
+				return false;
+			}
+
+			// RFC 1952: magic, deflate, no flags, no time, unknown system, then the data, its CRC-32 and its size
+			const unsigned char header[] = { 0x1f, 0x8b, 8u, 0u, 0u, 0u, 0u, 0u, 0u, 0xff };
+			unsigned char trailer[8];
+			uint32_t crc = lodepng_crc32(data.data(), data.size());
+			uint32_t size = static_cast<uint32_t>(data.size());
+			for (uint32_t i = 0u; i < 4u; ++i)
+			{
+				trailer[i] = static_cast<unsigned char>(crc >> (8u * i));
+				trailer[4u + i] = static_cast<unsigned char>(size >> (8u * i));
+			}
+
+			std::ofstream archive(archivePath, std::ios::out | std::ios::binary | std::ios::trunc);
+			archive.write(reinterpret_cast<const char*>(header), sizeof(header));
+			archive.write(reinterpret_cast<const char*>(compressed), static_cast<std::streamsize>(compressedSize));
+			archive.write(reinterpret_cast<const char*>(trailer), sizeof(trailer));
+			archive.close();
+			std::free(compressed);
+
+			if (!archive)
+			{
+				std::remove(archivePath.c_str());
+				return false;
+			}
+
+			std::remove(sourcePath.c_str());
+
+			return true;
+		}
+
+		bool isSameMessage(const LogRecord& lhs, const LogRecord& rhs)
+		{
+			return lhs.FileName == rhs.FileName && lhs.LineNumber == rhs.LineNumber && lhs.Channel == rhs.Channel && lhs.Verbosity == rhs.Verbosity
+				&& lhs.Format == rhs.Format && lhs.ArgumentCount == rhs.ArgumentCount && lhs.Length == rhs.Length
+				&& std::memcmp(lhs.Message, rhs.Message, lhs.Length) == 0;
+		}
+
+		/*
+		 * Fills outRecord with a text message of the log itself about the call site of source.
+		 */
+		template <typename... Args>
+		void formatNote(LogRecord& outRecord, const LogRecord& source, LogFormatString format, const Args&... args)
+		{
+			outRecord.FileName = source.FileName;
+			outRecord.FunctionName = source.FunctionName;
+			outRecord.Format = nullptr;
+			outRecord.FormatLength = 0u;
+			outRecord.LineNumber = source.LineNumber;
+			outRecord.Channel = source.Channel;
+			outRecord.Verbosity = source.Verbosity;
+			outRecord.ArgumentCount = 0u;
+			outRecord.SuppressedCount = 0u;
+			outRecord.Length = static_cast<uint16_t>(Format(outRecord.Message, sizeof(outRecord.Message), StringView(format.GetData(), format.GetLength()), args...).Length);
+		}
+
+		/*
+		 * Token bucket per call site, kept as the time the bucket is full again (generic cell rate algorithm)
+		 * so that taking a token is a single compare-and-swap.
+		 */
+		class LogRateLimiter final
+		{
+		public:
+			LogRateLimiter()
+			{
+				SetRate(DEFAULT_RATE_LIMIT_PER_SECOND, DEFAULT_RATE_LIMIT_BURST_COUNT);
+			}
+
+			void SetRate(uint32_t messagesPerSecond, uint32_t burstCount)
+			{
+				int64_t interval = messagesPerSecond != 0u ? 1'000'000'000ll / static_cast<int64_t>(messagesPerSecond) : 0ll;
+				mInterval.store(interval, std::memory_order_relaxed);
+				mTolerance.store(interval * static_cast<int64_t>(burstCount > 0u ? burstCount : 1u), std::memory_order_relaxed);
+
+				// new limits start with full buckets
+				for (Site& site : mSites)
+				{
+					site.FullTime.store(0ll, std::memory_order_relaxed);
+				}
+			}
+
+			/*
+			 * Returns false when the call site is over its limit. Otherwise outSuppressedCount is how many were refused before.
+			 */
+			bool TryAcquire(const char* fileName, int32_t lineNumber, uint32_t& outSuppressedCount)
+			{
+				int64_t interval = mInterval.load(std::memory_order_relaxed);
+				if (interval == 0ll)
+				{
+					outSuppressedCount = 0u;
+					return true;
+				}
+
+				uint64_t key = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(fileName)) ^ (static_cast<uint64_t>(static_cast<uint32_t>(lineNumber)) << 40);
+				Site& site = mSites[(key * 0x9E3779B97F4A7C15ull) >> (64u - RATE_LIMIT_SITE_BITS)];
+				if (site.Key.load(std::memory_order_relaxed) != key)
+				{
+					site.Key.store(key, std::memory_order_relaxed);
+					site.FullTime.store(0ll, std::memory_order_relaxed);
+					site.SuppressedCount.store(0u, std::memory_order_relaxed);
+				}
+
+				int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+				int64_t tolerance = mTolerance.load(std::memory_order_relaxed);
+				int64_t fullTime = site.FullTime.load(std::memory_order_relaxed);
+				for (;;)
+				{
+					int64_t nextFullTime = (fullTime > now ? fullTime : now) + interval;
+					if (nextFullTime - now > tolerance)
+					{
+						site.SuppressedCount.fetch_add(1u, std::memory_order_relaxed);
+						mSuppressedCount.fetch_add(1ull, std::memory_order_relaxed);
+						return false;
+					}
+
+					if (site.FullTime.compare_exchange_weak(fullTime, nextFullTime, std::memory_order_relaxed))
+					{
+						break;
+					}
+				}
+
+				outSuppressedCount = site.SuppressedCount.load(std::memory_order_relaxed) != 0u ? site.SuppressedCount.exchange(0u, std::memory_order_relaxed) : 0u;
+				return true;
+			}
+
+			uint64_t GetSuppressedCount() const
+			{
+				return mSuppressedCount.load(std::memory_order_relaxed);
+			}
+
+		private:
+			static constexpr uint32_t RATE_LIMIT_SITE_BITS = 10u;
+			static_assert((1ul << RATE_LIMIT_SITE_BITS) == RATE_LIMIT_SITE_COUNT);
+
+			struct Site
+			{
+				std::atomic<uint64_t> Key = 0ull;
+				std::atomic<int64_t> FullTime = 0ll;
+				std::atomic<uint32_t> SuppressedCount = 0u;
+			};
+
+			Site mSites[RATE_LIMIT_SITE_COUNT];
+			// nanoseconds per message, 0 when there is no limit
+			std::atomic<int64_t> mInterval = 0ll;
+			std::atomic<int64_t> mTolerance = 0ll;
+			std::atomic<uint64_t> mSuppressedCount = 0ull;
+		};
+
+		/*
+		 * Bounded multi-producer single-consumer ring of fixed-size records (Vyukov), and the log thread that drains it.
+		 * A producer claims a slot with one compare-and-swap, fills it in place and publishes it with a release store.
+		 * The log thread sleeps for WAKE_INTERVAL between drains and is only woken early every WAKE_MESSAGE_COUNT messages,
+		 * so a producer almost never makes a system call and a burst of messages does not cost a context switch each.
+		 * The wake-up is an Event, signaling it takes no lock and only calls into the kernel while the log thread sleeps.
+		 * Call sites over their rate limit are refused before anything is formatted, and the log thread folds
+		 * consecutive identical messages into one "repeated N times" line.
+		 */
+		class LogQueue final
+		{
+		public:
+			LogQueue(const LogQueue&) = delete;
+			LogQueue& operator=(const LogQueue&) = delete;
+
+			static LogQueue& GetInstance()
+			{
+				// never destroyed, so that logging from static destructors stays valid
+				static LogQueue* msInstance = new LogQueue();
+				return *msInstance;
+			}
+
+			/*
+			 * fill(LogRecord& record) writes the message or the deferred arguments into record.Message and returns their length.
+			 */
+			template <typename Fill>
+			void Push(eLogChannel channel, eLogVerbosity verbosity, const char* fileName, const char* functionName, int32_t lineNumber, Fill&& fill);
+
+			void Start();
+			void Stop();
+			void Flush();
+			bool OpenBinaryFile(const char* filePath);
+			void CloseBinaryFile();
+			bool OpenFile(const char* filePath);
+			void CloseFile();
+			void SetFileRotation(uint64_t maxFileSize, uint32_t maxFileSeconds);
+			void SetFileArchive(uint32_t archiveCount, bool bCompress);
+
+			uint64_t GetDroppedCount() const
+			{
+				return mDroppedCount.load(std::memory_order_relaxed);
+			}
+
+			uint64_t GetSuppressedCount() const
+			{
+				return mRateLimiter.GetSuppressedCount();
+			}
+
+			uint64_t GetCoalescedCount() const
+			{
+				return mCoalescedCount.load(std::memory_order_relaxed);
+			}
+
+			void SetRateLimit(uint32_t messagesPerSecond, uint32_t burstCount)
+			{
+				mRateLimiter.SetRate(messagesPerSecond, burstCount);
+			}
+
+			size_t GetWrittenCount() const
+			{
+				return mWrittenPosition.load(std::memory_order_acquire);
+			}
+
+		private:
+			LogQueue();
+
+			void run();
+			size_t drain();
+			void wakeConsumer();
+			void reportDropped();
+			void reportRepeated(bool bForce);
+			void append(const LogRecord& record);
+			void appendRecord(const LogRecord& record);
+			void appendText(const LogRecord& record, StringView text);
+			void appendFile(const LogRecord& record, StringView text);
+			void appendBinary(const LogRecord& record);
+			void appendBytes(const void* data, size_t size);
+			uint32_t getStringId(const char* string, size_t length);
+			void writeBatch();
+			void writeFileBatch();
+			void updateFile(bool bForce);
+			void rotateFile();
+			void closeFile();
+			void closeBinaryFile();
+
+			std::unique_ptr<LogSlot[]> mSlots;
+
+			alignas(64) std::atomic<size_t> mEnqueuePosition = 0ul;
+			std::atomic<uint64_t> mDroppedCount = 0ull;
+
+			// guarded by mOutputMutex, which the log thread holds while it drains
+			alignas(64) Mutex mOutputMutex;
+			size_t mDequeuePosition = 0ul;
+			uint64_t mReportedDroppedCount = 0ull;
+			size_t mBatchLength = 0ul;
+			std::unique_ptr<char[]> mBatch;
+#ifdef __WIN32__
+			std::unique_ptr<wchar_t[]> mWideBatch;
+#endif
+			std::ofstream mBinaryFile;
+			std::unordered_map<const void*, uint32_t> mStringIds;
+			// the text log file, which is rotated to mFilePath.1 and so on, see rotateFile
+			std::ofstream mFile;
+			std::string mFilePath;
+			std::unique_ptr<char[]> mFileBatch;
+			size_t mFileBatchLength = 0ul;
+			uint64_t mFileSize = 0ull;
+			std::chrono::steady_clock::time_point mFileOpenTime;
+			std::chrono::steady_clock::time_point mFileWriteTime;
+			bool mbFileWriteRequested = false;
+			uint64_t mMaxFileSize = DEFAULT_MAX_FILE_SIZE;
+			uint32_t mMaxFileSeconds = 0u;
+			uint32_t mFileArchiveCount = DEFAULT_FILE_ARCHIVE_COUNT;
+			bool mbCompressFileArchive = false;
+			// compresses the file rotated last, the log thread does not wait for it
+			std::thread mArchiveThread;
+			// the last message written, and how many identical ones have been folded into it since
+			LogRecord mLastRecord;
+			bool mbHasLastRecord = false;
+			uint64_t mRepeatedCount = 0ull;
+			std::chrono::steady_clock::time_point mRepeatStartTime;
+			std::atomic<uint64_t> mCoalescedCount = 0ull;
+
+			LogRateLimiter mRateLimiter;
+
+			alignas(64) std::atomic<size_t> mWrittenPosition = 0ul;
+			std::atomic<uint32_t> mFlushWaiterCount = 0u;
+			std::atomic<bool> mbRunning = false;
+			std::atomic<bool> mbStopRequested = false;
+
+			Event mWakeEvent{ eEventReset::AUTO };
+			Mutex mSyncMutex;
+			std::thread mThread;
+		};
+
+		LogQueue::LogQueue()
+			: mSlots(new LogSlot[SLOT_COUNT])
+			, mBatch(new char[BATCH_SIZE])
+#ifdef __WIN32__
+			, mWideBatch(new wchar_t[BATCH_SIZE + 1ul])
+#endif
+		{
+			for (size_t i = 0; i < SLOT_COUNT; ++i)
+			{
+				mSlots[i].Sequence.store(i, std::memory_order_relaxed);
+			}
+
+			Start();
+			std::atexit([]()
+				{
+					Log::Destroy();
+				});
+		}
+
+		template <typename Fill>
+		void LogQueue::Push(eLogChannel channel, eLogVerbosity verbosity, const char* fileName, const char* functionName, int32_t lineNumber, Fill&& fill)
+		{
+			uint32_t suppressedCount = 0u;
+			if (!mRateLimiter.TryAcquire(fileName, lineNumber, suppressedCount))
+			{
+				return;
+			}
+
+			auto fillRecord = [&](LogRecord& record)
+				{
+					record.FileName = fileName;
+					record.FunctionName = functionName;
+					record.Format = nullptr;
+					record.FormatLength = 0u;
+					record.LineNumber = lineNumber;
+					record.Channel = channel;
+					record.Verbosity = verbosity;
+					record.ArgumentCount = 0u;
+					record.SuppressedCount = suppressedCount;
+					record.Length = static_cast<uint16_t>(fill(record));
+				};
+
+			while (!mbRunning.load(std::memory_order_acquire))
+			{
+				// no log thread, write on the calling thread
+				std::lock_guard<Mutex> lock(mSyncMutex);
+				if (mbRunning.load(std::memory_order_acquire))
+				{
+					break;
+				}
+
+				LogRecord record;
+				fillRecord(record);
+
+				std::lock_guard<Mutex> outputLock(mOutputMutex);
+				append(record);
+				reportRepeated(true);
+				writeBatch();
+				updateFile(true);
+				return;
+			}
+
+			size_t position = mEnqueuePosition.load(std::memory_order_relaxed);
+			LogSlot* slot = nullptr;
+			for (;;)
+			{
+				slot = &mSlots[position & SLOT_MASK];
+				size_t sequence = slot->Sequence.load(std::memory_order_acquire);
+				intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+				if (difference == 0)
+				{
+					if (mEnqueuePosition.compare_exchange_weak(position, position + 1ul, std::memory_order_relaxed))
+					{
+						break;
+					}
+				}
+				else if (difference < 0)
+				{
+					// full, the log thread is behind by a whole ring
+					mDroppedCount.fetch_add(1ull, std::memory_order_relaxed);
+					return;
+				}
+				else
+				{
+					position = mEnqueuePosition.load(std::memory_order_relaxed);
+				}
+			}
+
+			fillRecord(slot->Record);
+			slot->Sequence.store(position + 1ul, std::memory_order_release);
+
+			if ((position & (WAKE_MESSAGE_COUNT - 1ul)) == 0ul)
+			{
+				mWakeEvent.Signal();
+			}
+		}
+
+		void LogQueue::Start()
+		{
+			std::lock_guard<Mutex> lock(mSyncMutex);
+			if (mbRunning.load(std::memory_order_relaxed))
+			{
+				return;
+			}
+
+			mbStopRequested.store(false, std::memory_order_relaxed);
+			mbRunning.store(true, std::memory_order_release);
+			mThread = std::thread(&LogQueue::run, this);
+		}
+
+		void LogQueue::Stop()
+		{
+			std::lock_guard<Mutex> lock(mSyncMutex);
+			if (!mbRunning.load(std::memory_order_relaxed))
+			{
+				return;
+			}
+
+			mbStopRequested.store(true, std::memory_order_release);
+			wakeConsumer();
+			mThread.join();
+			mbRunning.store(false, std::memory_order_release);
+
+			// records published while the log thread was exiting
+			std::lock_guard<Mutex> outputLock(mOutputMutex);
+			drain();
+			reportDropped();
+			reportRepeated(true);
+			writeBatch();
+			updateFile(true);
+			if (mBinaryFile.is_open())
+			{
+				mBinaryFile.flush();
+			}
+			if (mArchiveThread.joinable())
+			{
+				mArchiveThread.join();
+			}
+			mWrittenPosition.store(mDequeuePosition, std::memory_order_release);
+			mWrittenPosition.notify_all();
+		}
+
+		void LogQueue::Flush()
+		{
+			if (!mbRunning.load(std::memory_order_acquire))
+			{
+				return;
+			}
+
+			size_t target = mEnqueuePosition.load(std::memory_order_acquire);
+			mFlushWaiterCount.fetch_add(1u, std::memory_order_seq_cst);
+			wakeConsumer();
+
+			size_t written = mWrittenPosition.load(std::memory_order_seq_cst);
+			while (written < target && mbRunning.load(std::memory_order_acquire))
+			{
+				mWrittenPosition.wait(written, std::memory_order_acquire);
+				written = mWrittenPosition.load(std::memory_order_acquire);
+			}
+
+			mFlushWaiterCount.fetch_sub(1u, std::memory_order_relaxed);
+
+			// what the log thread holds back on purpose
+			std::lock_guard<Mutex> outputLock(mOutputMutex);
+			reportRepeated(true);
+			writeBatch();
+			updateFile(true);
+		}
+
+		void LogQueue::run()
+		{
+			SetCurrentThreadName("CaveLog");
+
+			for (;;)
+			{
+				size_t count = 0ul;
+				{
+					std::lock_guard<Mutex> outputLock(mOutputMutex);
+					count = drain();
+					reportDropped();
+					reportRepeated(false);
+					writeBatch();
+					updateFile(false);
+				}
+
+				// seq_cst on both sides: either Flush() sees the new position or we see its waiter count
+				mWrittenPosition.store(mDequeuePosition, std::memory_order_seq_cst);
+				if (mFlushWaiterCount.load(std::memory_order_seq_cst) != 0u)
+				{
+					mWrittenPosition.notify_all();
+				}
+
+				if (count != 0ul)
+				{
+					continue;
+				}
+
+				if (mbStopRequested.load(std::memory_order_acquire))
+				{
+					break;
+				}
+
+				mWakeEvent.WaitFor(WAKE_INTERVAL);
+			}
+		}
+
+		size_t LogQueue::drain()
+		{
+			size_t count = 0ul;
+			for (;;)
+			{
+				LogSlot& slot = mSlots[mDequeuePosition & SLOT_MASK];
+				if (slot.Sequence.load(std::memory_order_acquire) != mDequeuePosition + 1ul)
+				{
+					return count;
+				}
+
+				append(slot.Record);
+				slot.Sequence.store(mDequeuePosition + SLOT_COUNT, std::memory_order_release);
+				++mDequeuePosition;
+				++count;
+			}
+		}
+
+		void LogQueue::wakeConsumer()
+		{
+			mWakeEvent.Signal();
+		}
+
+		void LogQueue::reportDropped()
+		{
+			uint64_t droppedCount = mDroppedCount.load(std::memory_order_relaxed);
+			if (droppedCount == mReportedDroppedCount)
+			{
+				return;
+			}
+
+			LogRecord source;
+			source.FileName = __FILE__;
+			source.FunctionName = __func__;
+			source.LineNumber = __LINE__;
+			source.Channel = eLogChannel::CORE;
+			source.Verbosity = eLogVerbosity::Warn;
+
+			LogRecord record;
+			formatNote(record, source, "{} messages dropped, the log queue was full", droppedCount - mReportedDroppedCount);
+			append(record);
+
+			mReportedDroppedCount = droppedCount;
+		}
+
+		void LogQueue::reportRepeated(bool bForce)
+		{
+			if (mRepeatedCount == 0ull || (!bForce && std::chrono::steady_clock::now() - mRepeatStartTime < REPEAT_REPORT_INTERVAL))
+			{
+				return;
+			}
+
+			LogRecord record;
+			formatNote(record, mLastRecord, "last message repeated {} times", mRepeatedCount);
+			mRepeatedCount = 0ull;
+			appendRecord(record);
+		}
+
+		void LogQueue::append(const LogRecord& record)
+		{
+			if (mbHasLastRecord && isSameMessage(record, mLastRecord))
+			{
+				if (mRepeatedCount == 0ull)
+				{
+					mRepeatStartTime = std::chrono::steady_clock::now();
+				}
+
+				// the rate limited ones were identical too as far as anyone can tell
+				mRepeatedCount += 1ull + record.SuppressedCount;
+				mCoalescedCount.fetch_add(1ull, std::memory_order_relaxed);
+				return;
+			}
+
+			reportRepeated(true);
+			if (record.SuppressedCount != 0u)
+			{
+				LogRecord note;
+				formatNote(note, record, "{} messages suppressed by the rate limit", record.SuppressedCount);
+				appendRecord(note);
+			}
+			appendRecord(record);
+
+			std::memcpy(&mLastRecord, &record, offsetof(LogRecord, Message) + record.Length);
+			mbHasLastRecord = true;
+		}
+
+		void LogQueue::appendRecord(const LogRecord& record)
+		{
+			if (mBinaryFile.is_open())
+			{
+				appendBinary(record);
+				if (!mFile.is_open())
+				{
+					return;
+				}
+			}
+
+			char message[MAX_BUFFER + 1ul];
+			StringView text = getMessage(record.Format, record.FormatLength, record.ArgumentCount, record.Message, record.Length, message, sizeof(message));
+
+			if (!mBinaryFile.is_open())
+			{
+				appendText(record, text);
+			}
+			if (mFile.is_open())
+			{
+				appendFile(record, text);
+			}
+		}
+
+		void LogQueue::appendText(const LogRecord& record, StringView text)
+		{
+#ifdef __WIN32__
+			constexpr bool bColor = false;
+#else
+			constexpr bool bColor = true;
+#endif
+
+			for (;;)
+			{
+				FormatResult result = formatLine(mBatch.get() + mBatchLength, BATCH_SIZE - mBatchLength, bColor
+					, record.Channel, record.Verbosity, record.FileName, record.FunctionName, record.LineNumber, text);
+
+				if (!result.bTruncated || mBatchLength == 0ul)
+				{
+					mBatchLength += result.Length;
+					return;
+				}
+
+				writeBatch();
+			}
+		}
+
+		void LogQueue::appendFile(const LogRecord& record, StringView text)
+		{
+			for (;;)
+			{
+				FormatResult result = formatLine(mFileBatch.get() + mFileBatchLength, FILE_BATCH_SIZE - mFileBatchLength, false
+					, record.Channel, record.Verbosity, record.FileName, record.FunctionName, record.LineNumber, text);
+
+				if (!result.bTruncated || mFileBatchLength == 0ul)
+				{
+					mFileBatchLength += result.Length;
+					break;
+				}
+
+				writeFileBatch();
+			}
+
+			// do not keep what led up to a crash in memory
+			if (record.Verbosity >= eLogVerbosity::Error)
+			{
+				mbFileWriteRequested = true;
+			}
+		}
+
+		void LogQueue::appendBinary(const LogRecord& record)
+		{
+			uint32_t fileId = getStringId(record.FileName, std::strlen(record.FileName));
+			uint32_t functionId = getStringId(record.FunctionName, std::strlen(record.FunctionName));
+			uint32_t formatId = record.Format != nullptr ? getStringId(record.Format, record.FormatLength) : 0u;
+
+			char header[BINARY_RECORD_HEADER_SIZE];
+			char* cursor = header;
+			auto put = [&](const auto& value)
+				{
+					std::memcpy(cursor, &value, sizeof(value));
+					cursor += sizeof(value);
+				};
+
+			put(eBinaryChunk::RECORD);
+			put(fileId);
+			put(functionId);
+			put(record.LineNumber);
+			put(static_cast<uint8_t>(record.Channel));
+			put(static_cast<uint8_t>(record.Verbosity));
+			put(formatId);
+			put(record.ArgumentCount);
+			put(record.Length);
+			assert(cursor == header + BINARY_RECORD_HEADER_SIZE);
+
+			appendBytes(header, sizeof(header));
+			appendBytes(record.Message, record.Length);
+		}
+
+		void LogQueue::appendBytes(const void* data, size_t size)
+		{
+			if (BATCH_SIZE - mBatchLength < size)
+			{
+				writeBatch();
+			}
+
+			if (size > BATCH_SIZE)
+			{
+				mBinaryFile.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+				return;
+			}
+
+			std::memcpy(mBatch.get() + mBatchLength, data, size);
+			mBatchLength += size;
+		}
+
+		uint32_t LogQueue::getStringId(const char* string, size_t length)
+		{
+			auto it = mStringIds.find(string);
+			if (it != mStringIds.end())
+			{
+				return it->second;
+			}
+
+			uint32_t id = static_cast<uint32_t>(mStringIds.size()) + 1u;
+			mStringIds.emplace(string, id);
+
+			eBinaryChunk chunk = eBinaryChunk::STRING;
+			uint32_t stringLength = static_cast<uint32_t>(length);
+			appendBytes(&chunk, sizeof(chunk));
+			appendBytes(&id, sizeof(id));
+			appendBytes(&stringLength, sizeof(stringLength));
+			appendBytes(string, length);
+
+			return id;
+		}
+
+		void LogQueue::writeBatch()
+		{
+			if (mBatchLength == 0ul)
+			{
+				return;
+			}
+
+			if (mBinaryFile.is_open())
+			{
+				mBinaryFile.write(mBatch.get(), static_cast<std::streamsize>(mBatchLength));
+				mBatchLength = 0ul;
+				return;
+			}
+
+#ifdef __WIN32__
+			int wideLength = MultiByteToWideChar(CP_UTF8, 0, mBatch.get(), static_cast<int>(mBatchLength), mWideBatch.get(), static_cast<int>(BATCH_SIZE));
+			mWideBatch[wideLength] = L'\0';
+			OutputDebugStringW(mWideBatch.get());
+#else
+			const char* data = mBatch.get();
+			size_t remaining = mBatchLength;
+			while (remaining != 0ul)
+			{
+				ssize_t written = ::write(STDOUT_FILENO, data, remaining);
+				if (written < 0)
+				{
+					if (errno == EINTR)
+					{
+						continue;
+					}
+					break;
+				}
+
+				data += written;
+				remaining -= static_cast<size_t>(written);
+			}
+#endif
+
+			mBatchLength = 0ul;
+		}
+
+		void LogQueue::writeFileBatch()
+		{
+			mFileWriteTime = std::chrono::steady_clock::now();
+			mbFileWriteRequested = false;
+			if (mFileBatchLength == 0ul)
+			{
+				return;
+			}
+
+			if (mMaxFileSize != 0ull && mFileSize != 0ull && mFileSize + mFileBatchLength > mMaxFileSize)
+			{
+				rotateFile();
+			}
+
+			mFile.write(mFileBatch.get(), static_cast<std::streamsize>(mFileBatchLength));
+			mFile.flush();
+			mFileSize += mFileBatchLength;
+			mFileBatchLength = 0ul;
+		}
+
+		void LogQueue::updateFile(bool bForce)
+		{
+			if (!mFile.is_open())
+			{
+				return;
+			}
+
+			std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+			if (mMaxFileSeconds != 0u && now - mFileOpenTime >= std::chrono::seconds(mMaxFileSeconds))
+			{
+				writeFileBatch();
+				if (mFileSize != 0ull)
+				{
+					rotateFile();
+				}
+				mFileOpenTime = now;
+			}
+
+			if (bForce || mbFileWriteRequested || now - mFileWriteTime >= FILE_WRITE_INTERVAL)
+			{
+				writeFileBatch();
+			}
+		}
+
+		/*
+		 * mFilePath becomes mFilePath.1 (.gz), mFilePath.1 becomes mFilePath.2 and so on, the oldest past mFileArchiveCount is removed.
+		 */
+		void LogQueue::rotateFile()
+		{
+			mFile.close();
+			if (mArchiveThread.joinable())
+			{
+				mArchiveThread.join();
+			}
+
+			const char* extension = mbCompressFileArchive ? ".gz" : "";
+			auto getArchivePath = [&](uint32_t index)
+				{
+					return mFilePath + '.' + std::to_string(index) + extension;
+				};
+
+			if (mFileArchiveCount == 0u)
+			{
+				std::remove(mFilePath.c_str());
+			}
+			else
+			{
+				std::remove(getArchivePath(mFileArchiveCount).c_str());
+				for (uint32_t i = mFileArchiveCount - 1u; i > 0u; --i)
+				{
+					std::rename(getArchivePath(i).c_str(), getArchivePath(i + 1u).c_str());
+				}
+
+				std::string rotatedPath = mFilePath + ".1";
+				std::remove(rotatedPath.c_str());
+				std::rename(mFilePath.c_str(), rotatedPath.c_str());
+				if (mbCompressFileArchive)
+				{
+					mArchiveThread = std::thread(compressFile, rotatedPath, getArchivePath(1u));
+				}
+			}
+
+			mFile.open(mFilePath, std::ios::out | std::ios::binary | std::ios::trunc);
+			mFileSize = 0ull;
+			mFileOpenTime = std::chrono::steady_clock::now();
+		}
+
+		bool LogQueue::OpenFile(const char* filePath)
+		{
+			// messages logged before the call are not written to the file
+			Flush();
+
+			std::lock_guard<Mutex> outputLock(mOutputMutex);
+			closeFile();
+
+			mFile.open(filePath, std::ios::out | std::ios::binary | std::ios::app);
+			if (!mFile.is_open())
+			{
+				return false;
+			}
+
+			mFile.seekp(0, std::ios::end);
+			mFilePath = filePath;
+			mFileSize = static_cast<uint64_t>(mFile.tellp());
+			mFileOpenTime = std::chrono::steady_clock::now();
+			mFileWriteTime = mFileOpenTime;
+			if (mFileBatch == nullptr)
+			{
+				mFileBatch.reset(new char[FILE_BATCH_SIZE]);
+			}
+
+			return true;
+		}
+
+		void LogQueue::CloseFile()
+		{
+			Flush();
+
+			std::lock_guard<Mutex> outputLock(mOutputMutex);
+			closeFile();
+		}
+
+		void LogQueue::SetFileRotation(uint64_t maxFileSize, uint32_t maxFileSeconds)
+		{
+			std::lock_guard<Mutex> outputLock(mOutputMutex);
+			mMaxFileSize = maxFileSize;
+			mMaxFileSeconds = maxFileSeconds;
+		}
+
+		void LogQueue::SetFileArchive(uint32_t archiveCount, bool bCompress)
+		{
+			std::lock_guard<Mutex> outputLock(mOutputMutex);
+			mFileArchiveCount = archiveCount;
+			mbCompressFileArchive = bCompress;
+		}
+
+		void LogQueue::closeFile()
+		{
+			if (mFile.is_open())
+			{
+				writeFileBatch();
+				mFile.close();
+			}
+			if (mArchiveThread.joinable())
+			{
+				mArchiveThread.join();
+			}
+		}
+
+		bool LogQueue::OpenBinaryFile(const char* filePath)
+		{
+			// messages logged before the call still go to the old output
+			Flush();
+
+			std::lock_guard<Mutex> outputLock(mOutputMutex);
+			reportRepeated(true);
+			writeBatch();
+			closeBinaryFile();
+
+			mBinaryFile.open(filePath, std::ios::out | std::ios::binary | std::ios::trunc);
+			if (!mBinaryFile.is_open())
+			{
+				return false;
+			}
+
+			mBinaryFile.write(BINARY_LOG_MAGIC, sizeof(BINARY_LOG_MAGIC));
+
+			return true;
+		}
+
+		void LogQueue::CloseBinaryFile()
+		{
+			Flush();
+
+			std::lock_guard<Mutex> outputLock(mOutputMutex);
+			reportRepeated(true);
+			writeBatch();
+			closeBinaryFile();
+		}
 
-#ifdef __UNIX__
-namespace cave
-{
-	eLogVerbosity Log::msCurrentVerbosity = eLogVerbosity::All;
-	char Log::mBuffer[MAX_BUFFER] = {'\0', };
+		void LogQueue::closeBinaryFile()
+		{
+			if (mBinaryFile.is_open())
+			{
+				mBinaryFile.close();
+			}
+			mStringIds.clear();
+			mbHasLastRecord = false;
+		}
+	}
+
+	void Log::Initialize()
+	{
+		LogQueue::GetInstance().Start();
+	}
+
+	void Log::Destroy()
+	{
+		LogQueue::GetInstance().Stop();
+	}
+
+	void Log::Flush()
+	{
+		LogQueue::GetInstance().Flush();
+	}
+
+	uint64_t Log::GetDroppedCount()
+	{
+		return LogQueue::GetInstance().GetDroppedCount();
+	}
+
+	uint64_t Log::GetSuppressedCount()
+	{
+		return LogQueue::GetInstance().GetSuppressedCount();
+	}
+
+	uint64_t Log::GetCoalescedCount()
+	{
+		return LogQueue::GetInstance().GetCoalescedCount();
+	}
+
+	void Log::SetRateLimit(uint32_t messagesPerSecond, uint32_t burstCount)
+	{
+		LogQueue::GetInstance().SetRateLimit(messagesPerSecond, burstCount);
+	}
+
+	bool Log::OpenFile(const char* filePath)
+	{
+		return LogQueue::GetInstance().OpenFile(filePath);
+	}
+
+	void Log::CloseFile()
+	{
+		LogQueue::GetInstance().CloseFile();
+	}
+
+	void Log::SetFileRotation(uint64_t maxFileSize, uint32_t maxFileSeconds)
+	{
+		LogQueue::GetInstance().SetFileRotation(maxFileSize, maxFileSeconds);
+	}
+
+	void Log::SetFileArchive(uint32_t archiveCount, bool bCompress)
+	{
+		LogQueue::GetInstance().SetFileArchive(archiveCount, bCompress);
+	}
+
+	bool Log::OpenBinaryFile(const char* filePath)
+	{
+		return LogQueue::GetInstance().OpenBinaryFile(filePath);
+	}
+
+	void Log::CloseBinaryFile()
+	{
+		LogQueue::GetInstance().CloseBinaryFile();
+	}
+
+	bool Log::DecodeBinaryFile(std::istream& input, std::ostream& output)
+	{
+		std::vector<char> data{ std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>() };
+		const char* cursor = data.data();
+		const char* end = data.data() + data.size();
+
+		auto read = [&](auto& value)
+			{
+				if (static_cast<size_t>(end - cursor) < sizeof(value))
+				{
+					return false;
+				}
+
+				std::memcpy(&value, cursor, sizeof(value));
+				cursor += sizeof(value);
+				return true;
+			};
+
+		char magic[sizeof(BINARY_LOG_MAGIC)];
+		if (!read(magic) || std::memcmp(magic, BINARY_LOG_MAGIC, sizeof(magic)) != 0)
+		{
+			return false;
+		}
+
+		std::vector<StringView> strings;
+		auto getString = [&](uint32_t id, StringView& outString)
+			{
+				if (id == 0u || id > strings.size())
+				{
+					return false;
+				}
+
+				outString = strings[id - 1u];
+				return true;
+			};
+
+		char message[MAX_BUFFER + 1ul];
+		char line[MAX_LINE];
+		while (cursor != end)
+		{
+			eBinaryChunk chunk = static_cast<eBinaryChunk>(*cursor++);
+			if (chunk == eBinaryChunk::STRING)
+			{
+				uint32_t id = 0u;
+				uint32_t length = 0u;
+				if (!read(id) || !read(length) || id != strings.size() + 1ul || static_cast<size_t>(end - cursor) < length)
+				{
+					return false;
+				}
+
+				strings.push_back(StringView(cursor, length));
+				cursor += length;
+				continue;
+			}
+
+			if (chunk != eBinaryChunk::RECORD)
+			{
+				return false;
+			}
+
+			uint32_t fileId = 0u;
+			uint32_t functionId = 0u;
+			int32_t lineNumber = 0;
+			uint8_t channel = 0u;
+			uint8_t verbosity = 0u;
+			uint32_t formatId = 0u;
+			uint8_t argumentCount = 0u;
+			uint16_t length = 0u;
+			if (!read(fileId) || !read(functionId) || !read(lineNumber) || !read(channel) || !read(verbosity) || !read(formatId) || !read(argumentCount) || !read(length)
+				|| static_cast<size_t>(end - cursor) < length || verbosity >= static_cast<uint8_t>(eLogVerbosity::Count))
+			{
+				return false;
+			}
+
+			StringView fileName;
+			StringView functionName;
+			StringView format;
+			if (!getString(fileId, fileName) || !getString(functionId, functionName) || (formatId != 0u && !getString(formatId, format)))
+			{
+				return false;
+			}
+
+			StringView text = getMessage(formatId != 0u ? format.GetData() : nullptr, format.GetLength(), argumentCount, cursor, length, message, sizeof(message));
+			cursor += length;
+
+			FormatResult result = formatLine(line, sizeof(line), false, static_cast<eLogChannel>(channel), static_cast<eLogVerbosity>(verbosity), fileName, functionName, lineNumber, text);
+			output.write(line, static_cast<std::streamsize>(result.Length));
+		}
+
+		return static_cast<bool>(output);
+	}
 
 	void Log::SetVerbosity(eLogVerbosity verbosity)
 	{
-		msCurrentVerbosity = verbosity;
+		uint8_t disabledVerbosities = getDisabledVerbosities(verbosity);
+		for (std::atomic<uint8_t>& channelVerbosities : msDisabledVerbosities)
+		{
+			channelVerbosities.store(disabledVerbosities, std::memory_order_relaxed);
+		}
+	}
+
+	void Log::SetChannelVerbosity(eLogChannel channel, eLogVerbosity verbosity)
+	{
+		msDisabledVerbosities[static_cast<uint8_t>(channel)].store(getDisabledVerbosities(verbosity), std::memory_order_relaxed);
 	}
 
 	void Log::Verbose(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const char* message)
@@ -27,8 +1677,7 @@ namespace cave
 	{
 		va_list vl;
 		va_start(vl, message);
-		vsnprintf(mBuffer, MAX_BUFFER, message, vl);
-		log(channel, eLogVerbosity::Verbose, fileName, functionName, lineNumber, mBuffer);
+		logV(channel, eLogVerbosity::Verbose, fileName, functionName, lineNumber, message, vl);
 		va_end(vl);
 	}
 
@@ -41,8 +1690,7 @@ namespace cave
 	{
 		va_list vl;
 		va_start(vl, message);
-		vsnprintf(mBuffer, MAX_BUFFER, message, vl);
-		log(channel, eLogVerbosity::Debug, fileName, functionName, lineNumber, mBuffer);
+		logV(channel, eLogVerbosity::Debug, fileName, functionName, lineNumber, message, vl);
 		va_end(vl);
 	}
 
@@ -55,8 +1703,7 @@ namespace cave
 	{
 		va_list vl;
 		va_start(vl, message);
-		vsnprintf(mBuffer, MAX_BUFFER, message, vl);
-		log(channel, eLogVerbosity::Info, fileName, functionName, lineNumber, mBuffer);
+		logV(channel, eLogVerbosity::Info, fileName, functionName, lineNumber, message, vl);
 		va_end(vl);
 	}
 
@@ -69,8 +1716,7 @@ namespace cave
 	{
 		va_list vl;
 		va_start(vl, message);
-		vsnprintf(mBuffer, MAX_BUFFER, message, vl);
-		log(channel, eLogVerbosity::Warn, fileName, functionName, lineNumber, mBuffer);
+		logV(channel, eLogVerbosity::Warn, fileName, functionName, lineNumber, message, vl);
 		va_end(vl);
 	}
 
@@ -83,8 +1729,7 @@ namespace cave
 	{
 		va_list vl;
 		va_start(vl, message);
-		vsnprintf(mBuffer, MAX_BUFFER, message, vl);
-		log(channel, eLogVerbosity::Error, fileName, functionName, lineNumber, mBuffer);
+		logV(channel, eLogVerbosity::Error, fileName, functionName, lineNumber, message, vl);
 		va_end(vl);
 	}
 
@@ -97,123 +1742,439 @@ namespace cave
 	{
 		va_list vl;
 		va_start(vl, message);
-		vsnprintf(mBuffer, MAX_BUFFER, message, vl);
-		log(channel, eLogVerbosity::Assert, fileName, functionName, lineNumber, mBuffer);
+		logV(channel, eLogVerbosity::Assert, fileName, functionName, lineNumber, message, vl);
+		va_end(vl);
+	}
+
+	void Log::WVerbose(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const wchar_t* message)
+	{
+		wlog(channel, eLogVerbosity::Verbose, fileName, functionName, lineNumber, message);
+	}
+
+	void Log::WVerboseF(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const wchar_t* message, ...)
+	{
+		va_list vl;
+		va_start(vl, message);
+		wlogV(channel, eLogVerbosity::Verbose, fileName, functionName, lineNumber, message, vl);
+		va_end(vl);
+	}
+
+	void Log::WDebug(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const wchar_t* message)
+	{
+		wlog(channel, eLogVerbosity::Debug, fileName, functionName, lineNumber, message);
+	}
+
+	void Log::WDebugF(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const wchar_t* message, ...)
+	{
+		va_list vl;
+		va_start(vl, message);
+		wlogV(channel, eLogVerbosity::Debug, fileName, functionName, lineNumber, message, vl);
+		va_end(vl);
+	}
+
+	void Log::WInfo(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const wchar_t* message)
+	{
+		wlog(channel, eLogVerbosity::Info, fileName, functionName, lineNumber, message);
+	}
+
+	void Log::WInfoF(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const wchar_t* message, ...)
+	{
+		va_list vl;
+		va_start(vl, message);
+		wlogV(channel, eLogVerbosity::Info, fileName, functionName, lineNumber, message, vl);
+		va_end(vl);
+	}
+
+	void Log::WWarn(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const wchar_t* message)
+	{
+		wlog(channel, eLogVerbosity::Warn, fileName, functionName, lineNumber, message);
+	}
+
+	void Log::WWarnF(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const wchar_t* message, ...)
+	{
+		va_list vl;
+		va_start(vl, message);
+		wlogV(channel, eLogVerbosity::Warn, fileName, functionName, lineNumber, message, vl);
+		va_end(vl);
+	}
+
+	void Log::WError(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const wchar_t* message)
+	{
+		wlog(channel, eLogVerbosity::Error, fileName, functionName, lineNumber, message);
+	}
+
+	void Log::WErrorF(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const wchar_t* message, ...)
+	{
+		va_list vl;
+		va_start(vl, message);
+		wlogV(channel, eLogVerbosity::Error, fileName, functionName, lineNumber, message, vl);
+		va_end(vl);
+	}
+
+	void Log::WAssert(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const wchar_t* message)
+	{
+		wlog(channel, eLogVerbosity::Assert, fileName, functionName, lineNumber, message);
+	}
+
+	void Log::WAssertF(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const wchar_t* message, ...)
+	{
+		va_list vl;
+		va_start(vl, message);
+		wlogV(channel, eLogVerbosity::Assert, fileName, functionName, lineNumber, message, vl);
 		va_end(vl);
 	}
 
+	uint8_t Log::getDisabledVerbosities(eLogVerbosity verbosity)
+	{
+		if (verbosity == eLogVerbosity::All)
+		{
+			return 0u;
+		}
+
+		if (verbosity == eLogVerbosity::Count)
+		{
+			return UINT8_MAX;
+		}
+
+		return static_cast<uint8_t>(~(1u << static_cast<uint32_t>(verbosity)));
+	}
+
+	void Log::logArguments(eLogChannel channel, eLogVerbosity verbosity, const char* fileName, const char* functionName, int32_t lineNumber, LogFormatString format, const FormatArgument* arguments, size_t argumentCount)
+	{
+		LogQueue::GetInstance().Push(channel, verbosity, fileName, functionName, lineNumber, [&](LogRecord& record)
+			{
+				size_t length = 0ul;
+				if (encodeArguments(arguments, argumentCount, record.Message, sizeof(record.Message), length))
+				{
+					record.Format = format.GetData();
+					record.FormatLength = static_cast<uint32_t>(format.GetLength());
+					record.ArgumentCount = static_cast<uint8_t>(argumentCount);
+					return length;
+				}
+
+				// too many arguments to defer
+				return VFormat(record.Message, sizeof(record.Message), StringView(format.GetData(), format.GetLength()), arguments, argumentCount).Length;
+			});
+	}
+
 	void Log::log(eLogChannel channel, eLogVerbosity verbosity, const char* fileName, const char* functionName, int32_t lineNumber, const char* message)
 	{
-		if (msCurrentVerbosity == eLogVerbosity::All || verbosity == msCurrentVerbosity)
+		if (!IsEnabled(channel, verbosity))
 		{
-			std::string buffer;
+			return;
+		}
 
-			switch (channel)
+		LogQueue::GetInstance().Push(channel, verbosity, fileName, functionName, lineNumber, [message](LogRecord& record)
 			{
-			case eLogChannel::GRAPHICS:
-				buffer = "Graphics/";
-				break;
-			case eLogChannel::PHYSICS:
-				buffer = "Physics/";
-				break;
-			case eLogChannel::AUDIO:
-				buffer = "Audio/";
-				break;
-			case eLogChannel::AI:
-				buffer = "AI/";
-				break;
-			case eLogChannel::GAMEPLAY:
-				buffer = "Gameplay/";
-				break;
-			case eLogChannel::CORE:
-				buffer = "Core/";
-				break;
-			case eLogChannel::CORE_MODULE:
-				buffer = "Core/Module/";
-				break;
-			case eLogChannel::CORE_UNIT_TEST:
-				buffer = "Core/UnitTest/";
-				break;
-			case eLogChannel::CORE_MEMORY:
-				buffer = "Core/Memory/";
-				break;
-			case eLogChannel::CORE_MATH:
-				buffer = "Core/Math/";
-				break;
-			case eLogChannel::CORE_STRING:
-				buffer = "Core/String/";
-				break;
-			case eLogChannel::CORE_LOCALIZATION:
-				buffer = "Core/Localization/";
-				break;
-			case eLogChannel::CORE_PARSER:
-				buffer = "Core/Parser/";
-				break;
-			case eLogChannel::CORE_PROFILE:
-				buffer = "Core/Profile/";
-				break;
-			case eLogChannel::CORE_ENGINE_CONFIG:
-				buffer = "Core/EngineConfig/";
-				break;
-			case eLogChannel::CORE_RNG:
-				buffer = "Core/RandomNumberGenerator/";
-				break;
-			case eLogChannel::CORE_OBJECT:
-				buffer = "Core/Object/";
-				break;
-			case eLogChannel::CORE_THREAD:
-				buffer = "Core/Thread/";
-				break;
-			case eLogChannel::CORE_CONTAINER:
-				buffer = "Core/Container/";
-				break;
-			case eLogChannel::CORE_FILE_SYSTEM:
-				buffer = "Core/FileSystem/";
-				break;
-			case eLogChannel::CORE_TIMER:
-				buffer = "Core/Timer/";
-				break;
-			case eLogChannel::CORE_RESOURCE_MANAGER:
-				buffer = "Core/ResourceManager/";
-				break;
-			default:
-				assert(false);
-				break;
+				size_t length = 0ul;
+				while (length < MAX_BUFFER && message[length] != '\0')
+				{
+					record.Message[length] = message[length];
+					++length;
+				}
+				return length;
+			});
+	}
+
+	void Log::logV(eLogChannel channel, eLogVerbosity verbosity, const char* fileName, const char* functionName, int32_t lineNumber, const char* message, va_list vl)
+	{
+		if (!IsEnabled(channel, verbosity))
+		{
+			return;
+		}
+
+		LogQueue::GetInstance().Push(channel, verbosity, fileName, functionName, lineNumber, [&](LogRecord& record)
+			{
+				int count = vsnprintf(record.Message, sizeof(record.Message), message, vl);
+				if (count < 0)
+				{
+					return 0ul;
+				}
+				return static_cast<size_t>(count) < MAX_BUFFER ? static_cast<size_t>(count) : MAX_BUFFER;
+			});
+	}
+
+	void Log::wlog(eLogChannel channel, eLogVerbosity verbosity, const char* fileName, const char* functionName, int32_t lineNumber, const wchar_t* message)
+	{
+		if (!IsEnabled(channel, verbosity))
+		{
+			return;
+		}
+
+		LogQueue::GetInstance().Push(channel, verbosity, fileName, functionName, lineNumber, [message](LogRecord& record)
+			{
+				return encodeUtf8(message, std::wcslen(message), record.Message, MAX_BUFFER);
+			});
+	}
+
+	void Log::wlogV(eLogChannel channel, eLogVerbosity verbosity, const char* fileName, const char* functionName, int32_t lineNumber, const wchar_t* message, va_list vl)
+	{
+		if (!IsEnabled(channel, verbosity))
+		{
+			return;
+		}
+
+		wchar_t wideMessage[MAX_BUFFER];
+		int count = vswprintf(wideMessage, MAX_BUFFER, message, vl);
+		// unlike vsnprintf, a truncated vswprintf returns -1
+		wideMessage[MAX_BUFFER - 1ul] = L'\0';
+		size_t length = count >= 0 ? static_cast<size_t>(count) : std::wcslen(wideMessage);
+
+		LogQueue::GetInstance().Push(channel, verbosity, fileName, functionName, lineNumber, [&](LogRecord& record)
+			{
+				return encodeUtf8(wideMessage, length, record.Message, MAX_BUFFER);
+			});
+	}
+
+#ifdef CAVE_BUILD_DEBUG
+	namespace LogTest
+	{
+		void Main()
+		{
+			LOGD(eLogChannel::CORE, "======Log Test======");
+
+			{
+				char buffer[16];
+				const wchar_t hangul[] = { 0xD55C, 0xAE00, 0 };
+				assert(encodeUtf8(L"abc", 3ul, buffer, sizeof(buffer)) == 3ul);
+				assert(encodeUtf8(hangul, 2ul, buffer, sizeof(buffer)) == 6ul && StringView(buffer, 6ul) == "\xED\x95\x9C\xEA\xB8\x80");
+				// never splits a character
+				assert(encodeUtf8(hangul, 2ul, buffer, 5ul) == 3ul);
 			}
 
-			char color = '7';
-			switch (verbosity)
 			{
-			case eLogVerbosity::Verbose:
-				buffer += "V/";
-				break;
-			case eLogVerbosity::Debug:
-				buffer += "D/";
-				color = '2';
-				break;
-			case eLogVerbosity::Info:
-				buffer += "I/";
-				color = '3';
-				break;
-			case eLogVerbosity::Warn:
-				buffer += "W/";
-				color = '5';
-				break;
-			case eLogVerbosity::Error:
-				buffer += "E/";
-				color = '1';
-				break;
-			case eLogVerbosity::Assert:
-				buffer += "A/";
-				color = '6';
-				break;
-			default:
-				assert(false);
-				break;
+				// deferred arguments format exactly like the ones they were copied from
+				int32_t value = -5;
+				std::string temporary = "str";
+				const FormatArgument arguments[] = { true, 'x', -5, 7u, 1.5f, 2.25, StringView(temporary), static_cast<const void*>(&value) };
+				constexpr size_t ARGUMENT_COUNT = sizeof(arguments) / sizeof(arguments[0]);
+				StringView format = "{} {} {} {} {} {} {} {}";
+
+				char payload[MAX_BUFFER + 1ul];
+				size_t length = 0ul;
+				assert(encodeArguments(arguments, ARGUMENT_COUNT, payload, sizeof(payload), length));
+				temporary = "changed";
+
+				DecodedArguments decoded;
+				assert(decodeArguments(payload, length, ARGUMENT_COUNT, decoded));
+				assert(!decodeArguments(payload, length - 1ul, ARGUMENT_COUNT, decoded));
+
+				char expected[MAX_BUFFER + 1ul];
+				char actual[MAX_BUFFER + 1ul];
+				temporary = "str";
+				FormatResult expectedResult = VFormat(expected, sizeof(expected), format, arguments, ARGUMENT_COUNT);
+				FormatResult actualResult = VFormat(actual, sizeof(actual), format, decoded.Arguments, ARGUMENT_COUNT);
+				assert(StringView(expected, expectedResult.Length) == StringView(actual, actualResult.Length));
+
+				// long strings are cut to the space left, too many arguments are not deferred
+				std::string longString(2ul * MAX_BUFFER, 'a');
+				const FormatArgument longArgument[] = { StringView(longString) };
+				assert(encodeArguments(longArgument, 1ul, payload, sizeof(payload), length) && length == sizeof(payload));
+				assert(decodeArguments(payload, length, 1ul, decoded) && decoded.Arguments[0].GetString().GetLength() == sizeof(payload) - 3ul);
+				FormatArgument manyArguments[MAX_DEFERRED_ARGUMENT_COUNT + 1ul] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
+				assert(!encodeArguments(manyArguments, MAX_DEFERRED_ARGUMENT_COUNT + 1ul, payload, sizeof(payload), length));
+			}
+
+			{
+				// a binary file decodes to the lines that would have been printed
+				constexpr const char* FILE_PATH = "LogTest.cavelog";
+				assert(Log::OpenBinaryFile(FILE_PATH));
+				{
+					std::string name = "binary";
+					LOGDFMT(eLogChannel::CORE, "{} {:.1f} {}", name, 2.5, 42);
+				}
+				int32_t lineNumber = __LINE__ - 2;
+				LOGWF(eLogChannel::CORE_STRING, "%s", "printf");
+				LOGD(eLogChannel::CORE, "plain");
+				Log::CloseBinaryFile();
+
+				std::ifstream input(FILE_PATH, std::ios::in | std::ios::binary);
+				std::ostringstream output;
+				assert(Log::DecodeBinaryFile(input, output));
+				input.close();
+				std::remove(FILE_PATH);
+
+				char expected[MAX_LINE];
+				FormatResult result = formatLine(expected, sizeof(expected), false, eLogChannel::CORE, eLogVerbosity::Debug, __FILE__, __func__, lineNumber, "binary 2.5 42");
+				std::string decoded = output.str();
+				assert(decoded.find(std::string(expected, result.Length)) == 0ul);
+				assert(decoded.find("Core/String/W/") != std::string::npos && decoded.find(":\tprintf\n") != std::string::npos);
+				assert(decoded.find(":\tplain\n") != std::string::npos);
+
+				std::istringstream garbage("CAVELOG1\x07");
+				assert(!Log::DecodeBinaryFile(garbage, output));
+			}
+
+			{
+				// filtered statements do not evaluate their arguments
+				static_assert(IsLogCompiled(eLogChannel::CORE, eLogVerbosity::Assert));
+				static_assert(!IsLogCompiled(eLogChannel::CORE, eLogVerbosity::All));
+
+				uint32_t evaluationCount = 0u;
+				auto evaluate = [&evaluationCount]()
+					{
+						return ++evaluationCount;
+					};
+
+				Log::SetChannelVerbosity(eLogChannel::CORE_UNIT_TEST, eLogVerbosity::Count);
+				assert(!Log::IsEnabled(eLogChannel::CORE_UNIT_TEST, eLogVerbosity::Assert) && Log::IsEnabled(eLogChannel::CORE, eLogVerbosity::Debug));
+				LOGAFMT(eLogChannel::CORE_UNIT_TEST, "{}", evaluate());
+				LOGDF(eLogChannel::CORE_UNIT_TEST, "%u", evaluate());
+				assert(evaluationCount == 0u);
+
+				Log::SetVerbosity(eLogVerbosity::Warn);
+				assert(Log::IsEnabled(eLogChannel::CORE_UNIT_TEST, eLogVerbosity::Warn) && !Log::IsEnabled(eLogChannel::CORE, eLogVerbosity::Error));
+				LOGDFMT(eLogChannel::CORE, "{}", evaluate());
+				LOGWFMT(eLogChannel::CORE, "{} evaluated", evaluate());
+				assert(evaluationCount == 1u);
+
+				Log::SetVerbosity(eLogVerbosity::All);
+			}
+
+			{
+				// a call site over its rate limit is suppressed, and the next message it gets through says so
+				constexpr const char* FILE_PATH = "LogTest.cavelog";
+				assert(Log::OpenBinaryFile(FILE_PATH));
+
+				Log::SetRateLimit(1u, 4u);
+				uint64_t suppressedCount = Log::GetSuppressedCount();
+				auto logFromOneSite = [](int32_t i)
+					{
+						LOGDFMT(eLogChannel::CORE, "limited {}", i);
+					};
+				for (int32_t i = 0; i < 10; ++i)
+				{
+					logFromOneSite(i);
+				}
+				assert(Log::GetSuppressedCount() - suppressedCount == 6ull);
+
+				Log::SetRateLimit(1u, 4u);
+				logFromOneSite(10);
+				Log::SetRateLimit(DEFAULT_RATE_LIMIT_PER_SECOND, DEFAULT_RATE_LIMIT_BURST_COUNT);
+
+				// identical messages are folded into the first one
+				uint64_t coalescedCount = Log::GetCoalescedCount();
+				for (int32_t i = 0; i < 5; ++i)
+				{
+					LOGD(eLogChannel::CORE, "same");
+				}
+				LOGD(eLogChannel::CORE, "different");
+				Log::CloseBinaryFile();
+				assert(Log::GetCoalescedCount() - coalescedCount == 4ull);
+
+				std::ifstream input(FILE_PATH, std::ios::in | std::ios::binary);
+				std::ostringstream output;
+				assert(Log::DecodeBinaryFile(input, output));
+				input.close();
+				std::remove(FILE_PATH);
+
+				std::string decoded = output.str();
+				assert(decoded.find(":\tlimited 3\n") != std::string::npos && decoded.find(":\tlimited 4\n") == std::string::npos);
+				assert(decoded.find(":\t6 messages suppressed by the rate limit\n") < decoded.find(":\tlimited 10\n"));
+				assert(decoded.find(":\tsame\n") < decoded.find(":\tlast message repeated 4 times\n"));
+				assert(decoded.find(":\tlast message repeated 4 times\n") < decoded.find(":\tdifferent\n"));
+			}
+
+			{
+				// the log file is rotated on the first write past its size, older files are shifted and compressed
+				constexpr const char* FILE_PATH = "LogTest.log";
+				const std::string archivePaths[] = { std::string(FILE_PATH) + ".1.gz", std::string(FILE_PATH) + ".2.gz", std::string(FILE_PATH) + ".3.gz" };
+				std::remove(FILE_PATH);
+
+				Log::SetFileRotation(1ull, 0u);
+				Log::SetFileArchive(2u, true);
+				assert(Log::OpenFile(FILE_PATH));
+				for (int32_t i = 0; i < 4; ++i)
+				{
+					LOGDFMT(eLogChannel::CORE, "file {}", i);
+					Log::Flush();
+				}
+				Log::CloseFile();
+				Log::SetFileRotation(DEFAULT_MAX_FILE_SIZE, 0u);
+				Log::SetFileArchive(DEFAULT_FILE_ARCHIVE_COUNT, false);
+
+				auto readFile = [](const std::string& filePath)
+					{
+						std::ifstream input(filePath, std::ios::in | std::ios::binary);
+						return std::string(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+					};
+				auto readArchive = [&readFile](const std::string& filePath)
+					{
+						std::string archive = readFile(filePath);
+						assert(archive.size() > 18ul && static_cast<unsigned char>(archive[0]) == 0x1fu && static_cast<unsigned char>(archive[1]) == 0x8bu);
+
+						unsigned char* data = nullptr;
+						size_t size = 0ul;
+						assert(lodepng_inflate(&data, &size, reinterpret_cast<const unsigned char*>(archive.data()) + 10ul, archive.size() - 18ul, &lodepng_default_decompress_settings) == 0u);
+						uint32_t crc = 0u;
+						for (size_t i = 0ul; i < 4ul; ++i)
+						{
+							crc |= static_cast<uint32_t>(static_cast<unsigned char>(archive[archive.size() - 8ul + i])) << (8u * i);
+						}
+						assert(lodepng_crc32(data, size) == crc);
+						std::string text(reinterpret_cast<const char*>(data), size);
+						std::free(data);
+						return text;
+					};
+
+				std::string current = readFile(FILE_PATH);
+				assert(current.find(":\tfile 3\n") != std::string::npos && current.find(":\tfile 2\n") == std::string::npos);
+				assert(readArchive(archivePaths[0]).find(":\tfile 2\n") != std::string::npos);
+				assert(readArchive(archivePaths[1]).find(":\tfile 1\n") != std::string::npos);
+				assert(!std::ifstream(archivePaths[2]).is_open() && !std::ifstream(std::string(FILE_PATH) + ".1").is_open());
+
+				std::remove(FILE_PATH);
+				for (const std::string& archivePath : archivePaths)
+				{
+					std::remove(archivePath.c_str());
+				}
+			}
+
+			{
+				// every message from every thread is either written or counted as dropped or suppressed
+				constexpr size_t THREAD_COUNT = 4ul;
+				constexpr size_t MESSAGE_COUNT = 500ul;
+
+				LogQueue& queue = LogQueue::GetInstance();
+				Log::Flush();
+				size_t writtenCount = queue.GetWrittenCount();
+				uint64_t droppedCount = queue.GetDroppedCount();
+				uint64_t suppressedCount = queue.GetSuppressedCount();
+
+				std::vector<std::thread> threads;
+				for (size_t t = 0; t < THREAD_COUNT; ++t)
+				{
+					threads.emplace_back([t]()
+						{
+							for (size_t i = 0; i < MESSAGE_COUNT; ++i)
+							{
+								LOGDFMT(eLogChannel::CORE, "thread {} message {}", t, i);
+							}
+						});
+				}
+
+				for (std::thread& thread : threads)
+				{
+					thread.join();
+				}
+
+				Log::Flush();
+				size_t logged = (queue.GetWrittenCount() - writtenCount) + static_cast<size_t>(queue.GetDroppedCount() - droppedCount)
+					+ static_cast<size_t>(queue.GetSuppressedCount() - suppressedCount);
+				assert(logged == THREAD_COUNT * MESSAGE_COUNT);
+			}
+
+			{
+				// without the log thread messages are written right away, and it can be started again
+				Log::Destroy();
+				LOGD(eLogChannel::CORE, "written synchronously");
+				WLOGDF(eLogChannel::CORE, L"wide %ls", L"message");
+				Log::Initialize();
 			}
 
-			std::cout << "\033[1;3" << color << 'm' << buffer << fileName << "/" << functionName << "/line:" << lineNumber << " :\t" << message << "\033[0m" << std::endl;
+			LOGD(eLogChannel::CORE, "======Log Test Success======");
+			Log::Flush();
 		}
 	}
+#endif // CAVE_BUILD_DEBUG
 } // namespace cave
-#endif
\ No newline at end of file
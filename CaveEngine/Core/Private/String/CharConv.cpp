@@ -0,0 +1,303 @@
+/*!
+ * Copyright (c) 2021 SWTube. All rights reserved.
+ * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
+ */
+
+#include <charconv>
+
+#include "Assertion/Assert.h"
+#include "Debug/Log.h"
+#include "String/CharConv.h"
+
+#ifdef CAVE_BUILD_DEBUG
+#include <cmath>
+#include <cstdio>
+#include <random>
+#endif // CAVE_BUILD_DEBUG
+
+/*
+ * Floats go through the standard library: both the MSVC STL and libstdc++ implement std::to_chars with Ryu
+ * and std::from_chars with correctly rounded parsing, which is as fast as a shortest round-trip gets.
+ */
+namespace cave
+{
+	namespace
+	{
+		eCharConvError toCharConvError(std::errc error)
+		{
+			if (error == std::errc())
+			{
+				return eCharConvError::NONE;
+			}
+
+			switch (error)
+			{
+			case std::errc::value_too_large:
+				return eCharConvError::BUFFER_TOO_SMALL;
+			case std::errc::result_out_of_range:
+				return eCharConvError::OUT_OF_RANGE;
+			default:
+				return eCharConvError::INVALID_ARGUMENT;
+			}
+		}
+
+		std::chars_format toCharsFormat(eFloatFormat format)
+		{
+			switch (format)
+			{
+			case eFloatFormat::FIXED:
+				return std::chars_format::fixed;
+			case eFloatFormat::SCIENTIFIC:
+				return std::chars_format::scientific;
+			case eFloatFormat::GENERAL:
+				return std::chars_format::general;
+			default:
+				assert(false);
+				return std::chars_format::general;
+			}
+		}
+
+		template <typename T>
+		ToCharsResult toCharsFloat(char* first, char* last, T value, eFloatFormat format)
+		{
+			std::to_chars_result result = format == eFloatFormat::SHORTEST ? std::to_chars(first, last, value) : std::to_chars(first, last, value, toCharsFormat(format));
+
+			return ToCharsResult{ result.ptr, toCharConvError(result.ec) };
+		}
+
+		template <typename T>
+		ToCharsResult toCharsFloat(char* first, char* last, T value, eFloatFormat format, int32_t precision)
+		{
+			if (format == eFloatFormat::SHORTEST || precision < 0)
+			{
+				return toCharsFloat(first, last, value, format);
+			}
+
+			std::to_chars_result result = std::to_chars(first, last, value, toCharsFormat(format), precision);
+
+			return ToCharsResult{ result.ptr, toCharConvError(result.ec) };
+		}
+
+		template <typename T>
+		FromCharsResult fromCharsFloat(const char* first, const char* last, T& outValue)
+		{
+			std::from_chars_result result = std::from_chars(first, last, outValue, std::chars_format::general);
+
+			return FromCharsResult{ result.ptr, toCharConvError(result.ec) };
+		}
+	}
+
+	ToCharsResult ToChars(char* first, char* last, float value, eFloatFormat format)
+	{
+		return toCharsFloat(first, last, value, format);
+	}
+
+	ToCharsResult ToChars(char* first, char* last, double value, eFloatFormat format)
+	{
+		return toCharsFloat(first, last, value, format);
+	}
+
+	ToCharsResult ToChars(char* first, char* last, float value, eFloatFormat format, int32_t precision)
+	{
+		return toCharsFloat(first, last, value, format, precision);
+	}
+
+	ToCharsResult ToChars(char* first, char* last, double value, eFloatFormat format, int32_t precision)
+	{
+		return toCharsFloat(first, last, value, format, precision);
+	}
+
+	FromCharsResult FromChars(const char* first, const char* last, float& outValue)
+	{
+		return fromCharsFloat(first, last, outValue);
+	}
+
+	FromCharsResult FromChars(const char* first, const char* last, double& outValue)
+	{
+		return fromCharsFloat(first, last, outValue);
+	}
+
+#ifdef CAVE_BUILD_DEBUG
+	namespace CharConvTest
+	{
+		void Main()
+		{
+			LOGD(eLogChannel::CORE_STRING, "======CharConv Test======");
+			Integer();
+			Float();
+			LOGD(eLogChannel::CORE_STRING, "======CharConv Test Success======");
+		}
+
+		void Integer()
+		{
+			char buffer[MAX_INTEGER_CHAR_COUNT];
+			char* last = buffer + MAX_INTEGER_CHAR_COUNT;
+
+			auto toString = [&](auto value, uint32_t base)
+				{
+					ToCharsResult result = ToChars(buffer, last, value, base);
+					assert(result.Error == eCharConvError::NONE);
+					return StringView(buffer, static_cast<size_t>(result.End - buffer));
+				};
+
+			{
+				assert(toString(0, 10u) == "0");
+				assert(toString(7, 10u) == "7");
+				assert(toString(42, 10u) == "42");
+				assert(toString(-100, 10u) == "-100");
+				assert(toString(1234567, 10u) == "1234567");
+				assert(toString(std::numeric_limits<int8_t>::min(), 10u) == "-128");
+				assert(toString(std::numeric_limits<int32_t>::min(), 10u) == "-2147483648");
+				assert(toString(std::numeric_limits<int64_t>::min(), 10u) == "-9223372036854775808");
+				assert(toString(std::numeric_limits<uint64_t>::max(), 10u) == "18446744073709551615");
+				assert(toString(255u, 16u) == "ff");
+				assert(toString(-255, 16u) == "-ff");
+				assert(toString(5u, 2u) == "101");
+				assert(toString(std::numeric_limits<uint64_t>::max(), 2u).GetLength() == 64ul);
+				assert(toString(8u, 8u) == "10");
+				assert(toString(35u, 36u) == "z");
+				assert(toString(100u, 3u) == "10201");
+			}
+
+			{
+				// never writes past last
+				char small[3];
+				assert(ToChars(small, small + 3, 1000).Error == eCharConvError::BUFFER_TOO_SMALL);
+				assert(ToChars(small, small + 3, -100).Error == eCharConvError::BUFFER_TOO_SMALL);
+				assert(ToChars(small, small + 3, 0xffffu, 16u).Error == eCharConvError::BUFFER_TOO_SMALL);
+				assert(ToChars(small, small + 3, 999).End == small + 3);
+			}
+
+			{
+				auto parse = [](StringView s, auto& value)
+					{
+						return FromChars(s, value);
+					};
+
+				int32_t i32 = 0;
+				assert(parse("12345", i32).Error == eCharConvError::NONE && i32 == 12345);
+				assert(parse("-2147483648", i32).Error == eCharConvError::NONE && i32 == std::numeric_limits<int32_t>::min());
+				assert(parse("2147483648", i32).Error == eCharConvError::OUT_OF_RANGE && i32 == std::numeric_limits<int32_t>::min());
+				assert(parse("+1", i32).Error == eCharConvError::INVALID_ARGUMENT);
+				assert(parse(" 1", i32).Error == eCharConvError::INVALID_ARGUMENT);
+				assert(parse("-", i32).Error == eCharConvError::INVALID_ARGUMENT);
+
+				StringView trailing("42px");
+				FromCharsResult result = parse(trailing, i32);
+				assert(result.Error == eCharConvError::NONE && i32 == 42 && result.End == trailing.GetData() + 2);
+
+				uint32_t u32 = 0u;
+				assert(parse("-1", u32).Error == eCharConvError::INVALID_ARGUMENT);
+				assert(parse("4294967295", u32).Error == eCharConvError::NONE && u32 == std::numeric_limits<uint32_t>::max());
+
+				uint64_t u64 = 0ull;
+				assert(parse("18446744073709551615", u64).Error == eCharConvError::NONE && u64 == std::numeric_limits<uint64_t>::max());
+				assert(parse("18446744073709551616", u64).Error == eCharConvError::OUT_OF_RANGE);
+				assert(parse("0000000000000000000000000001", u64).Error == eCharConvError::NONE && u64 == 1ull);
+				assert(parse("123456789012345678901234567890", u64).Error == eCharConvError::OUT_OF_RANGE);
+
+				int64_t i64 = 0;
+				assert(parse("-9223372036854775808", i64).Error == eCharConvError::NONE && i64 == std::numeric_limits<int64_t>::min());
+				assert(parse("9223372036854775808", i64).Error == eCharConvError::OUT_OF_RANGE);
+
+				uint8_t u8 = 0u;
+				assert(parse("255", u8).Error == eCharConvError::NONE && u8 == 255u);
+				assert(parse("256", u8).Error == eCharConvError::OUT_OF_RANGE);
+
+				StringView hex("DeadBeef");
+				assert(FromChars(hex.GetData(), hex.GetData() + hex.GetLength(), u32, 16u).Error == eCharConvError::NONE && u32 == 0xdeadbeefu);
+			}
+
+			{
+				// the eight digit path has to agree with the scalar one everywhere
+				std::mt19937_64 engine(36u);
+				for (uint32_t i = 0u; i < 100000u; ++i)
+				{
+					int64_t value = static_cast<int64_t>(engine() >> (engine() % 64u));
+					if (engine() & 1u)
+					{
+						value = -value;
+					}
+
+					char text[MAX_INTEGER_CHAR_COUNT];
+					ToCharsResult written = ToChars(text, text + MAX_INTEGER_CHAR_COUNT, value);
+					assert(written.Error == eCharConvError::NONE);
+
+					char expected[MAX_INTEGER_CHAR_COUNT + 1ul];
+					std::snprintf(expected, sizeof(expected), "%lld", static_cast<long long>(value));
+					assert(StringView(text, static_cast<size_t>(written.End - text)) == StringView(expected));
+
+					int64_t parsed = 0;
+					FromCharsResult read = FromChars(text, written.End, parsed);
+					assert(read.Error == eCharConvError::NONE && read.End == written.End && parsed == value);
+				}
+			}
+		}
+
+		void Float()
+		{
+			char buffer[MAX_FLOAT_CHAR_COUNT];
+			char* last = buffer + MAX_FLOAT_CHAR_COUNT;
+
+			auto toString = [&](auto value)
+				{
+					ToCharsResult result = ToChars(buffer, last, value);
+					assert(result.Error == eCharConvError::NONE);
+					return StringView(buffer, static_cast<size_t>(result.End - buffer));
+				};
+
+			{
+				assert(toString(0.0) == "0");
+				assert(toString(-0.0) == "-0");
+				assert(toString(0.1) == "0.1");
+				assert(toString(0.1f) == "0.1");
+				assert(toString(1.5) == "1.5");
+				assert(toString(100.0) == "100");
+				assert(toString(1e21) == "1e+21");
+				assert(toString(-2.2250738585072014e-308).GetLength() <= MAX_FLOAT_CHAR_COUNT);
+				assert(toString(std::numeric_limits<double>::infinity()) == "inf");
+			}
+
+			{
+				ToCharsResult result = ToChars(buffer, last, 3.14159, eFloatFormat::FIXED, 2);
+				assert(StringView(buffer, static_cast<size_t>(result.End - buffer)) == "3.14");
+				result = ToChars(buffer, last, 1500.0, eFloatFormat::SCIENTIFIC, 1);
+				assert(StringView(buffer, static_cast<size_t>(result.End - buffer)) == "1.5e+03");
+			}
+
+			{
+				double value = 0.0;
+				assert(FromChars("2.5", value).Error == eCharConvError::NONE && value == 2.5);
+				assert(FromChars("-1e3", value).Error == eCharConvError::NONE && value == -1000.0);
+				assert(FromChars(".5", value).Error == eCharConvError::NONE && value == 0.5);
+				assert(FromChars("x", value).Error == eCharConvError::INVALID_ARGUMENT);
+				assert(FromChars("1e400", value).Error == eCharConvError::OUT_OF_RANGE);
+
+				float single = 0.0f;
+				assert(FromChars("0.1", single).Error == eCharConvError::NONE && single == 0.1f);
+			}
+
+			{
+				// shortest output reads back to the same bits
+				std::mt19937_64 engine(36u);
+				for (uint32_t i = 0u; i < 100000u; ++i)
+				{
+					double value = std::bit_cast<double>(engine());
+					if (!std::isfinite(value))
+					{
+						continue;
+					}
+
+					ToCharsResult written = ToChars(buffer, last, value);
+					assert(written.Error == eCharConvError::NONE);
+
+					double parsed = 0.0;
+					FromCharsResult read = FromChars(buffer, written.End, parsed);
+					assert(read.Error == eCharConvError::NONE && read.End == written.End);
+					assert(std::bit_cast<uint64_t>(parsed) == std::bit_cast<uint64_t>(value));
+				}
+			}
+		}
+	}
+#endif // CAVE_BUILD_DEBUG
+}
@@ -0,0 +1,520 @@
+/*!
+ * Copyright (c) 2021 SWTube. All rights reserved.
+ * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
+ */
+
+#include <cstring>
+
+#include "Assertion/Assert.h"
+#include "Debug/Log.h"
+#include "String/Format.h"
+
+#ifdef CAVE_BUILD_DEBUG
+#include <string>
+#endif // CAVE_BUILD_DEBUG
+
+namespace cave
+{
+	namespace
+	{
+		struct FormatSpec
+		{
+			char Fill = ' ';
+			char Align = '\0';
+			bool bZeroPad = false;
+			uint32_t Width = 0u;
+			int32_t Precision = -1;
+			char Type = '\0';
+		};
+
+		// widths and precisions above this are clamped, which keeps every field within a fixed stack buffer
+		constexpr uint32_t MAX_WIDTH = 256u;
+		constexpr int32_t MAX_PRECISION = 64;
+		// fixed notation of the largest double with MAX_PRECISION decimals
+		constexpr size_t MAX_FIELD_CHAR_COUNT = 400ul;
+
+		class Writer final
+		{
+		public:
+			Writer(char* buffer, size_t bufferSize)
+				: mCursor(buffer)
+				, mBegin(buffer)
+				, mEnd(bufferSize != 0ul ? buffer + bufferSize - 1ul : buffer)
+			{
+			}
+
+			void Append(const char* s, size_t length)
+			{
+				size_t remaining = static_cast<size_t>(mEnd - mCursor);
+				if (length > remaining)
+				{
+					length = remaining;
+					mbTruncated = true;
+				}
+
+				std::memcpy(mCursor, s, length);
+				mCursor += length;
+			}
+
+			void Append(char c, size_t count)
+			{
+				size_t remaining = static_cast<size_t>(mEnd - mCursor);
+				if (count > remaining)
+				{
+					count = remaining;
+					mbTruncated = true;
+				}
+
+				std::memset(mCursor, c, count);
+				mCursor += count;
+			}
+
+			FormatResult Finish(size_t bufferSize)
+			{
+				if (bufferSize != 0ul)
+				{
+					*mCursor = '\0';
+				}
+				else
+				{
+					mbTruncated = true;
+				}
+
+				return FormatResult{ static_cast<size_t>(mCursor - mBegin), mbTruncated };
+			}
+
+		private:
+			char* mCursor;
+			char* mBegin;
+			char* mEnd;
+			bool mbTruncated = false;
+		};
+
+		FORCEINLINE bool isDigit(char c)
+		{
+			return c >= '0' && c <= '9';
+		}
+
+		/*
+		 * Reads a non-negative decimal number at [cursor, last), clamped to max.
+		 */
+		uint32_t readNumber(const char*& cursor, const char* last, uint32_t max)
+		{
+			uint32_t value = 0u;
+			while (cursor != last && isDigit(*cursor))
+			{
+				value = value * 10u + static_cast<uint32_t>(*cursor - '0');
+				if (value > max)
+				{
+					value = max;
+				}
+				++cursor;
+			}
+
+			return value;
+		}
+
+		/*
+		 * Parses [fill]align, 0, width, .precision and type from [cursor, last), the part of a field after ':'.
+		 */
+		bool parseSpec(const char* cursor, const char* last, FormatSpec& outSpec)
+		{
+			auto isAlign = [](char c)
+				{
+					return c == '<' || c == '>' || c == '^';
+				};
+
+			if (last - cursor >= 2 && isAlign(cursor[1]) && cursor[0] != '{' && cursor[0] != '}')
+			{
+				outSpec.Fill = cursor[0];
+				outSpec.Align = cursor[1];
+				cursor += 2;
+			}
+			else if (cursor != last && isAlign(*cursor))
+			{
+				outSpec.Align = *cursor++;
+			}
+
+			if (cursor != last && *cursor == '0')
+			{
+				outSpec.bZeroPad = true;
+				++cursor;
+			}
+
+			outSpec.Width = readNumber(cursor, last, MAX_WIDTH);
+
+			if (cursor != last && *cursor == '.')
+			{
+				++cursor;
+				if (cursor == last || !isDigit(*cursor))
+				{
+					return false;
+				}
+				outSpec.Precision = static_cast<int32_t>(readNumber(cursor, last, static_cast<uint32_t>(MAX_PRECISION)));
+			}
+
+			if (cursor != last)
+			{
+				outSpec.Type = *cursor++;
+			}
+
+			return cursor == last;
+		}
+
+		/*
+		 * Writes body padded to the field width. Zero padding goes between the sign or base prefix and the digits.
+		 */
+		void writePadded(Writer& writer, const FormatSpec& spec, const char* body, size_t length, char defaultAlign, size_t prefixLength = 0ul)
+		{
+			size_t padding = spec.Width > length ? spec.Width - length : 0ul;
+			if (padding == 0ul)
+			{
+				writer.Append(body, length);
+				return;
+			}
+
+			if (spec.bZeroPad && spec.Align == '\0')
+			{
+				writer.Append(body, prefixLength);
+				writer.Append('0', padding);
+				writer.Append(body + prefixLength, length - prefixLength);
+				return;
+			}
+
+			char align = spec.Align != '\0' ? spec.Align : defaultAlign;
+			size_t before = align == '>' ? padding : (align == '^' ? padding / 2ul : 0ul);
+			writer.Append(spec.Fill, before);
+			writer.Append(body, length);
+			writer.Append(spec.Fill, padding - before);
+		}
+
+		bool writeInteger(Writer& writer, const FormatSpec& spec, const FormatArgument& argument)
+		{
+			uint32_t base = 10u;
+			const char* prefix = "";
+			switch (spec.Type)
+			{
+			case '\0':
+			case 'd':
+				break;
+			case 'b':
+				base = 2u;
+				break;
+			case 'o':
+				base = 8u;
+				break;
+			case 'x':
+			case 'X':
+				base = 16u;
+				break;
+			case 'p':
+				base = 16u;
+				prefix = "0x";
+				break;
+			default:
+				return false;
+			}
+
+			char field[MAX_INTEGER_CHAR_COUNT + 2ul];
+			char* last = field + sizeof(field);
+
+			size_t prefixLength = std::strlen(prefix);
+			std::memcpy(field, prefix, prefixLength);
+
+			ToCharsResult result = argument.GetType() == FormatArgument::eType::INT
+				? ToChars(field + prefixLength, last, argument.GetInt(), base)
+				: ToChars(field + prefixLength, last, argument.GetUint(), base);
+			assert(result.Error == eCharConvError::NONE);
+
+			if (spec.Type == 'X')
+			{
+				for (char* c = field; c != result.End; ++c)
+				{
+					if (*c >= 'a' && *c <= 'f')
+					{
+						*c = static_cast<char>(*c - 'a' + 'A');
+					}
+				}
+			}
+
+			if (field[prefixLength] == '-')
+			{
+				// sign before any zero padding
+				++prefixLength;
+			}
+
+			writePadded(writer, spec, field, static_cast<size_t>(result.End - field), '>', prefixLength);
+
+			return true;
+		}
+
+		template <typename T>
+		bool writeFloat(Writer& writer, const FormatSpec& spec, T value)
+		{
+			eFloatFormat format = eFloatFormat::SHORTEST;
+			switch (spec.Type)
+			{
+			case '\0':
+				format = spec.Precision >= 0 ? eFloatFormat::GENERAL : eFloatFormat::SHORTEST;
+				break;
+			case 'f':
+				format = eFloatFormat::FIXED;
+				break;
+			case 'e':
+				format = eFloatFormat::SCIENTIFIC;
+				break;
+			case 'g':
+				format = eFloatFormat::GENERAL;
+				break;
+			default:
+				return false;
+			}
+
+			// std::format defaults to 6 digits once a type is given
+			int32_t precision = spec.Precision;
+			if (precision < 0 && spec.Type != '\0')
+			{
+				precision = 6;
+			}
+
+			char field[MAX_FIELD_CHAR_COUNT];
+			ToCharsResult result = ToChars(field, field + MAX_FIELD_CHAR_COUNT, value, format, precision);
+			assert(result.Error == eCharConvError::NONE);
+
+			writePadded(writer, spec, field, static_cast<size_t>(result.End - field), '>', field[0] == '-' ? 1ul : 0ul);
+
+			return true;
+		}
+
+		bool writeArgument(Writer& writer, const FormatSpec& spec, const FormatArgument& argument)
+		{
+			switch (argument.GetType())
+			{
+			case FormatArgument::eType::BOOL:
+				if (spec.Type == '\0' || spec.Type == 's')
+				{
+					StringView text = argument.GetUint() != 0ull ? StringView("true", 4ul) : StringView("false", 5ul);
+					writePadded(writer, spec, text.GetData(), text.GetLength(), '<');
+					return true;
+				}
+				return writeInteger(writer, spec, argument);
+			case FormatArgument::eType::CHAR:
+				if (spec.Type == '\0' || spec.Type == 'c')
+				{
+					char c = static_cast<char>(argument.GetUint());
+					writePadded(writer, spec, &c, 1ul, '<');
+					return true;
+				}
+				return writeInteger(writer, spec, argument);
+			case FormatArgument::eType::INT:
+			case FormatArgument::eType::UINT:
+				return writeInteger(writer, spec, argument);
+			case FormatArgument::eType::FLOAT:
+				return writeFloat(writer, spec, argument.GetFloat());
+			case FormatArgument::eType::DOUBLE:
+				return writeFloat(writer, spec, argument.GetDouble());
+			case FormatArgument::eType::STRING:
+			{
+				if (spec.Type != '\0' && spec.Type != 's')
+				{
+					return false;
+				}
+
+				// precision is the maximum number of characters
+				StringView text = argument.GetString();
+				size_t length = spec.Precision >= 0 && static_cast<size_t>(spec.Precision) < text.GetLength() ? static_cast<size_t>(spec.Precision) : text.GetLength();
+				writePadded(writer, spec, text.GetData(), length, '<');
+				return true;
+			}
+			case FormatArgument::eType::POINTER:
+			{
+				if (spec.Type != '\0' && spec.Type != 'p')
+				{
+					return false;
+				}
+
+				FormatSpec pointerSpec = spec;
+				pointerSpec.Type = 'p';
+				return writeInteger(writer, pointerSpec, FormatArgument(reinterpret_cast<uintptr_t>(argument.GetPointer())));
+			}
+			default:
+				assert(false);
+				return false;
+			}
+		}
+	}
+
+	FormatResult VFormat(char* buffer, size_t bufferSize, StringView format, const FormatArgument* arguments, size_t argumentCount)
+	{
+		assert(buffer != nullptr || bufferSize == 0ul);
+
+		Writer writer(buffer, bufferSize);
+
+		const char* cursor = format.GetData();
+		const char* last = cursor + format.GetLength();
+		size_t nextArgument = 0ul;
+
+		while (cursor != last)
+		{
+			// copy everything up to the next brace in one go
+			const char* brace = cursor;
+			while (brace != last && *brace != '{' && *brace != '}')
+			{
+				++brace;
+			}
+			writer.Append(cursor, static_cast<size_t>(brace - cursor));
+			cursor = brace;
+
+			if (cursor == last)
+			{
+				break;
+			}
+
+			if (cursor + 1 != last && cursor[1] == *cursor)
+			{
+				// {{ or }}
+				writer.Append(cursor, 1ul);
+				cursor += 2;
+				continue;
+			}
+
+			if (*cursor == '}')
+			{
+				// a lone closing brace is kept
+				writer.Append(cursor, 1ul);
+				++cursor;
+				continue;
+			}
+
+			const char* fieldBegin = cursor;
+			const char* fieldEnd = cursor + 1;
+			while (fieldEnd != last && *fieldEnd != '}' && *fieldEnd != '{')
+			{
+				++fieldEnd;
+			}
+
+			if (fieldEnd == last || *fieldEnd == '{')
+			{
+				// unterminated, copy the brace and carry on after it
+				writer.Append(fieldBegin, 1ul);
+				cursor = fieldBegin + 1;
+				continue;
+			}
+
+			const char* field = fieldBegin + 1;
+			size_t argumentIndex = nextArgument;
+			if (field != fieldEnd && isDigit(*field))
+			{
+				argumentIndex = readNumber(field, fieldEnd, 0xffffu);
+			}
+			else
+			{
+				++nextArgument;
+			}
+
+			FormatSpec spec;
+			bool bValid = argumentIndex < argumentCount;
+			if (bValid && field != fieldEnd)
+			{
+				bValid = *field == ':' && parseSpec(field + 1, fieldEnd, spec);
+			}
+
+			if (!bValid || !writeArgument(writer, spec, arguments[argumentIndex]))
+			{
+				writer.Append(fieldBegin, static_cast<size_t>(fieldEnd + 1 - fieldBegin));
+			}
+
+			cursor = fieldEnd + 1;
+		}
+
+		return writer.Finish(bufferSize);
+	}
+
+#ifdef CAVE_BUILD_DEBUG
+	namespace FormatTest
+	{
+		void Main()
+		{
+			LOGD(eLogChannel::CORE_STRING, "======Format Test======");
+
+			char buffer[128];
+			auto format = [&buffer](StringView text, const auto&... args)
+				{
+					FormatResult result = Format(buffer, sizeof(buffer), text, args...);
+					assert(result.Length == std::strlen(buffer));
+					return StringView(buffer, result.Length);
+				};
+
+			{
+				assert(format("") == "");
+				assert(format("plain text") == "plain text");
+				assert(format("{{}} {{{}}}", 1) == "{} {1}");
+				assert(format("{} + {} = {}", 1, 2u, 3ll) == "1 + 2 = 3");
+				assert(format("{1} {0} {1}", "a", "b") == "b a b");
+				assert(format("{} {} {}", true, false, 'c') == "true false c");
+				assert(format("{}", static_cast<int8_t>(-5)) == "-5");
+				assert(format("{}", static_cast<uint8_t>(200)) == "200");
+				assert(format("{}", eLogChannel::CORE_STRING) == "165");
+			}
+
+			{
+				std::string standard("std");
+				StringView view("view");
+				const char* nullString = nullptr;
+				assert(format("{} {} {} {}", "literal", standard, view, nullString) == "literal std view (null)");
+				assert(format("[{:>6}] [{:<6}] [{:^6}] [{:*^7}]", "ab", "ab", "ab", "ab") == "[    ab] [ab    ] [  ab  ] [**ab***]");
+				assert(format("{:.3}", "abcdef") == "abc");
+			}
+
+			{
+				assert(format("{:x} {:X} {:o} {:b}", 255, 255u, 8, 5) == "ff FF 10 101");
+				assert(format("{:5}|{:<5}|{:05}|{:05}", 42, 42, 42, -42) == "   42|42   |00042|-0042");
+				assert(format("{:08x}", 0xbeefu) == "0000beef");
+				assert(format("{:d}", 'A') == "65");
+
+				int value = 0;
+				assert(format("{}", &value).StartsWith("0x"));
+				assert(format("{:p}", static_cast<void*>(nullptr)) == "0x0");
+			}
+
+			{
+				assert(format("{}", 0.1) == "0.1");
+				assert(format("{}", 0.1f) == "0.1");
+				assert(format("{}", -1.5) == "-1.5");
+				assert(format("{}", 1e21) == "1e+21");
+				assert(format("{:.2f}", 3.14159) == "3.14");
+				assert(format("{:f}", 1.0) == "1.000000");
+				assert(format("{:.3e}", 1234.5) == "1.234e+03");
+				assert(format("{:.3}", 1234.5) == "1.23e+03");
+				assert(format("{:8.2f}|{:08.2f}", 3.14159, -3.14159) == "    3.14|-0003.14");
+				assert(format("{}", std::numeric_limits<double>::infinity()) == "inf");
+			}
+
+			{
+				// malformed fields are written as is
+				assert(format("{} {}", 1) == "1 {}");
+				assert(format("{:q}", 1) == "{:q}");
+				assert(format("{:.}", 1.0) == "{:.}");
+				assert(format("{", 1) == "{");
+				assert(format("a}b", 1) == "a}b");
+				assert(format("{5}", 1) == "{5}");
+				assert(format("{:s}", 1.0) == "{:s}");
+			}
+
+			{
+				char small[8];
+				FormatResult result = Format(small, sizeof(small), "{} {}", "truncated", 12345);
+				assert(result.bTruncated && result.Length == 7ul && std::strcmp(small, "truncat") == 0);
+
+				result = Format(small, sizeof(small), "{}", 1234567);
+				assert(!result.bTruncated && std::strcmp(small, "1234567") == 0);
+
+				result = Format(small, 0ul, "{}", 1);
+				assert(result.bTruncated && result.Length == 0ul);
+			}
+
+			LOGD(eLogChannel::CORE_STRING, "======Format Test Success======");
+		}
+	}
+#endif // CAVE_BUILD_DEBUG
+}
@@ -0,0 +1,347 @@
+/*!
+ * Copyright (c) 2021 SWTube. All rights reserved.
+ * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
+ */
+
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+#include "Assertion/Assert.h"
+#include "Debug/Log.h"
+#include "String/Name.h"
+
+#ifdef CAVE_BUILD_DEBUG
+#include <thread>
+#endif // CAVE_BUILD_DEBUG
+
+namespace cave
+{
+	namespace
+	{
+		struct NameEntry
+		{
+			const char* String;
+			uint32_t Length;
+			uint32_t Hash;
+		};
+
+		/*
+		 * Global storage behind Name.
+		 * Entries live in fixed-size blocks that never move, so an id can be resolved without taking the lock.
+		 * Lookups by string go through an open addressing table of ids guarded by a reader-writer lock.
+		 */
+		class NameTable final
+		{
+		public:
+			NameTable(const NameTable&) = delete;
+			NameTable& operator=(const NameTable&) = delete;
+
+			static NameTable& GetInstance()
+			{
+				static NameTable msInstance;
+				return msInstance;
+			}
+
+			uint32_t Intern(const char* s, size_t length, uint32_t hash);
+			uint32_t Find(const char* s, size_t length, uint32_t hash) const;
+			const NameEntry& GetEntry(uint32_t id) const;
+
+		private:
+			NameTable();
+
+			uint32_t findId(const char* s, size_t length, uint32_t hash) const;
+			void insertSlot(uint32_t id, uint32_t hash);
+			const char* copyString(const char* s, size_t length);
+
+			static constexpr size_t ENTRIES_PER_BLOCK = 4096ul;
+			static constexpr size_t MAX_ENTRY_BLOCK_COUNT = 1024ul;
+			static constexpr size_t STRING_BLOCK_SIZE = 64ul * 1024ul;
+			static constexpr size_t INITIAL_SLOT_COUNT = 1024ul;
+
+			mutable std::shared_mutex mMutex;
+
+			std::unique_ptr<NameEntry[]> mEntryBlocks[MAX_ENTRY_BLOCK_COUNT];
+			uint32_t mEntryCount = 0u;
+
+			// id of each occupied slot, NONE_ID if empty. The slot count is a power of two.
+			std::vector<uint32_t> mSlots;
+
+			std::vector<std::unique_ptr<char[]>> mStringBlocks;
+			char* mStringCursor = nullptr;
+			size_t mStringRemaining = 0ul;
+		};
+
+		NameTable::NameTable()
+			: mSlots(INITIAL_SLOT_COUNT, Name::NONE_ID)
+		{
+			// id 0 is the empty string
+			mEntryBlocks[0] = std::make_unique<NameEntry[]>(ENTRIES_PER_BLOCK);
+			mEntryBlocks[0][0] = NameEntry{ "", 0u, GetNameHash("", 0ul) };
+			mEntryCount = 1u;
+		}
+
+		uint32_t NameTable::Intern(const char* s, size_t length, uint32_t hash)
+		{
+			if (length == 0ul)
+			{
+				return Name::NONE_ID;
+			}
+
+			{
+				std::shared_lock<std::shared_mutex> lock(mMutex);
+				uint32_t id = findId(s, length, hash);
+				if (id != Name::NONE_ID)
+				{
+					return id;
+				}
+			}
+
+			std::unique_lock<std::shared_mutex> lock(mMutex);
+
+			// another thread may have interned it in between
+			uint32_t id = findId(s, length, hash);
+			if (id != Name::NONE_ID)
+			{
+				return id;
+			}
+
+			assert(mEntryCount < ENTRIES_PER_BLOCK * MAX_ENTRY_BLOCK_COUNT);
+
+			id = mEntryCount;
+			size_t block = id / ENTRIES_PER_BLOCK;
+			if (mEntryBlocks[block] == nullptr)
+			{
+				mEntryBlocks[block] = std::make_unique<NameEntry[]>(ENTRIES_PER_BLOCK);
+			}
+
+			mEntryBlocks[block][id % ENTRIES_PER_BLOCK] = NameEntry{ copyString(s, length), static_cast<uint32_t>(length), hash };
+			++mEntryCount;
+
+			insertSlot(id, hash);
+
+			return id;
+		}
+
+		uint32_t NameTable::Find(const char* s, size_t length, uint32_t hash) const
+		{
+			if (length == 0ul)
+			{
+				return Name::NONE_ID;
+			}
+
+			std::shared_lock<std::shared_mutex> lock(mMutex);
+
+			return findId(s, length, hash);
+		}
+
+		const NameEntry& NameTable::GetEntry(uint32_t id) const
+		{
+			return mEntryBlocks[id / ENTRIES_PER_BLOCK][id % ENTRIES_PER_BLOCK];
+		}
+
+		uint32_t NameTable::findId(const char* s, size_t length, uint32_t hash) const
+		{
+			size_t mask = mSlots.size() - 1ul;
+			for (size_t slot = hash & mask; mSlots[slot] != Name::NONE_ID; slot = (slot + 1ul) & mask)
+			{
+				const NameEntry& entry = GetEntry(mSlots[slot]);
+				if (entry.Hash == hash && entry.Length == length && std::memcmp(entry.String, s, length) == 0)
+				{
+					return mSlots[slot];
+				}
+			}
+
+			return Name::NONE_ID;
+		}
+
+		void NameTable::insertSlot(uint32_t id, uint32_t hash)
+		{
+			// keep the load factor at or below one half
+			if (static_cast<size_t>(mEntryCount) * 2ul > mSlots.size())
+			{
+				std::vector<uint32_t> slots(mSlots.size() * 2ul, Name::NONE_ID);
+				size_t mask = slots.size() - 1ul;
+				for (uint32_t oldId : mSlots)
+				{
+					if (oldId == Name::NONE_ID)
+					{
+						continue;
+					}
+
+					size_t slot = GetEntry(oldId).Hash & mask;
+					while (slots[slot] != Name::NONE_ID)
+					{
+						slot = (slot + 1ul) & mask;
+					}
+					slots[slot] = oldId;
+				}
+
+				mSlots = std::move(slots);
+			}
+
+			size_t mask = mSlots.size() - 1ul;
+			size_t slot = hash & mask;
+			while (mSlots[slot] != Name::NONE_ID)
+			{
+				slot = (slot + 1ul) & mask;
+			}
+			mSlots[slot] = id;
+		}
+
+		const char* NameTable::copyString(const char* s, size_t length)
+		{
+			if (length + 1ul > mStringRemaining)
+			{
+				size_t blockSize = length + 1ul > STRING_BLOCK_SIZE ? length + 1ul : STRING_BLOCK_SIZE;
+				mStringBlocks.push_back(std::make_unique<char[]>(blockSize));
+				mStringCursor = mStringBlocks.back().get();
+				mStringRemaining = blockSize;
+			}
+
+			char* string = mStringCursor;
+			std::memcpy(string, s, length);
+			string[length] = '\0';
+
+			mStringCursor += length + 1ul;
+			mStringRemaining -= length + 1ul;
+
+			return string;
+		}
+	}
+
+	Name::Name(const char* s)
+		: Name(StringView(s))
+	{
+	}
+
+	Name::Name(StringView s)
+		: Name(HashedStringView(s))
+	{
+	}
+
+	Name::Name(HashedStringView s)
+		: mId(NameTable::GetInstance().Intern(s.GetView().GetData(), s.GetView().GetLength(), s.GetHash()))
+	{
+	}
+
+	Name::Name(NameLiteral literal)
+		: mId(NameTable::GetInstance().Intern(literal.GetCString(), literal.GetLength(), literal.GetHash()))
+	{
+	}
+
+	/**
+	 *
+	 * @brief Looks up an already interned name
+	 * @details Unlike the constructors, never adds s to the name table.
+	 * @return The name of s, or NAME_NONE if s has never been interned
+	 *
+	 */
+	Name Name::Find(StringView s)
+	{
+		return Find(HashedStringView(s));
+	}
+
+	Name Name::Find(HashedStringView s)
+	{
+		Name name;
+		name.mId = NameTable::GetInstance().Find(s.GetView().GetData(), s.GetView().GetLength(), s.GetHash());
+
+		return name;
+	}
+
+	const char* Name::GetCString() const
+	{
+		return NameTable::GetInstance().GetEntry(mId).String;
+	}
+
+	size_t Name::GetLength() const
+	{
+		return NameTable::GetInstance().GetEntry(mId).Length;
+	}
+
+	StringView Name::GetView() const
+	{
+		const NameEntry& entry = NameTable::GetInstance().GetEntry(mId);
+
+		return StringView(entry.String, entry.Length);
+	}
+
+#ifdef CAVE_BUILD_DEBUG
+	namespace NameTest
+	{
+		void Main()
+		{
+			LOGD(eLogChannel::CORE_STRING, "======Name Test======");
+
+			{
+				Name none;
+				assert(none.IsNone() && none == NAME_NONE);
+				assert(Name("") == NAME_NONE);
+				assert(std::strcmp(none.GetCString(), "") == 0);
+			}
+
+			{
+				std::string idle("Idle");
+				Name fromString(idle);
+				Name fromCString("Idle");
+				Name fromLiteral("Idle"_name);
+				assert(fromString == fromCString && fromCString == fromLiteral);
+				assert(std::strcmp(fromString.GetCString(), "Idle") == 0);
+				assert(fromString.GetLength() == 4ul);
+				assert(Name("Run") != fromString);
+
+				static_assert(NameLiteral("Idle").GetHash() == GetNameHash("Idle", 4ul));
+			}
+
+			{
+				assert(Name::Find("NameTest never interns this").IsNone());
+				Name interned("NameTest interns this");
+				assert(Name::Find("NameTest interns this") == interned);
+
+				// views need not be null-terminated
+				StringView view("NameTest interns this and more", 21ul);
+				assert(Name::Find(view) == interned);
+				assert(Name::Find(HashedStringView(view)) == interned);
+				assert(interned.GetView() == view);
+			}
+
+			{
+				// every thread has to agree on the ids while the table grows
+				constexpr size_t THREAD_COUNT = 4ul;
+				constexpr size_t NAME_COUNT = 4096ul;
+				std::vector<std::vector<uint32_t>> ids(THREAD_COUNT, std::vector<uint32_t>(NAME_COUNT));
+				std::vector<std::thread> threads;
+				for (size_t t = 0; t < THREAD_COUNT; ++t)
+				{
+					threads.emplace_back([&ids, t]()
+						{
+							for (size_t i = 0; i < NAME_COUNT; ++i)
+							{
+								ids[t][i] = Name("NameTest_" + std::to_string(i)).GetId();
+							}
+						});
+				}
+
+				for (std::thread& thread : threads)
+				{
+					thread.join();
+				}
+
+				for (size_t i = 0; i < NAME_COUNT; ++i)
+				{
+					for (size_t t = 1; t < THREAD_COUNT; ++t)
+					{
+						assert(ids[t][i] == ids[0][i]);
+					}
+					assert(Name::Find("NameTest_" + std::to_string(i)).GetId() == ids[0][i]);
+				}
+			}
+
+			LOGD(eLogChannel::CORE_STRING, "======Name Test Success======");
+		}
+	}
+#endif // CAVE_BUILD_DEBUG
+}
@@ -0,0 +1,786 @@
+/*!
+ * Copyright (c) 2021 SWTube. All rights reserved.
+ * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+#ifdef __WIN32__
+	#define CAVE_IO_URING 0
+	#include <windows.h>
+#else
+	#include <cerrno>
+
+	#include <fcntl.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+
+	#if __has_include(<linux/io_uring.h>)
+		#define CAVE_IO_URING 1
+		#include <poll.h>
+
+		#include <linux/io_uring.h>
+		#include <sys/eventfd.h>
+		#include <sys/mman.h>
+		#include <sys/syscall.h>
+	#else
+		#define CAVE_IO_URING 0
+	#endif
+#endif
+
+#include "Assertion/Assert.h"
+#include "Debug/Log.h"
+#include "Thread/AsyncIo.h"
+#include "Thread/ThreadAffinity.h"
+
+#ifdef CAVE_BUILD_DEBUG
+#include <fstream>
+#endif // CAVE_BUILD_DEBUG
+
+namespace cave
+{
+#if CAVE_IO_URING
+	// the ring indices are shared with the kernel as plain 32-bit integers
+	static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t));
+	static_assert(std::atomic<uint32_t>::is_always_lock_free);
+
+	/*
+	 * The submission and completion rings of an io_uring, and the eventfd whose poll wakes the I/O thread up for new reads.
+	 * Only the I/O thread touches the rings, Wake() is called from any thread.
+	 */
+	class AsyncIo::Ring final
+	{
+	public:
+		// user_data of the poll on the eventfd, reads carry the address of their request
+		static constexpr uint64_t WAKE_USER_DATA = 0ull;
+
+		Ring(const Ring&) = delete;
+		Ring& operator=(const Ring&) = delete;
+
+		~Ring()
+		{
+			if (mSqes != nullptr)
+			{
+				munmap(mSqes, mSqeMapSize);
+			}
+			if (mCqMemory != nullptr && mCqMemory != mSqMemory)
+			{
+				munmap(mCqMemory, mCqMapSize);
+			}
+			if (mSqMemory != nullptr)
+			{
+				munmap(mSqMemory, mSqMapSize);
+			}
+			if (mEventFd >= 0)
+			{
+				close(mEventFd);
+			}
+			close(mRingFd);
+		}
+
+		/*Null if the kernel has no io_uring, refuses it, or is too old for IORING_OP_READ.*/
+		static std::unique_ptr<Ring> Create(uint32_t entryCount)
+		{
+			io_uring_params params;
+			std::memset(&params, 0, sizeof(params));
+			const int ringFd = static_cast<int>(syscall(__NR_io_uring_setup, entryCount, &params));
+			if (ringFd < 0)
+			{
+				return nullptr;
+			}
+
+			std::unique_ptr<Ring> ring(new Ring(ringFd));
+			// IORING_OP_READ is older than fast poll, a kernel with the feature has both
+			if ((params.features & IORING_FEAT_FAST_POLL) == 0u || !ring->map(params))
+			{
+				return nullptr;
+			}
+
+			ring->mEventFd = eventfd(0u, EFD_CLOEXEC);
+			if (ring->mEventFd < 0)
+			{
+				return nullptr;
+			}
+
+			return ring;
+		}
+
+		/*The next free submission entry, cleared. Handed to the kernel by the next Submit().*/
+		io_uring_sqe& GetSqe()
+		{
+			assert(mSqTail - mSqHead->load(std::memory_order_acquire) < mSqEntryCount);
+
+			const uint32_t index = mSqTail & mSqMask;
+			io_uring_sqe& sqe = mSqes[index];
+			std::memset(&sqe, 0, sizeof(sqe));
+			mSqArray[index] = index;
+			++mSqTail;
+			++mUnsubmittedCount;
+
+			return sqe;
+		}
+
+		/*Submits what was prepared and waits until something completed. A negative errno if the kernel refused.*/
+		int Submit()
+		{
+			mSqTailShared->store(mSqTail, std::memory_order_release);
+
+			const int result = static_cast<int>(syscall(__NR_io_uring_enter, mRingFd, mUnsubmittedCount, 1u, IORING_ENTER_GETEVENTS, nullptr, 0ul));
+			if (result < 0)
+			{
+				return -errno;
+			}
+
+			mUnsubmittedCount -= static_cast<uint32_t>(result);
+			return result;
+		}
+
+		/*Calls function(userData, result) on every completion the kernel posted.*/
+		template <typename Function>
+		void ForEachCompletion(Function&& function)
+		{
+			uint32_t head = mCqHead->load(std::memory_order_relaxed);
+			const uint32_t tail = mCqTail->load(std::memory_order_acquire);
+			for (; head != tail; ++head)
+			{
+				const io_uring_cqe& cqe = mCqes[head & mCqMask];
+				function(cqe.user_data, cqe.res);
+			}
+
+			mCqHead->store(head, std::memory_order_release);
+		}
+
+		void ArmWake()
+		{
+			io_uring_sqe& sqe = GetSqe();
+			sqe.opcode = IORING_OP_POLL_ADD;
+			sqe.fd = mEventFd;
+			sqe.poll32_events = POLLIN;
+			sqe.user_data = WAKE_USER_DATA;
+		}
+
+		/*Only the first Wake() after the I/O thread looked at the queues makes a system call.*/
+		void Wake()
+		{
+			if (!mbWakeSignaled.exchange(true, std::memory_order_seq_cst))
+			{
+				const uint64_t one = 1ull;
+				[[maybe_unused]] const ssize_t written = write(mEventFd, &one, sizeof(one));
+			}
+		}
+
+		/*Called by the I/O thread when the poll completed, before it looks at the queues.*/
+		void ConsumeWake()
+		{
+			uint64_t count = 0ull;
+			[[maybe_unused]] const ssize_t readCount = read(mEventFd, &count, sizeof(count));
+			mbWakeSignaled.store(false, std::memory_order_seq_cst);
+		}
+
+	private:
+		explicit Ring(int ringFd)
+			: mRingFd(ringFd)
+		{
+		}
+
+		bool map(const io_uring_params& params)
+		{
+			mSqMapSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+			mCqMapSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+			// both rings in one mapping
+			const bool bSingleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0u;
+			if (bSingleMap)
+			{
+				mSqMapSize = std::max(mSqMapSize, mCqMapSize);
+				mCqMapSize = mSqMapSize;
+			}
+
+			void* sqMemory = mmap(nullptr, mSqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRingFd, IORING_OFF_SQ_RING);
+			if (sqMemory == MAP_FAILED)
+			{
+				return false;
+			}
+			mSqMemory = static_cast<unsigned char*>(sqMemory);
+
+			if (bSingleMap)
+			{
+				mCqMemory = mSqMemory;
+			}
+			else
+			{
+				void* cqMemory = mmap(nullptr, mCqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRingFd, IORING_OFF_CQ_RING);
+				if (cqMemory == MAP_FAILED)
+				{
+					return false;
+				}
+				mCqMemory = static_cast<unsigned char*>(cqMemory);
+			}
+
+			mSqeMapSize = params.sq_entries * sizeof(io_uring_sqe);
+			void* sqes = mmap(nullptr, mSqeMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRingFd, IORING_OFF_SQES);
+			if (sqes == MAP_FAILED)
+			{
+				return false;
+			}
+			mSqes = static_cast<io_uring_sqe*>(sqes);
+
+			mSqHead = reinterpret_cast<std::atomic<uint32_t>*>(mSqMemory + params.sq_off.head);
+			mSqTailShared = reinterpret_cast<std::atomic<uint32_t>*>(mSqMemory + params.sq_off.tail);
+			mSqMask = *reinterpret_cast<const uint32_t*>(mSqMemory + params.sq_off.ring_mask);
+			mSqArray = reinterpret_cast<uint32_t*>(mSqMemory + params.sq_off.array);
+			mSqEntryCount = params.sq_entries;
+			mSqTail = mSqTailShared->load(std::memory_order_relaxed);
+
+			mCqHead = reinterpret_cast<std::atomic<uint32_t>*>(mCqMemory + params.cq_off.head);
+			mCqTail = reinterpret_cast<std::atomic<uint32_t>*>(mCqMemory + params.cq_off.tail);
+			mCqMask = *reinterpret_cast<const uint32_t*>(mCqMemory + params.cq_off.ring_mask);
+			mCqes = reinterpret_cast<const io_uring_cqe*>(mCqMemory + params.cq_off.cqes);
+
+			return true;
+		}
+
+		int mRingFd;
+		int mEventFd = -1;
+
+		unsigned char* mSqMemory = nullptr;
+		unsigned char* mCqMemory = nullptr;
+		io_uring_sqe* mSqes = nullptr;
+		size_t mSqMapSize = 0ul;
+		size_t mCqMapSize = 0ul;
+		size_t mSqeMapSize = 0ul;
+
+		std::atomic<uint32_t>* mSqHead = nullptr;
+		std::atomic<uint32_t>* mSqTailShared = nullptr;
+		uint32_t* mSqArray = nullptr;
+		uint32_t mSqMask = 0u;
+		uint32_t mSqEntryCount = 0u;
+		// entries are prepared here and published to mSqTailShared when submitted
+		uint32_t mSqTail = 0u;
+		uint32_t mUnsubmittedCount = 0u;
+
+		std::atomic<uint32_t>* mCqHead = nullptr;
+		std::atomic<uint32_t>* mCqTail = nullptr;
+		const io_uring_cqe* mCqes = nullptr;
+		uint32_t mCqMask = 0u;
+
+		std::atomic<bool> mbWakeSignaled = false;
+	};
+#else
+	class AsyncIo::Ring final
+	{
+	};
+#endif
+
+	bool AsyncFile::Open(const char* path)
+	{
+		Close();
+
+#ifdef __WIN32__
+		HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		LARGE_INTEGER size;
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			return false;
+		}
+		if (!GetFileSizeEx(file, &size))
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		mHandle = reinterpret_cast<intptr_t>(file);
+		mSize = static_cast<uint64_t>(size.QuadPart);
+#else
+		const int file = open(path, O_RDONLY | O_CLOEXEC);
+		struct stat status;
+		if (file < 0)
+		{
+			return false;
+		}
+		if (fstat(file, &status) != 0)
+		{
+			close(file);
+			return false;
+		}
+
+		mHandle = file;
+		mSize = static_cast<uint64_t>(status.st_size);
+#endif
+
+		return true;
+	}
+
+	void AsyncFile::Close()
+	{
+		if (mHandle == INVALID_HANDLE)
+		{
+			return;
+		}
+
+#ifdef __WIN32__
+		CloseHandle(reinterpret_cast<HANDLE>(mHandle));
+#else
+		close(static_cast<int>(mHandle));
+#endif
+		mHandle = INVALID_HANDLE;
+		mSize = 0ull;
+	}
+
+	AsyncIo::AsyncIo(uint32_t threadCount)
+	{
+#if CAVE_IO_URING
+		// one entry more for the poll that wakes the I/O thread
+		mRing = Ring::Create(RING_QUEUE_DEPTH + 1u);
+		if (mRing != nullptr)
+		{
+			mThreads.emplace_back([this]() { runRing(); });
+			return;
+		}
+		LOGI(eLogChannel::CORE_THREAD, "io_uring is not available, files are read by threads");
+#endif
+
+		if (threadCount == 0u)
+		{
+			threadCount = DEFAULT_IO_THREAD_COUNT;
+		}
+
+		mThreads.reserve(threadCount);
+		for (uint32_t i = 0u; i < threadCount; ++i)
+		{
+			mThreads.emplace_back([this, i]() { runThread(i); });
+		}
+	}
+
+	AsyncIo::~AsyncIo()
+	{
+		mbStopRequested.store(true, std::memory_order_seq_cst);
+
+#if CAVE_IO_URING
+		if (mRing != nullptr)
+		{
+			mRing->Wake();
+		}
+		else
+#endif
+		{
+			mQueuedSemaphore.Release(static_cast<uint32_t>(mThreads.size()));
+		}
+
+		for (std::thread& thread : mThreads)
+		{
+			thread.join();
+		}
+	}
+
+	void AsyncIo::Read(IoRequest& request, const AsyncFile& file, void* buffer, size_t size, uint64_t offset, eIoPriority priority, JobCounter* counter)
+	{
+		assert(request.IsDone());
+		assert(file.IsOpen());
+		assert(buffer != nullptr || size == 0ul);
+		assert(!mbStopRequested.load(std::memory_order_relaxed));
+
+		request.mHandle = file.mHandle;
+		request.mBuffer = static_cast<unsigned char*>(buffer);
+		request.mSize = size;
+		request.mOffset = offset;
+		request.mCounter = counter;
+		request.mNext = nullptr;
+		request.mByteCount = 0ul;
+		request.mError = 0;
+		request.mbDone.store(false, std::memory_order_relaxed);
+
+		if (counter != nullptr)
+		{
+			counter->add();
+		}
+
+		if (size == 0ul)
+		{
+			complete(request);
+			return;
+		}
+
+		push(request, priority);
+
+#if CAVE_IO_URING
+		if (mRing != nullptr)
+		{
+			mRing->Wake();
+			return;
+		}
+#endif
+		mQueuedSemaphore.Release();
+	}
+
+	void AsyncIo::push(IoRequest& request, eIoPriority priority)
+	{
+		const uint32_t queue = static_cast<uint32_t>(priority);
+		assert(queue < IO_PRIORITY_COUNT);
+
+		std::lock_guard<Mutex> lock(mQueueMutex);
+
+		if (mTails[queue] == nullptr)
+		{
+			mHeads[queue] = &request;
+		}
+		else
+		{
+			mTails[queue]->mNext = &request;
+		}
+		mTails[queue] = &request;
+	}
+
+	IoRequest* AsyncIo::pop()
+	{
+		std::lock_guard<Mutex> lock(mQueueMutex);
+
+		for (uint32_t queue = 0u; queue < IO_PRIORITY_COUNT; ++queue)
+		{
+			IoRequest* request = mHeads[queue];
+			if (request != nullptr)
+			{
+				mHeads[queue] = request->mNext;
+				if (mHeads[queue] == nullptr)
+				{
+					mTails[queue] = nullptr;
+				}
+
+				return request;
+			}
+		}
+
+		return nullptr;
+	}
+
+	void AsyncIo::readBlocking(IoRequest& request)
+	{
+		while (request.mByteCount < request.mSize)
+		{
+			unsigned char* buffer = request.mBuffer + request.mByteCount;
+			const size_t size = std::min(request.mSize - request.mByteCount, MAX_READ_SIZE);
+			const uint64_t offset = request.mOffset + request.mByteCount;
+
+#ifdef __WIN32__
+			// a synchronous handle reads at the offset of the OVERLAPPED, like pread()
+			OVERLAPPED overlapped = {};
+			overlapped.Offset = static_cast<DWORD>(offset);
+			overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32ull);
+			DWORD readCount = 0u;
+			if (!ReadFile(reinterpret_cast<HANDLE>(request.mHandle), buffer, static_cast<DWORD>(size), &readCount, &overlapped))
+			{
+				const DWORD error = GetLastError();
+				if (error != ERROR_HANDLE_EOF)
+				{
+					request.mError = static_cast<int32_t>(error);
+				}
+				return;
+			}
+#else
+			const ssize_t readCount = pread(static_cast<int>(request.mHandle), buffer, size, static_cast<off_t>(offset));
+			if (readCount < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+
+				request.mError = errno;
+				return;
+			}
+#endif
+
+			// the end of the file
+			if (readCount == 0)
+			{
+				return;
+			}
+
+			request.mByteCount += static_cast<size_t>(readCount);
+		}
+	}
+
+	void AsyncIo::complete(IoRequest& request)
+	{
+		// the request may be gone once it is done, the counter outlives it
+		JobCounter* counter = request.mCounter;
+		request.mbDone.store(true, std::memory_order_release);
+		if (counter != nullptr)
+		{
+			// the Tasks it resumes are submitted from this I/O thread into pools of the JobSystem, not of the thread,
+			// they may still be queued once it has exited
+			counter->release();
+		}
+	}
+
+	void AsyncIo::runRing()
+	{
+#if CAVE_IO_URING
+		SetCurrentThreadName("CaveIo");
+
+		Ring& ring = *mRing;
+		auto prepareRead = [&ring](IoRequest& request)
+			{
+				io_uring_sqe& sqe = ring.GetSqe();
+				sqe.opcode = IORING_OP_READ;
+				sqe.fd = static_cast<int>(request.mHandle);
+				sqe.addr = reinterpret_cast<uint64_t>(request.mBuffer + request.mByteCount);
+				sqe.len = static_cast<uint32_t>(std::min(request.mSize - request.mByteCount, MAX_READ_SIZE));
+				sqe.off = request.mOffset + request.mByteCount;
+				sqe.user_data = reinterpret_cast<uint64_t>(&request);
+			};
+
+		ring.ArmWake();
+		uint32_t inFlightCount = 0u;
+		while (true)
+		{
+			// read before the queues, every read queued before the stop request is still taken
+			const bool bStopping = mbStopRequested.load(std::memory_order_seq_cst);
+
+			bool bQueueEmpty = false;
+			while (inFlightCount < RING_QUEUE_DEPTH)
+			{
+				IoRequest* request = pop();
+				if (request == nullptr)
+				{
+					bQueueEmpty = true;
+					break;
+				}
+
+				prepareRead(*request);
+				++inFlightCount;
+			}
+
+			if (bStopping && bQueueEmpty && inFlightCount == 0u)
+			{
+				break;
+			}
+
+			// every read queued meanwhile goes to the kernel in this one call
+			const int result = ring.Submit();
+			if (result < 0 && result != -EINTR && result != -EAGAIN && result != -EBUSY)
+			{
+				LOGEF(eLogChannel::CORE_THREAD, "io_uring_enter failed with %d", -result);
+			}
+
+			ring.ForEachCompletion([&](uint64_t userData, int32_t readCount)
+				{
+					if (userData == Ring::WAKE_USER_DATA)
+					{
+						ring.ConsumeWake();
+						ring.ArmWake();
+						return;
+					}
+
+					IoRequest& request = *reinterpret_cast<IoRequest*>(userData);
+					if (readCount == -EINTR || readCount == -EAGAIN)
+					{
+						prepareRead(request);
+						return;
+					}
+
+					if (readCount < 0)
+					{
+						request.mError = -readCount;
+					}
+					else if (readCount > 0)
+					{
+						// a short read that did not reach the end of the file reads the rest
+						request.mByteCount += static_cast<size_t>(readCount);
+						if (request.mByteCount < request.mSize)
+						{
+							prepareRead(request);
+							return;
+						}
+					}
+
+					--inFlightCount;
+					complete(request);
+				});
+		}
+#endif
+	}
+
+	void AsyncIo::runThread(uint32_t index)
+	{
+		char name[16];
+		std::snprintf(name, sizeof(name), "CaveIo %u", index);
+		SetCurrentThreadName(name);
+
+		while (true)
+		{
+			mQueuedSemaphore.Acquire();
+
+			// only the releases of the destructor find the queues empty
+			IoRequest* request = pop();
+			if (request == nullptr)
+			{
+				return;
+			}
+
+			readBlocking(*request);
+			complete(*request);
+		}
+	}
+
+#ifdef CAVE_BUILD_DEBUG
+	namespace AsyncIoTest
+	{
+		Task<bool> readAll(AsyncIo& io, const AsyncFile& file, std::vector<unsigned char>& data)
+		{
+			data.resize(static_cast<size_t>(file.GetSize()));
+			co_return co_await io.ReadAsync(file, data.data(), data.size(), 0ull, eIoPriority::HIGH);
+		}
+
+		Task<size_t> countExpected(JobCounter& readCounter, const std::vector<unsigned char>& buffer, size_t begin, size_t end)
+		{
+			co_await readCounter;
+
+			size_t count = 0ul;
+			for (size_t i = begin; i < end; ++i)
+			{
+				count += buffer[i] == static_cast<unsigned char>(i * 7ul + i / 251ul) ? 1ul : 0ul;
+			}
+			co_return count;
+		}
+
+		void Main()
+		{
+			LOGD(eLogChannel::CORE_THREAD, "======AsyncIo Test======");
+
+			constexpr size_t CHUNK_SIZE = 4096ul;
+			constexpr size_t CHUNK_COUNT = 300ul;
+			const char* path = "AsyncIoTest.bin";
+			{
+				std::ofstream file(path, std::ios::binary);
+				for (size_t i = 0ul; i < CHUNK_SIZE * CHUNK_COUNT; ++i)
+				{
+					file.put(static_cast<char>(i * 7ul + i / 251ul));
+				}
+			}
+			auto expected = [](size_t i)
+				{
+					return static_cast<unsigned char>(i * 7ul + i / 251ul);
+				};
+
+			JobSystem jobSystem(2u);
+
+			{
+				AsyncIo io;
+				LOGDF(eLogChannel::CORE_THREAD, "reading through %s", io.IsUsingIoUring() ? "io_uring" : "threads");
+
+				AsyncFile missing;
+				assert(!missing.Open("AsyncIoTest.missing"));
+				assert(!missing.IsOpen());
+
+				AsyncFile file;
+				assert(file.Open(path));
+				assert(file.GetSize() == CHUNK_SIZE * CHUNK_COUNT);
+
+				{
+					// more reads than the ring keeps in flight, in every priority, into one caller buffer
+					std::vector<unsigned char> buffer(CHUNK_SIZE * CHUNK_COUNT);
+					std::vector<IoRequest> requests(CHUNK_COUNT);
+					JobCounter counter;
+					for (size_t i = 0ul; i < CHUNK_COUNT; ++i)
+					{
+						const size_t chunk = CHUNK_COUNT - i - 1ul;
+						io.Read(requests[chunk], file, buffer.data() + chunk * CHUNK_SIZE, CHUNK_SIZE, chunk * CHUNK_SIZE
+							, static_cast<eIoPriority>(i % IO_PRIORITY_COUNT), &counter);
+					}
+					jobSystem.Wait(counter);
+
+					for (const IoRequest& request : requests)
+					{
+						assert(request.IsSucceeded());
+					}
+					for (size_t i = 0ul; i < buffer.size(); ++i)
+					{
+						assert(buffer[i] == expected(i));
+					}
+				}
+
+				{
+					// past the end of the file, and nothing at all
+					std::vector<unsigned char> buffer(CHUNK_SIZE * 2ul);
+					IoRequest request;
+					IoRequest empty;
+					JobCounter counter;
+					io.Read(request, file, buffer.data(), buffer.size(), file.GetSize() - CHUNK_SIZE, eIoPriority::LOW, &counter);
+					io.Read(empty, file, nullptr, 0ul, 0ull, eIoPriority::LOW, &counter);
+					jobSystem.Wait(counter);
+					assert(!request.IsSucceeded());
+					assert(request.GetError() == 0);
+					assert(request.GetByteCount() == CHUNK_SIZE);
+					assert(buffer[0] == expected(file.GetSize() - CHUNK_SIZE));
+					assert(empty.IsSucceeded());
+				}
+
+				{
+					std::vector<unsigned char> data;
+					Task<bool> task = readAll(io, file, data);
+					JobCounter counter;
+					task.Start(jobSystem, &counter);
+					jobSystem.Wait(counter);
+					assert(task.GetResult());
+					assert(data.size() == CHUNK_SIZE * CHUNK_COUNT && data.back() == expected(data.size() - 1ul));
+				}
+			}
+
+			{
+				// the destructor finishes what is queued, requests are polled without a counter
+				AsyncFile file;
+				assert(file.Open(path));
+				std::vector<unsigned char> buffer(CHUNK_SIZE * CHUNK_COUNT);
+				std::vector<IoRequest> requests(CHUNK_COUNT);
+				{
+					AsyncIo io(1u);
+					for (size_t i = 0ul; i < CHUNK_COUNT; ++i)
+					{
+						io.Read(requests[i], file, buffer.data() + i * CHUNK_SIZE, CHUNK_SIZE, i * CHUNK_SIZE);
+					}
+				}
+				for (const IoRequest& request : requests)
+				{
+					assert(request.IsDone() && request.IsSucceeded());
+				}
+				assert(buffer[12345ul] == expected(12345ul));
+			}
+
+			{
+				// Tasks resumed by the last read outlive the I/O thread that submitted them
+				AsyncFile file;
+				assert(file.Open(path));
+				std::vector<unsigned char> buffer(CHUNK_SIZE * CHUNK_COUNT);
+				std::vector<IoRequest> requests(CHUNK_COUNT);
+				JobCounter readCounter;
+				std::vector<Task<size_t>> tasks;
+				JobCounter taskCounter;
+				{
+					AsyncIo io(1u);
+					for (size_t i = 0ul; i < CHUNK_COUNT; ++i)
+					{
+						io.Read(requests[i], file, buffer.data() + i * CHUNK_SIZE, CHUNK_SIZE, i * CHUNK_SIZE, eIoPriority::LOW, &readCounter);
+					}
+					for (size_t i = 0ul; i < CHUNK_COUNT; ++i)
+					{
+						tasks.push_back(countExpected(readCounter, buffer, i * CHUNK_SIZE, (i + 1ul) * CHUNK_SIZE));
+						tasks.back().Start(jobSystem, &taskCounter);
+					}
+				}
+				jobSystem.Wait(taskCounter);
+				for (Task<size_t>& task : tasks)
+				{
+					assert(task.GetResult() == CHUNK_SIZE);
+				}
+			}
+
+			std::remove(path);
+
+			LOGD(eLogChannel::CORE_THREAD, "======AsyncIo Test Success======");
+		}
+	}
+#endif // CAVE_BUILD_DEBUG
+}
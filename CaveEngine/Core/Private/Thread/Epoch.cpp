@@ -0,0 +1,391 @@
+/*!
+ * Copyright (c) 2021 SWTube. All rights reserved.
+ * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
+ */
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Assertion/Assert.h"
+#include "Debug/Log.h"
+#include "Thread/Epoch.h"
+
+#ifdef CAVE_BUILD_DEBUG
+#include <string>
+#endif // CAVE_BUILD_DEBUG
+
+namespace cave
+{
+	namespace
+	{
+		// a writer tries to free once this many objects are waiting
+		constexpr size_t COLLECT_RETIRED_COUNT = 64ul;
+
+		// a thread's epoch shifted left, the low bit set while it is inside a guard
+		constexpr uint64_t ACTIVE_FLAG = 1ull;
+
+		// one per thread that ever entered a guard, reused once the thread exits and never freed
+		struct ThreadRecord
+		{
+			std::atomic<uint64_t> State = 0ull;
+			std::atomic<bool> bInUse = true;
+			ThreadRecord* Next = nullptr;
+			// only touched by the owning thread
+			uint32_t NestCount = 0u;
+		};
+
+		struct Retired
+		{
+			void* Object;
+			Epoch::Deleter Delete;
+			void* Context;
+			uint64_t RetiredEpoch;
+		};
+
+		std::atomic<uint64_t> gEpoch = 0ull;
+		std::atomic<ThreadRecord*> gRecords = nullptr;
+
+		Mutex gRetiredMutex;
+		std::vector<Retired> gRetired;
+
+		ThreadRecord* acquireRecord()
+		{
+			for (ThreadRecord* record = gRecords.load(std::memory_order_acquire); record != nullptr; record = record->Next)
+			{
+				bool bInUse = false;
+				if (!record->bInUse.load(std::memory_order_relaxed)
+					&& record->bInUse.compare_exchange_strong(bInUse, true, std::memory_order_acquire, std::memory_order_relaxed))
+				{
+					return record;
+				}
+			}
+
+			ThreadRecord* record = new ThreadRecord();
+			ThreadRecord* head = gRecords.load(std::memory_order_relaxed);
+			do
+			{
+				record->Next = head;
+			} while (!gRecords.compare_exchange_weak(head, record, std::memory_order_release, std::memory_order_relaxed));
+
+			return record;
+		}
+
+		class ThreadRecordHolder final
+		{
+		public:
+			~ThreadRecordHolder()
+			{
+				if (mRecord != nullptr)
+				{
+					assert(mRecord->NestCount == 0u);
+					mRecord->bInUse.store(false, std::memory_order_release);
+				}
+			}
+
+			ThreadRecord& Get()
+			{
+				if (mRecord == nullptr)
+				{
+					mRecord = acquireRecord();
+				}
+
+				return *mRecord;
+			}
+
+		private:
+			ThreadRecord* mRecord = nullptr;
+		};
+
+		thread_local ThreadRecordHolder tRecord;
+
+		/*false if a thread inside a guard has not seen the current epoch yet.*/
+		bool tryAdvance()
+		{
+			uint64_t epoch = gEpoch.load(std::memory_order_seq_cst);
+			for (const ThreadRecord* record = gRecords.load(std::memory_order_acquire); record != nullptr; record = record->Next)
+			{
+				const uint64_t state = record->State.load(std::memory_order_seq_cst);
+				if ((state & ACTIVE_FLAG) != 0ull && (state >> 1ull) != epoch)
+				{
+					return false;
+				}
+			}
+
+			// a failed exchange means another thread advanced it
+			gEpoch.compare_exchange_strong(epoch, epoch + 1ull, std::memory_order_seq_cst);
+			return true;
+		}
+
+		/*Takes what can be freed out of gRetired, the deleters run after the lock is released.*/
+		void takeFreeable(std::vector<Retired>& outFreeable)
+		{
+			const uint64_t epoch = gEpoch.load(std::memory_order_acquire);
+
+			auto kept = gRetired.begin();
+			for (Retired& retired : gRetired)
+			{
+				if (retired.RetiredEpoch + 2ull <= epoch)
+				{
+					outFreeable.push_back(retired);
+				}
+				else
+				{
+					*kept++ = retired;
+				}
+			}
+			gRetired.erase(kept, gRetired.end());
+		}
+
+		void freeRetired(const std::vector<Retired>& freeable)
+		{
+			for (const Retired& retired : freeable)
+			{
+				retired.Delete(retired.Object, retired.Context);
+			}
+		}
+	}
+
+	void Epoch::enter()
+	{
+		ThreadRecord& record = tRecord.Get();
+		if (record.NestCount++ != 0u)
+		{
+			return;
+		}
+
+		// the epoch is published before it is checked again: either an advancing thread sees this one,
+		// or this one reads the advanced epoch and publishes that instead
+		uint64_t epoch = gEpoch.load(std::memory_order_relaxed);
+		while (true)
+		{
+			record.State.store((epoch << 1ull) | ACTIVE_FLAG, std::memory_order_seq_cst);
+
+			const uint64_t current = gEpoch.load(std::memory_order_seq_cst);
+			if (current == epoch)
+			{
+				break;
+			}
+			epoch = current;
+		}
+	}
+
+	void Epoch::leave()
+	{
+		ThreadRecord& record = tRecord.Get();
+		assert(record.NestCount > 0u);
+		if (--record.NestCount == 0u)
+		{
+			record.State.store(0ull, std::memory_order_release);
+		}
+	}
+
+	void Epoch::Retire(void* object, Deleter deleter, void* context)
+	{
+		assert(object != nullptr);
+		assert(deleter != nullptr);
+
+		std::vector<Retired> freeable;
+		{
+			std::lock_guard<Mutex> lock(gRetiredMutex);
+
+			gRetired.push_back({ object, deleter, context, gEpoch.load(std::memory_order_seq_cst) });
+			if (gRetired.size() < COLLECT_RETIRED_COUNT)
+			{
+				return;
+			}
+
+			tryAdvance();
+			takeFreeable(freeable);
+		}
+
+		freeRetired(freeable);
+	}
+
+	bool Epoch::Collect()
+	{
+		std::vector<Retired> freeable;
+		bool bEmpty = false;
+		{
+			std::lock_guard<Mutex> lock(gRetiredMutex);
+
+			tryAdvance();
+			takeFreeable(freeable);
+			bEmpty = gRetired.empty();
+		}
+
+		freeRetired(freeable);
+
+		return bEmpty;
+	}
+
+	void Epoch::Synchronize()
+	{
+		assert(tRecord.Get().NestCount == 0u);
+
+		// everything retired so far carries an epoch below target - 1
+		const uint64_t target = gEpoch.load(std::memory_order_seq_cst) + 2ull;
+		while (gEpoch.load(std::memory_order_seq_cst) < target)
+		{
+			if (!tryAdvance())
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		Collect();
+	}
+
+#ifdef CAVE_BUILD_DEBUG
+	namespace EpochTest
+	{
+		struct Entry
+		{
+			explicit Entry(uint32_t value)
+				: Value(value)
+				, Check(~value)
+			{
+			}
+
+			~Entry()
+			{
+				// a reader that sees these was given a freed entry
+				Value = 0xdeadbeefu;
+				Check = 0xdeadbeefu;
+			}
+
+			uint32_t Value;
+			uint32_t Check;
+		};
+
+		void Main()
+		{
+			LOGD(eLogChannel::CORE_THREAD, "======Epoch Test======");
+
+			{
+				// nested guards, and a retired object outlives the guard that may see it
+				std::atomic<uint32_t> freedCount = 0u;
+				const Epoch::Deleter countFree = [](void* object, void* context)
+				{
+					delete static_cast<Entry*>(object);
+					static_cast<std::atomic<uint32_t>*>(context)->fetch_add(1u, std::memory_order_relaxed);
+				};
+
+				Entry* entry = new Entry(1u);
+				std::atomic<bool> bEntered = false;
+				std::atomic<bool> bLeave = false;
+				std::thread reader([&]()
+					{
+						EpochGuard outer;
+						{
+							EpochGuard inner;
+						}
+						bEntered.store(true);
+						while (!bLeave.load())
+						{
+							std::this_thread::yield();
+						}
+					});
+
+				while (!bEntered.load())
+				{
+					std::this_thread::yield();
+				}
+				Epoch::Retire(entry, countFree, &freedCount);
+				assert(!Epoch::Collect());
+				assert(!Epoch::Collect());
+				assert(freedCount.load() == 0u);
+
+				bLeave.store(true);
+				reader.join();
+				Epoch::Synchronize();
+				assert(freedCount.load() == 1u);
+			}
+
+			{
+				EpochHashMap<uint32_t, uint32_t> map(2ul);
+				uint32_t value = 0u;
+				for (uint32_t i = 0u; i < 1000u; ++i)
+				{
+					assert(map.Insert(i, i * 3u));
+				}
+				assert(!map.Insert(10u, 0u));
+				assert(map.GetSize() == 1000u);
+				for (uint32_t i = 0u; i < 1000u; ++i)
+				{
+					assert(map.Find(i, value) && value == i * 3u);
+				}
+				for (uint32_t i = 0u; i < 1000u; i += 2u)
+				{
+					assert(map.Remove(i, value) && value == i * 3u);
+				}
+				assert(!map.Remove(0u, value));
+				assert(!map.Contains(0u));
+				assert(map.Contains(1u));
+
+				size_t visitCount = 0ul;
+				map.ForEach([&visitCount](uint32_t key, uint32_t data)
+					{
+						assert(key % 2u == 1u && data == key * 3u);
+						++visitCount;
+					});
+				assert(visitCount == 500ul);
+			}
+
+			{
+				// readers look entries up while a writer adds, removes and retires them
+				constexpr uint32_t KEY_COUNT = 256u;
+				constexpr uint32_t WRITE_COUNT = 20000u;
+				EpochHashMap<std::string, Entry*> map(4ul);
+				std::atomic<bool> bDone = false;
+				std::atomic<uint32_t> hitCount = 0u;
+
+				std::vector<std::thread> readers;
+				for (uint32_t i = 0u; i < 3u; ++i)
+				{
+					readers.emplace_back([&, i]()
+						{
+							uint32_t hits = 0u;
+							for (uint32_t key = i; !bDone.load(std::memory_order_relaxed); key = (key + 7u) % KEY_COUNT)
+							{
+								EpochGuard guard;
+
+								Entry* entry = nullptr;
+								if (map.Find(std::to_string(key), entry))
+								{
+									assert(entry->Check == ~entry->Value);
+									assert(entry->Value % KEY_COUNT == key);
+									++hits;
+								}
+							}
+							hitCount.fetch_add(hits);
+						});
+				}
+
+				for (uint32_t i = 0u; i < WRITE_COUNT; ++i)
+				{
+					const uint32_t key = i % KEY_COUNT;
+					Entry* entry = nullptr;
+					if (map.Remove(std::to_string(key), entry))
+					{
+						Epoch::Retire(entry);
+					}
+					map.Insert(std::to_string(key), new Entry(i));
+				}
+
+				bDone.store(true);
+				for (std::thread& reader : readers)
+				{
+					reader.join();
+				}
+
+				map.ForEach([](const std::string&, Entry* entry) { Epoch::Retire(entry); });
+				Epoch::Synchronize();
+				LOGDF(eLogChannel::CORE_THREAD, "%u lookups hit", hitCount.load());
+			}
+
+			LOGD(eLogChannel::CORE_THREAD, "======Epoch Test Success======");
+		}
+	}
+#endif // CAVE_BUILD_DEBUG
+}
@@ -0,0 +1,823 @@
+/*!
+ * Copyright (c) 2021 SWTube. All rights reserved.
+ * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+	#define CAVE_JOB_PAUSE 1
+	#include <emmintrin.h>
+#else
+	#define CAVE_JOB_PAUSE 0
+#endif
+
+#include "Assertion/Assert.h"
+#include "Debug/Log.h"
+#include "Thread/JobSystem.h"
+#include "Thread/ThreadAffinity.h"
+
+#ifdef CAVE_BUILD_DEBUG
+#include <chrono>
+#include <string>
+#endif // CAVE_BUILD_DEBUG
+
+namespace cave
+{
+	namespace
+	{
+		constexpr size_t JOB_POOL_MASK = JOB_POOL_SIZE - 1ul;
+		// a worker only holds jobs it spawned itself, so its deque never has more than its pool
+		constexpr size_t DEQUE_SIZE = JOB_POOL_SIZE;
+		constexpr size_t DEQUE_MASK = DEQUE_SIZE - 1ul;
+		constexpr size_t SHARED_QUEUE_SIZE = 4096ul;
+		constexpr size_t SHARED_QUEUE_MASK = SHARED_QUEUE_SIZE - 1ul;
+		// an idle worker looks for work this many times with a pause in between, then this many times yielding, then parks
+		constexpr uint32_t SPIN_COUNT = 64u;
+		constexpr uint32_t YIELD_COUNT = 16u;
+
+		static_assert((JOB_POOL_SIZE & JOB_POOL_MASK) == 0ul);
+		static_assert((SHARED_QUEUE_SIZE & SHARED_QUEUE_MASK) == 0ul);
+
+		thread_local uint32_t tRandomState = 0u;
+		std::atomic<uint64_t> gNextSerial = 1ull;
+
+		void pause()
+		{
+#if CAVE_JOB_PAUSE
+			_mm_pause();
+#else
+			std::this_thread::yield();
+#endif
+		}
+
+		uint32_t getRandom()
+		{
+			if (tRandomState == 0u)
+			{
+				tRandomState = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&tRandomState) >> 4u) | 1u;
+			}
+
+			// xorshift32
+			tRandomState ^= tRandomState << 13u;
+			tRandomState ^= tRandomState >> 17u;
+			tRandomState ^= tRandomState << 5u;
+
+			return tRandomState;
+		}
+	}
+
+	/*
+	 * The ring of jobs a thread submits, allocated on its first Run(). A slot is only reused once its job has started.
+	 */
+	class JobSystem::JobPool final
+	{
+	public:
+		Job* GetNext()
+		{
+			if (mJobs == nullptr)
+			{
+				mJobs.reset(new Job[JOB_POOL_SIZE]);
+			}
+
+			Job* job = &mJobs[mNextIndex & JOB_POOL_MASK];
+			++mNextIndex;
+
+			return job;
+		}
+
+		// set while a thread that is not a worker submits through the pool
+		std::atomic<bool> Claimed = false;
+
+	private:
+		std::unique_ptr<Job[]> mJobs;
+		size_t mNextIndex = 0ul;
+	};
+
+	/*
+	 * The pools of the threads that are not workers. Shared with their threads, so that neither the JobSystem
+	 * nor the thread has to outlive the other.
+	 */
+	class JobSystem::SubmitterPools final
+	{
+	public:
+		std::shared_ptr<JobPool> Claim()
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			for (const std::shared_ptr<JobPool>& pool : mPools)
+			{
+				if (!pool->Claimed.exchange(true, std::memory_order_acquire))
+				{
+					return pool;
+				}
+			}
+
+			mPools.push_back(std::make_shared<JobPool>());
+			mPools.back()->Claimed.store(true, std::memory_order_relaxed);
+
+			return mPools.back();
+		}
+
+	private:
+		std::mutex mMutex;
+		std::vector<std::shared_ptr<JobPool>> mPools;
+	};
+
+	struct JobSystem::SubmitterSlot final
+	{
+		~SubmitterSlot()
+		{
+			Release();
+		}
+
+		void Release()
+		{
+			if (Pool != nullptr)
+			{
+				// jobs still queued in it are waited for by whoever submits through it next
+				Pool->Claimed.store(false, std::memory_order_release);
+				Pool.reset();
+			}
+		}
+
+		std::shared_ptr<JobPool> Pool;
+		uint64_t Serial = 0ull;
+	};
+
+	/*
+	 * Chase-Lev deque (Le et al., "Correct and Efficient Work-Stealing for Weak Memory Models") of fixed size.
+	 * Only the owner pushes and pops at the bottom, thieves take from the top. The owner and a thief only race
+	 * with a compare-and-swap over the last job.
+	 */
+	class JobSystem::Worker final
+	{
+	public:
+		bool Push(Job* job)
+		{
+			int64_t bottom = mBottom.load(std::memory_order_relaxed);
+			int64_t top = mTop.load(std::memory_order_acquire);
+			if (bottom - top >= static_cast<int64_t>(DEQUE_SIZE))
+			{
+				return false;
+			}
+
+			mJobs[static_cast<size_t>(bottom) & DEQUE_MASK].store(job, std::memory_order_relaxed);
+			mBottom.store(bottom + 1, std::memory_order_release);
+
+			return true;
+		}
+
+		Job* Pop()
+		{
+			int64_t bottom = mBottom.load(std::memory_order_relaxed) - 1;
+			mBottom.store(bottom, std::memory_order_seq_cst);
+			int64_t top = mTop.load(std::memory_order_seq_cst);
+
+			if (top > bottom)
+			{
+				mBottom.store(bottom + 1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			Job* job = mJobs[static_cast<size_t>(bottom) & DEQUE_MASK].load(std::memory_order_relaxed);
+			if (top == bottom)
+			{
+				// the last one, a thief may be taking it as well
+				if (!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				{
+					job = nullptr;
+				}
+				mBottom.store(bottom + 1, std::memory_order_relaxed);
+			}
+
+			return job;
+		}
+
+		Job* Steal()
+		{
+			int64_t top = mTop.load(std::memory_order_seq_cst);
+			int64_t bottom = mBottom.load(std::memory_order_seq_cst);
+			if (top >= bottom)
+			{
+				return nullptr;
+			}
+
+			Job* job = mJobs[static_cast<size_t>(top) & DEQUE_MASK].load(std::memory_order_relaxed);
+			if (!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			{
+				return nullptr;
+			}
+
+			return job;
+		}
+
+		bool IsEmpty() const
+		{
+			return mTop.load(std::memory_order_seq_cst) >= mBottom.load(std::memory_order_seq_cst);
+		}
+
+		JobSystem* Owner = nullptr;
+		uint32_t Index = 0u;
+		std::thread Thread;
+		JobPool Pool;
+
+	private:
+		alignas(64) std::atomic<int64_t> mTop = 0;
+		alignas(64) std::atomic<int64_t> mBottom = 0;
+		alignas(64) std::atomic<Job*> mJobs[DEQUE_SIZE];
+	};
+
+	/*
+	 * Bounded multi-producer multi-consumer ring (Vyukov) for jobs submitted by threads that are not workers.
+	 */
+	class JobSystem::SharedQueue final
+	{
+	public:
+		SharedQueue()
+		{
+			for (size_t i = 0ul; i < SHARED_QUEUE_SIZE; ++i)
+			{
+				mCells[i].Sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		bool Push(Job* job)
+		{
+			size_t position = mEnqueuePosition.load(std::memory_order_relaxed);
+			for (;;)
+			{
+				Cell& cell = mCells[position & SHARED_QUEUE_MASK];
+				size_t sequence = cell.Sequence.load(std::memory_order_acquire);
+				if (sequence == position)
+				{
+					if (mEnqueuePosition.compare_exchange_weak(position, position + 1ul, std::memory_order_relaxed))
+					{
+						cell.Value = job;
+						cell.Sequence.store(position + 1ul, std::memory_order_release);
+						return true;
+					}
+				}
+				else if (sequence < position)
+				{
+					return false;
+				}
+				else
+				{
+					position = mEnqueuePosition.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		Job* Pop()
+		{
+			size_t position = mDequeuePosition.load(std::memory_order_relaxed);
+			for (;;)
+			{
+				Cell& cell = mCells[position & SHARED_QUEUE_MASK];
+				size_t sequence = cell.Sequence.load(std::memory_order_acquire);
+				if (sequence == position + 1ul)
+				{
+					if (mDequeuePosition.compare_exchange_weak(position, position + 1ul, std::memory_order_relaxed))
+					{
+						Job* job = cell.Value;
+						cell.Sequence.store(position + SHARED_QUEUE_SIZE, std::memory_order_release);
+						return job;
+					}
+				}
+				else if (sequence <= position)
+				{
+					return nullptr;
+				}
+				else
+				{
+					position = mDequeuePosition.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		bool IsEmpty() const
+		{
+			return mDequeuePosition.load(std::memory_order_seq_cst) >= mEnqueuePosition.load(std::memory_order_seq_cst);
+		}
+
+	private:
+		struct Cell
+		{
+			std::atomic<size_t> Sequence;
+			Job* Value;
+		};
+
+		alignas(64) std::atomic<size_t> mEnqueuePosition = 0ul;
+		alignas(64) std::atomic<size_t> mDequeuePosition = 0ul;
+		alignas(64) Cell mCells[SHARED_QUEUE_SIZE];
+	};
+
+	void JobCounter::release()
+	{
+		const uint32_t state = mCount.fetch_sub(1u, std::memory_order_acq_rel) - 1u;
+		if ((state & COUNT_MASK) == 0u && (state & WAITER_FLAG) != 0u)
+		{
+			resumeWaiters();
+		}
+	}
+
+	/*
+	 * A waiter is only queued while the count is not zero, so the job that takes it to zero is sure to see its flag.
+	 * The counter is not done before that job cleared the flags, whoever waits for it can't free it too early.
+	 */
+	bool JobCounter::addWaiter(Waiter& waiter)
+	{
+		uint32_t state = mCount.load(std::memory_order_relaxed);
+		while (true)
+		{
+			if ((state & COUNT_MASK) == 0u)
+			{
+				return false;
+			}
+
+			if ((state & LOCK_FLAG) != 0u)
+			{
+				pause();
+				state = mCount.load(std::memory_order_relaxed);
+				continue;
+			}
+
+			if (mCount.compare_exchange_weak(state, state | LOCK_FLAG | WAITER_FLAG, std::memory_order_acquire, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+
+		waiter.Next = mWaiters;
+		mWaiters = &waiter;
+		mCount.fetch_and(~LOCK_FLAG, std::memory_order_release);
+
+		return true;
+	}
+
+	void JobCounter::resumeWaiters()
+	{
+		uint32_t state = mCount.load(std::memory_order_relaxed);
+		while ((state & LOCK_FLAG) != 0u
+			|| !mCount.compare_exchange_weak(state, state | LOCK_FLAG, std::memory_order_acquire, std::memory_order_relaxed))
+		{
+			pause();
+			state = mCount.load(std::memory_order_relaxed);
+		}
+
+		Waiter* waiter = mWaiters;
+		mWaiters = nullptr;
+		// the last time the counter is touched, the waiters are resumed from the list taken off it
+		mCount.fetch_and(~(LOCK_FLAG | WAITER_FLAG), std::memory_order_release);
+
+		while (waiter != nullptr)
+		{
+			// read before it is resumed, which may free its frame
+			Waiter* next = waiter->Next;
+			std::coroutine_handle<> handle = waiter->Handle;
+			waiter->System->Run([handle]()
+				{
+					handle.resume();
+				});
+			waiter = next;
+		}
+	}
+
+	thread_local JobSystem::Worker* JobSystem::msCurrentWorker = nullptr;
+	thread_local JobSystem::SubmitterSlot JobSystem::msSubmitterSlot;
+
+	JobSystem::JobSystem(uint32_t workerCount, bool bPinWorkers)
+		: mWorkerCount(workerCount)
+		, mbPinWorkers(bPinWorkers)
+		, mSharedQueue(new SharedQueue())
+		, mSubmitterPools(new SubmitterPools())
+		, mSerial(gNextSerial.fetch_add(1ull, std::memory_order_relaxed))
+	{
+		if (mWorkerCount == 0u)
+		{
+			// SMT siblings share the execution units the jobs compete for, a worker per physical core keeps frame times steady
+			mWorkerCount = CpuTopology::Get().GetDefaultWorkerCount();
+		}
+
+		mWorkers.reset(new Worker[mWorkerCount]);
+		for (uint32_t i = 0u; i < mWorkerCount; ++i)
+		{
+			mWorkers[i].Owner = this;
+			mWorkers[i].Index = i;
+			mWorkers[i].Thread = std::thread(&JobSystem::run, this, &mWorkers[i]);
+		}
+	}
+
+	JobSystem::~JobSystem()
+	{
+		// workers run every job still queued before they see this
+		mbStopRequested.store(true, std::memory_order_seq_cst);
+		mWakeEpoch.fetch_add(1u, std::memory_order_release);
+		mWakeEpoch.notify_all();
+
+		for (uint32_t i = 0u; i < mWorkerCount; ++i)
+		{
+			mWorkers[i].Thread.join();
+		}
+	}
+
+	void JobSystem::Wait(JobCounter& counter)
+	{
+		uint32_t spinCount = 0u;
+		while (counter.mCount.load(std::memory_order_acquire) != 0u)
+		{
+			if (tryRunJob())
+			{
+				spinCount = 0u;
+				continue;
+			}
+
+			if (++spinCount < SPIN_COUNT)
+			{
+				pause();
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	Job* JobSystem::allocateJob()
+	{
+		Worker* worker = getCurrentWorker();
+		Job* job = worker != nullptr ? worker->Pool.GetNext() : getSubmitterPool().GetNext();
+
+		// the oldest job of this pool has not started yet
+		while (job->mbPending.load(std::memory_order_acquire))
+		{
+			if (!tryRunJob())
+			{
+				pause();
+			}
+		}
+		job->mbPending.store(true, std::memory_order_relaxed);
+
+		return job;
+	}
+
+	JobSystem::JobPool& JobSystem::getSubmitterPool()
+	{
+		SubmitterSlot& slot = msSubmitterSlot;
+		if (slot.Pool == nullptr || slot.Serial != mSerial)
+		{
+			// a thread that submits to another JobSystem hands back the pool of the previous one
+			slot.Release();
+			slot.Pool = mSubmitterPools->Claim();
+			slot.Serial = mSerial;
+		}
+
+		return *slot.Pool;
+	}
+
+	void JobSystem::submit(Job* job)
+	{
+		Worker* worker = getCurrentWorker();
+		bool bQueued = worker != nullptr ? worker->Push(job) : mSharedQueue->Push(job);
+		if (!bQueued)
+		{
+			execute(job);
+			return;
+		}
+
+		// pairs with park(): either the worker sees the job or we see the worker
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (mSleeperCount.load(std::memory_order_relaxed) != 0u)
+		{
+			wakeWorker();
+		}
+	}
+
+	void JobSystem::execute(Job* job)
+	{
+		// the job is reused as soon as it started
+		JobCounter* counter = job->mCounter;
+		job->mFunction(*job);
+
+		if (counter != nullptr)
+		{
+			counter->release();
+		}
+	}
+
+	/*
+	 * Own deque first, newest job first so that it is still in cache, then the shared queue, then the oldest job of a random worker.
+	 */
+	Job* JobSystem::findJob(Worker* worker)
+	{
+		Job* job = nullptr;
+		if (worker != nullptr)
+		{
+			job = worker->Pop();
+			if (job != nullptr)
+			{
+				return job;
+			}
+		}
+
+		job = mSharedQueue->Pop();
+		if (job != nullptr)
+		{
+			return job;
+		}
+
+		uint32_t start = getRandom() % mWorkerCount;
+		for (uint32_t i = 0u; i < mWorkerCount; ++i)
+		{
+			Worker& victim = mWorkers[(start + i) % mWorkerCount];
+			if (&victim == worker)
+			{
+				continue;
+			}
+
+			job = victim.Steal();
+			if (job != nullptr)
+			{
+				return job;
+			}
+		}
+
+		return nullptr;
+	}
+
+	bool JobSystem::hasJob() const
+	{
+		if (!mSharedQueue->IsEmpty())
+		{
+			return true;
+		}
+
+		for (uint32_t i = 0u; i < mWorkerCount; ++i)
+		{
+			if (!mWorkers[i].IsEmpty())
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool JobSystem::tryRunJob()
+	{
+		Job* job = findJob(getCurrentWorker());
+		if (job == nullptr)
+		{
+			return false;
+		}
+
+		execute(job);
+
+		return true;
+	}
+
+	void JobSystem::run(Worker* worker)
+	{
+		msCurrentWorker = worker;
+
+		char name[16];
+		std::snprintf(name, sizeof(name), "CaveWorker %u", worker->Index);
+		SetCurrentThreadName(name);
+		if (mbPinWorkers)
+		{
+			PinCurrentThread(eThreadRole::WORKER, worker->Index);
+		}
+
+		uint32_t idleCount = 0u;
+		bool bWoken = false;
+		for (;;)
+		{
+			Job* job = findJob(worker);
+			if (job != nullptr)
+			{
+				// a burst woke one worker, which wakes the next while there is more
+				if (bWoken && mSleeperCount.load(std::memory_order_relaxed) != 0u && hasJob())
+				{
+					wakeWorker();
+				}
+				bWoken = false;
+
+				execute(job);
+				idleCount = 0u;
+				continue;
+			}
+
+			if (mbStopRequested.load(std::memory_order_acquire))
+			{
+				break;
+			}
+
+			++idleCount;
+			if (idleCount < SPIN_COUNT)
+			{
+				pause();
+			}
+			else if (idleCount < SPIN_COUNT + YIELD_COUNT)
+			{
+				std::this_thread::yield();
+			}
+			else
+			{
+				park();
+				idleCount = 0u;
+				bWoken = true;
+			}
+		}
+
+		msCurrentWorker = nullptr;
+	}
+
+	void JobSystem::park()
+	{
+		uint32_t epoch = mWakeEpoch.load(std::memory_order_acquire);
+		mSleeperCount.fetch_add(1u, std::memory_order_seq_cst);
+
+		if (!hasJob() && !mbStopRequested.load(std::memory_order_seq_cst))
+		{
+			mWakeEpoch.wait(epoch, std::memory_order_acquire);
+		}
+
+		mSleeperCount.fetch_sub(1u, std::memory_order_relaxed);
+	}
+
+	void JobSystem::wakeWorker()
+	{
+		mWakeEpoch.fetch_add(1u, std::memory_order_release);
+		mWakeEpoch.notify_one();
+	}
+
+	JobSystem::Worker* JobSystem::getCurrentWorker() const
+	{
+		Worker* worker = msCurrentWorker;
+		return worker != nullptr && worker->Owner == this ? worker : nullptr;
+	}
+
+#ifdef CAVE_BUILD_DEBUG
+	namespace JobSystemTest
+	{
+		void Main()
+		{
+			LOGD(eLogChannel::CORE_THREAD, "======JobSystem Test======");
+
+			JobSystem jobSystem(3u);
+			assert(jobSystem.GetWorkerCount() == 3u);
+
+			{
+				// more jobs than fit in the pool of the submitting thread at once
+				constexpr uint32_t JOB_COUNT = 3u * static_cast<uint32_t>(JOB_POOL_SIZE);
+				std::atomic<uint32_t> sum = 0u;
+				JobCounter counter;
+				for (uint32_t i = 0u; i < JOB_COUNT; ++i)
+				{
+					jobSystem.Run([&sum, i]()
+						{
+							sum.fetch_add(i, std::memory_order_relaxed);
+						}, &counter);
+				}
+				jobSystem.Wait(counter);
+				assert(counter.IsDone());
+				assert(sum.load() == JOB_COUNT * (JOB_COUNT - 1u) / 2u);
+			}
+
+			{
+				// jobs spawn jobs on their own worker's deque and wait for them
+				struct Node
+				{
+					static uint32_t Count(JobSystem& jobSystem, uint32_t depth)
+					{
+						if (depth == 0u)
+						{
+							return 1u;
+						}
+
+						uint32_t left = 0u;
+						uint32_t right = 0u;
+						JobCounter counter;
+						jobSystem.Run([&jobSystem, &left, depth]() { left = Count(jobSystem, depth - 1u); }, &counter);
+						jobSystem.Run([&jobSystem, &right, depth]() { right = Count(jobSystem, depth - 1u); }, &counter);
+						jobSystem.Wait(counter);
+
+						return left + right + 1u;
+					}
+				};
+
+				uint32_t count = 0u;
+				JobCounter counter;
+				jobSystem.Run([&jobSystem, &count]() { count = Node::Count(jobSystem, 12u); }, &counter);
+				jobSystem.Wait(counter);
+				assert(count == (1u << 13u) - 1u);
+			}
+
+			{
+				// captures are destroyed after the job ran, and parked workers wake up for new work
+				std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+				std::string text = "job";
+				std::atomic<size_t> length = 0ul;
+				JobCounter counter;
+				jobSystem.Run([text, &length]()
+					{
+						length.fetch_add(text.size(), std::memory_order_relaxed);
+					}, &counter);
+				jobSystem.Wait(counter);
+				assert(length.load() == 3ul);
+			}
+
+			{
+				// threads that are not workers submit at the same time
+				std::atomic<uint32_t> count = 0u;
+				std::thread threads[2];
+				for (std::thread& thread : threads)
+				{
+					thread = std::thread([&jobSystem, &count]()
+						{
+							JobCounter counter;
+							for (uint32_t i = 0u; i < 10000u; ++i)
+							{
+								jobSystem.Run([&count]() { count.fetch_add(1u, std::memory_order_relaxed); }, &counter);
+							}
+							jobSystem.Wait(counter);
+						});
+				}
+				for (std::thread& thread : threads)
+				{
+					thread.join();
+				}
+				assert(count.load() == 20000u);
+			}
+
+			{
+				// a thread exits with its jobs still queued, the next thread to submit reuses its pool
+				std::atomic<bool> bReleased = false;
+				std::atomic<uint32_t> count = 0u;
+				JobCounter counter;
+				for (uint32_t round = 0u; round < 2u; ++round)
+				{
+					std::thread thread([&jobSystem, &bReleased, &count, &counter]()
+						{
+							for (uint32_t i = 0u; i < 1000u; ++i)
+							{
+								jobSystem.Run([&bReleased, &count]()
+									{
+										while (!bReleased.load(std::memory_order_acquire))
+										{
+											std::this_thread::yield();
+										}
+										count.fetch_add(1u, std::memory_order_relaxed);
+									}, &counter);
+							}
+						});
+					thread.join();
+				}
+				bReleased.store(true, std::memory_order_release);
+				jobSystem.Wait(counter);
+				assert(count.load() == 2000u);
+			}
+
+			{
+				// every index is visited exactly once, whatever the grain
+				constexpr size_t COUNT = 100000ul;
+				std::unique_ptr<std::atomic<uint32_t>[]> visits(new std::atomic<uint32_t>[COUNT]);
+				const size_t grainSizes[] = { 0ul, 1ul, 7ul, 1000ul, COUNT, 2ul * COUNT };
+				for (size_t grainSize : grainSizes)
+				{
+					for (size_t i = 0ul; i < COUNT; ++i)
+					{
+						visits[i].store(0u, std::memory_order_relaxed);
+					}
+
+					jobSystem.ParallelFor(COUNT, grainSize, [&visits, grainSize](size_t begin, size_t end)
+						{
+							assert(begin < end);
+							assert(end - begin <= (grainSize == 0ul ? 1ul : grainSize));
+							for (size_t i = begin; i < end; ++i)
+							{
+								visits[i].fetch_add(1u, std::memory_order_relaxed);
+							}
+						});
+
+					for (size_t i = 0ul; i < COUNT; ++i)
+					{
+						assert(visits[i].load(std::memory_order_relaxed) == 1u);
+					}
+				}
+
+				bool bCalled = false;
+				jobSystem.ParallelFor(0ul, 16ul, [&bCalled](size_t, size_t) { bCalled = true; });
+				assert(!bCalled);
+			}
+
+			LOGD(eLogChannel::CORE_THREAD, "======JobSystem Test Success======");
+		}
+	}
+#endif // CAVE_BUILD_DEBUG
+}
@@ -0,0 +1,369 @@
+/*!
+ * Copyright (c) 2021 SWTube. All rights reserved.
+ * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
+ */
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+	#define CAVE_PARALLEL_SSE2 1
+	#include <emmintrin.h>
+#else
+	#define CAVE_PARALLEL_SSE2 0
+#endif
+
+#include "Assertion/Assert.h"
+#include "Debug/Log.h"
+#include "Thread/ParallelAlgorithms.h"
+
+#ifdef CAVE_BUILD_DEBUG
+#include <cmath>
+#include <numeric>
+#include <random>
+#endif // CAVE_BUILD_DEBUG
+
+namespace cave
+{
+	namespace
+	{
+		// the tails of the SIMD loops, and everything without SSE2.
+		// int32_t goes through uint32_t, whose overflow wraps like the SIMD lanes do
+		template <typename T>
+		T sumScalar(const T* data, size_t count, T value)
+		{
+			for (size_t i = 0ul; i < count; ++i)
+			{
+				value += data[i];
+			}
+
+			return value;
+		}
+
+		template <typename T>
+		T inclusiveScanScalar(const T* input, T* output, size_t count, T value)
+		{
+			for (size_t i = 0ul; i < count; ++i)
+			{
+				value += input[i];
+				output[i] = value;
+			}
+
+			return value;
+		}
+
+		template <typename T>
+		T exclusiveScanScalar(const T* input, T* output, size_t count, T value)
+		{
+			for (size_t i = 0ul; i < count; ++i)
+			{
+				const T element = input[i];
+				output[i] = value;
+				value += element;
+			}
+
+			return value;
+		}
+
+#if CAVE_PARALLEL_SSE2
+		// the sums of every lane and the lanes before it
+		__m128i prefixSum(__m128i value)
+		{
+			value = _mm_add_epi32(value, _mm_slli_si128(value, 4));
+			return _mm_add_epi32(value, _mm_slli_si128(value, 8));
+		}
+
+		__m128 prefixSum(__m128 value)
+		{
+			value = _mm_add_ps(value, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(value), 4)));
+			return _mm_add_ps(value, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(value), 8)));
+		}
+#endif
+	}
+
+	float Sum(const float* data, size_t count)
+	{
+		size_t i = 0ul;
+		float sum = 0.0f;
+
+#if CAVE_PARALLEL_SSE2
+		// four accumulators hide the latency of the additions
+		__m128 sums[4] = { _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps() };
+		for (; i + 16ul <= count; i += 16ul)
+		{
+			sums[0] = _mm_add_ps(sums[0], _mm_loadu_ps(data + i));
+			sums[1] = _mm_add_ps(sums[1], _mm_loadu_ps(data + i + 4ul));
+			sums[2] = _mm_add_ps(sums[2], _mm_loadu_ps(data + i + 8ul));
+			sums[3] = _mm_add_ps(sums[3], _mm_loadu_ps(data + i + 12ul));
+		}
+		for (; i + 4ul <= count; i += 4ul)
+		{
+			sums[0] = _mm_add_ps(sums[0], _mm_loadu_ps(data + i));
+		}
+
+		const __m128 total = _mm_add_ps(_mm_add_ps(sums[0], sums[1]), _mm_add_ps(sums[2], sums[3]));
+		alignas(16) float lanes[4];
+		_mm_store_ps(lanes, total);
+		sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#endif
+
+		return sumScalar(data + i, count - i, sum);
+	}
+
+	uint32_t Sum(const uint32_t* data, size_t count)
+	{
+		size_t i = 0ul;
+		uint32_t sum = 0u;
+
+#if CAVE_PARALLEL_SSE2
+		__m128i sums[4] = { _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128() };
+		for (; i + 16ul <= count; i += 16ul)
+		{
+			const __m128i* source = reinterpret_cast<const __m128i*>(data + i);
+			sums[0] = _mm_add_epi32(sums[0], _mm_loadu_si128(source));
+			sums[1] = _mm_add_epi32(sums[1], _mm_loadu_si128(source + 1));
+			sums[2] = _mm_add_epi32(sums[2], _mm_loadu_si128(source + 2));
+			sums[3] = _mm_add_epi32(sums[3], _mm_loadu_si128(source + 3));
+		}
+		for (; i + 4ul <= count; i += 4ul)
+		{
+			sums[0] = _mm_add_epi32(sums[0], _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+		}
+
+		const __m128i total = _mm_add_epi32(_mm_add_epi32(sums[0], sums[1]), _mm_add_epi32(sums[2], sums[3]));
+		alignas(16) uint32_t lanes[4];
+		_mm_store_si128(reinterpret_cast<__m128i*>(lanes), total);
+		sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+
+		return sumScalar(data + i, count - i, sum);
+	}
+
+	int32_t Sum(const int32_t* data, size_t count)
+	{
+		return static_cast<int32_t>(Sum(reinterpret_cast<const uint32_t*>(data), count));
+	}
+
+	float InclusiveScan(const float* input, float* output, size_t count, float offset)
+	{
+		size_t i = 0ul;
+
+#if CAVE_PARALLEL_SSE2
+		__m128 carry = _mm_set1_ps(offset);
+		for (; i + 4ul <= count; i += 4ul)
+		{
+			const __m128 sums = _mm_add_ps(prefixSum(_mm_loadu_ps(input + i)), carry);
+			_mm_storeu_ps(output + i, sums);
+			carry = _mm_shuffle_ps(sums, sums, _MM_SHUFFLE(3, 3, 3, 3));
+		}
+		offset = _mm_cvtss_f32(carry);
+#endif
+
+		return inclusiveScanScalar(input + i, output + i, count - i, offset);
+	}
+
+	uint32_t InclusiveScan(const uint32_t* input, uint32_t* output, size_t count, uint32_t offset)
+	{
+		size_t i = 0ul;
+
+#if CAVE_PARALLEL_SSE2
+		__m128i carry = _mm_set1_epi32(static_cast<int32_t>(offset));
+		for (; i + 4ul <= count; i += 4ul)
+		{
+			const __m128i sums = _mm_add_epi32(prefixSum(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i))), carry);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), sums);
+			carry = _mm_shuffle_epi32(sums, _MM_SHUFFLE(3, 3, 3, 3));
+		}
+		offset = static_cast<uint32_t>(_mm_cvtsi128_si32(carry));
+#endif
+
+		return inclusiveScanScalar(input + i, output + i, count - i, offset);
+	}
+
+	int32_t InclusiveScan(const int32_t* input, int32_t* output, size_t count, int32_t offset)
+	{
+		return static_cast<int32_t>(InclusiveScan(reinterpret_cast<const uint32_t*>(input), reinterpret_cast<uint32_t*>(output), count, static_cast<uint32_t>(offset)));
+	}
+
+	float ExclusiveScan(const float* input, float* output, size_t count, float offset)
+	{
+		size_t i = 0ul;
+
+#if CAVE_PARALLEL_SSE2
+		__m128 carry = _mm_set1_ps(offset);
+		for (; i + 4ul <= count; i += 4ul)
+		{
+			const __m128 sums = prefixSum(_mm_loadu_ps(input + i));
+			// the inclusive sums moved up a lane
+			_mm_storeu_ps(output + i, _mm_add_ps(_mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(sums), 4)), carry));
+			carry = _mm_add_ps(carry, _mm_shuffle_ps(sums, sums, _MM_SHUFFLE(3, 3, 3, 3)));
+		}
+		offset = _mm_cvtss_f32(carry);
+#endif
+
+		return exclusiveScanScalar(input + i, output + i, count - i, offset);
+	}
+
+	uint32_t ExclusiveScan(const uint32_t* input, uint32_t* output, size_t count, uint32_t offset)
+	{
+		size_t i = 0ul;
+
+#if CAVE_PARALLEL_SSE2
+		__m128i carry = _mm_set1_epi32(static_cast<int32_t>(offset));
+		for (; i + 4ul <= count; i += 4ul)
+		{
+			const __m128i sums = prefixSum(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i)));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_add_epi32(_mm_slli_si128(sums, 4), carry));
+			carry = _mm_add_epi32(carry, _mm_shuffle_epi32(sums, _MM_SHUFFLE(3, 3, 3, 3)));
+		}
+		offset = static_cast<uint32_t>(_mm_cvtsi128_si32(carry));
+#endif
+
+		return exclusiveScanScalar(input + i, output + i, count - i, offset);
+	}
+
+	int32_t ExclusiveScan(const int32_t* input, int32_t* output, size_t count, int32_t offset)
+	{
+		return static_cast<int32_t>(ExclusiveScan(reinterpret_cast<const uint32_t*>(input), reinterpret_cast<uint32_t*>(output), count, static_cast<uint32_t>(offset)));
+	}
+
+#ifdef CAVE_BUILD_DEBUG
+	namespace ParallelAlgorithmsTest
+	{
+		struct Item
+		{
+			uint32_t Key;
+			uint32_t Order;
+		};
+
+		void testSize(JobSystem* jobSystem, size_t count, std::mt19937& random)
+		{
+			std::vector<uint32_t> values(count);
+			for (uint32_t& value : values)
+			{
+				value = random();
+			}
+
+			{
+				std::vector<uint32_t> keys = values;
+				std::vector<uint32_t> expected = values;
+				ParallelRadixSort(jobSystem, keys.data(), count);
+				std::sort(expected.begin(), expected.end());
+				assert(keys == expected);
+
+				// the upper bytes are all zero and skipped
+				std::vector<uint64_t> wideKeys(count);
+				for (size_t i = 0ul; i < count; ++i)
+				{
+					wideKeys[i] = values[i] & 0xfffffu;
+				}
+				ParallelRadixSort(jobSystem, wideKeys.data(), count);
+				assert(std::is_sorted(wideKeys.begin(), wideKeys.end()));
+			}
+
+			{
+				// few distinct keys, so stability shows
+				std::vector<Item> items(count);
+				for (size_t i = 0ul; i < count; ++i)
+				{
+					items[i] = { values[i] % 64u, static_cast<uint32_t>(i) };
+				}
+				ParallelMergeSort(jobSystem, items.data(), count, [](const Item& left, const Item& right) { return left.Key < right.Key; });
+				for (size_t i = 1ul; i < count; ++i)
+				{
+					assert(items[i - 1ul].Key < items[i].Key || (items[i - 1ul].Key == items[i].Key && items[i - 1ul].Order < items[i].Order));
+				}
+			}
+
+			{
+				const uint32_t sum = ParallelReduce(jobSystem, values.data(), count, 5u);
+				assert(sum == std::accumulate(values.begin(), values.end(), 5u));
+
+				const uint32_t maximum = ParallelReduce(jobSystem, values.data(), count, 0u, [](uint32_t left, uint32_t right) { return std::max(left, right); });
+				assert(maximum == (count > 0ul ? *std::max_element(values.begin(), values.end()) : 0u));
+
+				std::vector<float> floats(count);
+				double expected = 0.0;
+				for (size_t i = 0ul; i < count; ++i)
+				{
+					floats[i] = static_cast<float>(values[i] % 1000u) * 0.25f;
+					expected += floats[i];
+				}
+				const float floatSum = ParallelReduce(jobSystem, floats.data(), count, 0.0f);
+				assert(std::abs(floatSum - expected) <= expected * 1e-5);
+			}
+
+			{
+				std::vector<uint32_t> output(count);
+				std::vector<uint32_t> expected(count);
+				ParallelInclusiveScan(jobSystem, values.data(), output.data(), count, 3u);
+				std::inclusive_scan(values.begin(), values.end(), expected.begin(), std::plus<uint32_t>(), 3u);
+				assert(output == expected);
+
+				ParallelExclusiveScan(jobSystem, values.data(), output.data(), count, 3u);
+				std::exclusive_scan(values.begin(), values.end(), expected.begin(), 3u);
+				assert(output == expected);
+
+				// in place, with an operation that has no SIMD kernel
+				std::vector<int32_t> signedValues(count);
+				for (size_t i = 0ul; i < count; ++i)
+				{
+					signedValues[i] = static_cast<int32_t>(values[i] % 201u) - 100;
+				}
+				std::vector<int32_t> signedExpected(count);
+				auto maximum = [](int32_t left, int32_t right) { return std::max(left, right); };
+				std::inclusive_scan(signedValues.begin(), signedValues.end(), signedExpected.begin(), maximum, -1000);
+				ParallelInclusiveScan(jobSystem, signedValues.data(), signedValues.data(), count, -1000, maximum);
+				assert(signedValues == signedExpected);
+			}
+
+			{
+				std::vector<uint32_t> output(count);
+				auto isEven = [](uint32_t value) { return value % 2u == 0u; };
+				const size_t keptCount = ParallelPartition(jobSystem, values.data(), output.data(), count, isEven);
+
+				std::vector<uint32_t> expected = values;
+				const auto middle = std::stable_partition(expected.begin(), expected.end(), isEven);
+				assert(keptCount == static_cast<size_t>(middle - expected.begin()));
+				assert(output == expected);
+			}
+		}
+
+		void Main()
+		{
+			LOGD(eLogChannel::CORE_THREAD, "======ParallelAlgorithms Test======");
+
+			{
+				// the kernels on their own, every tail length
+				std::vector<int32_t> values(37);
+				std::vector<int32_t> output(37);
+				for (size_t i = 0ul; i < values.size(); ++i)
+				{
+					values[i] = static_cast<int32_t>(i) - 10;
+				}
+				for (size_t count = 0ul; count <= values.size(); ++count)
+				{
+					int32_t sum = 0;
+					for (size_t i = 0ul; i < count; ++i)
+					{
+						sum += values[i];
+					}
+					assert(Sum(values.data(), count) == sum);
+					assert(InclusiveScan(values.data(), output.data(), count, 7) == sum + 7);
+					assert(count == 0ul || output[count - 1ul] == sum + 7);
+					assert(ExclusiveScan(values.data(), output.data(), count, 7) == sum + 7);
+					assert(count == 0ul || output[count - 1ul] == sum + 7 - values[count - 1ul]);
+				}
+			}
+
+			JobSystem jobSystem(3u);
+			std::mt19937 random(7u);
+			const size_t sizes[] = { 0ul, 1ul, 100ul, PARALLEL_ALGORITHM_GRAIN_SIZE, RADIX_SORT_GRAIN_SIZE * 3ul + 17ul, 200000ul };
+			for (size_t size : sizes)
+			{
+				testSize(nullptr, size, random);
+				testSize(&jobSystem, size, random);
+			}
+
+			LOGD(eLogChannel::CORE_THREAD, "======ParallelAlgorithms Test Success======");
+		}
+	}
+#endif // CAVE_BUILD_DEBUG
+}
@@ -0,0 +1,454 @@
+/*!
+ * Copyright (c) 2021 SWTube. All rights reserved.
+ * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+	#define CAVE_SYNC_PAUSE 1
+	#include <emmintrin.h>
+#else
+	#define CAVE_SYNC_PAUSE 0
+#endif
+
+#ifdef __WIN32__
+#include <windows.h>
+
+// WaitOnAddress() and WakeByAddress*(), which need _WIN32_WINNT 0x0602
+#pragma comment(lib, "Synchronization.lib")
+#else
+#include <cerrno>
+#include <climits>
+#include <ctime>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "Assertion/Assert.h"
+#include "Debug/Log.h"
+#include "Thread/Synchronization.h"
+
+#ifdef CAVE_BUILD_DEBUG
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+#endif // CAVE_BUILD_DEBUG
+
+namespace cave
+{
+	namespace
+	{
+		// a futex word is a plain 32-bit integer to the kernel
+		static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t));
+		static_assert(std::atomic<uint32_t>::is_always_lock_free);
+
+		// spins of a contended Mutex, Event or Semaphore before it sleeps, about a microsecond or two
+		constexpr uint32_t SPIN_COUNT = 64u;
+		// RwSpinLock doubles its pauses up to this many, then yields between tries
+		constexpr uint32_t MAX_BACKOFF_PAUSE_COUNT = 64u;
+
+		void pause()
+		{
+#if CAVE_SYNC_PAUSE
+			_mm_pause();
+#else
+			std::this_thread::yield();
+#endif
+		}
+
+		class Backoff final
+		{
+		public:
+			void Pause()
+			{
+				if (mPauseCount > MAX_BACKOFF_PAUSE_COUNT)
+				{
+					std::this_thread::yield();
+					return;
+				}
+
+				for (uint32_t i = 0u; i < mPauseCount; ++i)
+				{
+					pause();
+				}
+				mPauseCount <<= 1u;
+			}
+
+		private:
+			uint32_t mPauseCount = 1u;
+		};
+
+		/*
+		 * Sleeps while word holds expected, for at most nanoseconds unless that is negative. May return spuriously.
+		 * false once the timeout passed.
+		 */
+		bool futexWait(std::atomic<uint32_t>& word, uint32_t expected, int64_t nanoseconds)
+		{
+#ifdef __WIN32__
+			DWORD milliseconds = INFINITE;
+			if (nanoseconds >= 0)
+			{
+				milliseconds = static_cast<DWORD>((nanoseconds + 999999) / 1000000);
+			}
+
+			if (!WaitOnAddress(&word, &expected, sizeof(expected), milliseconds))
+			{
+				return GetLastError() != ERROR_TIMEOUT;
+			}
+
+			return true;
+#else
+			timespec timeout;
+			timespec* timeoutPointer = nullptr;
+			if (nanoseconds >= 0)
+			{
+				timeout.tv_sec = static_cast<time_t>(nanoseconds / 1000000000);
+				timeout.tv_nsec = static_cast<long>(nanoseconds % 1000000000);
+				timeoutPointer = &timeout;
+			}
+
+			if (syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, timeoutPointer, nullptr, 0) != 0)
+			{
+				return errno != ETIMEDOUT;
+			}
+
+			return true;
+#endif
+		}
+
+		void futexWake(std::atomic<uint32_t>& word, bool bAll)
+		{
+#ifdef __WIN32__
+			if (bAll)
+			{
+				WakeByAddressAll(&word);
+			}
+			else
+			{
+				WakeByAddressSingle(&word);
+			}
+#else
+			syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE, bAll ? INT_MAX : 1, nullptr, nullptr, 0);
+#endif
+		}
+
+		/*
+		 * Shared by Event and Semaphore: spins on tryTake, then registers as a waiter and sleeps on word while it is zero.
+		 * The waiter count and word are both sequentially consistent, so whichever of a waiter and a waker
+		 * comes second sees the other.
+		 */
+		template <typename TryTake>
+		bool waitUntilTaken(std::atomic<uint32_t>& word, std::atomic<uint32_t>& waiterCount, int64_t nanoseconds, TryTake&& tryTake)
+		{
+			for (uint32_t i = 0u; i < SPIN_COUNT; ++i)
+			{
+				if (word.load(std::memory_order_relaxed) != 0u && tryTake())
+				{
+					return true;
+				}
+				pause();
+			}
+
+			const auto deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(nanoseconds);
+
+			bool bTaken = false;
+			waiterCount.fetch_add(1u, std::memory_order_seq_cst);
+			for (;;)
+			{
+				if (tryTake())
+				{
+					bTaken = true;
+					break;
+				}
+
+				int64_t remaining = -1;
+				if (nanoseconds >= 0)
+				{
+					remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - std::chrono::steady_clock::now()).count();
+					if (remaining <= 0)
+					{
+						break;
+					}
+				}
+
+				futexWait(word, 0u, remaining);
+			}
+			waiterCount.fetch_sub(1u, std::memory_order_relaxed);
+
+			return bTaken;
+		}
+	}
+
+	void Mutex::lockSlow()
+	{
+		// spin while the holder runs, unless others already gave up and sleep
+		for (uint32_t i = 0u; i < SPIN_COUNT; ++i)
+		{
+			uint32_t state = mState.load(std::memory_order_relaxed);
+			if (state == CONTENDED)
+			{
+				break;
+			}
+
+			if (state == UNLOCKED && mState.compare_exchange_weak(state, LOCKED, std::memory_order_acquire, std::memory_order_relaxed))
+			{
+				return;
+			}
+			pause();
+		}
+
+		// taken as CONTENDED from here on, as we can't tell whether other threads still sleep
+		while (mState.exchange(CONTENDED, std::memory_order_acquire) != UNLOCKED)
+		{
+			futexWait(mState, CONTENDED, -1);
+		}
+	}
+
+	void Mutex::wakeOne()
+	{
+		futexWake(mState, false);
+	}
+
+	void Event::Signal()
+	{
+		mState.store(1u, std::memory_order_seq_cst);
+		if (mWaiterCount.load(std::memory_order_seq_cst) != 0u)
+		{
+			futexWake(mState, mbManualReset);
+		}
+	}
+
+	bool Event::wait(int64_t nanoseconds)
+	{
+		return waitUntilTaken(mState, mWaiterCount, nanoseconds, [this]()
+			{
+				return tryConsume();
+			});
+	}
+
+	void Semaphore::Release(uint32_t count)
+	{
+		mCount.fetch_add(count, std::memory_order_seq_cst);
+		if (mWaiterCount.load(std::memory_order_seq_cst) != 0u)
+		{
+			futexWake(mCount, count > 1u);
+		}
+	}
+
+	bool Semaphore::acquire(int64_t nanoseconds)
+	{
+		return waitUntilTaken(mCount, mWaiterCount, nanoseconds, [this]()
+			{
+				return TryAcquire();
+			});
+	}
+
+	void RwSpinLock::lockSlow()
+	{
+		Backoff backoff;
+		for (;;)
+		{
+			uint32_t state = mState.load(std::memory_order_relaxed);
+			if ((state & ~WRITER_WAITING) == 0u)
+			{
+				// taking the lock clears WRITER_WAITING, other waiting writers set it again
+				if (mState.compare_exchange_weak(state, WRITER, std::memory_order_acquire, std::memory_order_relaxed))
+				{
+					return;
+				}
+			}
+			else if ((state & WRITER_WAITING) == 0u)
+			{
+				mState.fetch_or(WRITER_WAITING, std::memory_order_relaxed);
+			}
+
+			backoff.Pause();
+		}
+	}
+
+	void RwSpinLock::lockSharedSlow()
+	{
+		Backoff backoff;
+		for (;;)
+		{
+			uint32_t state = mState.load(std::memory_order_relaxed);
+			if ((state & (WRITER | WRITER_WAITING)) == 0u
+				&& mState.compare_exchange_weak(state, state + 1u, std::memory_order_acquire, std::memory_order_relaxed))
+			{
+				return;
+			}
+
+			backoff.Pause();
+		}
+	}
+
+#ifdef CAVE_BUILD_DEBUG
+	namespace SynchronizationTest
+	{
+		void Main()
+		{
+			LOGD(eLogChannel::CORE_THREAD, "======Synchronization Test======");
+
+			constexpr uint32_t THREAD_COUNT = 4u;
+			constexpr uint32_t ITERATION_COUNT = 20000u;
+
+			{
+				Mutex mutex;
+				uint32_t count = 0u;
+				std::vector<std::thread> threads;
+				for (uint32_t i = 0u; i < THREAD_COUNT; ++i)
+				{
+					threads.emplace_back([&mutex, &count]()
+						{
+							for (uint32_t j = 0u; j < ITERATION_COUNT; ++j)
+							{
+								std::lock_guard<Mutex> lock(mutex);
+								++count;
+							}
+						});
+				}
+				for (std::thread& thread : threads)
+				{
+					thread.join();
+				}
+				assert(count == THREAD_COUNT * ITERATION_COUNT);
+				assert(mutex.TryLock());
+				assert(!mutex.TryLock());
+				mutex.Unlock();
+			}
+
+			{
+				// readers see both halves of every write
+				RwSpinLock lock;
+				uint32_t first = 0u;
+				uint32_t second = 0u;
+				std::atomic<bool> bTorn = false;
+				std::vector<std::thread> threads;
+				for (uint32_t i = 0u; i < THREAD_COUNT; ++i)
+				{
+					threads.emplace_back([&, i]()
+						{
+							for (uint32_t j = 0u; j < ITERATION_COUNT; ++j)
+							{
+								if ((i & 1u) == 0u)
+								{
+									std::lock_guard<RwSpinLock> writeLock(lock);
+									++first;
+									++second;
+								}
+								else
+								{
+									std::shared_lock<RwSpinLock> readLock(lock);
+									if (first != second)
+									{
+										bTorn.store(true, std::memory_order_relaxed);
+									}
+								}
+							}
+						});
+				}
+				for (std::thread& thread : threads)
+				{
+					thread.join();
+				}
+				assert(!bTorn.load());
+				assert(first == THREAD_COUNT / 2u * ITERATION_COUNT && second == first);
+			}
+
+			{
+				// ping-pong between two threads through auto-reset events
+				Event ping(eEventReset::AUTO);
+				Event pong(eEventReset::AUTO);
+				uint32_t value = 0u;
+				std::thread thread([&]()
+					{
+						for (uint32_t i = 0u; i < ITERATION_COUNT; ++i)
+						{
+							ping.Wait();
+							++value;
+							pong.Signal();
+						}
+					});
+				for (uint32_t i = 0u; i < ITERATION_COUNT; ++i)
+				{
+					ping.Signal();
+					pong.Wait();
+					assert(value == i + 1u);
+				}
+				thread.join();
+
+				assert(!ping.IsSignaled());
+				assert(!ping.WaitFor(std::chrono::milliseconds(1)));
+			}
+
+			{
+				// a manual-reset event lets every waiter through
+				Event event(eEventReset::MANUAL);
+				std::atomic<uint32_t> passed = 0u;
+				std::vector<std::thread> threads;
+				for (uint32_t i = 0u; i < THREAD_COUNT; ++i)
+				{
+					threads.emplace_back([&]()
+						{
+							event.Wait();
+							passed.fetch_add(1u, std::memory_order_relaxed);
+						});
+				}
+				std::this_thread::sleep_for(std::chrono::milliseconds(10));
+				event.Signal();
+				for (std::thread& thread : threads)
+				{
+					thread.join();
+				}
+				assert(passed.load() == THREAD_COUNT);
+				assert(event.IsSignaled());
+				event.Reset();
+				assert(!event.WaitFor(std::chrono::microseconds(100)));
+			}
+
+			{
+				// producers and consumers through a semaphore
+				Semaphore semaphore;
+				std::atomic<uint32_t> consumed = 0u;
+				std::vector<std::thread> threads;
+				for (uint32_t i = 0u; i < THREAD_COUNT; ++i)
+				{
+					threads.emplace_back([&, i]()
+						{
+							for (uint32_t j = 0u; j < ITERATION_COUNT; ++j)
+							{
+								if ((i & 1u) == 0u)
+								{
+									semaphore.Release();
+								}
+								else
+								{
+									semaphore.Acquire();
+									consumed.fetch_add(1u, std::memory_order_relaxed);
+								}
+							}
+						});
+				}
+				for (std::thread& thread : threads)
+				{
+					thread.join();
+				}
+				assert(consumed.load() == THREAD_COUNT / 2u * ITERATION_COUNT);
+				assert(!semaphore.TryAcquire());
+
+				semaphore.Release(2u);
+				assert(semaphore.TryAcquireFor(std::chrono::milliseconds(1)));
+				assert(semaphore.TryAcquire());
+				assert(!semaphore.TryAcquireFor(std::chrono::microseconds(100)));
+			}
+
+			LOGD(eLogChannel::CORE_THREAD, "======Synchronization Test Success======");
+		}
+	}
+#endif // CAVE_BUILD_DEBUG
+}
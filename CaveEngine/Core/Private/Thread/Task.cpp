@@ -0,0 +1,253 @@
+/*!
+ * Copyright (c) 2021 SWTube. All rights reserved.
+ * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
+ */
+
+#include <fstream>
+#include <new>
+
+#include "Debug/Log.h"
+#include "Thread/Task.h"
+
+#ifdef CAVE_BUILD_DEBUG
+#include <cstdio>
+#include <string>
+#endif // CAVE_BUILD_DEBUG
+
+namespace cave
+{
+	namespace
+	{
+		// frames are rounded up to a multiple of FRAME_GRANULE, larger ones than the last class come from the heap
+		constexpr size_t FRAME_GRANULE = 64ul;
+		constexpr size_t FRAME_CLASS_COUNT = 32ul;
+		// free frames a thread keeps per class, a thread that frees frames others allocated gives the rest back to the heap
+		constexpr uint32_t FRAME_CACHE_COUNT = 64u;
+
+		class FrameCache final
+		{
+		public:
+			FrameCache() = default;
+			FrameCache(const FrameCache&) = delete;
+			FrameCache& operator=(const FrameCache&) = delete;
+
+			~FrameCache()
+			{
+				for (FreeFrame* frame : mFrames)
+				{
+					while (frame != nullptr)
+					{
+						FreeFrame* next = frame->Next;
+						::operator delete(frame);
+						frame = next;
+					}
+				}
+			}
+
+			void* Allocate(size_t sizeClass)
+			{
+				FreeFrame* frame = mFrames[sizeClass];
+				if (frame == nullptr)
+				{
+					return ::operator new((sizeClass + 1ul) * FRAME_GRANULE);
+				}
+
+				mFrames[sizeClass] = frame->Next;
+				--mCounts[sizeClass];
+
+				return frame;
+			}
+
+			void Deallocate(void* memory, size_t sizeClass)
+			{
+				if (mCounts[sizeClass] == FRAME_CACHE_COUNT)
+				{
+					::operator delete(memory);
+					return;
+				}
+
+				FreeFrame* frame = static_cast<FreeFrame*>(memory);
+				frame->Next = mFrames[sizeClass];
+				mFrames[sizeClass] = frame;
+				++mCounts[sizeClass];
+			}
+
+		private:
+			struct FreeFrame
+			{
+				FreeFrame* Next;
+			};
+
+			FreeFrame* mFrames[FRAME_CLASS_COUNT] = { nullptr, };
+			uint32_t mCounts[FRAME_CLASS_COUNT] = { 0u, };
+		};
+
+		thread_local FrameCache tFrameCache;
+
+		size_t getSizeClass(size_t size)
+		{
+			return (size + FRAME_GRANULE - 1ul) / FRAME_GRANULE - 1ul;
+		}
+	}
+
+	void* AllocateTaskFrame(size_t size)
+	{
+		const size_t sizeClass = getSizeClass(size);
+		if (sizeClass >= FRAME_CLASS_COUNT)
+		{
+			return ::operator new(size);
+		}
+
+		return tFrameCache.Allocate(sizeClass);
+	}
+
+	void DeallocateTaskFrame(void* frame, size_t size)
+	{
+		const size_t sizeClass = getSizeClass(size);
+		if (sizeClass >= FRAME_CLASS_COUNT)
+		{
+			::operator delete(frame);
+			return;
+		}
+
+		tFrameCache.Deallocate(frame, sizeClass);
+	}
+
+	// blocks the worker for as long as the disk takes, AsyncIo reads without holding one
+	bool FileReadAwaiter::read()
+	{
+		std::ifstream file(mPath, std::ios::binary | std::ios::ate);
+		if (!file.is_open())
+		{
+			LOGEF(eLogChannel::CORE_THREAD, "cannot open %s", mPath);
+			return false;
+		}
+
+		const std::streamoff size = file.tellg();
+		mData.resize(static_cast<size_t>(size));
+		file.seekg(0);
+
+		return size == 0 || static_cast<bool>(file.read(reinterpret_cast<char*>(mData.data()), size));
+	}
+
+#ifdef CAVE_BUILD_DEBUG
+	namespace TaskTest
+	{
+		Task<uint32_t> fibonacci(uint32_t n)
+		{
+			if (n < 2u)
+			{
+				co_return n;
+			}
+
+			Task<uint32_t> left = fibonacci(n - 1u);
+			Task<uint32_t> right = fibonacci(n - 2u);
+			co_return co_await left + co_await right;
+		}
+
+		Task<uint32_t> sumInJobs(JobSystem& jobSystem, uint32_t jobCount)
+		{
+			std::atomic<uint32_t> sum = 0u;
+			JobCounter counter;
+			for (uint32_t i = 1u; i <= jobCount; ++i)
+			{
+				jobSystem.Run([&sum, i]() { sum.fetch_add(i, std::memory_order_relaxed); }, &counter);
+			}
+
+			co_await counter;
+			co_return sum.load(std::memory_order_relaxed);
+		}
+
+		Task<std::string> readText(const char* path)
+		{
+			std::vector<unsigned char> data;
+			if (!co_await ReadFileAsync(path, data))
+			{
+				co_return std::string();
+			}
+
+			co_return std::string(data.begin(), data.end());
+		}
+
+		Task<> count(JobSystem& jobSystem, std::atomic<uint32_t>& total)
+		{
+			const uint32_t sum = co_await sumInJobs(jobSystem, 100u);
+			total.fetch_add(sum, std::memory_order_relaxed);
+		}
+
+		void Main()
+		{
+			LOGD(eLogChannel::CORE_THREAD, "======Task Test======");
+
+			JobSystem jobSystem(3u);
+
+			{
+				// awaited tasks run inline, in order
+				Task<uint32_t> task = fibonacci(15u);
+				assert(!task.IsDone());
+				JobCounter counter;
+				task.Start(jobSystem, &counter);
+				jobSystem.Wait(counter);
+				assert(task.IsDone());
+				assert(task.GetResult() == 610u);
+			}
+
+			{
+				// many tasks suspended on job counters at once
+				constexpr uint32_t TASK_COUNT = 256u;
+				std::atomic<uint32_t> total = 0u;
+				std::vector<Task<>> tasks;
+				tasks.reserve(TASK_COUNT);
+				JobCounter counter;
+				for (uint32_t i = 0u; i < TASK_COUNT; ++i)
+				{
+					tasks.push_back(count(jobSystem, total));
+					tasks.back().Start(jobSystem, &counter);
+				}
+				jobSystem.Wait(counter);
+				assert(total.load() == TASK_COUNT * 5050u);
+			}
+
+			{
+				// a counter that is already done does not suspend
+				Task<uint32_t> task = sumInJobs(jobSystem, 0u);
+				JobCounter counter;
+				task.Start(jobSystem, &counter);
+				jobSystem.Wait(counter);
+				assert(task.GetResult() == 0u);
+			}
+
+			{
+				const char* path = "TaskTest.txt";
+				{
+					std::ofstream file(path, std::ios::binary);
+					file << "darkest cave";
+				}
+
+				Task<std::string> task = readText(path);
+				JobCounter counter;
+				task.Start(jobSystem, &counter);
+				jobSystem.Wait(counter);
+				assert(task.GetResult() == "darkest cave");
+				std::remove(path);
+
+				Task<std::string> missing = readText("TaskTest.missing");
+				missing.Start(jobSystem, &counter);
+				jobSystem.Wait(counter);
+				assert(missing.GetResult().empty());
+			}
+
+			{
+				// frames are reused
+				void* first = AllocateTaskFrame(100ul);
+				DeallocateTaskFrame(first, 100ul);
+				void* second = AllocateTaskFrame(128ul);
+				assert(first == second);
+				DeallocateTaskFrame(second, 128ul);
+			}
+
+			LOGD(eLogChannel::CORE_THREAD, "======Task Test Success======");
+		}
+	}
+#endif // CAVE_BUILD_DEBUG
+}
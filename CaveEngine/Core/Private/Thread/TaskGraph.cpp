@@ -0,0 +1,237 @@
+/*!
+ * Copyright (c) 2021 SWTube. All rights reserved.
+ * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
+ */
+
+#include <limits>
+
+#include "Debug/Log.h"
+#include "Thread/JobSystem.h"
+#include "Thread/TaskGraph.h"
+
+namespace cave
+{
+	namespace
+	{
+		constexpr uint32_t NO_TASK = std::numeric_limits<uint32_t>::max();
+	}
+
+	void TaskGraph::AddDependency(uint32_t predecessor, uint32_t successor)
+	{
+		assert(mJobSystem == nullptr);
+		assert(predecessor < mTasks.size() && successor < mTasks.size());
+		assert(predecessor != successor);
+
+		mTasks[predecessor].Successors.push_back(successor);
+		++mTasks[successor].DependencyCount;
+	}
+
+	void TaskGraph::Run(JobSystem& jobSystem)
+	{
+		assert(mJobSystem == nullptr);
+		assert(isAcyclic());
+
+		const uint32_t taskCount = GetTaskCount();
+		if (taskCount > mRemainingCountSize)
+		{
+			mRemainingCounts.reset(new std::atomic<uint32_t>[taskCount]);
+			mRemainingCountSize = taskCount;
+		}
+
+		for (uint32_t i = 0u; i < taskCount; ++i)
+		{
+			mRemainingCounts[i].store(mTasks[i].DependencyCount, std::memory_order_relaxed);
+		}
+
+		JobCounter counter;
+		mJobSystem = &jobSystem;
+		mCounter = &counter;
+
+		// submitting publishes the counts above to the workers
+		for (uint32_t i = 0u; i < taskCount; ++i)
+		{
+			if (mTasks[i].DependencyCount == 0u)
+			{
+				jobSystem.Run([this, i]() { runTask(i); }, &counter);
+			}
+		}
+
+		jobSystem.Wait(counter);
+
+		mJobSystem = nullptr;
+		mCounter = nullptr;
+	}
+
+	void TaskGraph::Clear()
+	{
+		assert(mJobSystem == nullptr);
+
+		mTasks.clear();
+	}
+
+	void TaskGraph::runTask(uint32_t index)
+	{
+		while (index != NO_TASK)
+		{
+			const Task& task = mTasks[index];
+			task.Function();
+
+			// the first successor this task made ready runs here without a trip through a queue, the others are spawned
+			// before this job ends, so the counter of Run() never reaches zero early
+			index = NO_TASK;
+			for (uint32_t successor : task.Successors)
+			{
+				if (mRemainingCounts[successor].fetch_sub(1u, std::memory_order_acq_rel) != 1u)
+				{
+					continue;
+				}
+
+				if (index == NO_TASK)
+				{
+					index = successor;
+				}
+				else
+				{
+					mJobSystem->Run([this, successor]() { runTask(successor); }, mCounter);
+				}
+			}
+		}
+	}
+
+	bool TaskGraph::isAcyclic() const
+	{
+		// Kahn's algorithm: every task is reached once all its predecessors are
+		std::vector<uint32_t> remainingCounts;
+		std::vector<uint32_t> readyTasks;
+		remainingCounts.reserve(mTasks.size());
+		for (uint32_t i = 0u; i < mTasks.size(); ++i)
+		{
+			remainingCounts.push_back(mTasks[i].DependencyCount);
+			if (mTasks[i].DependencyCount == 0u)
+			{
+				readyTasks.push_back(i);
+			}
+		}
+
+		size_t reachedCount = 0ul;
+		while (!readyTasks.empty())
+		{
+			const uint32_t index = readyTasks.back();
+			readyTasks.pop_back();
+			++reachedCount;
+
+			for (uint32_t successor : mTasks[index].Successors)
+			{
+				if (--remainingCounts[successor] == 0u)
+				{
+					readyTasks.push_back(successor);
+				}
+			}
+		}
+
+		return reachedCount == mTasks.size();
+	}
+
+#ifdef CAVE_BUILD_DEBUG
+	namespace TaskGraphTest
+	{
+		void Main()
+		{
+			LOGD(eLogChannel::CORE_THREAD, "======TaskGraph Test======");
+
+			JobSystem jobSystem(3u);
+
+			{
+				// a diamond: b and c wait for a, d waits for both, and every task sees what its predecessors wrote
+				uint32_t values[4] = { 0u, };
+				TaskGraph graph;
+				const uint32_t a = graph.AddTask([&values]() { values[0] = 1u; });
+				const uint32_t b = graph.AddTask([&values]() { values[1] = values[0] + 1u; });
+				const uint32_t c = graph.AddTask([&values]() { values[2] = values[0] + 2u; });
+				const uint32_t d = graph.AddTask([&values]() { values[3] = values[1] + values[2]; });
+				graph.AddDependency(a, b);
+				graph.AddDependency(a, c);
+				graph.AddDependency(b, d);
+				graph.AddDependency(c, d);
+				assert(graph.GetTaskCount() == 4u);
+
+				for (uint32_t run = 0u; run < 100u; ++run)
+				{
+					values[0] = values[1] = values[2] = values[3] = 0u;
+					graph.Run(jobSystem);
+					assert(values[3] == 5u);
+				}
+			}
+
+			{
+				// a wide fan-out and fan-in, with a ParallelFor nested in the middle layer
+				constexpr uint32_t WIDTH = 64u;
+				constexpr size_t COUNT = 1000ul;
+				std::atomic<uint32_t> started = 0u;
+				std::atomic<uint64_t> sum = 0ul;
+				bool bJoined = false;
+
+				TaskGraph graph;
+				const uint32_t source = graph.AddTask([&started]() { started.store(1u, std::memory_order_relaxed); });
+				const uint32_t sink = graph.AddTask([&sum, &bJoined]()
+					{
+						bJoined = sum.load(std::memory_order_relaxed) == WIDTH * COUNT * (COUNT - 1ul) / 2ul;
+					});
+				for (uint32_t i = 0u; i < WIDTH; ++i)
+				{
+					const uint32_t task = graph.AddTask([&jobSystem, &started, &sum]()
+						{
+							assert(started.load(std::memory_order_relaxed) == 1u);
+							jobSystem.ParallelFor(COUNT, 100ul, [&sum](size_t begin, size_t end)
+								{
+									uint64_t partialSum = 0ul;
+									for (size_t j = begin; j < end; ++j)
+									{
+										partialSum += j;
+									}
+									sum.fetch_add(partialSum, std::memory_order_relaxed);
+								});
+						});
+					graph.AddDependency(source, task);
+					graph.AddDependency(task, sink);
+				}
+
+				graph.Run(jobSystem);
+				assert(bJoined);
+			}
+
+			{
+				// a long chain runs as continuations of one job
+				constexpr uint32_t LENGTH = 10000u;
+				uint32_t next = 0u;
+				bool bInOrder = true;
+
+				TaskGraph graph;
+				uint32_t previous = NO_TASK;
+				for (uint32_t i = 0u; i < LENGTH; ++i)
+				{
+					const uint32_t task = graph.AddTask([&next, &bInOrder, i]()
+						{
+							bInOrder = bInOrder && next == i;
+							++next;
+						});
+					if (previous != NO_TASK)
+					{
+						graph.AddDependency(previous, task);
+					}
+					previous = task;
+				}
+
+				graph.Run(jobSystem);
+				assert(bInOrder && next == LENGTH);
+
+				graph.Clear();
+				assert(graph.GetTaskCount() == 0u);
+				graph.Run(jobSystem);
+			}
+
+			LOGD(eLogChannel::CORE_THREAD, "======TaskGraph Test Success======");
+		}
+	}
+#endif // CAVE_BUILD_DEBUG
+}
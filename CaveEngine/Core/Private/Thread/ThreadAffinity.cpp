@@ -0,0 +1,365 @@
+/*!
+ * Copyright (c) 2021 SWTube. All rights reserved.
+ * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+#ifdef __WIN32__
+#include <windows.h>
+#else
+#include <fstream>
+#include <string>
+
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "Assertion/Assert.h"
+#include "Debug/Log.h"
+#include "Thread/ThreadAffinity.h"
+
+namespace cave
+{
+	namespace
+	{
+		// Linux keeps 16 bytes of a thread name, the null character included
+		constexpr size_t MAX_THREAD_NAME_LENGTH = 15ul;
+
+#ifndef __WIN32__
+		bool readTopologyValue(uint32_t processor, const char* name, uint32_t& outValue)
+		{
+			std::string path = "/sys/devices/system/cpu/cpu" + std::to_string(processor) + "/topology/" + name;
+			std::ifstream file(path);
+			int64_t value = -1;
+
+			// core_id and physical_package_id are -1 where the platform does not report them
+			if (!(file >> value) || value < 0)
+			{
+				return false;
+			}
+
+			outValue = static_cast<uint32_t>(value);
+			return true;
+		}
+#else
+		using SetThreadDescriptionFunction = HRESULT(WINAPI*)(HANDLE thread, PCWSTR description);
+
+		// only Windows 10 1607 and later have it, linking to it would keep the engine from starting on older ones
+		SetThreadDescriptionFunction getSetThreadDescription()
+		{
+			static const SetThreadDescriptionFunction function = reinterpret_cast<SetThreadDescriptionFunction>(
+				GetProcAddress(GetModuleHandleW(L"kernel32.dll"), "SetThreadDescription"));
+
+			return function;
+		}
+#endif
+	}
+
+	CpuTopology::CpuTopology()
+	{
+		detect();
+
+		if (mCores.empty())
+		{
+			const uint32_t processorCount = std::max(std::thread::hardware_concurrency(), 1u);
+			for (uint32_t i = 0u; i < processorCount; ++i)
+			{
+				mCores.push_back({ 0u, i, { i } });
+			}
+		}
+
+		std::sort(mCores.begin(), mCores.end(), [](const Core& left, const Core& right)
+			{
+				return left.PackageId != right.PackageId ? left.PackageId < right.PackageId : left.CoreId < right.CoreId;
+			});
+
+		size_t maxSiblingCount = 0ul;
+		for (Core& core : mCores)
+		{
+			std::sort(core.Processors.begin(), core.Processors.end());
+			maxSiblingCount = std::max(maxSiblingCount, core.Processors.size());
+			if (core.PackageId + 1u > mPackageCount)
+			{
+				mPackageCount = core.PackageId + 1u;
+			}
+		}
+
+		for (size_t sibling = 0ul; sibling < maxSiblingCount; ++sibling)
+		{
+			for (const Core& core : mCores)
+			{
+				if (sibling < core.Processors.size())
+				{
+					mPlacement.push_back(core.Processors[sibling]);
+				}
+			}
+		}
+
+		LOGIF(eLogChannel::CORE_THREAD, "%u logical processors on %u cores in %u packages",
+			GetProcessorCount(), GetCoreCount(), GetPackageCount());
+	}
+
+	const CpuTopology& CpuTopology::Get()
+	{
+		static CpuTopology topology;
+
+		return topology;
+	}
+
+#ifdef __WIN32__
+	void CpuTopology::detect()
+	{
+		// processor groups are left out, only the group the process runs in is used
+		DWORD_PTR processMask = 0u;
+		DWORD_PTR systemMask = 0u;
+		if (!GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask))
+		{
+			return;
+		}
+
+		DWORD size = 0u;
+		GetLogicalProcessorInformation(nullptr, &size);
+		std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> infos(size / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+		if (infos.empty() || !GetLogicalProcessorInformation(infos.data(), &size))
+		{
+			return;
+		}
+
+		std::vector<ULONG_PTR> packageMasks;
+		for (const SYSTEM_LOGICAL_PROCESSOR_INFORMATION& info : infos)
+		{
+			if (info.Relationship == RelationProcessorPackage)
+			{
+				packageMasks.push_back(info.ProcessorMask);
+			}
+		}
+
+		uint32_t coreId = 0u;
+		for (const SYSTEM_LOGICAL_PROCESSOR_INFORMATION& info : infos)
+		{
+			if (info.Relationship != RelationProcessorCore)
+			{
+				continue;
+			}
+
+			Core core = { 0u, coreId++, {} };
+			for (uint32_t processor = 0u; processor < sizeof(ULONG_PTR) * 8u; ++processor)
+			{
+				const ULONG_PTR bit = static_cast<ULONG_PTR>(1u) << processor;
+				if ((info.ProcessorMask & bit) != 0u && (processMask & bit) != 0u)
+				{
+					core.Processors.push_back(processor);
+				}
+			}
+
+			for (uint32_t packageId = 0u; packageId < packageMasks.size(); ++packageId)
+			{
+				if ((packageMasks[packageId] & info.ProcessorMask) != 0u)
+				{
+					core.PackageId = packageId;
+				}
+			}
+
+			if (!core.Processors.empty())
+			{
+				mCores.push_back(std::move(core));
+			}
+		}
+	}
+#else
+	void CpuTopology::detect()
+	{
+		cpu_set_t allowedSet;
+		CPU_ZERO(&allowedSet);
+		if (sched_getaffinity(0, sizeof(allowedSet), &allowedSet) != 0)
+		{
+			LOGW(eLogChannel::CORE_THREAD, "sched_getaffinity failed, assuming every processor is a core");
+			return;
+		}
+
+		for (uint32_t processor = 0u; processor < CPU_SETSIZE; ++processor)
+		{
+			if (!CPU_ISSET(processor, &allowedSet))
+			{
+				continue;
+			}
+
+			uint32_t packageId = 0u;
+			uint32_t coreId = processor;
+			if (!readTopologyValue(processor, "physical_package_id", packageId) || !readTopologyValue(processor, "core_id", coreId))
+			{
+				// no sysfs in this container, or the value is unknown
+				packageId = 0u;
+				coreId = processor;
+			}
+
+			auto iter = std::find_if(mCores.begin(), mCores.end(), [packageId, coreId](const Core& core)
+				{
+					return core.PackageId == packageId && core.CoreId == coreId;
+				});
+
+			if (iter == mCores.end())
+			{
+				mCores.push_back({ packageId, coreId, { processor } });
+			}
+			else
+			{
+				iter->Processors.push_back(processor);
+			}
+		}
+	}
+#endif
+
+	uint32_t CpuTopology::GetDefaultWorkerCount() const
+	{
+		return GetCoreCount() > 1u ? GetCoreCount() - 1u : 1u;
+	}
+
+	uint32_t CpuTopology::GetProcessor(eThreadRole role, uint32_t index) const
+	{
+		const uint32_t processorCount = GetProcessorCount();
+		assert(processorCount > 0u);
+
+		// placement slots past the core count are SMT siblings
+		const uint32_t siblingCount = processorCount - GetCoreCount();
+		switch (role)
+		{
+		case eThreadRole::GAME:
+			return mPlacement[0];
+		case eThreadRole::RENDER:
+			return siblingCount > 0u ? mPlacement[GetCoreCount()] : mPlacement[1u % processorCount];
+		case eThreadRole::AUDIO:
+			return siblingCount > 1u ? mPlacement[GetCoreCount() + 1u] : mPlacement[2u % processorCount];
+		case eThreadRole::WORKER:
+			return mPlacement[(1u + index) % processorCount];
+		default:
+			assert(false);
+			return mPlacement[0];
+		}
+	}
+
+	void SetCurrentThreadName(const char* name)
+	{
+		char shortName[MAX_THREAD_NAME_LENGTH + 1ul];
+		std::strncpy(shortName, name, MAX_THREAD_NAME_LENGTH);
+		shortName[MAX_THREAD_NAME_LENGTH] = '\0';
+
+#ifdef __WIN32__
+		const SetThreadDescriptionFunction setThreadDescription = getSetThreadDescription();
+		if (setThreadDescription == nullptr)
+		{
+			return;
+		}
+
+		wchar_t wideName[MAX_THREAD_NAME_LENGTH + 1ul];
+		size_t i = 0ul;
+		for (; shortName[i] != '\0'; ++i)
+		{
+			wideName[i] = static_cast<wchar_t>(static_cast<unsigned char>(shortName[i]));
+		}
+		wideName[i] = L'\0';
+		setThreadDescription(GetCurrentThread(), wideName);
+#else
+		pthread_setname_np(pthread_self(), shortName);
+#endif
+	}
+
+	bool PinCurrentThread(uint32_t processor)
+	{
+#ifdef __WIN32__
+		if (processor >= sizeof(DWORD_PTR) * 8u)
+		{
+			return false;
+		}
+
+		return SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1u) << processor) != 0u;
+#else
+		if (processor >= CPU_SETSIZE)
+		{
+			return false;
+		}
+
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		CPU_SET(processor, &set);
+
+		return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#endif
+	}
+
+	bool PinCurrentThread(eThreadRole role, uint32_t index)
+	{
+		const uint32_t processor = CpuTopology::Get().GetProcessor(role, index);
+		if (!PinCurrentThread(processor))
+		{
+			LOGWF(eLogChannel::CORE_THREAD, "cannot pin thread to processor %u", processor);
+			return false;
+		}
+
+		return true;
+	}
+
+#ifdef CAVE_BUILD_DEBUG
+	namespace ThreadAffinityTest
+	{
+		void Main()
+		{
+			LOGD(eLogChannel::CORE_THREAD, "======ThreadAffinity Test======");
+
+			const CpuTopology& topology = CpuTopology::Get();
+			assert(topology.GetCoreCount() > 0u);
+			assert(topology.GetProcessorCount() >= topology.GetCoreCount());
+			assert(topology.GetPackageCount() > 0u);
+			assert(topology.GetDefaultWorkerCount() > 0u);
+			assert(topology.GetDefaultWorkerCount() <= topology.GetProcessorCount());
+
+			// every allowed processor is in exactly one core
+			std::vector<uint32_t> processors;
+			for (const CpuTopology::Core& core : topology.GetCores())
+			{
+				assert(!core.Processors.empty());
+				processors.insert(processors.end(), core.Processors.begin(), core.Processors.end());
+			}
+			std::sort(processors.begin(), processors.end());
+			assert(std::adjacent_find(processors.begin(), processors.end()) == processors.end());
+			assert(processors.size() == topology.GetProcessorCount());
+
+			// the first workers get physical cores of their own
+			const uint32_t game = topology.GetProcessor(eThreadRole::GAME);
+			for (uint32_t i = 0u; i + 1u < topology.GetCoreCount(); ++i)
+			{
+				const uint32_t worker = topology.GetProcessor(eThreadRole::WORKER, i);
+				for (const CpuTopology::Core& core : topology.GetCores())
+				{
+					const bool bHasWorker = std::find(core.Processors.begin(), core.Processors.end(), worker) != core.Processors.end();
+					const bool bHasGame = std::find(core.Processors.begin(), core.Processors.end(), game) != core.Processors.end();
+					assert(!(bHasWorker && bHasGame));
+				}
+			}
+
+			std::thread thread([&topology]()
+				{
+					SetCurrentThreadName("CaveAffinityTestThread");
+					const bool bPinned = PinCurrentThread(eThreadRole::WORKER, 0u);
+#ifndef __WIN32__
+					char name[32];
+					pthread_getname_np(pthread_self(), name, sizeof(name));
+					assert(std::strcmp(name, "CaveAffinityTes") == 0);
+
+					if (bPinned)
+					{
+						assert(sched_getcpu() == static_cast<int>(topology.GetProcessor(eThreadRole::WORKER, 0u)));
+					}
+#endif
+					(void)bPinned;
+				});
+			thread.join();
+
+			LOGD(eLogChannel::CORE_THREAD, "======ThreadAffinity Test Success======");
+		}
+	}
+#endif // CAVE_BUILD_DEBUG
+}
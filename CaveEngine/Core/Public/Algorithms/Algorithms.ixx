@@ -0,0 +1,563 @@
+/*!
+ * Copyright (c) 2021 SWTube. All rights reserved.
+ * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
+ */
+
+module;
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+	#define CAVE_ALGORITHMS_SSE2 1
+	#include <emmintrin.h>
+#else
+	#define CAVE_ALGORITHMS_SSE2 0
+#endif
+
+#include "CoreTypes.h"
+
+#include "Assertion/Assert.h"
+#include "Debug/Log.h"
+
+#ifdef CAVE_BUILD_DEBUG
+#include <random>
+#endif // CAVE_BUILD_DEBUG
+
+export module cave.Core.Algorithms;
+
+/*
+ * Single-threaded sorting and searching for the small and medium arrays of hot paths:
+ * render commands sorted by key, keyframe times searched every frame.
+ * Thread/ParallelAlgorithms.h has the versions that spread large arrays over the job system.
+ */
+namespace cave
+{
+	// arrays up to this long are sorted by a sorting network in SSE2 registers
+	export constexpr size_t SORTING_NETWORK_MAX_COUNT = 16ul;
+	// shorter arrays are insertion sorted, radix passes cost more than they save
+	export constexpr size_t RADIX_SORT_MIN_COUNT = 64ul;
+
+	namespace
+	{
+		template <typename Key, typename Value>
+		void insertionSort(Key* keys, Value* values, size_t count)
+		{
+			for (size_t i = 1ul; i < count; ++i)
+			{
+				const Key key = keys[i];
+				Value value = std::move(values[i]);
+				size_t j = i;
+				for (; j > 0ul && key < keys[j - 1ul]; --j)
+				{
+					keys[j] = keys[j - 1ul];
+					values[j] = std::move(values[j - 1ul]);
+				}
+				keys[j] = key;
+				values[j] = std::move(value);
+			}
+		}
+
+		template <typename Key>
+		void insertionSort(Key* keys, size_t count)
+		{
+			for (size_t i = 1ul; i < count; ++i)
+			{
+				const Key key = keys[i];
+				size_t j = i;
+				for (; j > 0ul && key < keys[j - 1ul]; --j)
+				{
+					keys[j] = keys[j - 1ul];
+				}
+				keys[j] = key;
+			}
+		}
+
+		// stands in for the values of a sort without any, the radix passes then only move keys
+		struct NoValue
+		{
+			NoValue& operator[](size_t)
+			{
+				return *this;
+			}
+		};
+
+		template <typename Key, typename Values>
+		void radixSort(Key* keys, Values values, Key* keyBuffer, Values valueBuffer, size_t count)
+		{
+			constexpr size_t RADIX = 256ul;
+			constexpr size_t PASS_COUNT = sizeof(Key);
+
+			// every pass's histogram from one read of the keys
+			size_t histograms[PASS_COUNT][RADIX] = {};
+			for (size_t i = 0ul; i < count; ++i)
+			{
+				const Key key = keys[i];
+				for (size_t pass = 0ul; pass < PASS_COUNT; ++pass)
+				{
+					++histograms[pass][(key >> (pass * 8ul)) & (RADIX - 1ul)];
+				}
+			}
+
+			Key* sourceKeys = keys;
+			Key* destinationKeys = keyBuffer;
+			Values sourceValues = values;
+			Values destinationValues = valueBuffer;
+			for (size_t pass = 0ul; pass < PASS_COUNT; ++pass)
+			{
+				size_t* offsets = histograms[pass];
+
+				// every key has the same byte here, the pass would not move anything
+				if (offsets[(keys[0] >> (pass * 8ul)) & (RADIX - 1ul)] == count)
+				{
+					continue;
+				}
+
+				size_t offset = 0ul;
+				for (size_t digit = 0ul; digit < RADIX; ++digit)
+				{
+					const size_t digitCount = offsets[digit];
+					offsets[digit] = offset;
+					offset += digitCount;
+				}
+
+				for (size_t i = 0ul; i < count; ++i)
+				{
+					const Key key = sourceKeys[i];
+					const size_t destination = offsets[(key >> (pass * 8ul)) & (RADIX - 1ul)]++;
+					destinationKeys[destination] = key;
+					destinationValues[destination] = std::move(sourceValues[i]);
+				}
+
+				std::swap(sourceKeys, destinationKeys);
+				std::swap(sourceValues, destinationValues);
+			}
+
+			if (sourceKeys != keys)
+			{
+				for (size_t i = 0ul; i < count; ++i)
+				{
+					keys[i] = sourceKeys[i];
+					values[i] = std::move(sourceValues[i]);
+				}
+			}
+		}
+
+#if CAVE_ALGORITHMS_SSE2
+		// SSE2 has no 32-bit min and max, a compare picks the lanes
+		void compareExchange(__m128i& low, __m128i& high)
+		{
+			const __m128i greater = _mm_cmpgt_epi32(low, high);
+			const __m128i minimum = _mm_or_si128(_mm_and_si128(greater, high), _mm_andnot_si128(greater, low));
+			high = _mm_or_si128(_mm_and_si128(greater, low), _mm_andnot_si128(greater, high));
+			low = minimum;
+		}
+
+		__m128i reverse(__m128i value)
+		{
+			return _mm_shuffle_epi32(value, _MM_SHUFFLE(0, 1, 2, 3));
+		}
+
+		/*Sorts the four lanes of a bitonic register.*/
+		__m128i mergeBitonic(__m128i value)
+		{
+			// lanes two apart, then neighbours
+			__m128i low = value;
+			__m128i high = _mm_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2));
+			compareExchange(low, high);
+			value = _mm_unpacklo_epi64(low, high);
+
+			low = value;
+			high = _mm_shuffle_epi32(value, _MM_SHUFFLE(2, 3, 0, 1));
+			compareExchange(low, high);
+			const __m128i oddLanes = _mm_set_epi32(-1, 0, -1, 0);
+			return _mm_or_si128(_mm_and_si128(oddLanes, high), _mm_andnot_si128(oddLanes, low));
+		}
+
+		/*Merges two sorted registers into eight sorted lanes, first the lower four.*/
+		void merge4(__m128i& first, __m128i& second)
+		{
+			second = reverse(second);
+			compareExchange(first, second);
+			first = mergeBitonic(first);
+			second = mergeBitonic(second);
+		}
+
+		/*Sorts the eight lanes of a bitonic pair of registers.*/
+		void mergeBitonic8(__m128i& first, __m128i& second)
+		{
+			compareExchange(first, second);
+			first = mergeBitonic(first);
+			second = mergeBitonic(second);
+		}
+
+		/*
+		 * Bitonic sorting network over 16 lanes: every column of the four registers is sorted,
+		 * the registers transposed into four sorted rows, and the rows merged pairwise.
+		 */
+		void sortNetwork16(__m128i& r0, __m128i& r1, __m128i& r2, __m128i& r3)
+		{
+			compareExchange(r0, r1);
+			compareExchange(r2, r3);
+			compareExchange(r0, r2);
+			compareExchange(r1, r3);
+			compareExchange(r1, r2);
+
+			const __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+			const __m128i t1 = _mm_unpacklo_epi32(r2, r3);
+			const __m128i t2 = _mm_unpackhi_epi32(r0, r1);
+			const __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+			r0 = _mm_unpacklo_epi64(t0, t1);
+			r1 = _mm_unpackhi_epi64(t0, t1);
+			r2 = _mm_unpacklo_epi64(t2, t3);
+			r3 = _mm_unpackhi_epi64(t2, t3);
+
+			merge4(r0, r1);
+			merge4(r2, r3);
+
+			// the second run reversed makes the 16 lanes bitonic
+			__m128i reversed2 = reverse(r3);
+			__m128i reversed3 = reverse(r2);
+			compareExchange(r0, reversed2);
+			compareExchange(r1, reversed3);
+			mergeBitonic8(r0, r1);
+			mergeBitonic8(reversed2, reversed3);
+			r2 = reversed2;
+			r3 = reversed3;
+		}
+
+		/*signBias flips the sign bit on the way in and out, so unsigned keys compare as signed lanes.*/
+		void sortNetwork(int32_t* data, size_t count, int32_t signBias)
+		{
+			alignas(16) int32_t lanes[SORTING_NETWORK_MAX_COUNT];
+			for (size_t i = 0ul; i < SORTING_NETWORK_MAX_COUNT; ++i)
+			{
+				// padding sorts behind every key
+				lanes[i] = i < count ? data[i] ^ signBias : INT32_MAX;
+			}
+
+			__m128i* registers = reinterpret_cast<__m128i*>(lanes);
+			__m128i r0 = _mm_load_si128(registers);
+			__m128i r1 = _mm_load_si128(registers + 1);
+			__m128i r2 = _mm_load_si128(registers + 2);
+			__m128i r3 = _mm_load_si128(registers + 3);
+			sortNetwork16(r0, r1, r2, r3);
+			_mm_store_si128(registers, r0);
+			_mm_store_si128(registers + 1, r1);
+			_mm_store_si128(registers + 2, r2);
+			_mm_store_si128(registers + 3, r3);
+
+			for (size_t i = 0ul; i < count; ++i)
+			{
+				data[i] = lanes[i] ^ signBias;
+			}
+		}
+#endif
+	}
+
+	/*Sorts up to SORTING_NETWORK_MAX_COUNT keys branch-free in SSE2 registers, insertion sort without SSE2.*/
+	export void SortSmall(int32_t* data, size_t count)
+	{
+		assert(count <= SORTING_NETWORK_MAX_COUNT);
+
+#if CAVE_ALGORITHMS_SSE2
+		sortNetwork(data, count, 0);
+#else
+		insertionSort(data, count);
+#endif
+	}
+
+	export void SortSmall(uint32_t* data, size_t count)
+	{
+		assert(count <= SORTING_NETWORK_MAX_COUNT);
+
+#if CAVE_ALGORITHMS_SSE2
+		sortNetwork(reinterpret_cast<int32_t*>(data), count, INT32_MIN);
+#else
+		insertionSort(data, count);
+#endif
+	}
+
+	/*
+	 * LSD radix sort of 32 or 64-bit unsigned keys, a byte per pass. One read of the keys builds every histogram,
+	 * and passes on a byte all keys share are skipped, so 64-bit keys that use few bits sort as fast as narrow ones.
+	 * Stable. Needs a buffer as large as the keys, allocated per call unless keyBuffer is given.
+	 */
+	export template <typename Key>
+	void RadixSort(Key* keys, size_t count, Key* keyBuffer = nullptr)
+	{
+		static_assert(std::is_same_v<Key, uint32_t> || std::is_same_v<Key, uint64_t>, "radix sort orders 32 or 64-bit unsigned keys");
+
+		if constexpr (std::is_same_v<Key, uint32_t>)
+		{
+			if (count <= SORTING_NETWORK_MAX_COUNT)
+			{
+				SortSmall(keys, count);
+				return;
+			}
+		}
+		if (count < RADIX_SORT_MIN_COUNT)
+		{
+			insertionSort(keys, count);
+			return;
+		}
+
+		std::vector<Key> buffer;
+		if (keyBuffer == nullptr)
+		{
+			buffer.resize(count);
+			keyBuffer = buffer.data();
+		}
+
+		radixSort(keys, NoValue(), keyBuffer, NoValue(), count);
+	}
+
+	/*
+	 * values[i] moves along with keys[i], e.g. the index of the render command a sort key belongs to.
+	 * Value has to be default constructible and movable.
+	 */
+	export template <typename Key, typename Value>
+	void RadixSort(Key* keys, Value* values, size_t count)
+	{
+		static_assert(std::is_same_v<Key, uint32_t> || std::is_same_v<Key, uint64_t>, "radix sort orders 32 or 64-bit unsigned keys");
+
+		if (count < RADIX_SORT_MIN_COUNT)
+		{
+			insertionSort(keys, values, count);
+			return;
+		}
+
+		std::vector<Key> keyBuffer(count);
+		std::vector<Value> valueBuffer(count);
+		radixSort(keys, values, keyBuffer.data(), valueBuffer.data(), count);
+	}
+
+	/*
+	 * std::lower_bound without a branch on the comparison: the loop runs log2(count) times whatever the keys,
+	 * and the half to take is computed, so mispredictions don't cost ~15 cycles a level.
+	 */
+	export template <typename T, typename Compare = std::less<>>
+	const T* BranchlessLowerBound(const T* first, size_t count, const T& value, Compare compare = Compare())
+	{
+		if (count == 0ul)
+		{
+			return first;
+		}
+
+		const T* base = first;
+		while (count > 1ul)
+		{
+			const size_t half = count / 2ul;
+			// a product rather than ?:, which compilers turn back into a branch when they guess it predictable
+			base += static_cast<size_t>(compare(base[half], value)) * half;
+			count -= half;
+		}
+
+		return base + static_cast<size_t>(compare(*base, value));
+	}
+
+	/**
+	 *
+	 * @brief Sorted array in Eytzinger (breadth-first) order for lower bound searches
+	 * @details Element k has its children at 2k and 2k + 1, so the first levels of every search share a few cache lines
+	 * 			and the 16 nodes four levels below the current one are contiguous: the search prefetches them
+	 * 			while it compares, and each level costs a compare instead of a cache miss.
+	 * 			@n@n
+	 * 			Built once from a sorted array and then only searched, like the keyframe times of an animation.
+	 * 			LowerBound returns the index into that sorted array.
+	 *
+	 */
+	export template <typename T, typename Compare = std::less<>>
+	class EytzingerArray final
+	{
+	public:
+		EytzingerArray(const T* sorted, size_t count, Compare compare = Compare())
+			: mData(count + 1ul)
+			, mIndices(count + 1ul)
+			, mCompare(compare)
+		{
+			assert(std::is_sorted(sorted, sorted + count, compare));
+			assert(count < UINT32_MAX);
+
+			// index 0 is not a node, a search that runs off the tree ends there
+			build(sorted, 0ul, 1ul);
+			mIndices[0] = static_cast<uint32_t>(count);
+		}
+
+		/*Index in the sorted array of the first element not less than value, the element count if there is none.*/
+		size_t LowerBound(const T& value) const
+		{
+			const size_t count = mData.size() - 1ul;
+			size_t k = 1ul;
+			while (k <= count)
+			{
+#if CAVE_ALGORITHMS_SSE2
+				// the address may lie past the end, a prefetch never faults
+				_mm_prefetch(reinterpret_cast<const char*>(reinterpret_cast<uintptr_t>(mData.data()) + k * PREFETCH_DISTANCE * sizeof(T)), _MM_HINT_T0);
+#endif
+				k = 2ul * k + (mCompare(mData[k], value) ? 1ul : 0ul);
+			}
+
+			// the path went right, to greater elements, after the answer; the trailing ones undo those steps and the last left one
+			k >>= std::countr_one(k) + 1;
+
+			return mIndices[k];
+		}
+
+		size_t GetSize() const
+		{
+			return mData.size() - 1ul;
+		}
+
+	private:
+		// the descendants four levels below node k start at 16k
+		static constexpr size_t PREFETCH_DISTANCE = 16ul;
+
+		size_t build(const T* sorted, size_t index, size_t k)
+		{
+			if (k < mData.size())
+			{
+				index = build(sorted, index, 2ul * k);
+				mData[k] = sorted[index];
+				mIndices[k] = static_cast<uint32_t>(index);
+				index = build(sorted, index + 1ul, 2ul * k + 1ul);
+			}
+
+			return index;
+		}
+
+		std::vector<T> mData;
+		// position in the sorted array of every node
+		std::vector<uint32_t> mIndices;
+		Compare mCompare;
+	};
+
+#ifdef CAVE_BUILD_DEBUG
+	export namespace AlgorithmsTest
+	{
+		// DECLARATIONS
+
+		void Main();
+
+		void SortSmallTest();
+		void RadixSortTest();
+		void SearchTest();
+
+		// DEFINITIONS
+		void Main()
+		{
+			LOGD(eLogChannel::CORE, "======Algorithms Test======");
+			SortSmallTest();
+			RadixSortTest();
+			SearchTest();
+			LOGD(eLogChannel::CORE, "======Algorithms Test Success======");
+		}
+
+		void SortSmallTest()
+		{
+			LOGD(eLogChannel::CORE, "====SortSmall Test====");
+
+			std::mt19937 random(11u);
+			for (uint32_t round = 0u; round < 2000u; ++round)
+			{
+				const size_t count = round % (SORTING_NETWORK_MAX_COUNT + 1ul);
+
+				uint32_t keys[SORTING_NETWORK_MAX_COUNT];
+				int32_t signedKeys[SORTING_NETWORK_MAX_COUNT];
+				for (size_t i = 0ul; i < count; ++i)
+				{
+					// few distinct values, with the extremes, so duplicates and padding meet
+					const uint32_t choice = random() % 8u;
+					keys[i] = choice == 0u ? UINT32_MAX : choice == 1u ? 0u : random() % 1000u;
+					signedKeys[i] = choice == 0u ? INT32_MAX : choice == 1u ? INT32_MIN : static_cast<int32_t>(random() % 1000u) - 500;
+				}
+
+				std::vector<uint32_t> expected(keys, keys + count);
+				std::vector<int32_t> signedExpected(signedKeys, signedKeys + count);
+				std::sort(expected.begin(), expected.end());
+				std::sort(signedExpected.begin(), signedExpected.end());
+
+				SortSmall(keys, count);
+				SortSmall(signedKeys, count);
+				assert(std::equal(expected.begin(), expected.end(), keys));
+				assert(std::equal(signedExpected.begin(), signedExpected.end(), signedKeys));
+			}
+		}
+
+		void RadixSortTest()
+		{
+			LOGD(eLogChannel::CORE, "====RadixSort Test====");
+
+			std::mt19937_64 random(13u);
+			const size_t counts[] = { 0ul, 1ul, 10ul, 63ul, 64ul, 1000ul, 100000ul };
+			for (size_t count : counts)
+			{
+				std::vector<uint32_t> keys(count);
+				std::vector<uint64_t> wideKeys(count);
+				std::vector<uint64_t> narrowWideKeys(count);
+				for (size_t i = 0ul; i < count; ++i)
+				{
+					keys[i] = static_cast<uint32_t>(random());
+					wideKeys[i] = random();
+					narrowWideKeys[i] = random() % 5000u;
+				}
+
+				std::vector<uint32_t> expected = keys;
+				std::sort(expected.begin(), expected.end());
+				RadixSort(keys.data(), count);
+				assert(keys == expected);
+
+				std::vector<uint64_t> wideExpected = wideKeys;
+				std::sort(wideExpected.begin(), wideExpected.end());
+				RadixSort(wideKeys.data(), count);
+				assert(wideKeys == wideExpected);
+
+				// stable: values of equal keys keep their order
+				std::vector<uint32_t> values(count);
+				for (size_t i = 0ul; i < count; ++i)
+				{
+					values[i] = static_cast<uint32_t>(i);
+				}
+				std::vector<uint64_t> original = narrowWideKeys;
+				RadixSort(narrowWideKeys.data(), values.data(), count);
+				for (size_t i = 0ul; i < count; ++i)
+				{
+					assert(original[values[i]] == narrowWideKeys[i]);
+					assert(i == 0ul || narrowWideKeys[i - 1ul] < narrowWideKeys[i] || values[i - 1ul] < values[i]);
+				}
+			}
+		}
+
+		void SearchTest()
+		{
+			LOGD(eLogChannel::CORE, "====Search Test====");
+
+			std::mt19937 random(17u);
+			const size_t counts[] = { 0ul, 1ul, 2ul, 3ul, 7ul, 8ul, 100ul, 4095ul, 4096ul };
+			for (size_t count : counts)
+			{
+				std::vector<float> times(count);
+				for (float& time : times)
+				{
+					time = static_cast<float>(random() % 1000u) * 0.5f;
+				}
+				std::sort(times.begin(), times.end());
+
+				const EytzingerArray<float> eytzinger(times.data(), count);
+				assert(eytzinger.GetSize() == count);
+				for (uint32_t i = 0u; i < 1100u; ++i)
+				{
+					const float time = static_cast<float>(i) * 0.5f - 25.0f;
+					const size_t expected = static_cast<size_t>(std::lower_bound(times.begin(), times.end(), time) - times.begin());
+					assert(static_cast<size_t>(BranchlessLowerBound(times.data(), count, time) - times.data()) == expected);
+					assert(eytzinger.LowerBound(time) == expected);
+				}
+			}
+		}
+	}
+#endif // CAVE_BUILD_DEBUG
+}
@@ -3,134 +3,652 @@
  * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
  */
 
-import TArray;
+module;
 
-export module Matrix;
+#include <cmath>
+
+#include "CoreTypes.h"
+
+#include "Assertion/Assert.h"
+#include "Debug/Log.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+	#define CAVE_MATRIX_SSE 1
+	#include <emmintrin.h>
+#else
+	#define CAVE_MATRIX_SSE 0
+#endif
+
+export module cave.Core.Containers.Matrix;
+
+import cave.Core.Types.Float;
 
 namespace cave
 {
-	export class Matrix4x4Float
+	static_assert(sizeof(Float3) == 3 * sizeof(float), "TransformPoints streams Float3 arrays as packed floats");
+
+	/**
+	 *
+	 * @brief 4x4 single precision matrix
+	 * @details Row-major storage, column vector convention: a point p is transformed as M * p,
+	 * 			so the translation lives in the last column and A * B applies B first.@n
+	 * 			Multiplication and point transformation use SSE2 when it is available and fall back to scalar code otherwise.
+	 *
+	 */
+	export class alignas(16) Matrix4x4Float final
 	{
+		friend Matrix4x4Float operator*(const Matrix4x4Float& leftMatrix, const Matrix4x4Float& rightMatrix);
+		friend bool operator==(const Matrix4x4Float& leftMatrix, const Matrix4x4Float& rightMatrix);
+		friend bool operator!=(const Matrix4x4Float& leftMatrix, const Matrix4x4Float& rightMatrix);
 	public:
-		Matrix4x4Float()
-			: mMatrix{ 0.f }
-		{
+		Matrix4x4Float();
+		Matrix4x4Float(float x, float y, float z, float w);
+		explicit Matrix4x4Float(const float* rowMajor);
+
+		static Matrix4x4Float GetIdentity();
+		static Matrix4x4Float GetTranslationMatrix(float xDistance, float yDistance, float zDistance);
+		static Matrix4x4Float GetScaleMatrix(float xMultiple, float yMultiple, float zMultiple);
+		static Matrix4x4Float GetRotationMatrix(float xDegree, float yDegree, float zDegree);
+		static Matrix4x4Float GetAffine2D(const Float2& translation, float degree, const Float2& scale, float z);
+
+		// Element Access
+		float Get(size_t row, size_t column) const;
+		void Set(size_t row, size_t column, float value);
+		const float* GetData() const;
+
+		// Transforms, each one is applied after the current transform
+		void TranslationX(float distance);
+		void TranslationY(float distance);
+		void TranslationZ(float distance);
+		void Translation(float xDistance, float yDistance, float zDistance);
+
+		void ScaleX(float multiple);
+		void ScaleY(float multiple);
+		void ScaleZ(float multiple);
+		void Scale(float xMultiple, float yMultiple, float zMultiple);
+
+		void RotationX(float degree);
+		void RotationY(float degree);
+		void RotationZ(float degree);
+		void Rotation(float xDegree, float yDegree, float zDegree);
+
+		// Operations
+		Matrix4x4Float GetTranspose() const;
+		bool GetInverse(Matrix4x4Float& outInverse) const;
+		Float3 TransformPoint(const Float3& point) const;
+		void TransformPoints(const Float3* in, Float3* out, size_t count) const;
+
+		static constexpr float DEGREE_TO_RADIAN = 3.14159265358979323846f / 180.0f;
 
-		}
+	private:
+		float mMatrix[4][4];
+	};
+
+	Matrix4x4Float::Matrix4x4Float()
+		: mMatrix{ 0.f }
+	{
+	}
+
+	/**
+	 *
+	 * @brief Constructs a matrix whose last column is (x, y, z, w) and every other element is zero
+	 *
+	 */
+	Matrix4x4Float::Matrix4x4Float(float x, float y, float z, float w)
+		: mMatrix{ 0.f }
+	{
+		mMatrix[0][3] = x;
+		mMatrix[1][3] = y;
+		mMatrix[2][3] = z;
+		mMatrix[3][3] = w;
+	}
+
+	/**
+	 *
+	 * @brief Constructs a matrix from 16 floats in row-major order
+	 *
+	 */
+	Matrix4x4Float::Matrix4x4Float(const float* rowMajor)
+	{
+		assert(rowMajor != nullptr);
 
-		Matrix4x4Float(float x, float y, float z, float w)
-			: mMatrix{ 0.f }
+		for (size_t i = 0; i < 16; ++i)
 		{
-			mMatrix[0][3] = x;
-			mMatrix[1][3] = y;
-			mMatrix[2][3] = z;
-			mMatrix[3][3] = w;
+			mMatrix[i / 4][i % 4] = rowMajor[i];
 		}
+	}
 
-		static Matrix4x4Float GetIdentity()
+	Matrix4x4Float Matrix4x4Float::GetIdentity()
+	{
+		Matrix4x4Float matrix;
+
+		for (int i = 0; i < 4; ++i)
 		{
-			Matrix4x4Float matrix;
+			matrix.mMatrix[i][i] = 1;
+		}
 
-			for (int i = 0; i < 4; ++i)
-			{
-				matrix.mMatrix[i][i] = 1;
-			}
+		return matrix;
+	}
 
-			return matrix;
-		}
+	Matrix4x4Float Matrix4x4Float::GetTranslationMatrix(float xDistance, float yDistance, float zDistance)
+	{
+		Matrix4x4Float translationMatrix = GetIdentity();
+
+		translationMatrix.mMatrix[0][3] = xDistance;
+		translationMatrix.mMatrix[1][3] = yDistance;
+		translationMatrix.mMatrix[2][3] = zDistance;
+
+		return translationMatrix;
+	}
+
+	Matrix4x4Float Matrix4x4Float::GetScaleMatrix(float xMultiple, float yMultiple, float zMultiple)
+	{
+		Matrix4x4Float scaleMatrix;
+
+		scaleMatrix.mMatrix[0][0] = xMultiple;
+		scaleMatrix.mMatrix[1][1] = yMultiple;
+		scaleMatrix.mMatrix[2][2] = zMultiple;
+		scaleMatrix.mMatrix[3][3] = 1;
+
+		return scaleMatrix;
+	}
+
+	/**
+	 *
+	 * @brief Returns the rotation matrix of the given euler angles
+	 * @details Rotates around X first, then Y, then Z, i.e. Rz * Ry * Rx.
+	 * @param xDegree rotation around the x axis in degrees
+	 * @param yDegree rotation around the y axis in degrees
+	 * @param zDegree rotation around the z axis in degrees
+	 * @return The rotation matrix
+	 *
+	 */
+	Matrix4x4Float Matrix4x4Float::GetRotationMatrix(float xDegree, float yDegree, float zDegree)
+	{
+		float sx = std::sin(xDegree * DEGREE_TO_RADIAN);
+		float cx = std::cos(xDegree * DEGREE_TO_RADIAN);
+		float sy = std::sin(yDegree * DEGREE_TO_RADIAN);
+		float cy = std::cos(yDegree * DEGREE_TO_RADIAN);
+		float sz = std::sin(zDegree * DEGREE_TO_RADIAN);
+		float cz = std::cos(zDegree * DEGREE_TO_RADIAN);
+
+		Matrix4x4Float rotationMatrix;
+
+		rotationMatrix.mMatrix[0][0] = cz * cy;
+		rotationMatrix.mMatrix[0][1] = cz * sy * sx - sz * cx;
+		rotationMatrix.mMatrix[0][2] = cz * sy * cx + sz * sx;
+		rotationMatrix.mMatrix[1][0] = sz * cy;
+		rotationMatrix.mMatrix[1][1] = sz * sy * sx + cz * cx;
+		rotationMatrix.mMatrix[1][2] = sz * sy * cx - cz * sx;
+		rotationMatrix.mMatrix[2][0] = -sy;
+		rotationMatrix.mMatrix[2][1] = cy * sx;
+		rotationMatrix.mMatrix[2][2] = cy * cx;
+		rotationMatrix.mMatrix[3][3] = 1;
+
+		return rotationMatrix;
+	}
+
+	/**
+	 *
+	 * @brief Composes a 2D affine transform
+	 * @details Equivalent to Translation * RotationZ * Scale, built directly without any matrix multiplication.
+	 * @param translation translation on the xy plane
+	 * @param degree rotation around the z axis in degrees
+	 * @param scale scale on the xy plane
+	 * @param z depth written to every transformed point
+	 * @return The composed matrix
+	 *
+	 */
+	Matrix4x4Float Matrix4x4Float::GetAffine2D(const Float2& translation, float degree, const Float2& scale, float z)
+	{
+		float s = std::sin(degree * DEGREE_TO_RADIAN);
+		float c = std::cos(degree * DEGREE_TO_RADIAN);
+
+		Matrix4x4Float matrix;
 
-		void TranslationX(float distance)
+		matrix.mMatrix[0][0] = c * scale.X;
+		matrix.mMatrix[0][1] = -s * scale.Y;
+		matrix.mMatrix[0][3] = translation.X;
+		matrix.mMatrix[1][0] = s * scale.X;
+		matrix.mMatrix[1][1] = c * scale.Y;
+		matrix.mMatrix[1][3] = translation.Y;
+		matrix.mMatrix[2][2] = 1;
+		matrix.mMatrix[2][3] = z;
+		matrix.mMatrix[3][3] = 1;
+
+		return matrix;
+	}
+
+	float Matrix4x4Float::Get(size_t row, size_t column) const
+	{
+		assert(row < 4 && column < 4);
+
+		return mMatrix[row][column];
+	}
+
+	void Matrix4x4Float::Set(size_t row, size_t column, float value)
+	{
+		assert(row < 4 && column < 4);
+
+		mMatrix[row][column] = value;
+	}
+
+	const float* Matrix4x4Float::GetData() const
+	{
+		return &mMatrix[0][0];
+	}
+
+	void Matrix4x4Float::TranslationX(float distance)
+	{
+		Translation(distance, 0, 0);
+	}
+
+	void Matrix4x4Float::TranslationY(float distance)
+	{
+		Translation(0, distance, 0);
+	}
+
+	void Matrix4x4Float::TranslationZ(float distance)
+	{
+		Translation(0, 0, distance);
+	}
+
+	void Matrix4x4Float::Translation(float xDistance, float yDistance, float zDistance)
+	{
+		// T * M only adds w-scaled offsets to the first three rows
+		for (size_t column = 0; column < 4; ++column)
 		{
-			Translation(distance, 0, 0);
+			mMatrix[0][column] += xDistance * mMatrix[3][column];
+			mMatrix[1][column] += yDistance * mMatrix[3][column];
+			mMatrix[2][column] += zDistance * mMatrix[3][column];
 		}
+	}
+
+	void Matrix4x4Float::ScaleX(float multiple)
+	{
+		Scale(multiple, 1, 1);
+	}
+
+	void Matrix4x4Float::ScaleY(float multiple)
+	{
+		Scale(1, multiple, 1);
+	}
+
+	void Matrix4x4Float::ScaleZ(float multiple)
+	{
+		Scale(1, 1, multiple);
+	}
 
-		void TranslationY(float distance)
+	void Matrix4x4Float::Scale(float xMultiple, float yMultiple, float zMultiple)
+	{
+		// S * M scales the first three rows
+		for (size_t column = 0; column < 4; ++column)
 		{
-			Translation(0, distance, 0);
+			mMatrix[0][column] *= xMultiple;
+			mMatrix[1][column] *= yMultiple;
+			mMatrix[2][column] *= zMultiple;
 		}
+	}
+
+	void Matrix4x4Float::RotationX(float degree)
+	{
+		Rotation(degree, 0, 0);
+	}
+
+	void Matrix4x4Float::RotationY(float degree)
+	{
+		Rotation(0, degree, 0);
+	}
+
+	void Matrix4x4Float::RotationZ(float degree)
+	{
+		Rotation(0, 0, degree);
+	}
+
+	void Matrix4x4Float::Rotation(float xDegree, float yDegree, float zDegree)
+	{
+		*this = GetRotationMatrix(xDegree, yDegree, zDegree) * *this;
+	}
 
-		void TranslationZ(float distance)
+	Matrix4x4Float Matrix4x4Float::GetTranspose() const
+	{
+		Matrix4x4Float transpose;
+
+#if CAVE_MATRIX_SSE
+		__m128 row0 = _mm_loadu_ps(mMatrix[0]);
+		__m128 row1 = _mm_loadu_ps(mMatrix[1]);
+		__m128 row2 = _mm_loadu_ps(mMatrix[2]);
+		__m128 row3 = _mm_loadu_ps(mMatrix[3]);
+		_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+		_mm_storeu_ps(transpose.mMatrix[0], row0);
+		_mm_storeu_ps(transpose.mMatrix[1], row1);
+		_mm_storeu_ps(transpose.mMatrix[2], row2);
+		_mm_storeu_ps(transpose.mMatrix[3], row3);
+#else
+		for (size_t row = 0; row < 4; ++row)
 		{
-			Translation(0, 0, distance);
+			for (size_t column = 0; column < 4; ++column)
+			{
+				transpose.mMatrix[column][row] = mMatrix[row][column];
+			}
+		}
+#endif
+
+		return transpose;
+	}
+
+	/**
+	 *
+	 * @brief Computes the inverse matrix
+	 * @details Uses the cofactor expansion over 2x2 sub-determinants, which needs about a hundred multiplications
+	 * 			and no pivoting.
+	 * @param outInverse receives the inverse matrix, untouched if the matrix is singular
+	 * @return `true` if the matrix is invertible, `false` otherwise
+	 *
+	 */
+	bool Matrix4x4Float::GetInverse(Matrix4x4Float& outInverse) const
+	{
+		const float (&a)[4][4] = mMatrix;
+
+		float s0 = a[0][0] * a[1][1] - a[1][0] * a[0][1];
+		float s1 = a[0][0] * a[1][2] - a[1][0] * a[0][2];
+		float s2 = a[0][0] * a[1][3] - a[1][0] * a[0][3];
+		float s3 = a[0][1] * a[1][2] - a[1][1] * a[0][2];
+		float s4 = a[0][1] * a[1][3] - a[1][1] * a[0][3];
+		float s5 = a[0][2] * a[1][3] - a[1][2] * a[0][3];
+
+		float c5 = a[2][2] * a[3][3] - a[3][2] * a[2][3];
+		float c4 = a[2][1] * a[3][3] - a[3][1] * a[2][3];
+		float c3 = a[2][1] * a[3][2] - a[3][1] * a[2][2];
+		float c2 = a[2][0] * a[3][3] - a[3][0] * a[2][3];
+		float c1 = a[2][0] * a[3][2] - a[3][0] * a[2][2];
+		float c0 = a[2][0] * a[3][1] - a[3][0] * a[2][1];
+
+		float determinant = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+		if (determinant == 0.0f || !std::isfinite(determinant))
+		{
+			return false;
 		}
 
-		void Translation(float xDistance, float yDistance, float zDistance)
+		alignas(16) float adjugate[4][4] =
 		{
+			{ a[1][1] * c5 - a[1][2] * c4 + a[1][3] * c3, -a[0][1] * c5 + a[0][2] * c4 - a[0][3] * c3, a[3][1] * s5 - a[3][2] * s4 + a[3][3] * s3, -a[2][1] * s5 + a[2][2] * s4 - a[2][3] * s3 },
+			{ -a[1][0] * c5 + a[1][2] * c2 - a[1][3] * c1, a[0][0] * c5 - a[0][2] * c2 + a[0][3] * c1, -a[3][0] * s5 + a[3][2] * s2 - a[3][3] * s1, a[2][0] * s5 - a[2][2] * s2 + a[2][3] * s1 },
+			{ a[1][0] * c4 - a[1][1] * c2 + a[1][3] * c0, -a[0][0] * c4 + a[0][1] * c2 - a[0][3] * c0, a[3][0] * s4 - a[3][1] * s2 + a[3][3] * s0, -a[2][0] * s4 + a[2][1] * s2 - a[2][3] * s0 },
+			{ -a[1][0] * c3 + a[1][1] * c1 - a[1][2] * c0, a[0][0] * c3 - a[0][1] * c1 + a[0][2] * c0, -a[3][0] * s3 + a[3][1] * s1 - a[3][2] * s0, a[2][0] * s3 - a[2][1] * s1 + a[2][2] * s0 },
+		};
 
-		}
+		float inverseDeterminant = 1.0f / determinant;
 
-		void ScaleX(float multiple)
+#if CAVE_MATRIX_SSE
+		__m128 scale = _mm_set1_ps(inverseDeterminant);
+		for (size_t row = 0; row < 4; ++row)
 		{
-			Scale(multiple, 1, 1);
+			_mm_storeu_ps(outInverse.mMatrix[row], _mm_mul_ps(_mm_load_ps(adjugate[row]), scale));
 		}
-
-		void ScaleY(float multiple)
+#else
+		for (size_t row = 0; row < 4; ++row)
 		{
-			Scale(1, multiple, 1);
+			for (size_t column = 0; column < 4; ++column)
+			{
+				outInverse.mMatrix[row][column] = adjugate[row][column] * inverseDeterminant;
+			}
 		}
-
-		void ScaleZ(float multiple)
+#endif
+
+		return true;
+	}
+
+	/**
+	 *
+	 * @brief Transforms a single point
+	 * @details The point is extended with w = 1. The matrix is assumed to be affine, so no perspective division takes place.
+	 *
+	 */
+	Float3 Matrix4x4Float::TransformPoint(const Float3& point) const
+	{
+		Float3 result;
+		TransformPoints(&point, &result, 1);
+
+		return result;
+	}
+
+	/**
+	 *
+	 * @brief Transforms an array of points
+	 * @details Every point is extended with w = 1 and transformed as M * p. The matrix is assumed to be affine,
+	 * 			so no perspective division takes place.@n
+	 * 			With SSE2 the points are processed four at a time: 12 packed floats are transposed into x, y and z lanes,
+	 * 			transformed with three multiply-adds per row and transposed back.
+	 * 			in and out may be the same array.
+	 * 			@n@n
+	 * 			Complexity: linear in count
+	 * @param in points to transform
+	 * @param out receives the transformed points
+	 * @param count number of points
+	 *
+	 */
+	void Matrix4x4Float::TransformPoints(const Float3* in, Float3* out, size_t count) const
+	{
+		assert(count == 0 || (in != nullptr && out != nullptr));
+
+		size_t i = 0;
+
+#if CAVE_MATRIX_SSE
+		const __m128 m00 = _mm_set1_ps(mMatrix[0][0]);
+		const __m128 m01 = _mm_set1_ps(mMatrix[0][1]);
+		const __m128 m02 = _mm_set1_ps(mMatrix[0][2]);
+		const __m128 m03 = _mm_set1_ps(mMatrix[0][3]);
+		const __m128 m10 = _mm_set1_ps(mMatrix[1][0]);
+		const __m128 m11 = _mm_set1_ps(mMatrix[1][1]);
+		const __m128 m12 = _mm_set1_ps(mMatrix[1][2]);
+		const __m128 m13 = _mm_set1_ps(mMatrix[1][3]);
+		const __m128 m20 = _mm_set1_ps(mMatrix[2][0]);
+		const __m128 m21 = _mm_set1_ps(mMatrix[2][1]);
+		const __m128 m22 = _mm_set1_ps(mMatrix[2][2]);
+		const __m128 m23 = _mm_set1_ps(mMatrix[2][3]);
+
+		for (; i + 4 <= count; i += 4)
 		{
-			Scale(1, 1, multiple);
+			const float* source = reinterpret_cast<const float*>(in + i);
+			float* destination = reinterpret_cast<float*>(out + i);
+
+			// x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3
+			__m128 a = _mm_loadu_ps(source);
+			__m128 b = _mm_loadu_ps(source + 4);
+			__m128 c = _mm_loadu_ps(source + 8);
+
+			__m128 x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+			__m128 y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+			__m128 z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+
+			__m128 resultX = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, x), _mm_mul_ps(m01, y)), _mm_add_ps(_mm_mul_ps(m02, z), m03));
+			__m128 resultY = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m10, x), _mm_mul_ps(m11, y)), _mm_add_ps(_mm_mul_ps(m12, z), m13));
+			__m128 resultZ = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m20, x), _mm_mul_ps(m21, y)), _mm_add_ps(_mm_mul_ps(m22, z), m23));
+
+			a = _mm_shuffle_ps(_mm_shuffle_ps(resultX, resultY, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(resultZ, resultX, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+			b = _mm_shuffle_ps(_mm_shuffle_ps(resultY, resultZ, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(resultX, resultY, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+			c = _mm_shuffle_ps(_mm_shuffle_ps(resultZ, resultX, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(resultY, resultZ, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+
+			_mm_storeu_ps(destination, a);
+			_mm_storeu_ps(destination + 4, b);
+			_mm_storeu_ps(destination + 8, c);
 		}
+#endif
 
-		void Scale(float xMultiple, float yMultiple, float zMultiple)
+		for (; i < count; ++i)
 		{
+			float x = in[i].X;
+			float y = in[i].Y;
+			float z = in[i].Z;
 
+			out[i].X = mMatrix[0][0] * x + mMatrix[0][1] * y + mMatrix[0][2] * z + mMatrix[0][3];
+			out[i].Y = mMatrix[1][0] * x + mMatrix[1][1] * y + mMatrix[1][2] * z + mMatrix[1][3];
+			out[i].Z = mMatrix[2][0] * x + mMatrix[2][1] * y + mMatrix[2][2] * z + mMatrix[2][3];
 		}
+	}
+
+	Matrix4x4Float operator*(const Matrix4x4Float& leftMatrix, const Matrix4x4Float& rightMatrix)
+	{
+		Matrix4x4Float result;
+
+#if CAVE_MATRIX_SSE
+		__m128 row0 = _mm_loadu_ps(rightMatrix.mMatrix[0]);
+		__m128 row1 = _mm_loadu_ps(rightMatrix.mMatrix[1]);
+		__m128 row2 = _mm_loadu_ps(rightMatrix.mMatrix[2]);
+		__m128 row3 = _mm_loadu_ps(rightMatrix.mMatrix[3]);
 
-		void RotationX(float degree)
+		// each row of the result is a linear combination of the rows of rightMatrix
+		for (size_t row = 0; row < 4; ++row)
 		{
-			Rotation(degree, 0, 0);
+			const float* left = leftMatrix.mMatrix[row];
+			__m128 sum = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(_mm_set1_ps(left[0]), row0), _mm_mul_ps(_mm_set1_ps(left[1]), row1)),
+				_mm_add_ps(_mm_mul_ps(_mm_set1_ps(left[2]), row2), _mm_mul_ps(_mm_set1_ps(left[3]), row3)));
+			_mm_storeu_ps(result.mMatrix[row], sum);
 		}
-
-		void RotationY(float degree)
+#else
+		for (size_t row = 0; row < 4; ++row)
 		{
-			Rotation(0, degree, 0);
+			for (size_t column = 0; column < 4; ++column)
+			{
+				result.mMatrix[row][column] = leftMatrix.mMatrix[row][0] * rightMatrix.mMatrix[0][column]
+					+ leftMatrix.mMatrix[row][1] * rightMatrix.mMatrix[1][column]
+					+ leftMatrix.mMatrix[row][2] * rightMatrix.mMatrix[2][column]
+					+ leftMatrix.mMatrix[row][3] * rightMatrix.mMatrix[3][column];
+			}
 		}
+#endif
+
+		return result;
+	}
 
-		void RotationZ(float degree)
+	bool operator==(const Matrix4x4Float& leftMatrix, const Matrix4x4Float& rightMatrix)
+	{
+		for (size_t row = 0; row < 4; ++row)
 		{
-			Rotation(0, 0, degree);
+			for (size_t column = 0; column < 4; ++column)
+			{
+				if (leftMatrix.mMatrix[row][column] != rightMatrix.mMatrix[row][column])
+				{
+					return false;
+				}
+			}
 		}
 
-		void Rotation(float xDegree, float yDegree, float zDegree)
-		{
+		return true;
+	}
 
-		}
+	bool operator!=(const Matrix4x4Float& leftMatrix, const Matrix4x4Float& rightMatrix)
+	{
+		return !(leftMatrix == rightMatrix);
+	}
 
-	private:
-		Matrix4x4Float GetTranslationMatrix(float xDistance, float yDistance, float zDistance)
-		{
-			Matrix4x4Float translationMatrix(xDistance, yDistance, zDistance, 1);
+#ifdef CAVE_BUILD_DEBUG
+	export namespace MatrixTest
+	{
+		// DECLARATIONS
 
-			return translationMatrix;
-		}
+		void Main();
 
-		Matrix4x4Float GetScaleMatrix(float xMultiple, float yMultiple, float zMultiple)
-		{
-			Matrix4x4Float scaleMatrix;
+		void Multiply();
+		void Inverse();
+		void TransformPoints();
 
-			scaleMatrix.mMatrix[0][0] = xMultiple;
-			scaleMatrix.mMatrix[1][1] = yMultiple;
-			scaleMatrix.mMatrix[2][2] = zMultiple;
-			scaleMatrix.mMatrix[3][3] = 1;
+		bool isNearlyEqual(float lhs, float rhs);
 
-			return scaleMatrix;
+		// DEFINITIONS
+		void Main()
+		{
+			LOGD(eLogChannel::CORE_CONTAINER, "======Matrix Test======");
+			Multiply();
+			Inverse();
+			TransformPoints();
+			LOGD(eLogChannel::CORE_CONTAINER, "======Matrix Test Success======");
 		}
 
-		Matrix4x4Float GetRotaitonMatrix(float xDegree, float yDegree, float zDegree)
+		bool isNearlyEqual(float lhs, float rhs)
 		{
-			Matrix4x4Float rotationMatrix;
-
-
+			return std::fabs(lhs - rhs) <= 1e-4f * (1.0f + std::fabs(lhs) + std::fabs(rhs));
+		}
 
-			return rotationMatrix;
+		void Multiply()
+		{
+			LOGD(eLogChannel::CORE_CONTAINER, "====Multiply Test====");
+			{
+				Matrix4x4Float identity = Matrix4x4Float::GetIdentity();
+				Matrix4x4Float translation = Matrix4x4Float::GetTranslationMatrix(1.0f, 2.0f, 3.0f);
+				assert(identity * translation == translation);
+				assert(translation * identity == translation);
+
+				Matrix4x4Float scale = Matrix4x4Float::GetScaleMatrix(2.0f, 3.0f, 4.0f);
+				Matrix4x4Float composed = translation * scale;
+
+				Matrix4x4Float chained = Matrix4x4Float::GetIdentity();
+				chained.Scale(2.0f, 3.0f, 4.0f);
+				chained.Translation(1.0f, 2.0f, 3.0f);
+				assert(chained == composed);
+
+				Matrix4x4Float affine = Matrix4x4Float::GetAffine2D(Float2(5.0f, -3.0f), 30.0f, Float2(2.0f, 0.5f), 0.0f);
+				Matrix4x4Float expected = Matrix4x4Float::GetTranslationMatrix(5.0f, -3.0f, 0.0f) * Matrix4x4Float::GetRotationMatrix(0.0f, 0.0f, 30.0f) * Matrix4x4Float::GetScaleMatrix(2.0f, 0.5f, 1.0f);
+				for (size_t i = 0; i < 16; ++i)
+				{
+					assert(isNearlyEqual(affine.GetData()[i], expected.GetData()[i]));
+				}
+			}
 		}
 
-		friend Matrix4x4Float operator*(const Matrix4x4Float& leftMatrix, const Matrix4x4Float& rightMatrix);
+		void Inverse()
+		{
+			LOGD(eLogChannel::CORE_CONTAINER, "====Inverse Test====");
+			{
+				Matrix4x4Float matrix = Matrix4x4Float::GetTranslationMatrix(4.0f, -2.0f, 7.0f) * Matrix4x4Float::GetRotationMatrix(10.0f, 20.0f, 30.0f) * Matrix4x4Float::GetScaleMatrix(2.0f, 3.0f, 0.5f);
+				Matrix4x4Float inverse;
+				assert(matrix.GetInverse(inverse));
+
+				Matrix4x4Float product = matrix * inverse;
+				Matrix4x4Float identity = Matrix4x4Float::GetIdentity();
+				for (size_t i = 0; i < 16; ++i)
+				{
+					assert(isNearlyEqual(product.GetData()[i], identity.GetData()[i]));
+				}
+
+				Matrix4x4Float singular;
+				assert(!singular.GetInverse(inverse));
+			}
+		}
 
-	private:
-		float mMatrix[4][4];
-	};
-}
\ No newline at end of file
+		void TransformPoints()
+		{
+			LOGD(eLogChannel::CORE_CONTAINER, "====TransformPoints Test====");
+			{
+				Matrix4x4Float matrix = Matrix4x4Float::GetTranslationMatrix(1.0f, 2.0f, 3.0f) * Matrix4x4Float::GetRotationMatrix(15.0f, 25.0f, 35.0f);
+
+				Float3 points[11];
+				Float3 transformed[11];
+				for (size_t i = 0; i < 11; ++i)
+				{
+					points[i] = Float3(static_cast<float>(i), static_cast<float>(i) * 2.0f - 5.0f, 1.0f - static_cast<float>(i));
+				}
+
+				matrix.TransformPoints(points, transformed, 11);
+
+				for (size_t i = 0; i < 11; ++i)
+				{
+					const float* m = matrix.GetData();
+					assert(isNearlyEqual(transformed[i].X, m[0] * points[i].X + m[1] * points[i].Y + m[2] * points[i].Z + m[3]));
+					assert(isNearlyEqual(transformed[i].Y, m[4] * points[i].X + m[5] * points[i].Y + m[6] * points[i].Z + m[7]));
+					assert(isNearlyEqual(transformed[i].Z, m[8] * points[i].X + m[9] * points[i].Y + m[10] * points[i].Z + m[11]));
+				}
+
+				// in place
+				matrix.TransformPoints(points, points, 11);
+				for (size_t i = 0; i < 11; ++i)
+				{
+					assert(points[i] == transformed[i]);
+				}
+			}
+		}
+	}
+#endif
+}
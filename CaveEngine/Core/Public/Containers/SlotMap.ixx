@@ -0,0 +1,816 @@
+/*!
+ * Copyright (c) 2021 SWTube. All rights reserved.
+ * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
+ */
+
+module;
+
+#include "CoreTypes.h"
+
+#include "Assertion/Assert.h"
+#include "CoreGlobals.h"
+#include "Debug/Log.h"
+#include "Memory/MemoryPool.h"
+
+export module cave.Core.Containers.SlotMap;
+
+import cave.Core.Math;
+import cave.Core.Memory.Memory;
+
+namespace cave
+{
+	/**
+	 *
+	 * @brief Stable handle to an element of a cave::SlotMap
+	 * @details Index selects the slot, Generation is bumped every time the slot is released
+	 * 			so that a handle to an erased element never aliases a newer one.
+	 *
+	 */
+	export struct SlotId
+	{
+		uint32_t Index;
+		uint32_t Generation;
+
+		constexpr bool operator==(const SlotId& other) const = default;
+		constexpr bool operator!=(const SlotId& other) const = default;
+	};
+
+	export constexpr SlotId INVALID_SLOT_ID = { UINT32_MAX, UINT32_MAX };
+
+	/**
+	 *
+	 * @brief SlotMap is an associative container with stable ids and densely packed values.
+	 * @details Values live in a contiguous array so that iterating over them is a linear walk.@n
+	 * 			Every value is addressed through a SlotId which stays valid until the value is erased.
+	 * 			Erasing swaps the last value into the hole, so the order of the dense array is not preserved,
+	 * 			but ids held by other objects are never invalidated.
+	 * 			@n@n
+	 * 			Insert, Erase and Find are all constant time.
+	 *
+	 */
+	export class SlotMap final
+	{
+	public:
+		SlotMap();
+		SlotMap(MemoryPool& pool);
+		SlotMap(size_t capacity);
+		SlotMap(size_t capacity, MemoryPool& pool);
+		SlotMap(const SlotMap& other);
+		SlotMap(const SlotMap& other, MemoryPool& pool);
+		SlotMap(SlotMap&& other);
+		~SlotMap();
+		SlotMap& operator=(const SlotMap& other);
+		SlotMap& operator=(SlotMap&& other);
+
+		// Lookup
+		void* Find(SlotId id);
+		const void* Find(SlotId id) const;
+		bool Contains(SlotId id) const;
+
+		// Dense Access
+		void** GetData();
+		void* const* GetData() const;
+		void** begin();
+		void** end();
+		void* const* begin() const;
+		void* const* end() const;
+		SlotId GetIdAt(size_t denseIndex) const;
+
+		// Capacity
+		[[nodiscard]] bool IsEmpty() const;
+		size_t GetSize() const;
+		size_t GetCapacity() const;
+		void SetCapacity(size_t capacity);
+
+		// Modifiers
+		SlotId Insert(void* value);
+		bool Erase(SlotId id);
+		void Clear();
+
+		// Constants
+		static constexpr size_t INITIAL_CAPACITY = 16ul;
+		static constexpr size_t ALIGNED_BYTE = 16ul;
+		static constexpr uint32_t FREE_LIST_END = UINT32_MAX;
+	private:
+		void allocate(size_t capacity);
+		void deallocate();
+
+		MemoryPool* mPool = nullptr;
+		size_t mSize = 0ul;
+		size_t mCapacity = 0ul;
+		/* number of slots ever handed out, mSlotCount >= mSize */
+		size_t mSlotCount = 0ul;
+		uint32_t mFreeHead = FREE_LIST_END;
+		/* packed values, [0, mSize) */
+		void** mValues = nullptr;
+		/* slot index of each packed value */
+		uint32_t* mDenseToSlot = nullptr;
+		/* dense index of a live slot or the next free slot of a released one */
+		uint32_t* mSlotToDense = nullptr;
+		uint32_t* mGenerations = nullptr;
+	};
+
+	/**
+	 *
+	 * @brief (1) Constructs the slot map
+	 * @details Default constructor. Constructs an empty container with the default capacity.
+	 * 			@n@n
+	 * 			Complexity: constant
+	 *
+	 */
+	SlotMap::SlotMap()
+		: SlotMap(INITIAL_CAPACITY, gCoreMemoryPool)
+	{
+	}
+
+	/**
+	 *
+	 * @brief (2) Constructs the slot map
+	 * @details Constructs an empty container using pool as allocator.
+	 * 			@n@n
+	 * 			Complexity: constant
+	 * @param pool memory pool to use for all memory allocations of the container
+	 *
+	 */
+	SlotMap::SlotMap(MemoryPool& pool)
+		: SlotMap(INITIAL_CAPACITY, pool)
+	{
+	}
+
+	/**
+	 *
+	 * @brief (3) Constructs the slot map
+	 * @details Constructs an empty container which can hold capacity elements without reallocation.
+	 * 			@n@n
+	 * 			Complexity: constant
+	 * @param capacity number of elements to reserve storage for
+	 *
+	 */
+	SlotMap::SlotMap(size_t capacity)
+		: SlotMap(capacity, gCoreMemoryPool)
+	{
+	}
+
+	/**
+	 *
+	 * @brief (4) Constructs the slot map
+	 * @details Constructs an empty container which can hold capacity elements without reallocation, using pool as allocator.
+	 * 			@n@n
+	 * 			Complexity: constant
+	 * @param capacity number of elements to reserve storage for
+	 * @param pool memory pool to use for all memory allocations of the container
+	 *
+	 */
+	SlotMap::SlotMap(size_t capacity, MemoryPool& pool)
+		: mPool(&pool)
+	{
+		allocate(capacity > 0ul ? capacity : INITIAL_CAPACITY);
+	}
+
+	/**
+	 *
+	 * @brief (5) Constructs the slot map
+	 * @details Copy constructor. Ids of other are valid for the new container as well.
+	 * 			@n@n
+	 * 			Complexity: linear in the number of slots of other
+	 * @param other another container to be used as source to initialize the container with
+	 *
+	 */
+	SlotMap::SlotMap(const SlotMap& other)
+		: SlotMap(other, *other.mPool)
+	{
+	}
+
+	/**
+	 *
+	 * @brief (6) Constructs the slot map
+	 * @details Copy constructor using pool as allocator. Ids of other are valid for the new container as well.
+	 * 			@n@n
+	 * 			Complexity: linear in the number of slots of other
+	 * @param other another container to be used as source to initialize the container with
+	 * @param pool memory pool to use for all memory allocations of the container
+	 *
+	 */
+	SlotMap::SlotMap(const SlotMap& other, MemoryPool& pool)
+		: mPool(&pool)
+		, mSize(other.mSize)
+		, mSlotCount(other.mSlotCount)
+		, mFreeHead(other.mFreeHead)
+	{
+		// a moved-from source has no storage left
+		allocate(other.mCapacity > 0ul ? other.mCapacity : INITIAL_CAPACITY);
+		Memory::Memcpy(mValues, other.mValues, sizeof(void*) * mSize);
+		Memory::Memcpy(mDenseToSlot, other.mDenseToSlot, sizeof(uint32_t) * mSize);
+		Memory::Memcpy(mSlotToDense, other.mSlotToDense, sizeof(uint32_t) * mSlotCount);
+		Memory::Memcpy(mGenerations, other.mGenerations, sizeof(uint32_t) * mSlotCount);
+	}
+
+	/**
+	 *
+	 * @brief (7) Constructs the slot map
+	 * @details Move constructor. Takes over the storage of other, which is left empty.
+	 * 			@n@n
+	 * 			Complexity: constant
+	 * @param other another container to be used as source to initialize the container with
+	 *
+	 */
+	SlotMap::SlotMap(SlotMap&& other)
+		: mPool(other.mPool)
+		, mSize(other.mSize)
+		, mCapacity(other.mCapacity)
+		, mSlotCount(other.mSlotCount)
+		, mFreeHead(other.mFreeHead)
+		, mValues(other.mValues)
+		, mDenseToSlot(other.mDenseToSlot)
+		, mSlotToDense(other.mSlotToDense)
+		, mGenerations(other.mGenerations)
+	{
+		other.mSize = 0ul;
+		other.mCapacity = 0ul;
+		other.mSlotCount = 0ul;
+		other.mFreeHead = FREE_LIST_END;
+		other.mValues = nullptr;
+		other.mDenseToSlot = nullptr;
+		other.mSlotToDense = nullptr;
+		other.mGenerations = nullptr;
+	}
+
+	/**
+	 *
+	 * @brief Destructs the slot map.
+	 * @details The used storage is deallocated.@n
+	 * 			Note, that the elements are pointers, the pointed-to objects are not destroyed.
+	 * 			@n@n
+	 * 			Complexity: constant
+	 *
+	 */
+	SlotMap::~SlotMap()
+	{
+		deallocate();
+		mPool = nullptr;
+	}
+
+	/**
+	 *
+	 * @brief (1) Assigns values to the container
+	 * @details Copy assignment operator. Ids of other become valid for *this.
+	 * 			@n@n
+	 * 			Complexity: linear in the number of slots of other
+	 * @param other another container to use as data source
+	 * @return *this
+	 *
+	 */
+	SlotMap& SlotMap::operator=(const SlotMap& other)
+	{
+		if (this != &other)
+		{
+			if (mCapacity < other.mCapacity)
+			{
+				deallocate();
+				allocate(other.mCapacity);
+			}
+
+			mSize = other.mSize;
+			mSlotCount = other.mSlotCount;
+			mFreeHead = other.mFreeHead;
+			Memory::Memcpy(mValues, other.mValues, sizeof(void*) * mSize);
+			Memory::Memcpy(mDenseToSlot, other.mDenseToSlot, sizeof(uint32_t) * mSize);
+			Memory::Memcpy(mSlotToDense, other.mSlotToDense, sizeof(uint32_t) * mSlotCount);
+			Memory::Memcpy(mGenerations, other.mGenerations, sizeof(uint32_t) * mSlotCount);
+		}
+
+		return *this;
+	}
+
+	/**
+	 *
+	 * @brief (2) Assigns values to the container
+	 * @details Move assignment operator. Takes over the storage of other, which is left empty.
+	 * 			@n@n
+	 * 			Complexity: constant
+	 * @param other another container to use as data source
+	 * @return *this
+	 *
+	 */
+	SlotMap& SlotMap::operator=(SlotMap&& other)
+	{
+		if (this != &other)
+		{
+			deallocate();
+
+			mPool = other.mPool;
+			mSize = other.mSize;
+			mCapacity = other.mCapacity;
+			mSlotCount = other.mSlotCount;
+			mFreeHead = other.mFreeHead;
+			mValues = other.mValues;
+			mDenseToSlot = other.mDenseToSlot;
+			mSlotToDense = other.mSlotToDense;
+			mGenerations = other.mGenerations;
+
+			other.mSize = 0ul;
+			other.mCapacity = 0ul;
+			other.mSlotCount = 0ul;
+			other.mFreeHead = FREE_LIST_END;
+			other.mValues = nullptr;
+			other.mDenseToSlot = nullptr;
+			other.mSlotToDense = nullptr;
+			other.mGenerations = nullptr;
+		}
+
+		return *this;
+	}
+
+	/**
+	 *
+	 * @brief (1) Finds element with specific id
+	 * @details Returns the value addressed by id, or nullptr if it has been erased.
+	 * 			@n@n
+	 * 			Complexity: constant
+	 * @param id id of the element to search for
+	 * @return The value addressed by id, nullptr if no such element is found
+	 *
+	 */
+	void* SlotMap::Find(SlotId id)
+	{
+		if (!Contains(id))
+		{
+			return nullptr;
+		}
+
+		return mValues[mSlotToDense[id.Index]];
+	}
+
+	/**
+	 *
+	 * @brief (2) Finds element with specific id
+	 * @details Returns the value addressed by id, or nullptr if it has been erased.
+	 * 			@n@n
+	 * 			Complexity: constant
+	 * @param id id of the element to search for
+	 * @return The value addressed by id, nullptr if no such element is found
+	 *
+	 */
+	const void* SlotMap::Find(SlotId id) const
+	{
+		if (!Contains(id))
+		{
+			return nullptr;
+		}
+
+		return mValues[mSlotToDense[id.Index]];
+	}
+
+	/**
+	 *
+	 * @brief Checks if the container contains element with specific id
+	 * @details The generation of id has to match the slot, so ids of erased elements are rejected.
+	 * 			@n@n
+	 * 			Complexity: constant
+	 * @param id id of the element to search for
+	 * @return `true` if there is such an element, otherwise `false`.
+	 *
+	 */
+	bool SlotMap::Contains(SlotId id) const
+	{
+		return id.Index < mSlotCount && mGenerations[id.Index] == id.Generation;
+	}
+
+	/**
+	 *
+	 * @brief Direct access to the packed values
+	 * @details The range [GetData(), GetData() + GetSize()) is valid until the next Insert, Erase or SetCapacity.
+	 * 			@n@n
+	 * 			Complexity: constant
+	 * @return Pointer to the first packed value
+	 *
+	 */
+	void** SlotMap::GetData()
+	{
+		return mValues;
+	}
+
+	void* const* SlotMap::GetData() const
+	{
+		return mValues;
+	}
+
+	void** SlotMap::begin()
+	{
+		return mValues;
+	}
+
+	void** SlotMap::end()
+	{
+		return mValues + mSize;
+	}
+
+	void* const* SlotMap::begin() const
+	{
+		return mValues;
+	}
+
+	void* const* SlotMap::end() const
+	{
+		return mValues + mSize;
+	}
+
+	/**
+	 *
+	 * @brief Returns the id of a packed value
+	 * @details Useful when iterating over the dense values and a stable handle of the current value is needed.
+	 * 			@n@n
+	 * 			Complexity: constant
+	 * @param denseIndex position of the value in the dense array
+	 * @return Id addressing the value at denseIndex
+	 *
+	 */
+	SlotId SlotMap::GetIdAt(size_t denseIndex) const
+	{
+		assert(denseIndex < mSize);
+
+		uint32_t slot = mDenseToSlot[denseIndex];
+
+		return SlotId{ slot, mGenerations[slot] };
+	}
+
+	[[nodiscard]] bool SlotMap::IsEmpty() const
+	{
+		return mSize == 0ul;
+	}
+
+	size_t SlotMap::GetSize() const
+	{
+		return mSize;
+	}
+
+	size_t SlotMap::GetCapacity() const
+	{
+		return mCapacity;
+	}
+
+	/**
+	 *
+	 * @brief Reserves storage
+	 * @details If capacity is greater than the current GetCapacity(), new storage is allocated. Ids stay valid.
+	 * 			@n@n
+	 * 			Complexity: at most linear in the number of slots
+	 * @param capacity new capacity of the container
+	 *
+	 */
+	void SlotMap::SetCapacity(size_t capacity)
+	{
+		if (capacity <= mCapacity)
+		{
+			return;
+		}
+
+		assert(capacity < FREE_LIST_END);
+
+		void** values = mValues;
+		uint32_t* denseToSlot = mDenseToSlot;
+		uint32_t* slotToDense = mSlotToDense;
+		uint32_t* generations = mGenerations;
+		size_t oldCapacity = mCapacity;
+
+		allocate(capacity);
+		Memory::Memcpy(mValues, values, sizeof(void*) * mSize);
+		Memory::Memcpy(mDenseToSlot, denseToSlot, sizeof(uint32_t) * mSize);
+		Memory::Memcpy(mSlotToDense, slotToDense, sizeof(uint32_t) * mSlotCount);
+		Memory::Memcpy(mGenerations, generations, sizeof(uint32_t) * mSlotCount);
+
+		if (values == nullptr)
+		{
+			return;
+		}
+
+		mPool->Deallocate(values, sizeof(void*) * oldCapacity);
+		mPool->Deallocate(denseToSlot, sizeof(uint32_t) * oldCapacity);
+		mPool->Deallocate(slotToDense, sizeof(uint32_t) * oldCapacity);
+		mPool->Deallocate(generations, sizeof(uint32_t) * oldCapacity);
+	}
+
+	/**
+	 *
+	 * @brief Inserts an element
+	 * @details Appends value to the dense array and hands out an id, reusing a released slot if there is one.
+	 * 			@n@n
+	 * 			Complexity: amortized constant
+	 * @param value the value of the element to insert
+	 * @return Stable id of the inserted element
+	 *
+	 */
+	SlotId SlotMap::Insert(void* value)
+	{
+		if (mSize >= mCapacity)
+		{
+#if CAPACITY_INCREASE_MODE == CAPACITY_INCREASE_MODE_DOUBLE
+			// a moved-from map has no capacity to double
+			SetCapacity(Math::GetMaxSizeType(mCapacity * 2, INITIAL_CAPACITY));
+#else
+			SetCapacity(GetSufficientCapacity<ALIGNED_BYTE>(mSize + 1));
+#endif
+		}
+
+		uint32_t slot;
+		if (mFreeHead != FREE_LIST_END)
+		{
+			slot = mFreeHead;
+			mFreeHead = mSlotToDense[slot];
+		}
+		else
+		{
+			slot = static_cast<uint32_t>(mSlotCount);
+			mGenerations[slot] = 0u;
+			++mSlotCount;
+		}
+
+		mSlotToDense[slot] = static_cast<uint32_t>(mSize);
+		mDenseToSlot[mSize] = slot;
+		mValues[mSize] = value;
+		++mSize;
+
+		return SlotId{ slot, mGenerations[slot] };
+	}
+
+	/**
+	 *
+	 * @brief Erases an element
+	 * @details Moves the last packed value into the hole left by the erased value and releases the slot.
+	 * 			Ids of all other elements stay valid. Stale ids are ignored.
+	 * 			@n@n
+	 * 			Complexity: constant
+	 * @param id id of the element to erase
+	 * @return `true` if an element was erased, `false` otherwise
+	 *
+	 */
+	bool SlotMap::Erase(SlotId id)
+	{
+		if (!Contains(id))
+		{
+			return false;
+		}
+
+		uint32_t dense = mSlotToDense[id.Index];
+		uint32_t last = static_cast<uint32_t>(mSize - 1ul);
+
+		if (dense != last)
+		{
+			uint32_t movedSlot = mDenseToSlot[last];
+			mValues[dense] = mValues[last];
+			mDenseToSlot[dense] = movedSlot;
+			mSlotToDense[movedSlot] = dense;
+		}
+
+		mValues[last] = nullptr;
+		--mSize;
+
+		++mGenerations[id.Index];
+		mSlotToDense[id.Index] = mFreeHead;
+		mFreeHead = id.Index;
+
+		return true;
+	}
+
+	/**
+	 *
+	 * @brief Clears the contents
+	 * @details Erases all elements. Every id handed out so far becomes invalid, capacity is unchanged.
+	 * 			@n@n
+	 * 			Complexity: linear in the number of slots
+	 *
+	 */
+	void SlotMap::Clear()
+	{
+		mFreeHead = FREE_LIST_END;
+		for (size_t i = mSlotCount; i > 0ul; --i)
+		{
+			uint32_t slot = static_cast<uint32_t>(i - 1ul);
+			++mGenerations[slot];
+			mSlotToDense[slot] = mFreeHead;
+			mFreeHead = slot;
+		}
+
+		Memory::Memset(mValues, 0, sizeof(void*) * mSize);
+		mSize = 0ul;
+	}
+
+	void SlotMap::allocate(size_t capacity)
+	{
+		mCapacity = capacity;
+		mValues = reinterpret_cast<void**>(mPool->Allocate(sizeof(void*) * mCapacity));
+		mDenseToSlot = reinterpret_cast<uint32_t*>(mPool->Allocate(sizeof(uint32_t) * mCapacity));
+		mSlotToDense = reinterpret_cast<uint32_t*>(mPool->Allocate(sizeof(uint32_t) * mCapacity));
+		mGenerations = reinterpret_cast<uint32_t*>(mPool->Allocate(sizeof(uint32_t) * mCapacity));
+	}
+
+	void SlotMap::deallocate()
+	{
+		if (mValues == nullptr)
+		{
+			return;
+		}
+
+		mPool->Deallocate(mValues, sizeof(void*) * mCapacity);
+		mPool->Deallocate(mDenseToSlot, sizeof(uint32_t) * mCapacity);
+		mPool->Deallocate(mSlotToDense, sizeof(uint32_t) * mCapacity);
+		mPool->Deallocate(mGenerations, sizeof(uint32_t) * mCapacity);
+
+		mValues = nullptr;
+		mDenseToSlot = nullptr;
+		mSlotToDense = nullptr;
+		mGenerations = nullptr;
+		mSize = 0ul;
+		mCapacity = 0ul;
+		mSlotCount = 0ul;
+		mFreeHead = FREE_LIST_END;
+	}
+
+#ifdef CAVE_BUILD_DEBUG
+	export namespace SlotMapTest
+	{
+		// DECLARATIONS
+
+		void Main();
+
+		void Constructor();
+		void InsertFind();
+		void Erase();
+		void Iterate();
+		void InsertAfterMove();
+
+		// DEFINITIONS
+		void Main()
+		{
+			LOGD(eLogChannel::CORE_CONTAINER, "======SlotMap Test======");
+			Constructor();
+			InsertFind();
+			Erase();
+			Iterate();
+			InsertAfterMove();
+			LOGD(eLogChannel::CORE_CONTAINER, "======SlotMap Test Success======");
+		}
+
+		void Constructor()
+		{
+			LOGD(eLogChannel::CORE_CONTAINER, "====Constructor Test====");
+			{
+				SlotMap slotMap0;
+				assert(slotMap0.IsEmpty());
+				assert(slotMap0.GetCapacity() == SlotMap::INITIAL_CAPACITY);
+
+				MemoryPool tempPool(1024);
+				SlotMap slotMap1(tempPool);
+				SlotMap slotMap2(64ul, tempPool);
+				assert(slotMap2.GetCapacity() == 64ul);
+
+				int value = 3;
+				SlotId id = slotMap1.Insert(&value);
+				SlotMap slotMap3(slotMap1);
+				assert(slotMap3.Find(id) == &value);
+
+				SlotMap slotMap4(std::move(slotMap3));
+				assert(slotMap4.Find(id) == &value);
+				assert(slotMap3.IsEmpty());
+			}
+		}
+
+		void InsertFind()
+		{
+			LOGD(eLogChannel::CORE_CONTAINER, "====Insert/Find Test====");
+			{
+				SlotMap slotMap;
+				int values[100];
+				SlotId ids[100];
+
+				for (int i = 0; i < 100; ++i)
+				{
+					values[i] = i;
+					ids[i] = slotMap.Insert(&values[i]);
+				}
+
+				assert(slotMap.GetSize() == 100ul);
+				for (int i = 0; i < 100; ++i)
+				{
+					assert(slotMap.Contains(ids[i]));
+					assert(*reinterpret_cast<int*>(slotMap.Find(ids[i])) == i);
+				}
+
+				assert(slotMap.Find(INVALID_SLOT_ID) == nullptr);
+			}
+		}
+
+		void Erase()
+		{
+			LOGD(eLogChannel::CORE_CONTAINER, "====Erase Test====");
+			{
+				SlotMap slotMap;
+				int values[8];
+				SlotId ids[8];
+
+				for (int i = 0; i < 8; ++i)
+				{
+					values[i] = i;
+					ids[i] = slotMap.Insert(&values[i]);
+				}
+
+				assert(slotMap.Erase(ids[0]));
+				assert(!slotMap.Erase(ids[0]));
+				assert(slotMap.Find(ids[0]) == nullptr);
+				assert(slotMap.GetSize() == 7ul);
+
+				for (int i = 1; i < 8; ++i)
+				{
+					assert(*reinterpret_cast<int*>(slotMap.Find(ids[i])) == i);
+				}
+
+				// released slot is reused, but the stale id must not see the new value
+				int reused = 42;
+				SlotId newId = slotMap.Insert(&reused);
+				assert(newId.Index == ids[0].Index);
+				assert(newId.Generation != ids[0].Generation);
+				assert(slotMap.Find(ids[0]) == nullptr);
+				assert(slotMap.Find(newId) == &reused);
+
+				slotMap.Clear();
+				assert(slotMap.IsEmpty());
+				assert(slotMap.Find(newId) == nullptr);
+			}
+		}
+
+		void Iterate()
+		{
+			LOGD(eLogChannel::CORE_CONTAINER, "====Iterate Test====");
+			{
+				SlotMap slotMap;
+				int values[32];
+				SlotId ids[32];
+
+				for (int i = 0; i < 32; ++i)
+				{
+					values[i] = 1;
+					ids[i] = slotMap.Insert(&values[i]);
+				}
+
+				for (int i = 0; i < 32; i += 2)
+				{
+					slotMap.Erase(ids[i]);
+				}
+
+				int sum = 0;
+				for (void* value : slotMap)
+				{
+					sum += *reinterpret_cast<int*>(value);
+				}
+				assert(sum == 16);
+
+				for (size_t i = 0; i < slotMap.GetSize(); ++i)
+				{
+					assert(slotMap.Find(slotMap.GetIdAt(i)) == slotMap.GetData()[i]);
+				}
+			}
+		}
+
+		void InsertAfterMove()
+		{
+			LOGD(eLogChannel::CORE_CONTAINER, "====Insert After Move Test====");
+			{
+				int values[20];
+				for (int i = 0; i < 20; ++i)
+				{
+					values[i] = i;
+				}
+
+				SlotMap slotMap0;
+				slotMap0.Insert(&values[0]);
+				SlotMap slotMap1(std::move(slotMap0));
+				assert(slotMap0.GetCapacity() == 0ul);
+
+				// the moved-from map grows again, past its initial capacity
+				SlotId ids[20];
+				for (int i = 0; i < 20; ++i)
+				{
+					ids[i] = slotMap0.Insert(&values[i]);
+				}
+				assert(slotMap0.GetSize() == 20ul);
+				assert(slotMap0.GetCapacity() >= 20ul);
+				for (int i = 0; i < 20; ++i)
+				{
+					assert(slotMap0.Find(ids[i]) == &values[i]);
+				}
+
+				// so do copies of a moved-from map
+				SlotMap slotMap2;
+				slotMap1 = std::move(slotMap2);
+				SlotMap slotMap3(slotMap2);
+				assert(slotMap3.GetCapacity() == SlotMap::INITIAL_CAPACITY);
+				SlotId id = slotMap3.Insert(&values[3]);
+				assert(slotMap3.Find(id) == &values[3]);
+
+				slotMap2.Insert(&values[4]);
+				assert(slotMap2.GetSize() == 1ul && *slotMap2.begin() == &values[4]);
+			}
+		}
+	}
+#endif
+}
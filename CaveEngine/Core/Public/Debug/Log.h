@@ -5,107 +5,339 @@
 
 #pragma once
 
-#ifdef __WIN32__
-	import cave.Core.Debug.Log;
+#include <atomic>
+#include <cstdarg>
+#include <iosfwd>
+
+#include "CoreTypes.h"
+#include "String/Format.h"
+
+namespace cave
+{
+	constexpr size_t MAX_BUFFER = 255ul;
+
+	enum class eLogVerbosity
+	{
+		All,
+		Verbose,
+		Debug,
+		Info,
+		Warn,
+		Error,
+		Assert,
+		Count,
+	};
+
+	enum class eLogChannel
+	{
+		GRAPHICS = 0x00,
+		PHYSICS = 0x20,
+		AUDIO = 0x40,
+		AI = 0x60,
+		GAMEPLAY = 0x80,
+		CORE = 0xa0,
+		CORE_MODULE = 0xa1,
+		CORE_UNIT_TEST = 0xa2,
+		CORE_MEMORY = 0xa3,
+		CORE_MATH = 0xa4,
+		CORE_STRING = 0xa5,
+		CORE_LOCALIZATION = 0xa6,
+		CORE_PARSER = 0xa7,
+		CORE_PROFILE = 0xa8,
+		CORE_ENGINE_CONFIG = 0xa9,
+		CORE_RNG = 0xaa,
+		CORE_OBJECT = 0xab,
+		CORE_THREAD = 0xac,
+		CORE_CONTAINER = 0xad,
+		CORE_FILE_SYSTEM = 0xae,
+		CORE_TIMER = 0xaf,
+		CORE_RESOURCE_MANAGER = 0xb0
+	};
+
+	/*
+	 * Lowest verbosity the LOG macros compile in for the build configuration.
+	 * Build with CAVE_LOG_COMPILED_VERBOSITY=<eLogVerbosity member> to override it.
+	 */
+#if defined(CAVE_LOG_COMPILED_VERBOSITY)
+	constexpr eLogVerbosity LOG_COMPILED_VERBOSITY = eLogVerbosity::CAVE_LOG_COMPILED_VERBOSITY;
+#elif CAVE_BUILD_DEBUG
+	constexpr eLogVerbosity LOG_COMPILED_VERBOSITY = eLogVerbosity::Verbose;
+#elif CAVE_BUILD_DEVELOPMENT
+	constexpr eLogVerbosity LOG_COMPILED_VERBOSITY = eLogVerbosity::Debug;
+#elif CAVE_BUILD_TEST
+	constexpr eLogVerbosity LOG_COMPILED_VERBOSITY = eLogVerbosity::Info;
 #else
-	#include <cstdarg>
-	#include <iostream>
+	constexpr eLogVerbosity LOG_COMPILED_VERBOSITY = eLogVerbosity::Warn;
+#endif
 
-	#include "CoreTypes.h"
-	
-	namespace cave
+	/*
+	 * Lowest verbosity compiled in for channel. Add a channel here to compile out its chatty levels
+	 * in every configuration, eLogVerbosity::Count compiles out the whole channel.
+	 */
+	constexpr eLogVerbosity GetCompiledLogVerbosity(eLogChannel channel)
 	{
-		constexpr size_t MAX_BUFFER = 255ul;
+#if CAVE_BUILD_RELEASE
+		// unit tests do not run in shipping builds
+		if (channel == eLogChannel::CORE_UNIT_TEST)
+		{
+			return eLogVerbosity::Count;
+		}
+#else
+		(void)channel;
+#endif
+
+		return LOG_COMPILED_VERBOSITY;
+	}
 
-		enum class eLogVerbosity
+	constexpr bool IsLogCompiled(eLogChannel channel, eLogVerbosity verbosity)
+	{
+		return verbosity >= GetCompiledLogVerbosity(channel);
+	}
+
+	/**
+	 *
+	 * @brief Format string of the LOG*FMT macros
+	 * @details Only constructible from a string literal, so the pointer stays valid after the call returns
+	 * 			and the log thread can format the message later.
+	 *
+	 */
+	class LogFormatString final
+	{
+	public:
+		template <size_t N>
+		consteval LogFormatString(const char (&format)[N])
+			: mData(format)
+			, mLength(N - 1ul)
 		{
-			All,
-			Verbose,
-			Debug,
-			Info,
-			Warn,
-			Error,
-			Assert
-		};
-
-		enum class eLogChannel
+		}
+
+		constexpr const char* GetData() const
 		{
-			GRAPHICS = 0x00,
-			PHYSICS = 0x20,
-			AUDIO = 0x40,
-			AI = 0x60,
-			GAMEPLAY = 0x80,
-			CORE = 0xa0,
-			CORE_MODULE = 0xa1,
-			CORE_UNIT_TEST = 0xa2,
-			CORE_MEMORY = 0xa3,
-			CORE_MATH = 0xa4,
-			CORE_STRING = 0xa5,
-			CORE_LOCALIZATION = 0xa6,
-			CORE_PARSER = 0xa7,
-			CORE_PROFILE = 0xa8,
-			CORE_ENGINE_CONFIG = 0xa9,
-			CORE_RNG = 0xaa,
-			CORE_OBJECT = 0xab,
-			CORE_THREAD = 0xac,
-			CORE_CONTAINER = 0xad,
-			CORE_FILE_SYSTEM = 0xae,
-			CORE_TIMER = 0xaf,
-			CORE_RESOURCE_MANAGER = 0xb0
-		};
-
-		class Log final
+			return mData;
+		}
+
+		constexpr size_t GetLength() const
 		{
-		public:
-			Log() = delete;
-			Log(const Log&) = delete;
-			Log(const Log&&) = delete;
-			Log& operator=(const Log&) = delete;
-			Log& operator=(const Log&&) = delete;
-
-			static void SetVerbosity(eLogVerbosity verbosity);
-			static void Verbose(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const char* message);
-			static void VerboseF(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const char* message, ...);
-			static void Debug(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const char* message);
-			static void DebugF(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const char* message, ...);
-			static void Info(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const char* message);
-			static void InfoF(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const char* message, ...);
-			static void Warn(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const char* message);
-			static void WarnF(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const char* message, ...);
-			static void Error(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const char* message);
-			static void ErrorF(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const char* message, ...);
-			static void Assert(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const char* message);
-			static void AssertF(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const char* message, ...);
-		private:
-			static void log(eLogChannel channel, eLogVerbosity verbosity, const char* fileName, const char* functionName, int32_t lineNumber, const char* message);
-			static eLogVerbosity msCurrentVerbosity;
-			static char mBuffer[MAX_BUFFER];
-		};
-	} // namespace cave
+			return mLength;
+		}
+
+	private:
+		const char* mData;
+		size_t mLength;
+	};
+
+	/**
+	 *
+	 * @brief Asynchronous logger, the same on every platform
+	 * @details The calling thread only copies its message into a slot of a lock-free ring and returns.
+	 * 			The LOG*FMT macros do not even format: they copy the format pointer and the raw arguments,
+	 * 			and the log thread formats them. printf-style calls are still formatted by the caller.
+	 * 			A log thread decorates the messages and writes them in batches, one write per batch,
+	 * 			to stdout or to the debugger output on Windows, or undecorated to a binary file after OpenBinaryFile().
+	 * 			@n@n
+	 * 			@n@n
+	 * 			Statements below IsLogCompiled() compile to nothing, their arguments included.
+	 * 			The rest check IsEnabled(), one relaxed load, before their arguments are evaluated.
+	 * 			@n@n
+	 * 			Logging never blocks: when the ring is full the message is dropped and counted, and the log thread
+	 * 			reports how many were dropped. A call site logging faster than the rate limit is suppressed the same way,
+	 * 			and consecutive identical messages are written once followed by "last message repeated N times".
+	 * 			The log thread starts on first use, Destroy() writes everything still queued and stops it,
+	 * 			after which messages are written synchronously.
+	 * 			@n@n
+	 * 			OpenFile() keeps the lines in a rotated log file as well. The log thread writes it once a second
+	 * 			or as soon as an error is logged, and compresses rotated files on a thread of its own.
+	 *
+	 */
+	class Log final
+	{
+	public:
+		Log() = delete;
+		Log(const Log&) = delete;
+		Log(const Log&&) = delete;
+		Log& operator=(const Log&) = delete;
+		Log& operator=(const Log&&) = delete;
+
+		static void Initialize();
+		static void Destroy();
+		/*Blocks until every message logged before the call has been written.*/
+		static void Flush();
+		static uint64_t GetDroppedCount();
+		/*Messages refused by the rate limit, see SetRateLimit.*/
+		static uint64_t GetSuppressedCount();
+		/*Messages folded into a "last message repeated N times" line.*/
+		static uint64_t GetCoalescedCount();
+		/*Limits every call site to messagesPerSecond after a burst of burstCount, 0 messagesPerSecond turns the limit off. Defaults to 100 and 1000.*/
+		static void SetRateLimit(uint32_t messagesPerSecond, uint32_t burstCount);
+
+		/*Also writes the text lines to filePath, appending to what is there. Returns false when it cannot be opened.*/
+		static bool OpenFile(const char* filePath);
+		static void CloseFile();
+		/*Moves the log file aside once it would grow past maxFileSize bytes or is older than maxFileSeconds, 0 turns either off. Defaults to 64 MiB and 0.*/
+		static void SetFileRotation(uint64_t maxFileSize, uint32_t maxFileSeconds);
+		/*Keeps archiveCount rotated files as filePath.1 (newest) to filePath.archiveCount, gzip compressed with bCompress. Defaults to 4 and false.*/
+		static void SetFileArchive(uint32_t archiveCount, bool bCompress);
+
+		/*Writes records to filePath in binary instead of text, see DecodeBinaryFile. Returns false when it cannot be opened.*/
+		static bool OpenBinaryFile(const char* filePath);
+		static void CloseBinaryFile();
+		/*Turns a file written after OpenBinaryFile back into the text lines. Returns false when it is not a complete log.*/
+		static bool DecodeBinaryFile(std::istream& input, std::ostream& output);
+
+		/*Shows only verbosity on every channel, eLogVerbosity::All shows everything.*/
+		static void SetVerbosity(eLogVerbosity verbosity);
+		/*Same as SetVerbosity for one channel, eLogVerbosity::Count turns the channel off.*/
+		static void SetChannelVerbosity(eLogChannel channel, eLogVerbosity verbosity);
+
+		static bool IsEnabled(eLogChannel channel, eLogVerbosity verbosity)
+		{
+			return (msDisabledVerbosities[static_cast<uint8_t>(channel)].load(std::memory_order_relaxed) & (1u << static_cast<uint32_t>(verbosity))) == 0u;
+		}
+
+		static void Verbose(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const char* message);
+		static void VerboseF(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const char* message, ...);
+		static void Debug(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const char* message);
+		static void DebugF(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const char* message, ...);
+		static void Info(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const char* message);
+		static void InfoF(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const char* message, ...);
+		static void Warn(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const char* message);
+		static void WarnF(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const char* message, ...);
+		static void Error(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const char* message);
+		static void ErrorF(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const char* message, ...);
+		static void Assert(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const char* message);
+		static void AssertF(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const char* message, ...);
+
+		// wide messages are written as UTF-8
+		static void WVerbose(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const wchar_t* message);
+		static void WVerboseF(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const wchar_t* message, ...);
+		static void WDebug(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const wchar_t* message);
+		static void WDebugF(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const wchar_t* message, ...);
+		static void WInfo(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const wchar_t* message);
+		static void WInfoF(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const wchar_t* message, ...);
+		static void WWarn(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const wchar_t* message);
+		static void WWarnF(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const wchar_t* message, ...);
+		static void WError(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const wchar_t* message);
+		static void WErrorF(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const wchar_t* message, ...);
+		static void WAssert(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const wchar_t* message);
+		static void WAssertF(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, const wchar_t* message, ...);
+
+		// {} placeholders checked against the argument types, see String/Format.h
+		template <typename... Args>
+		static void VerboseFormat(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, LogFormatString format, const Args&... args)
+		{
+			logFormat(channel, eLogVerbosity::Verbose, fileName, functionName, lineNumber, format, args...);
+		}
+
+		template <typename... Args>
+		static void DebugFormat(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, LogFormatString format, const Args&... args)
+		{
+			logFormat(channel, eLogVerbosity::Debug, fileName, functionName, lineNumber, format, args...);
+		}
+
+		template <typename... Args>
+		static void InfoFormat(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, LogFormatString format, const Args&... args)
+		{
+			logFormat(channel, eLogVerbosity::Info, fileName, functionName, lineNumber, format, args...);
+		}
+
+		template <typename... Args>
+		static void WarnFormat(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, LogFormatString format, const Args&... args)
+		{
+			logFormat(channel, eLogVerbosity::Warn, fileName, functionName, lineNumber, format, args...);
+		}
+
+		template <typename... Args>
+		static void ErrorFormat(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, LogFormatString format, const Args&... args)
+		{
+			logFormat(channel, eLogVerbosity::Error, fileName, functionName, lineNumber, format, args...);
+		}
+
+		template <typename... Args>
+		static void AssertFormat(eLogChannel channel, const char* fileName, const char* functionName, int32_t lineNumber, LogFormatString format, const Args&... args)
+		{
+			logFormat(channel, eLogVerbosity::Assert, fileName, functionName, lineNumber, format, args...);
+		}
+	private:
+		template <typename... Args>
+		static void logFormat(eLogChannel channel, eLogVerbosity verbosity, const char* fileName, const char* functionName, int32_t lineNumber, LogFormatString format, const Args&... args)
+		{
+			if (!IsEnabled(channel, verbosity))
+			{
+				return;
+			}
+
+			if constexpr (sizeof...(Args) == 0)
+			{
+				logArguments(channel, verbosity, fileName, functionName, lineNumber, format, nullptr, 0ul);
+			}
+			else
+			{
+				const FormatArgument arguments[] = { FormatArgument(args)... };
+				logArguments(channel, verbosity, fileName, functionName, lineNumber, format, arguments, sizeof...(Args));
+			}
+		}
+
+		static void logArguments(eLogChannel channel, eLogVerbosity verbosity, const char* fileName, const char* functionName, int32_t lineNumber, LogFormatString format, const FormatArgument* arguments, size_t argumentCount);
+		static void log(eLogChannel channel, eLogVerbosity verbosity, const char* fileName, const char* functionName, int32_t lineNumber, const char* message);
+		static void logV(eLogChannel channel, eLogVerbosity verbosity, const char* fileName, const char* functionName, int32_t lineNumber, const char* message, va_list vl);
+		static void wlog(eLogChannel channel, eLogVerbosity verbosity, const char* fileName, const char* functionName, int32_t lineNumber, const wchar_t* message);
+		static void wlogV(eLogChannel channel, eLogVerbosity verbosity, const char* fileName, const char* functionName, int32_t lineNumber, const wchar_t* message, va_list vl);
+
+		static uint8_t getDisabledVerbosities(eLogVerbosity verbosity);
+
+		// per channel, bit v is set when eLogVerbosity v is filtered out
+		inline static std::atomic<uint8_t> msDisabledVerbosities[256];
+	};
+
+#ifdef CAVE_BUILD_DEBUG
+	namespace LogTest
+	{
+		void Main();
+	}
 #endif
+} // namespace cave
+
+// nothing is compiled below IsLogCompiled, and the arguments are only evaluated when IsEnabled
+#define CAVE_LOG(verbosity, channel, function, ...) \
+	do \
+	{ \
+		if constexpr (cave::IsLogCompiled(channel, verbosity)) \
+		{ \
+			if (cave::Log::IsEnabled(channel, verbosity)) \
+			{ \
+				cave::Log::function(channel, __FILE__, __func__, __LINE__, __VA_ARGS__); \
+			} \
+		} \
+	} while (false)
+
+#define LOGVF(channel, message, ...) CAVE_LOG(cave::eLogVerbosity::Verbose, channel, VerboseF, message, __VA_ARGS__)
+#define LOGV(channel, message) CAVE_LOG(cave::eLogVerbosity::Verbose, channel, Verbose, message)
+#define LOGVFMT(channel, format, ...) CAVE_LOG(cave::eLogVerbosity::Verbose, channel, VerboseFormat, format, __VA_ARGS__)
+#define LOGDF(channel, message, ...) CAVE_LOG(cave::eLogVerbosity::Debug, channel, DebugF, message, __VA_ARGS__)
+#define LOGD(channel, message) CAVE_LOG(cave::eLogVerbosity::Debug, channel, Debug, message)
+#define LOGDFMT(channel, format, ...) CAVE_LOG(cave::eLogVerbosity::Debug, channel, DebugFormat, format, __VA_ARGS__)
+#define LOGIF(channel, message, ...) CAVE_LOG(cave::eLogVerbosity::Info, channel, InfoF, message, __VA_ARGS__)
+#define LOGI(channel, message) CAVE_LOG(cave::eLogVerbosity::Info, channel, Info, message)
+#define LOGIFMT(channel, format, ...) CAVE_LOG(cave::eLogVerbosity::Info, channel, InfoFormat, format, __VA_ARGS__)
+#define LOGWF(channel, message, ...) CAVE_LOG(cave::eLogVerbosity::Warn, channel, WarnF, message, __VA_ARGS__)
+#define LOGW(channel, message) CAVE_LOG(cave::eLogVerbosity::Warn, channel, Warn, message)
+#define LOGWFMT(channel, format, ...) CAVE_LOG(cave::eLogVerbosity::Warn, channel, WarnFormat, format, __VA_ARGS__)
+#define LOGEF(channel, message, ...) CAVE_LOG(cave::eLogVerbosity::Error, channel, ErrorF, message, __VA_ARGS__)
+#define LOGE(channel, message) CAVE_LOG(cave::eLogVerbosity::Error, channel, Error, message)
+#define LOGEFMT(channel, format, ...) CAVE_LOG(cave::eLogVerbosity::Error, channel, ErrorFormat, format, __VA_ARGS__)
+#define LOGAF(channel, message, ...) CAVE_LOG(cave::eLogVerbosity::Assert, channel, AssertF, message, __VA_ARGS__)
+#define LOGA(channel, message) CAVE_LOG(cave::eLogVerbosity::Assert, channel, Assert, message)
+#define LOGAFMT(channel, format, ...) CAVE_LOG(cave::eLogVerbosity::Assert, channel, AssertFormat, format, __VA_ARGS__)
 
-#define LOGVF(channel, message, ...) cave::Log::VerboseF(channel, __FILE__, __func__, __LINE__, message, __VA_ARGS__)
-#define LOGV(channel, message) cave::Log::Verbose(channel, __FILE__, __func__, __LINE__, message)
-#define LOGDF(channel, message, ...) cave::Log::DebugF(channel, __FILE__, __func__, __LINE__, message, __VA_ARGS__)
-#define LOGD(channel, message) cave::Log::Debug(channel, __FILE__, __func__, __LINE__, message)
-#define LOGIF(channel, message, ...) cave::Log::InfoF(channel, __FILE__, __func__, __LINE__, message, __VA_ARGS__)
-#define LOGI(channel, message) cave::Log::Info(channel, __FILE__, __func__, __LINE__, message)
-#define LOGWF(channel, message, ...) cave::Log::WarnF(channel, __FILE__,__func__,  __LINE__, message, __VA_ARGS__)
-#define LOGW(channel, message) cave::Log::Warn(channel, __FILE__,__func__,  __LINE__, message)
-#define LOGEF(channel, message, ...) cave::Log::ErrorF(channel, __FILE__, __func__, __LINE__, message, __VA_ARGS__)
-#define LOGE(channel, message) cave::Log::Error(channel, __FILE__, __func__, __LINE__, message)
-#define LOGAF(channel, message, ...) cave::Log::AssertF(channel, __FILE__, __func__, __LINE__, message, __VA_ARGS__)
-#define LOGA(channel, message) cave::Log::Assert(channel, __FILE__, __func__, __LINE__, message)
-
-#define WLOGVF(channel, message, ...) cave::Log::WVerboseF(channel, __FILE__, __func__, __LINE__, message, __VA_ARGS__)
-#define WLOGV(channel, message) cave::Log::WVerbose(channel, __FILE__, __func__, __LINE__, message)
-#define WLOGDF(channel, message, ...) cave::Log::WDebugF(channel, __FILE__, __func__, __LINE__, message, __VA_ARGS__)
-#define WLOGD(channel, message) cave::Log::WDebug(channel, __FILE__, __func__, __LINE__, message)
-#define WLOGIF(channel, message, ...) cave::Log::WInfoF(channel, __FILE__, __func__, __LINE__, message, __VA_ARGS__)
-#define WLOGI(channel, message) cave::Log::WInfo(channel, __FILE__, __func__, __LINE__, message)
-#define WLOGWF(channel, message, ...) cave::Log::WWarnF(channel, __FILE__,__func__,  __LINE__, message, __VA_ARGS__)
-#define WLOGW(channel, message) cave::Log::WWarn(channel, __FILE__,__func__,  __LINE__, message)
-#define WLOGEF(channel, message, ...) cave::Log::WErrorF(channel, __FILE__, __func__, __LINE__, message, __VA_ARGS__)
-#define WLOGE(channel, message) cave::Log::WError(channel, __FILE__, __func__, __LINE__, message)
-#define WLOGAF(channel, message, ...) cave::Log::WAssertF(channel, __FILE__, __func__, __LINE__, message, __VA_ARGS__)
-#define WLOGA(channel, message) cave::Log::WAssert(channel, __FILE__, __func__, __LINE__, message)
\ No newline at end of file
+#define WLOGVF(channel, message, ...) CAVE_LOG(cave::eLogVerbosity::Verbose, channel, WVerboseF, message, __VA_ARGS__)
+#define WLOGV(channel, message) CAVE_LOG(cave::eLogVerbosity::Verbose, channel, WVerbose, message)
+#define WLOGDF(channel, message, ...) CAVE_LOG(cave::eLogVerbosity::Debug, channel, WDebugF, message, __VA_ARGS__)
+#define WLOGD(channel, message) CAVE_LOG(cave::eLogVerbosity::Debug, channel, WDebug, message)
+#define WLOGIF(channel, message, ...) CAVE_LOG(cave::eLogVerbosity::Info, channel, WInfoF, message, __VA_ARGS__)
+#define WLOGI(channel, message) CAVE_LOG(cave::eLogVerbosity::Info, channel, WInfo, message)
+#define WLOGWF(channel, message, ...) CAVE_LOG(cave::eLogVerbosity::Warn, channel, WWarnF, message, __VA_ARGS__)
+#define WLOGW(channel, message) CAVE_LOG(cave::eLogVerbosity::Warn, channel, WWarn, message)
+#define WLOGEF(channel, message, ...) CAVE_LOG(cave::eLogVerbosity::Error, channel, WErrorF, message, __VA_ARGS__)
+#define WLOGE(channel, message) CAVE_LOG(cave::eLogVerbosity::Error, channel, WError, message)
+#define WLOGAF(channel, message, ...) CAVE_LOG(cave::eLogVerbosity::Assert, channel, WAssertF, message, __VA_ARGS__)
+#define WLOGA(channel, message) CAVE_LOG(cave::eLogVerbosity::Assert, channel, WAssert, message)
@@ -107,14 +107,17 @@ namespace cave
 	constexpr size_t Math::GetMaxSizeType(size_t x, size_t y)
 	{
 		size_t a = x - y;
+		// all ones when x < y, the sign bit alone would only mask the lowest bit
+		size_t mask = 0ul - (a >> (sizeof(size_t) * 8 - 1));
 
-		return (x - (a & (a >> (sizeof(size_t) * 8 - 1))));
+		return (x - (a & mask));
 	}
 
 	constexpr size_t Math::GetMinSizeType(size_t x, size_t y)
 	{
 		size_t a = x - y;
+		size_t mask = 0ul - (a >> (sizeof(size_t) * 8 - 1));
 
-		return (x - (a & ~(a >> (sizeof(size_t) * 8 - 1))));
+		return (x - (a & ~mask));
 	}
 }
\ No newline at end of file
@@ -0,0 +1,386 @@
+/*!
+ * Copyright (c) 2021 SWTube. All rights reserved.
+ * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
+ */
+
+#pragma once
+
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "CoreTypes.h"
+
+#include "Assertion/Assert.h"
+#include "String/StringView.h"
+
+/*
+ * Locale-independent number to text conversion and back, with the semantics of std::to_chars and std::from_chars.
+ *
+ * Nothing allocates and nothing is null-terminated. Integers are written two decimal digits at a time and parsed
+ * eight digits at a time. Floats are written as the shortest string that reads back to the same value.
+ */
+namespace cave
+{
+	enum class eCharConvError : uint8_t
+	{
+		NONE,
+		INVALID_ARGUMENT,	// no number at the start of the input
+		OUT_OF_RANGE,		// the number does not fit in the destination type
+		BUFFER_TOO_SMALL,	// the output does not fit in [first, last)
+	};
+
+	struct ToCharsResult
+	{
+		// one past the last character written on success, last otherwise
+		char* End;
+		eCharConvError Error;
+	};
+
+	struct FromCharsResult
+	{
+		// one past the last character of the number, first if there was no number
+		const char* End;
+		eCharConvError Error;
+	};
+
+	enum class eFloatFormat : uint8_t
+	{
+		SHORTEST,		// shortest round-trip, fixed or scientific, whichever is shorter
+		FIXED,			// [-]ddd.ddd
+		SCIENTIFIC,		// [-]d.ddde[+-]dd
+		GENERAL,		// %g
+	};
+
+	// enough for any 64-bit integer in base 2, with its sign
+	constexpr size_t MAX_INTEGER_CHAR_COUNT = 65ul;
+	// enough for any double written with eFloatFormat::SHORTEST, e.g. -2.2250738585072014e-308
+	constexpr size_t MAX_FLOAT_CHAR_COUNT = 32ul;
+
+	namespace CharConv
+	{
+		template <typename T>
+		concept Integer = std::is_integral_v<T> && !std::is_same_v<std::remove_cv_t<T>, bool>;
+
+		inline constexpr char DIGIT_PAIRS[] =
+			"00010203040506070809"
+			"10111213141516171819"
+			"20212223242526272829"
+			"30313233343536373839"
+			"40414243444546474849"
+			"50515253545556575859"
+			"60616263646566676869"
+			"70717273747576777879"
+			"80818283848586878889"
+			"90919293949596979899";
+
+		inline constexpr char DIGITS[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+		FORCEINLINE constexpr uint32_t GetDecimalDigitCount(uint64_t value)
+		{
+			uint32_t count = 1u;
+			for (;;)
+			{
+				if (value < 10ull)
+				{
+					return count;
+				}
+				if (value < 100ull)
+				{
+					return count + 1u;
+				}
+				if (value < 1000ull)
+				{
+					return count + 2u;
+				}
+				if (value < 10000ull)
+				{
+					return count + 3u;
+				}
+				value /= 10000ull;
+				count += 4u;
+			}
+		}
+
+		/*
+		 * Writes the count decimal digits of value so that the last one lands at end - 1.
+		 */
+		FORCEINLINE void WriteDecimal(char* end, uint64_t value)
+		{
+			while (value >= 100ull)
+			{
+				uint64_t pair = value % 100ull;
+				value /= 100ull;
+				end -= 2;
+				std::memcpy(end, &DIGIT_PAIRS[pair * 2ull], 2ul);
+			}
+
+			if (value >= 10ull)
+			{
+				end -= 2;
+				std::memcpy(end, &DIGIT_PAIRS[value * 2ull], 2ul);
+			}
+			else
+			{
+				*--end = static_cast<char>('0' + value);
+			}
+		}
+
+		inline ToCharsResult WriteUnsigned(char* first, char* last, uint64_t value, uint32_t base)
+		{
+			uint32_t count = 0u;
+			if (base == 10u)
+			{
+				count = GetDecimalDigitCount(value);
+				if (static_cast<size_t>(last - first) < count)
+				{
+					return ToCharsResult{ last, eCharConvError::BUFFER_TOO_SMALL };
+				}
+
+				WriteDecimal(first + count, value);
+
+				return ToCharsResult{ first + count, eCharConvError::NONE };
+			}
+
+			if (std::has_single_bit(base))
+			{
+				uint32_t shift = static_cast<uint32_t>(std::countr_zero(base));
+				uint32_t bitCount = value != 0ull ? 64u - static_cast<uint32_t>(std::countl_zero(value)) : 1u;
+				count = (bitCount + shift - 1u) / shift;
+				if (static_cast<size_t>(last - first) < count)
+				{
+					return ToCharsResult{ last, eCharConvError::BUFFER_TOO_SMALL };
+				}
+
+				char* cursor = first + count;
+				do
+				{
+					*--cursor = DIGITS[value & (base - 1u)];
+					value >>= shift;
+				} while (value != 0ull);
+
+				return ToCharsResult{ first + count, eCharConvError::NONE };
+			}
+
+			char digits[MAX_INTEGER_CHAR_COUNT];
+			char* cursor = digits + MAX_INTEGER_CHAR_COUNT;
+			do
+			{
+				*--cursor = DIGITS[value % base];
+				value /= base;
+			} while (value != 0ull);
+
+			count = static_cast<uint32_t>(digits + MAX_INTEGER_CHAR_COUNT - cursor);
+			if (static_cast<size_t>(last - first) < count)
+			{
+				return ToCharsResult{ last, eCharConvError::BUFFER_TOO_SMALL };
+			}
+			std::memcpy(first, cursor, count);
+
+			return ToCharsResult{ first + count, eCharConvError::NONE };
+		}
+
+		FORCEINLINE constexpr uint32_t GetDigitValue(char c)
+		{
+			if (c >= '0' && c <= '9')
+			{
+				return static_cast<uint32_t>(c - '0');
+			}
+			if (c >= 'a' && c <= 'z')
+			{
+				return static_cast<uint32_t>(c - 'a' + 10);
+			}
+			if (c >= 'A' && c <= 'Z')
+			{
+				return static_cast<uint32_t>(c - 'A' + 10);
+			}
+
+			return 36u;
+		}
+
+		/*
+		 * True if all 8 bytes of chunk are ASCII digits.
+		 */
+		FORCEINLINE constexpr bool IsEightDigits(uint64_t chunk)
+		{
+			return ((chunk & 0xF0F0F0F0F0F0F0F0ull) | (((chunk + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull;
+		}
+
+		/*
+		 * Value of 8 ASCII digits loaded little-endian, combined pairwise in three multiplications.
+		 */
+		FORCEINLINE constexpr uint32_t ParseEightDigits(uint64_t chunk)
+		{
+			chunk -= 0x3030303030303030ull;
+			chunk = (chunk * 10ull + (chunk >> 8)) & 0x00FF00FF00FF00FFull;
+			chunk = (chunk * 100ull + (chunk >> 16)) & 0x0000FFFF0000FFFFull;
+			chunk = (chunk * 10000ull + (chunk >> 32)) & 0x00000000FFFFFFFFull;
+
+			return static_cast<uint32_t>(chunk);
+		}
+
+		/*
+		 * Parses digits in base until the first character that is not one.
+		 * bOverflow is set if the number does not fit in 64 bits, in which case all of its digits are still consumed.
+		 */
+		inline const char* ReadUnsigned(const char* first, const char* last, uint32_t base, uint64_t& outValue, bool& bOverflow)
+		{
+			uint64_t value = 0ull;
+			bOverflow = false;
+
+			if constexpr (std::endian::native == std::endian::little)
+			{
+				if (base == 10u)
+				{
+					// 19 decimal digits always fit in 64 bits
+					size_t digitCount = 0ul;
+					while (last - first >= 8 && digitCount + 8ul <= 19ul)
+					{
+						uint64_t chunk;
+						std::memcpy(&chunk, first, sizeof(chunk));
+						if (!IsEightDigits(chunk))
+						{
+							break;
+						}
+
+						value = value * 100000000ull + ParseEightDigits(chunk);
+						first += 8;
+						digitCount += 8ul;
+					}
+				}
+			}
+
+			for (; first != last; ++first)
+			{
+				uint32_t digit = GetDigitValue(*first);
+				if (digit >= base)
+				{
+					break;
+				}
+
+				if (value > (std::numeric_limits<uint64_t>::max() - digit) / base)
+				{
+					bOverflow = true;
+				}
+				value = value * base + digit;
+			}
+
+			outValue = value;
+
+			return first;
+		}
+	}
+
+	/**
+	 *
+	 * @brief Writes value in base to [first, last)
+	 * @details Lowercase letters for digits above 9, a leading '-' for negative values and nothing else:
+	 * 			no prefix, no padding and no null terminator.
+	 * 			MAX_INTEGER_CHAR_COUNT characters are always enough.
+	 * @param base 2 to 36
+	 *
+	 */
+	template <CharConv::Integer T>
+	ToCharsResult ToChars(char* first, char* last, T value, uint32_t base = 10u)
+	{
+		assert(base >= 2u && base <= 36u);
+
+		using Unsigned = std::make_unsigned_t<T>;
+		Unsigned magnitude = static_cast<Unsigned>(value);
+		if constexpr (std::is_signed_v<T>)
+		{
+			if (value < 0)
+			{
+				if (first == last)
+				{
+					return ToCharsResult{ last, eCharConvError::BUFFER_TOO_SMALL };
+				}
+
+				*first++ = '-';
+				magnitude = static_cast<Unsigned>(Unsigned(0) - magnitude);
+			}
+		}
+
+		return CharConv::WriteUnsigned(first, last, static_cast<uint64_t>(magnitude), base);
+	}
+
+	ToCharsResult ToChars(char* first, char* last, float value, eFloatFormat format = eFloatFormat::SHORTEST);
+	ToCharsResult ToChars(char* first, char* last, double value, eFloatFormat format = eFloatFormat::SHORTEST);
+	/*Writes value with precision digits after the decimal point, or precision significant digits for GENERAL.*/
+	ToCharsResult ToChars(char* first, char* last, float value, eFloatFormat format, int32_t precision);
+	ToCharsResult ToChars(char* first, char* last, double value, eFloatFormat format, int32_t precision);
+
+	/**
+	 *
+	 * @brief Parses an integer in base at the start of [first, last)
+	 * @details Accepts an optional '-' for signed types followed by digits in base, in either case.
+	 * 			Leading whitespace, '+' and prefixes such as 0x are not accepted.
+	 * 			On OUT_OF_RANGE End is still past the number and outValue is left untouched.
+	 * @param base 2 to 36
+	 *
+	 */
+	template <CharConv::Integer T>
+	FromCharsResult FromChars(const char* first, const char* last, T& outValue, uint32_t base = 10u)
+	{
+		assert(base >= 2u && base <= 36u);
+
+		const char* cursor = first;
+		bool bNegative = false;
+		if constexpr (std::is_signed_v<T>)
+		{
+			if (cursor != last && *cursor == '-')
+			{
+				bNegative = true;
+				++cursor;
+			}
+		}
+
+		uint64_t magnitude = 0ull;
+		bool bOverflow = false;
+		const char* end = CharConv::ReadUnsigned(cursor, last, base, magnitude, bOverflow);
+		if (end == cursor)
+		{
+			return FromCharsResult{ first, eCharConvError::INVALID_ARGUMENT };
+		}
+
+		using Unsigned = std::make_unsigned_t<T>;
+		uint64_t maxMagnitude = static_cast<uint64_t>(std::numeric_limits<T>::max());
+		if (bNegative)
+		{
+			// |min| is one more than max
+			++maxMagnitude;
+		}
+
+		if (bOverflow || magnitude > maxMagnitude)
+		{
+			return FromCharsResult{ end, eCharConvError::OUT_OF_RANGE };
+		}
+
+		outValue = bNegative ? static_cast<T>(Unsigned(0) - static_cast<Unsigned>(magnitude)) : static_cast<T>(magnitude);
+
+		return FromCharsResult{ end, eCharConvError::NONE };
+	}
+
+	/*
+	 * Parses a float or double written in fixed or scientific notation, or inf or nan.
+	 * The result is the nearest representable value, same as std::from_chars with std::chars_format::general.
+	 */
+	FromCharsResult FromChars(const char* first, const char* last, float& outValue);
+	FromCharsResult FromChars(const char* first, const char* last, double& outValue);
+
+	template <typename T>
+	FromCharsResult FromChars(StringView s, T& outValue)
+	{
+		return FromChars(s.GetData(), s.GetData() + s.GetLength(), outValue);
+	}
+
+#ifdef CAVE_BUILD_DEBUG
+	namespace CharConvTest
+	{
+		void Main();
+		void Integer();
+		void Float();
+	}
+#endif
+}
@@ -0,0 +1,200 @@
+/*!
+ * Copyright (c) 2021 SWTube. All rights reserved.
+ * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
+ */
+
+#pragma once
+
+#include <type_traits>
+
+#include "CoreTypes.h"
+#include "String/CharConv.h"
+#include "String/StringView.h"
+
+namespace cave
+{
+	/**
+	 *
+	 * @brief One type-erased argument of Format
+	 * @details Holds a copy of an integer, float, character or pointer, or a view of a string, tagged with its type,
+	 * 			so the formatting loop itself is not a template and is compiled once.
+	 * 			Anything else is rejected at compile time.
+	 *
+	 */
+	class FormatArgument final
+	{
+	public:
+		enum class eType : uint8_t
+		{
+			BOOL,
+			CHAR,
+			INT,
+			UINT,
+			FLOAT,
+			DOUBLE,
+			STRING,
+			POINTER,
+		};
+
+		constexpr FormatArgument(bool value)
+			: mType(eType::BOOL)
+			, mUint(value ? 1ull : 0ull)
+		{
+		}
+
+		constexpr FormatArgument(char value)
+			: mType(eType::CHAR)
+			, mUint(static_cast<unsigned char>(value))
+		{
+		}
+
+		template <CharConv::Integer T>
+			requires (!std::is_same_v<T, char>)
+		constexpr FormatArgument(T value)
+			: mType(std::is_signed_v<T> ? eType::INT : eType::UINT)
+			, mUint(std::is_signed_v<T> ? static_cast<uint64_t>(static_cast<int64_t>(value)) : static_cast<uint64_t>(value))
+		{
+		}
+
+		template <typename T>
+			requires std::is_enum_v<T>
+		constexpr FormatArgument(T value)
+			: FormatArgument(static_cast<std::underlying_type_t<T>>(value))
+		{
+		}
+
+		constexpr FormatArgument(float value)
+			: mType(eType::FLOAT)
+			, mFloat(value)
+		{
+		}
+
+		constexpr FormatArgument(double value)
+			: mType(eType::DOUBLE)
+			, mDouble(value)
+		{
+		}
+
+		constexpr FormatArgument(const char* value)
+			: FormatArgument(StringView(value != nullptr ? value : "(null)"))
+		{
+		}
+
+		/*Also takes std::string and String, which convert to StringView.*/
+		constexpr FormatArgument(StringView value)
+			: mType(eType::STRING)
+			, mString{ value.GetData(), value.GetLength() }
+		{
+		}
+
+		template <typename T>
+			requires (!std::is_same_v<std::remove_cv_t<T>, char>)
+		constexpr FormatArgument(T* value)
+			: mType(eType::POINTER)
+			, mPointer(value)
+		{
+		}
+
+		constexpr eType GetType() const
+		{
+			return mType;
+		}
+
+		constexpr int64_t GetInt() const
+		{
+			return static_cast<int64_t>(mUint);
+		}
+
+		constexpr uint64_t GetUint() const
+		{
+			return mUint;
+		}
+
+		constexpr float GetFloat() const
+		{
+			return mFloat;
+		}
+
+		constexpr double GetDouble() const
+		{
+			return mDouble;
+		}
+
+		constexpr StringView GetString() const
+		{
+			return StringView(mString.Data, mString.Length);
+		}
+
+		constexpr const void* GetPointer() const
+		{
+			return mPointer;
+		}
+
+	private:
+		eType mType;
+		union
+		{
+			uint64_t mUint;
+			float mFloat;
+			double mDouble;
+			struct
+			{
+				const char* Data;
+				size_t Length;
+			} mString;
+			const void* mPointer;
+		};
+	};
+
+	struct FormatResult
+	{
+		// characters written, not counting the null terminator
+		size_t Length;
+		bool bTruncated;
+	};
+
+	/**
+	 *
+	 * @brief Formats arguments into buffer, always null-terminated
+	 * @details Replacement fields follow std::format: <code>{[index][:[[fill]align][0][width][.precision][type]]}</code>,
+	 * 			with <code>{{</code> and <code>}}</code> for literal braces.
+	 * 			@n@n
+	 * 			align is '<', '>' or '^'. type is one of b, o, d, x, X for integers, f, e, g for floats and p for pointers.
+	 * 			Without a type, floats are written as the shortest string that reads back to the same value.
+	 * 			A malformed field or one without an argument is copied to the output as is.
+	 * 			@n@n
+	 * 			Output that does not fit in the buffer is cut off and bTruncated is set.
+	 *
+	 */
+	FormatResult VFormat(char* buffer, size_t bufferSize, StringView format, const FormatArgument* arguments, size_t argumentCount);
+
+	/**
+	 *
+	 * @brief Type-safe replacement for snprintf
+	 * @details Never allocates. The argument types are checked at compile time and the format at run time, see VFormat.
+	 * 			@n@n
+	 * 			<code>Format(buffer, sizeof(buffer), "{} has {:.1f}% health", name, health);</code>
+	 *
+	 */
+	template <typename... Args>
+	FormatResult Format(char* buffer, size_t bufferSize, StringView format, const Args&... args)
+	{
+		if constexpr (sizeof...(Args) == 0)
+		{
+			return VFormat(buffer, bufferSize, format, nullptr, 0ul);
+		}
+		else
+		{
+			const FormatArgument arguments[] = { FormatArgument(args)... };
+
+			return VFormat(buffer, bufferSize, format, arguments, sizeof...(Args));
+		}
+	}
+
+#ifdef CAVE_BUILD_DEBUG
+	namespace FormatTest
+	{
+		void Main();
+	}
+#endif
+}
@@ -0,0 +1,151 @@
+/*!
+ * Copyright (c) 2021 SWTube. All rights reserved.
+ * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
+ */
+
+#pragma once
+
+#include <functional>
+#include <string>
+
+#include "CoreTypes.h"
+#include "String/StringView.h"
+
+namespace cave
+{
+	/*
+	 * 32-bit FNV-1a hash of [s, s + length). Used by the name table and evaluated at compile time for NameLiteral.
+	 * Same as StringView::GetHash, so a HashedStringView can be handed to the name table as is.
+	 */
+	constexpr uint32_t GetNameHash(const char* s, size_t length)
+	{
+		return GetStringHash(s, length);
+	}
+
+	/**
+	 *
+	 * @brief String literal whose name hash is computed at compile time
+	 * @details Converting a NameLiteral to a Name skips hashing at run time, only the table lookup is left.
+	 * 			Written as <code>"Idle"_name</code> or <code>NameLiteral("Idle")</code>.
+	 *
+	 */
+	class NameLiteral final
+	{
+	public:
+		template <size_t N>
+		consteval NameLiteral(const char (&s)[N])
+			: mString(s)
+			, mLength(N - 1)
+			, mHash(GetNameHash(s, N - 1))
+		{
+		}
+
+		consteval NameLiteral(const char* s, size_t length)
+			: mString(s)
+			, mLength(length)
+			, mHash(GetNameHash(s, length))
+		{
+		}
+
+		constexpr const char* GetCString() const
+		{
+			return mString;
+		}
+
+		constexpr size_t GetLength() const
+		{
+			return mLength;
+		}
+
+		constexpr uint32_t GetHash() const
+		{
+			return mHash;
+		}
+
+	private:
+		const char* mString;
+		size_t mLength;
+		uint32_t mHash;
+	};
+
+	consteval NameLiteral operator""_name(const char* s, size_t length)
+	{
+		return NameLiteral(s, length);
+	}
+
+	/**
+	 *
+	 * @brief Interned string identifier
+	 * @details Every distinct string is stored once in a global name table and identified by a 32-bit id,
+	 * 			so names compare and hash as integers. Interning is thread-safe, and the characters of an interned
+	 * 			name stay valid until the program ends.
+	 * 			@n@n
+	 * 			A default constructed Name is NAME_NONE, which is also the name of the empty string.
+	 *
+	 */
+	class Name final
+	{
+	public:
+		constexpr Name() = default;
+		Name(const char* s);
+		Name(StringView s);
+		Name(HashedStringView s);
+		Name(NameLiteral literal);
+
+		static Name Find(StringView s);
+		static Name Find(HashedStringView s);
+
+		const char* GetCString() const;
+		size_t GetLength() const;
+		StringView GetView() const;
+
+		FORCEINLINE constexpr uint32_t GetId() const
+		{
+			return mId;
+		}
+
+		FORCEINLINE constexpr bool IsNone() const
+		{
+			return mId == NONE_ID;
+		}
+
+		FORCEINLINE friend constexpr bool operator==(const Name& lhs, const Name& rhs)
+		{
+			return lhs.mId == rhs.mId;
+		}
+
+		FORCEINLINE friend constexpr bool operator!=(const Name& lhs, const Name& rhs)
+		{
+			return lhs.mId != rhs.mId;
+		}
+
+		/*Orders by id, not alphabetically.*/
+		FORCEINLINE friend constexpr bool operator<(const Name& lhs, const Name& rhs)
+		{
+			return lhs.mId < rhs.mId;
+		}
+
+		static constexpr uint32_t NONE_ID = 0u;
+
+	private:
+		uint32_t mId = NONE_ID;
+	};
+
+	inline constexpr Name NAME_NONE;
+
+#ifdef CAVE_BUILD_DEBUG
+	namespace NameTest
+	{
+		void Main();
+	}
+#endif
+}
+
+template <>
+struct std::hash<cave::Name>
+{
+	size_t operator()(const cave::Name& name) const noexcept
+	{
+		return static_cast<size_t>(name.GetId());
+	}
+};
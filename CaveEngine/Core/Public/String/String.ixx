@@ -12,14 +12,262 @@
 #include "CoreGlobals.h"
 #include "Debug/Log.h"
 #include "Memory/MemoryPool.h"
+#include "String/StringView.h"
+
+#include <bit>
+#include <type_traits>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+	#define CAVE_STRING_SSE 1
+	#include <emmintrin.h>
+	#if defined(__AVX2__)
+		#define CAVE_STRING_AVX2 1
+		#include <immintrin.h>
+	#else
+		#define CAVE_STRING_AVX2 0
+	#endif
+#else
+	#define CAVE_STRING_SSE 0
+	#define CAVE_STRING_AVX2 0
+#endif
 
 export module cave.Core.String;
 
 //import std.core;
 import cave.Core.Math;
 import cave.Core.Memory.Memory;
+import cave.Core.String.Unicode;
 //import MemoryPool;
 
+namespace cave
+{
+	/*
+	 * Substring search behind String::GetIndexOf, GetLastIndexOf and Contains.
+	 * Candidate positions are filtered by comparing the first and the last character of the needle against
+	 * a whole register of the haystack at once, and only the survivors are compared in full.
+	 * Falls back to the same filter one character at a time when SIMD is unavailable or during constant evaluation.
+	 */
+	namespace StringSearch
+	{
+		constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+
+		constexpr bool IsMatch(const char* haystack, const char* needle, size_t needleLength)
+		{
+			// first and last characters are already known to match
+			for (size_t i = 1ul; i + 1ul < needleLength; ++i)
+			{
+				if (haystack[i] != needle[i])
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		constexpr size_t FindScalar(const char* haystack, size_t haystackLength, const char* needle, size_t needleLength)
+		{
+			const char first = needle[0];
+			const char last = needle[needleLength - 1ul];
+			for (size_t i = 0ul; i + needleLength <= haystackLength; ++i)
+			{
+				if (haystack[i] == first && haystack[i + needleLength - 1ul] == last && IsMatch(&haystack[i], needle, needleLength))
+				{
+					return i;
+				}
+			}
+
+			return NOT_FOUND;
+		}
+
+		constexpr size_t FindLastScalar(const char* haystack, size_t haystackLength, const char* needle, size_t needleLength)
+		{
+			const char first = needle[0];
+			const char last = needle[needleLength - 1ul];
+			for (size_t i = haystackLength - needleLength + 1ul; i > 0ul; --i)
+			{
+				if (haystack[i - 1ul] == first && haystack[i + needleLength - 2ul] == last && IsMatch(&haystack[i - 1ul], needle, needleLength))
+				{
+					return i - 1ul;
+				}
+			}
+
+			return NOT_FOUND;
+		}
+
+#if CAVE_STRING_SSE
+		FORCEINLINE bool IsMiddleMatch(const char* haystack, const char* needle, size_t needleLength)
+		{
+			return needleLength <= 2ul || Memory::Memcmp(haystack + 1, needle + 1, needleLength - 2ul) == 0;
+		}
+
+		inline size_t FindSimd(const char* haystack, size_t haystackLength, const char* needle, size_t needleLength)
+		{
+			// number of positions a match may start at
+			const size_t candidateCount = haystackLength - needleLength + 1ul;
+			size_t i = 0ul;
+
+#if CAVE_STRING_AVX2
+			const __m256i first32 = _mm256_set1_epi8(needle[0]);
+			const __m256i last32 = _mm256_set1_epi8(needle[needleLength - 1ul]);
+			for (; i + 32ul <= candidateCount; i += 32ul)
+			{
+				const __m256i blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + i));
+				const __m256i blockLast = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + i + needleLength - 1ul));
+				uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(first32, blockFirst), _mm256_cmpeq_epi8(last32, blockLast))));
+				while (mask != 0u)
+				{
+					const size_t bit = static_cast<size_t>(std::countr_zero(mask));
+					if (IsMiddleMatch(haystack + i + bit, needle, needleLength))
+					{
+						return i + bit;
+					}
+					mask &= mask - 1u;
+				}
+			}
+#endif
+
+			const __m128i first = _mm_set1_epi8(needle[0]);
+			const __m128i last = _mm_set1_epi8(needle[needleLength - 1ul]);
+			for (; i + 16ul <= candidateCount; i += 16ul)
+			{
+				const __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i));
+				const __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i + needleLength - 1ul));
+				uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, blockFirst), _mm_cmpeq_epi8(last, blockLast))));
+				while (mask != 0u)
+				{
+					const size_t bit = static_cast<size_t>(std::countr_zero(mask));
+					if (IsMiddleMatch(haystack + i + bit, needle, needleLength))
+					{
+						return i + bit;
+					}
+					mask &= mask - 1u;
+				}
+			}
+
+			for (; i < candidateCount; ++i)
+			{
+				if (haystack[i] == needle[0] && haystack[i + needleLength - 1ul] == needle[needleLength - 1ul] && IsMiddleMatch(haystack + i, needle, needleLength))
+				{
+					return i;
+				}
+			}
+
+			return NOT_FOUND;
+		}
+
+		inline size_t FindLastSimd(const char* haystack, size_t haystackLength, const char* needle, size_t needleLength)
+		{
+			// candidates [0, end) are left to check, scanned from the back
+			size_t end = haystackLength - needleLength + 1ul;
+
+#if CAVE_STRING_AVX2
+			const __m256i first32 = _mm256_set1_epi8(needle[0]);
+			const __m256i last32 = _mm256_set1_epi8(needle[needleLength - 1ul]);
+			for (; end >= 32ul; end -= 32ul)
+			{
+				const size_t base = end - 32ul;
+				const __m256i blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + base));
+				const __m256i blockLast = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + base + needleLength - 1ul));
+				uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(first32, blockFirst), _mm256_cmpeq_epi8(last32, blockLast))));
+				while (mask != 0u)
+				{
+					const size_t bit = 31ul - static_cast<size_t>(std::countl_zero(mask));
+					if (IsMiddleMatch(haystack + base + bit, needle, needleLength))
+					{
+						return base + bit;
+					}
+					mask &= ~(1u << bit);
+				}
+			}
+#endif
+
+			const __m128i first = _mm_set1_epi8(needle[0]);
+			const __m128i last = _mm_set1_epi8(needle[needleLength - 1ul]);
+			for (; end >= 16ul; end -= 16ul)
+			{
+				const size_t base = end - 16ul;
+				const __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + base));
+				const __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + base + needleLength - 1ul));
+				uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, blockFirst), _mm_cmpeq_epi8(last, blockLast))));
+				while (mask != 0u)
+				{
+					const size_t bit = 31ul - static_cast<size_t>(std::countl_zero(mask));
+					if (IsMiddleMatch(haystack + base + bit, needle, needleLength))
+					{
+						return base + bit;
+					}
+					mask &= ~(1u << bit);
+				}
+			}
+
+			for (; end > 0ul; --end)
+			{
+				const size_t i = end - 1ul;
+				if (haystack[i] == needle[0] && haystack[i + needleLength - 1ul] == needle[needleLength - 1ul] && IsMiddleMatch(haystack + i, needle, needleLength))
+				{
+					return i;
+				}
+			}
+
+			return NOT_FOUND;
+		}
+#endif
+
+		/*
+		 * Position of the first occurrence of [needle, needle + needleLength) in [haystack, haystack + haystackLength), or NOT_FOUND.
+		 * An empty needle is found at 0.
+		 */
+		constexpr size_t Find(const char* haystack, size_t haystackLength, const char* needle, size_t needleLength)
+		{
+			if (needleLength == 0ul)
+			{
+				return 0ul;
+			}
+
+			if (needleLength > haystackLength)
+			{
+				return NOT_FOUND;
+			}
+
+#if CAVE_STRING_SSE
+			if (!std::is_constant_evaluated())
+			{
+				return FindSimd(haystack, haystackLength, needle, needleLength);
+			}
+#endif
+
+			return FindScalar(haystack, haystackLength, needle, needleLength);
+		}
+
+		/*
+		 * Position of the last occurrence of [needle, needle + needleLength) in [haystack, haystack + haystackLength), or NOT_FOUND.
+		 * An empty needle is found at haystackLength.
+		 */
+		constexpr size_t FindLast(const char* haystack, size_t haystackLength, const char* needle, size_t needleLength)
+		{
+			if (needleLength == 0ul)
+			{
+				return haystackLength;
+			}
+
+			if (needleLength > haystackLength)
+			{
+				return NOT_FOUND;
+			}
+
+#if CAVE_STRING_SSE
+			if (!std::is_constant_evaluated())
+			{
+				return FindLastSimd(haystack, haystackLength, needle, needleLength);
+			}
+#endif
+
+			return FindLastScalar(haystack, haystackLength, needle, needleLength);
+		}
+	}
+}
+
 export namespace cave
 {
 	/**
@@ -88,6 +336,8 @@ export namespace cave
 		friend double StringToDouble(const String& str);
 		friend long double StringToLongDouble(const String& str, size_t* pos);
 		friend long double StringToLongDouble(const String& str);
+		// encoding conversions
+		friend String ToString(WStringView wide, MemoryPool& pool);
 	public:
 		String() noexcept(noexcept(gCoreMemoryPool));
 		String(MemoryPool& pool) noexcept;
@@ -107,6 +357,8 @@ export namespace cave
 		String(const String& other, MemoryPool& pool);
 		String(String&& other) noexcept;
 		String(String&& other, MemoryPool& pool);
+		explicit String(StringView view);
+		String(StringView view, MemoryPool& pool);
 
 		~String();
 
@@ -114,6 +366,7 @@ export namespace cave
 		String& operator=(String&& str);
 		String& operator=(const char* s);
 		String& operator=(char ch);
+		String& operator=(StringView view);
 
 		constexpr const MemoryPool& GetMemoryPool() const;
 
@@ -125,6 +378,7 @@ export namespace cave
 		constexpr char& GetBack();
 		constexpr const char& GetBack() const;
 		const char* GetCString() const;
+		operator StringView() const noexcept;
 
 		// Capacity
 		[[nodiscard]] constexpr bool IsEmpty() const noexcept;
@@ -152,21 +406,26 @@ export namespace cave
 		constexpr void Append(const String& str, size_t pos, size_t count);
 		constexpr void Append(const char* s, size_t count);
 		constexpr void Append(const char* s);
+		constexpr void Append(StringView view);
 		String& operator+=(const String& str);
 		String& operator+=(char ch);
 		String& operator+=(const char* s);
+		String& operator+=(StringView view);
 		constexpr bool StartsWith(const String& str) const noexcept;
 		constexpr bool StartsWith(const String&& str) const noexcept;
 		constexpr bool StartsWith(char c) const noexcept;
 		bool StartsWith(const char* s) const;
+		bool StartsWith(StringView view) const;
 		constexpr bool EndsWith(const String& str) const noexcept;
 		constexpr bool EndsWith(const String&& str) const noexcept;
 		constexpr bool EndsWith(char c) const noexcept;
 		bool EndsWith(const char* s) const;
+		bool EndsWith(StringView view) const;
 		constexpr bool Contains(const String& str) const noexcept;
 		constexpr bool Contains(const String&& str) const noexcept;
 		constexpr bool Contains(char c) const noexcept;
 		bool Contains(const char* s) const;
+		bool Contains(StringView view) const;
 		String& Replace(size_t pos, size_t count, const String& str);
 		String& Replace(size_t pos, size_t count, const String& str, size_t pos2);
 		String& Replace(size_t pos, size_t count, const String& str, size_t pos2, size_t count2);
@@ -184,6 +443,8 @@ export namespace cave
 		constexpr size_t GetIndexOf(const char* s, size_t pos, size_t count) const;
 		constexpr size_t GetIndexOf(const char* s) const;
 		constexpr size_t GetIndexOf(const char* s, size_t pos) const;
+		constexpr size_t GetIndexOf(StringView view) const;
+		constexpr size_t GetIndexOf(StringView view, size_t pos) const;
 		constexpr size_t GetIndexOf(char ch) const;
 		constexpr size_t GetIndexOf(char ch, size_t pos) const;
 		constexpr size_t GetLastIndexOf(const String& str) const noexcept;
@@ -197,12 +458,74 @@ export namespace cave
 		// Constants
 		static constexpr size_t NPOS = static_cast<size_t>(-1);
 		static constexpr size_t ALIGNED_BYTE = 16ul;
+		static constexpr size_t SSO_CAPACITY = 2ul * ALIGNED_BYTE;
 
 	private:
+		static constexpr size_t getSufficientCapacity(size_t length);
+		constexpr size_t getGrowthCapacity(size_t newLength) const;
+		char* allocate(size_t capacity);
+		void deallocate(char* string, size_t capacity);
+		constexpr void grow(size_t newLength);
+		constexpr void insert(size_t index, const char* s, size_t count);
+
 		MemoryPool* mPool = &gCoreMemoryPool;
 		size_t mLength = 0ul;
 		size_t mCapacity = 0ul;
 		char* mString = nullptr;
+		// short strings (31 characters or less) are stored in place, mString points here then
+		char mBuffer[SSO_CAPACITY];
+	};
+
+	/**
+	 *
+	 * @brief StringBuilder concatenates many pieces into a String with a single final allocation.
+	 * @details Pieces are copied into an in-place buffer of INLINE_CAPACITY characters, which holds a typical log line,
+	 * 			and only move to the memory pool, growing geometrically, once they no longer fit.
+	 * 			ToString() allocates the result exactly once, no matter how many pieces were appended.
+	 *
+	 */
+	class StringBuilder final
+	{
+	public:
+		StringBuilder() noexcept(noexcept(gCoreMemoryPool));
+		StringBuilder(MemoryPool& pool) noexcept;
+		StringBuilder(const StringBuilder&) = delete;
+		StringBuilder& operator=(const StringBuilder&) = delete;
+
+		~StringBuilder();
+
+		const char* GetCString() const;
+		constexpr size_t GetLength() const noexcept;
+		constexpr size_t GetCapacity() const noexcept;
+		void SetCapacity(size_t newCapacity);
+		void Clear() noexcept;
+
+		StringBuilder& Append(const String& str);
+		StringBuilder& Append(const char* s);
+		StringBuilder& Append(const char* s, size_t count);
+		StringBuilder& Append(char ch);
+		StringBuilder& Append(size_t count, char ch);
+		StringBuilder& Append(int32_t value);
+		StringBuilder& Append(uint32_t value);
+		StringBuilder& Append(int64_t value);
+		StringBuilder& Append(uint64_t value);
+		StringBuilder& operator+=(const String& str);
+		StringBuilder& operator+=(const char* s);
+		StringBuilder& operator+=(char ch);
+
+		String ToString() const;
+		String ToString(MemoryPool& pool) const;
+
+		static constexpr size_t INLINE_CAPACITY = 256ul;
+
+	private:
+		char* reserveBack(size_t count);
+
+		MemoryPool* mPool = &gCoreMemoryPool;
+		size_t mLength = 0ul;
+		size_t mCapacity = INLINE_CAPACITY;
+		char* mString = mBuffer;
+		char mBuffer[INLINE_CAPACITY];
 	};
 
 	/**
@@ -272,6 +595,7 @@ export namespace cave
 		friend long double WStringToLongDouble(const WString& wStr, size_t* pos);
 		friend long double WStringToLongDouble(const WString& wStr);
 		friend wchar_t* CStringToWCStringMalloc(const char* str, MemoryPool& pool);
+		friend WString ToWString(StringView utf8, MemoryPool& pool);
 	public:
 		WString() noexcept(noexcept(gCoreMemoryPool));
 		WString(MemoryPool& pool) noexcept;
@@ -291,6 +615,8 @@ export namespace cave
 		WString(const WString& other, MemoryPool& pool);
 		WString(WString&& other) noexcept;
 		WString(WString&& other, MemoryPool& pool);
+		explicit WString(WStringView view);
+		WString(WStringView view, MemoryPool& pool);
 
 		~WString();
 
@@ -298,6 +624,7 @@ export namespace cave
 		WString& operator=(WString&& wStr);
 		WString& operator=(const wchar_t* wStr);
 		WString& operator=(wchar_t wCh);
+		WString& operator=(WStringView view);
 
 		constexpr const MemoryPool& GetMemoryPool() const;
 
@@ -309,6 +636,7 @@ export namespace cave
 		constexpr wchar_t& GetBack();
 		constexpr const wchar_t& GetBack() const;
 		const wchar_t* GetCString() const;
+		operator WStringView() const noexcept;
 
 		// Capacity
 		[[nodiscard]] constexpr bool IsEmpty() const noexcept;
@@ -381,12 +709,21 @@ export namespace cave
 		// Constants
 		static constexpr size_t NPOS = static_cast<size_t>(-1);
 		static constexpr size_t ALIGNED_BYTE = 16ul;
+		// the in-place buffer is as large as the one of String, whatever the size of wchar_t
+		static constexpr size_t SSO_BYTE_SIZE = 2ul * ALIGNED_BYTE;
+		static constexpr size_t SSO_CAPACITY = SSO_BYTE_SIZE / sizeof(wchar_t);
 
 	private:
+		static constexpr size_t getSufficientCapacity(size_t length);
+		wchar_t* allocate(size_t capacity);
+		void deallocate(wchar_t* string, size_t capacity);
+
 		MemoryPool* mPool = &gCoreMemoryPool;
 		size_t mLength = 0ul;
 		size_t mCapacity = 0ul;
 		wchar_t* mString = nullptr;
+		// short strings (15 characters or less with a 2-byte wchar_t, 7 with a 4-byte one) are stored in place, mString points here then
+		wchar_t mBuffer[SSO_CAPACITY];
 	};
 
 	String ToString(int32_t value);
@@ -396,6 +733,8 @@ export namespace cave
 	String ToString(float value);
 	String ToString(double value);
 	String ToString(long double value);
+	String ToString(WStringView wide);
+	String ToString(WStringView wide, MemoryPool& pool);
 	String operator""_s(const char* str, size_t len);
 	constexpr eResult Strcpy(char* dest, size_t destSize, const char* src, size_t count);
 	constexpr eResult Strcat(char* dest, size_t destSize, const char* src, size_t count);
@@ -409,6 +748,8 @@ export namespace cave
 	WString ToWString(float value);
 	WString ToWString(double value);
 	WString ToWString(long double value);
+	WString ToWString(StringView utf8);
+	WString ToWString(StringView utf8, MemoryPool& pool);
 	WString operator""_s(const wchar_t* wStr, size_t len);
 	constexpr eResult WStrcpy(wchar_t* dest, size_t destSize, const wchar_t* src, size_t count);
 	constexpr eResult WStrcat(wchar_t* dest, size_t destSize, const wchar_t* src, size_t count);
@@ -441,8 +782,8 @@ export namespace cave
 	String::String(MemoryPool& pool) noexcept
 		: mPool(&pool)
 		, mLength(0ul)
-		, mCapacity(ALIGNED_BYTE)
-		, mString(static_cast<char*>(mPool->Allocate(mCapacity * sizeof(char))))
+		, mCapacity(SSO_CAPACITY)
+		, mString(allocate(mCapacity))
 	{
 		Memory::Memset(mString, '\0', mCapacity);
 	}
@@ -472,8 +813,8 @@ export namespace cave
 	String::String(size_t count, char ch, MemoryPool& pool)
 		: mPool(&pool)
 		, mLength(count)
-		, mCapacity(GetSufficientCapacity<ALIGNED_BYTE>(mLength))
-		, mString(static_cast<char*>(mPool->Allocate(mCapacity * sizeof(char))))
+		, mCapacity(getSufficientCapacity(mLength))
+		, mString(allocate(mCapacity))
 	{
 		Memory::Memset(mString, ch, mLength);
 		Memory::Memset(&mString[mLength], '\0', mCapacity - mLength);
@@ -546,7 +887,7 @@ export namespace cave
 		: mPool(&pool)
 		, mLength(count)
 		, mCapacity(other.mCapacity)
-		, mString(static_cast<char*>(mPool->Allocate(mCapacity * sizeof(char))))
+		, mString(allocate(mCapacity))
 	{
 		assert(other.mString != nullptr);
 
@@ -596,20 +937,50 @@ export namespace cave
 	{
 		assert(s != nullptr);
 
-		mLength = count;
-		mCapacity = GetSufficientCapacity<ALIGNED_BYTE>(mLength);
-		mString = static_cast<char*>(mPool->Allocate(mCapacity * sizeof(char)));
-
-		if (count == NPOS || Strlen(s) < count)
+		if (count == NPOS)
 		{
 			count = Strlen(s);
 		}
 
-		// Copy s to mString
-		strncpy_s(mString, mCapacity, s, count);
+		mLength = count;
+		mCapacity = getSufficientCapacity(mLength);
+		mString = allocate(mCapacity);
+
+		// Copy s to mString, s need not be null-terminated
+		Memory::Memcpy(mString, s, count);
 		Memory::Memset(&mString[mLength], '\0', mCapacity - mLength);
 	}
 
+	/**
+	 *
+	 * @brief (4) Constructs the string with the characters of view.
+	 * @details The view need not be null-terminated, it can contain null characters.
+	 * 			Explicit, so that an allocation never happens behind a function taking a String.
+	 * 			@n@n
+	 * 			Complexity: linear in view.GetLength()
+	 * @param view characters to initialize the string with
+	 *
+	 */
+	String::String(StringView view)
+		: String(view.GetData(), view.GetLength(), gCoreMemoryPool)
+	{
+	}
+
+	/**
+	 *
+	 * @brief (4) Constructs the string with the characters of view.
+	 * @details The view need not be null-terminated, it can contain null characters.
+	 * 			@n@n
+	 * 			Complexity: linear in view.GetLength()
+	 * @param view characters to initialize the string with
+	 * @param pool memory pool to use for all memory allocations of this string
+	 *
+	 */
+	String::String(StringView view, MemoryPool& pool)
+		: String(view.GetData(), view.GetLength(), pool)
+	{
+	}
+
 	/**
 	 *
 	 * @brief (5) Constructs the string with the contents initialized with a copy of the null-terminated character string pointed to by s.
@@ -643,8 +1014,8 @@ export namespace cave
 
 		// Allocate Memory
 		mLength = Strlen(s);
-		mCapacity = GetSufficientCapacity<ALIGNED_BYTE>(mLength);
-		mString = static_cast<char*>(mPool->Allocate(mCapacity * sizeof(char)));
+		mCapacity = getSufficientCapacity(mLength);
+		mString = allocate(mCapacity);
 
 		// Copy s to mString
 		strncpy_s(mString, mCapacity, s, mLength);
@@ -684,8 +1055,8 @@ export namespace cave
 		{
 		}
 
-		mCapacity = GetSufficientCapacity<ALIGNED_BYTE>(mLength);
-		mString = static_cast<char*>(mPool->Allocate(mCapacity * sizeof(char)));
+		mCapacity = getSufficientCapacity(mLength);
+		mString = allocate(mCapacity);
 
 		memcpy(mString, first, mLength);
 		Memory::Memset(&mString[mLength], '\0', mCapacity - mLength);
@@ -706,7 +1077,7 @@ export namespace cave
 		, mCapacity(other.mCapacity)
 	{
 		assert(other.mPool != nullptr && other.mString != nullptr);
-		mString = static_cast<char*>(mPool->Allocate((mCapacity) * sizeof(char)));
+		mString = allocate(mCapacity);
 		strncpy_s(mString, mCapacity, other.mString, mLength);
 		Memory::Memset(&mString[mLength], '\0', mCapacity - mLength);
 	}
@@ -727,7 +1098,7 @@ export namespace cave
 		, mCapacity(other.mCapacity)
 	{
 		assert(other.mString != nullptr);
-		mString = static_cast<char*>(mPool->Allocate((mCapacity) * sizeof(char)));
+		mString = allocate(mCapacity);
 		strncpy_s(mString, mCapacity, other.mString, mLength);
 		Memory::Memset(&mString[mLength], '\0', mCapacity - mLength);
 	}
@@ -750,6 +1121,12 @@ export namespace cave
 	{
 		assert(other.mPool != nullptr && other.mString != nullptr);
 
+		if (other.mString == other.mBuffer)
+		{
+			Memory::Memcpy(mBuffer, other.mBuffer, mCapacity * sizeof(char));
+			mString = mBuffer;
+		}
+
 		other.mPool = nullptr;
 		other.mLength = 0ul;
 		other.mCapacity = 0ul;
@@ -777,6 +1154,12 @@ export namespace cave
 	{
 		assert(other.mString != nullptr);
 
+		if (other.mString == other.mBuffer)
+		{
+			Memory::Memcpy(mBuffer, other.mBuffer, mCapacity * sizeof(char));
+			mString = mBuffer;
+		}
+
 		other.mPool = nullptr;
 		other.mLength = 0ul;
 		other.mCapacity = 0ul;
@@ -785,6 +1168,106 @@ export namespace cave
 		other.~String();
 	}
 
+	/**
+	 *
+	 * @brief Returns the capacity needed to store length characters and the null character
+	 * @details Strings that fit in the in-place buffer use SSO_CAPACITY, longer ones are rounded up to ALIGNED_BYTE.
+	 *
+	 */
+	constexpr size_t String::getSufficientCapacity(size_t length)
+	{
+		return length < SSO_CAPACITY ? SSO_CAPACITY : GetSufficientCapacity<ALIGNED_BYTE>(length);
+	}
+
+	/**
+	 *
+	 * @brief Returns the capacity to grow to when newLength characters no longer fit
+	 * @details The capacity at least doubles, so appending n characters one piece at a time
+	 * 			copies O(n) characters in total instead of O(n^2).
+	 *
+	 */
+	constexpr size_t String::getGrowthCapacity(size_t newLength) const
+	{
+		return Math::GetMaxSizeType(mCapacity * 2ul, getSufficientCapacity(newLength));
+	}
+
+	/**
+	 *
+	 * @brief Returns storage for capacity characters
+	 * @details The in-place buffer is used if capacity fits in it, the memory pool otherwise.
+	 *
+	 */
+	char* String::allocate(size_t capacity)
+	{
+		if (capacity <= SSO_CAPACITY)
+		{
+			return mBuffer;
+		}
+
+		return static_cast<char*>(mPool->Allocate(capacity * sizeof(char)));
+	}
+
+	void String::deallocate(char* string, size_t capacity)
+	{
+		if (string != mBuffer)
+		{
+			mPool->Deallocate(string, capacity * sizeof(char));
+		}
+	}
+
+	/**
+	 *
+	 * @brief Reallocates so that newLength characters fit, keeping the contents
+	 * @details Everything past the current length is filled with null characters.
+	 *
+	 */
+	constexpr void String::grow(size_t newLength)
+	{
+		size_t newCapacity = getGrowthCapacity(newLength);
+		char* newString = allocate(newCapacity);
+		Memory::Memcpy(newString, mString, mLength);
+		Memory::Memset(&newString[mLength], '\0', newCapacity - mLength);
+
+		deallocate(mString, mCapacity);
+		mString = newString;
+		mCapacity = newCapacity;
+	}
+
+	/**
+	 *
+	 * @brief Inserts [s, s + count) at index, growing geometrically if needed
+	 * @details When the string grows, the inserted characters are copied before the old storage is released,
+	 * 			so s may point into this string when appending.
+	 *
+	 */
+	constexpr void String::insert(size_t index, const char* s, size_t count)
+	{
+		assert(index <= mLength);
+
+		size_t newLength = mLength + count;
+		if (newLength >= mCapacity)
+		{
+			size_t newCapacity = getGrowthCapacity(newLength);
+			char* newString = allocate(newCapacity);
+			Memory::Memcpy(newString, mString, index);
+			Memory::Memcpy(&newString[index], s, count);
+			Memory::Memcpy(&newString[index + count], &mString[index], mLength - index);
+			Memory::Memset(&newString[newLength], '\0', newCapacity - newLength);
+
+			deallocate(mString, mCapacity);
+			mString = newString;
+			mCapacity = newCapacity;
+		}
+		else
+		{
+			// shift the tail, null character included
+			Memory::Memmove(&mString[index + count], &mString[index], mLength - index + 1ul);
+			Memory::Memcpy(&mString[index], s, count);
+		}
+
+		mLength = newLength;
+	}
+
 	/**
 	 *
 	 * @brief destroys the string, deallocating internal storage if used
@@ -794,7 +1277,7 @@ export namespace cave
 	{
 		if (mString != nullptr)
 		{
-			mPool->Deallocate(mString, mCapacity * sizeof(char));
+			deallocate(mString, mCapacity);
 			mString = nullptr;
 		}
 
@@ -822,11 +1305,11 @@ export namespace cave
 
 			if (mCapacity < str.mLength + 1)
 			{
-				mPool->Deallocate(mString, mCapacity * sizeof(char));
+				deallocate(mString, mCapacity);
 
-				mCapacity = GetSufficientCapacity<ALIGNED_BYTE>(str.mLength);
+				mCapacity = getSufficientCapacity(str.mLength);
 
-				mString = static_cast<char*>(mPool->Allocate(mCapacity * sizeof(char)));
+				mString = allocate(mCapacity);
 			}
 
 			mLength = str.mLength;
@@ -857,13 +1340,19 @@ export namespace cave
 
 			if (mString != nullptr)
 			{
-				mPool->Deallocate(mString, mCapacity * sizeof(char));
+				deallocate(mString, mCapacity);
 			}
 
 			mLength = str.mLength;
 			mCapacity = str.mCapacity;
 			mString = str.mString;
 
+			if (str.mString == str.mBuffer)
+			{
+				Memory::Memcpy(mBuffer, str.mBuffer, mCapacity * sizeof(char));
+				mString = mBuffer;
+			}
+
 			str.mPool = nullptr;
 			str.mLength = 0ul;
 			str.mCapacity = 0ul;
@@ -895,11 +1384,11 @@ export namespace cave
 
 			if (mCapacity < sLength + 1)
 			{
-				mPool->Deallocate(mString, mCapacity * sizeof(char));
+				deallocate(mString, mCapacity);
 
-				mCapacity = GetSufficientCapacity<ALIGNED_BYTE>(sLength);
+				mCapacity = getSufficientCapacity(sLength);
 
-				mString = static_cast<char*>(mPool->Allocate(mCapacity * sizeof(char)));
+				mString = allocate(mCapacity);
 			}
 
 			Memory::Memset(mString, '\0', mLength);
@@ -910,6 +1399,47 @@ export namespace cave
 		return *this;
 	}
 
+	/**
+	 *
+	 * @brief (3) Assigns values to the string
+	 * @details Replaces the contents with the characters of view, which may point into this string.
+	 * 			@n@n
+	 * 			Complexity: linear in size of <code>view</code>
+	 * @param view characters to initialize the string with
+	 * @return *this
+	 *
+	 */
+	String& String::operator=(StringView view)
+	{
+		size_t length = view.GetLength();
+
+		if (mCapacity < length + 1)
+		{
+			// copy before releasing the old storage, view may point into it
+			size_t capacity = getSufficientCapacity(length);
+			char* string = allocate(capacity);
+			Memory::Memmove(string, view.GetData(), length);
+			Memory::Memset(&string[length], '\0', capacity - length);
+
+			deallocate(mString, mCapacity);
+			mString = string;
+			mCapacity = capacity;
+		}
+		else
+		{
+			Memory::Memmove(mString, view.GetData(), length);
+			if (length < mLength)
+			{
+				Memory::Memset(&mString[length], '\0', mLength - length);
+			}
+			mString[length] = '\0';
+		}
+
+		mLength = length;
+
+		return *this;
+	}
+
 	/**
 	 *
 	 * @brief (4) Assigns values to the string
@@ -1076,20 +1606,33 @@ export namespace cave
 		return mString;
 	}
 
-	// Capacity
-
 	/**
 	 *
-	 * @brief Checks whether the string is empty
-	 * @details Checks if the string has no characters.
+	 * @brief Returns a view of the contents
+	 * @details The view is invalidated by anything that invalidates GetCString().
 	 * 			@n@n
 	 * 			Complexity: constant
-	 * @return <code>true</code> if the string is empty, <code>false</code> otherwise
 	 *
 	 */
-	[[nodiscard]] constexpr bool String::IsEmpty() const noexcept
+	String::operator StringView() const noexcept
 	{
-		return mLength == 0ul;
+		return StringView(mString, mLength);
+	}
+
+	// Capacity
+
+	/**
+	 *
+	 * @brief Checks whether the string is empty
+	 * @details Checks if the string has no characters.
+	 * 			@n@n
+	 * 			Complexity: constant
+	 * @return <code>true</code> if the string is empty, <code>false</code> otherwise
+	 *
+	 */
+	[[nodiscard]] constexpr bool String::IsEmpty() const noexcept
+	{
+		return mLength == 0ul;
 	}
 
 	/**
@@ -1137,11 +1680,11 @@ export namespace cave
 		++newCapacity;
 		if (newCapacity > mCapacity)
 		{
-			char* newString = reinterpret_cast<char*>(mPool->Allocate(newCapacity * sizeof(char)));
+			char* newString = allocate(newCapacity);
 			strncpy_s(newString, newCapacity, mString, mLength);
 			Memory::Memset(&newString[mLength], '\0', newCapacity - mLength);
 
-			mPool->Deallocate(mString, mCapacity * sizeof(char));
+			deallocate(mString, mCapacity);
 			mCapacity = newCapacity;
 			mString = newString;
 		}
@@ -1173,13 +1716,13 @@ export namespace cave
 	 */
 	constexpr void String::Shrink()
 	{
-		size_t fitCapacity = GetSufficientCapacity<ALIGNED_BYTE>(mLength);
+		size_t fitCapacity = getSufficientCapacity(mLength);
 		if (mCapacity != fitCapacity)
 		{
-			char* newString = static_cast<char*>(mPool->Allocate(fitCapacity * sizeof(char)));
+			char* newString = allocate(fitCapacity);
 			strncpy_s(newString, fitCapacity, mString, mLength);
 			Memory::Memset(&newString[mLength], '\0', fitCapacity - mLength);
-			mPool->Deallocate(mString, mCapacity * sizeof(char));
+			deallocate(mString, mCapacity);
 			mCapacity = fitCapacity;
 			mString = newString;
 		}
@@ -1220,30 +1763,15 @@ export namespace cave
 			return false;
 		}
 
-		if (index + count + 1 >= mCapacity)
-		{
-#if CAPACITY_INCREASE_MODE == CAPACITY_INCREASE_MODE_DOUBLE
-			size_t newCapacity = mCapacity * 2;
-#else
-			size_t newCapacity = GetSufficientCapacity<ALIGNED_BYTE>(newLength);
-#endif
-			char* newString = static_cast<char*>(mPool->Allocate(newCapacity * sizeof(char)));
-			strncpy_s(newString, newCapacity, mString, mLength);
-			Memory::Memset(&newString[mLength], '\0', newCapacity - mLength);
-
-			mPool->Deallocate(mString, mCapacity * sizeof(char));
-			mString = newString;
-			mCapacity = newCapacity;
-		}
-
-		for (size_t i = mLength + 1; i > index; --i)
+		if (mLength + count >= mCapacity)
 		{
-			mString[i - 1 + count] = mString[i - 1];
+			grow(mLength + count);
 		}
 
-		mLength = mLength + count;
-
+		// shift the tail, null character included
+		Memory::Memmove(&mString[index + count], &mString[index], mLength - index + 1ul);
 		Memory::Memset(&mString[index], ch, count);
+		mLength += count;
 
 		return true;
 	}
@@ -1286,30 +1814,7 @@ export namespace cave
 			return false;
 		}
 
-		if (index + count + 1 >= mCapacity)
-		{
-#if CAPACITY_INCREASE_MODE == CAPACITY_INCREASE_MODE_DOUBLE
-			size_t newCapacity = mCapacity * 2;
-#else
-			size_t newCapacity = GetSufficientCapacity<ALIGNED_BYTE>(newLength);
-#endif
-			char* newString = static_cast<char*>(mPool->Allocate(newCapacity * sizeof(char)));
-			strncpy_s(newString, newCapacity, mString, mLength);
-			Memory::Memset(&newString[mLength], '\0', newCapacity - mLength);
-
-			mPool->Deallocate(mString, mCapacity * sizeof(char));
-			mString = newString;
-			mCapacity = newCapacity;
-		}
-
-		for (size_t i = mLength + 1; i > index; --i)
-		{
-			mString[i - 1 + count] = mString[i - 1];
-		}
-		mLength = mLength + count;
-
-		Memory::Memcpy(&mString[index], s, Math::GetMinSizeType(mCapacity - index, count));
-		//strncpy_s(&mString[index], mCapacity - index, s, count);
+		insert(index, s, count);
 
 		return true;
 	}
@@ -1330,31 +1835,7 @@ export namespace cave
 			return false;
 		}
 
-		if (index + str.mLength + 1 >= mCapacity)
-		{
-#if CAPACITY_INCREASE_MODE == CAPACITY_INCREASE_MODE_DOUBLE
-			size_t newCapacity = mCapacity * 2;
-#else
-			size_t newCapacity = GetSufficientCapacity<ALIGNED_BYTE>(newLength);
-#endif
-			char* newString = static_cast<char*>(mPool->Allocate(newCapacity * sizeof(char)));
-			strncpy_s(newString, newCapacity, mString, mLength);
-			Memory::Memset(&newString[mLength], '\0', mCapacity - mLength);
-
-			mPool->Deallocate(mString, mCapacity * sizeof(char));
-			mString = newString;
-			mCapacity = newCapacity;
-		}
-
-		for (size_t i = mLength + 1; i > index; --i)
-		{
-			mString[i - 1 + str.mLength] = mString[i - 1];
-		}
-
-		mLength = mLength + str.mLength;
-
-		Memory::Memcpy(&mString[index], str.mString, Math::GetMinSizeType(mCapacity - index, str.mLength));
-		//strncpy_s(&mString[index], mCapacity - index, str.mString, str.mLength);
+		insert(index, str.mString, str.mLength);
 
 		return true;
 	}
@@ -1392,31 +1873,7 @@ export namespace cave
 			return false;
 		}
 
-		if (index + str.mLength + 1 >= mCapacity)
-		{
-#if CAPACITY_INCREASE_MODE == CAPACITY_INCREASE_MODE_DOUBLE
-			size_t newCapacity = mCapacity * 2;
-#else
-			size_t newCapacity = GetSufficientCapacity<ALIGNED_BYTE>(newLength);
-#endif
-			char* newString = static_cast<char*>(mPool->Allocate(newCapacity * sizeof(char)));
-			strncpy_s(newString, newCapacity, mString, mLength);
-			Memory::Memset(&newString[mLength], '\0', mCapacity - mLength);
-
-			mPool->Deallocate(mString, mCapacity * sizeof(char));
-			mString = newString;
-			mCapacity = newCapacity;
-		}
-
-		for (size_t i = mLength + 1; i > index; --i)
-		{
-			mString[i - 1 + str.mLength] = mString[i - 1];
-		}
-
-		mLength = mLength + count;
-
-		Memory::Memcpy(&mString[index], &str.mString[indexStr], Math::GetMinSizeType(mCapacity - index, count));
-		//strncpy_s(&mString[index], mCapacity - index, &str.mString[indexStr], count);
+		insert(index, &str.mString[indexStr], Math::GetMinSizeType(count, str.mLength - indexStr));
 
 		return true;
 	}
@@ -1475,28 +1932,14 @@ export namespace cave
 			return;
 		}
 
-		if (mLength + 1 >= mCapacity)
+		if (mLength + 1ul >= mCapacity)
 		{
-			// Reallocate memory
-			size_t newLength = mLength + 1;
-#if CAPACITY_INCREASE_MODE == CAPACITY_INCREASE_MODE_DOUBLE
-			size_t newCapacity = mCapacity * 2;
-#else
-			size_t newCapacity = GetSufficientCapacity<ALIGNED_BYTE>(newLength);
-#endif
-			char* newString = static_cast<char*>(mPool->Allocate(newCapacity * sizeof(char)));
-
-			// Copy s to mString
-			strncpy_s(newString, newCapacity, mString, mLength);
-			Memory::Memset(&newString[mLength], '\0', newCapacity - newLength);
-			mPool->Deallocate(mString, mCapacity * sizeof(char));
-			mString = newString;
-			mLength = newLength;
-			mCapacity = newCapacity;
+			grow(mLength + 1ul);
 		}
 
 		mString[mLength] = ch;
 		++mLength;
+		mString[mLength] = '\0';
 	}
 
 	/**
@@ -1512,6 +1955,7 @@ export namespace cave
 		if (mLength > 0ul)
 		{
 			--mLength;
+			mString[mLength] = '\0';
 		}
 	}
 
@@ -1521,7 +1965,7 @@ export namespace cave
 	 * @brief (1) Appends characters to the end
 	 * @details Appends count copies of character ch
 	 * 			@n@n
-	 * 			Complexity: constant
+	 * 			Complexity: amortized linear in the number of appended characters
 	 * @param count number of characters to append
 	 * @param ch character value to append
 	 *
@@ -1536,7 +1980,7 @@ export namespace cave
 	 * @brief (2) Appends characters to the end
 	 * @details Appends string str
 	 * 			@n@n
-	 * 			Complexity: constant
+	 * 			Complexity: amortized linear in the number of appended characters
 	 * @param str string to append
 	 *
 	 */
@@ -1551,7 +1995,7 @@ export namespace cave
 	 * @details Appends a substring [pos, pos+count) of str.
 	 * 			If the requested substring lasts past the end of the string, or if count == NPOS, the appended substring is [pos, GetLength()).
 	 * 			@n@n
-	 * 			Complexity: constant
+	 * 			Complexity: amortized linear in the number of appended characters
 	 * @param pos the index of the first character to append
 	 * @param str string to append
 	 *
@@ -1567,7 +2011,7 @@ export namespace cave
 	 * @details Appends a substring [pos, pos+count) of str.
 	 * 			If the requested substring lasts past the end of the string, or if count == NPOS, the appended substring is [pos, GetLength()).
 	 * 			@n@n
-	 * 			Complexity: constant
+	 * 			Complexity: amortized linear in the number of appended characters
 	 * @param count number of characters to append
 	 * @param pos the index of the first character to append
 	 * @param str string to append
@@ -1584,7 +2028,7 @@ export namespace cave
 	 * @details Appends characters in the range <code>[s, s + count)</code>.
 	 * 			This range can contain null characters.
 	 * 			@n@n
-	 * 			Complexity: constant
+	 * 			Complexity: amortized linear in the number of appended characters
 	 * @param count number of characters to append
 	 * @param s pointer to the character string to append
 	 *
@@ -1600,7 +2044,7 @@ export namespace cave
 	 * @details Appends the null-terminated character string pointed to by s.
 	 * 			The length of the string is determined by the first null character using <code>Strlen(s)</code>.
 	 * 			@n@n
-	 * 			Complexity: constant
+	 * 			Complexity: amortized linear in the number of appended characters
 	 * @param s pointer to the character string to append
 	 *
 	 */
@@ -1609,6 +2053,20 @@ export namespace cave
 		InsertAt(mLength, s);
 	}
 
+	/**
+	 *
+	 * @brief (6) Appends characters to the end
+	 * @details Appends the characters of view, which need not be null-terminated.
+	 * 			@n@n
+	 * 			Complexity: amortized linear in the number of appended characters
+	 * @param view characters to append
+	 *
+	 */
+	constexpr void String::Append(StringView view)
+	{
+		insert(mLength, view.GetData(), view.GetLength());
+	}
+
 	/**
 	 *
 	 * @brief (1) Appends characters to the end
@@ -1621,7 +2079,7 @@ export namespace cave
 	 */
 	String& String::operator+=(const String& str)
 	{
-		Append(str.mString);
+		Append(str);
 
 		return *this;
 	}
@@ -1660,6 +2118,23 @@ export namespace cave
 		return *this;
 	}
 
+	/**
+	 *
+	 * @brief (4) Appends characters to the end
+	 * @details Appends the characters of view.
+	 * 			@n@n
+	 * 			Complexity: linear in size of view
+	 * @param view characters to append
+	 * @return *this
+	 *
+	 */
+	String& String::operator+=(StringView view)
+	{
+		Append(view);
+
+		return *this;
+	}
+
 	/**
 	 *
 	 * @brief (1) Checks if the string starts with the given prefix
@@ -1757,6 +2232,19 @@ export namespace cave
 		return true;
 	}
 
+	/**
+	 *
+	 * @brief (4) Checks if the string starts with the given prefix
+	 * @details Checks if the string begins with the given prefix, a view.
+	 * @param view a string view
+	 * @return true if the string begins with the provided prefix, false otherwise.
+	 *
+	 */
+	bool String::StartsWith(StringView view) const
+	{
+		return StringView(*this).StartsWith(view);
+	}
+
 	/**
 	 *
 	 * @brief (1) Checks if the string ends with the given suffix
@@ -1854,6 +2342,19 @@ export namespace cave
 		return true;
 	}
 
+	/**
+	 *
+	 * @brief (4) Checks if the string ends with the given suffix
+	 * @details Checks if the string ends with the given suffix, a view.
+	 * @param view a string view
+	 * @return true if the string ends with the provided suffix, false otherwise.
+	 *
+	 */
+	bool String::EndsWith(StringView view) const
+	{
+		return StringView(*this).EndsWith(view);
+	}
+
 	/**
 	 *
 	 * @brief (1) Checks if the string contains the given substring or character
@@ -1864,37 +2365,7 @@ export namespace cave
 	 */
 	constexpr bool String::Contains(const String& str) const noexcept
 	{
-		if (mLength < str.mLength)
-		{
-			return false;
-		}
-
-		for (size_t i = 0ul; i < mLength; ++i)
-		{
-			if (mString[i] == str.mString[0])
-			{
-				if (mLength - i < str.mLength)
-				{
-					return false;
-				}
-
-				size_t strIndex = 1ul;
-				for (; strIndex < str.mLength; ++strIndex)
-				{
-					if (mString[strIndex + i] != str.mString[strIndex])
-					{
-						break;
-					}
-				}
-
-				if (strIndex == str.mLength)
-				{
-					return true;
-				}
-			}
-		}
-
-		return false;
+		return StringSearch::Find(mString, mLength, str.mString, str.mLength) != StringSearch::NOT_FOUND;
 	}
 
 	/**
@@ -1907,37 +2378,7 @@ export namespace cave
 	 */
 	constexpr bool String::Contains(const String&& str) const noexcept
 	{
-		if (mLength < str.mLength)
-		{
-			return false;
-		}
-
-		for (size_t i = 0ul; i < mLength; ++i)
-		{
-			if (mString[i] == str.mString[0])
-			{
-				if (mLength - i < str.mLength)
-				{
-					return false;
-				}
-
-				size_t strIndex = 1ul;
-				for (; strIndex < str.mLength; ++strIndex)
-				{
-					if (mString[strIndex + i] != str.mString[strIndex])
-					{
-						break;
-					}
-				}
-
-				if (strIndex == str.mLength)
-				{
-					return true;
-				}
-			}
-		}
-
-		return false;
+		return StringSearch::Find(mString, mLength, str.mString, str.mLength) != StringSearch::NOT_FOUND;
 	}
 
 	/**
@@ -1950,15 +2391,7 @@ export namespace cave
 	 */
 	constexpr bool String::Contains(char c) const noexcept
 	{
-		for (size_t i = 0ul; i < mLength; ++i)
-		{
-			if (mString[i] == c)
-			{
-				return true;
-			}
-		}
-
-		return false;
+		return StringSearch::Find(mString, mLength, &c, 1ul) != StringSearch::NOT_FOUND;
 	}
 
 	/**
@@ -1971,38 +2404,22 @@ export namespace cave
 	 */
 	bool String::Contains(const char* s) const
 	{
-		size_t sLength = Strlen(s);
-		if (mLength < sLength)
-		{
-			return false;
-		}
-
-		for (size_t i = 0ul; i < mLength; ++i)
-		{
-			if (mString[i] == s[0])
-			{
-				if (mLength - i < sLength)
-				{
-					return false;
-				}
-
-				size_t strIndex = 1ul;
-				for (; strIndex < sLength; ++strIndex)
-				{
-					if (mString[strIndex + i] != s[strIndex])
-					{
-						break;
-					}
-				}
+		assert(s != nullptr);
 
-				if (strIndex == sLength)
-				{
-					return true;
-				}
-			}
-		}
+		return StringSearch::Find(mString, mLength, s, Strlen(s)) != StringSearch::NOT_FOUND;
+	}
 
-		return false;
+	/**
+	 *
+	 * @brief (4) Checks if the string contains the given substring or character
+	 * @details Checks if the string contains the given substring, a view.
+	 * @param view a string view
+	 * @return true if the string contains the provided substring, false otherwise.
+	 *
+	 */
+	bool String::Contains(StringView view) const
+	{
+		return StringSearch::Find(mString, mLength, view.GetData(), view.GetLength()) != StringSearch::NOT_FOUND;
 	}
 
 	/**
@@ -2086,20 +2503,8 @@ export namespace cave
 			}
 		}
 
-		if (count < count2)
-		{
-			for (size_t i = mLength + 1; i > pos + count; --i)
-			{
-				mString[i - 1 + count2 - count] = mString[i - 1];
-			}
-		}
-		else
-		{
-			for (size_t i = pos + count; i < mLength + 1; ++i)
-			{
-				mString[i - count + count2] = mString[i];
-			}
-		}
+		// shift the tail, null character included, to its new place
+		Memory::Memmove(&mString[pos + count2], &mString[pos + count], mLength + 1 - pos - count);
 
 		Memory::Memcpy(&mString[pos], &str.mString[pos2], Math::GetMinSizeType(mCapacity - pos, count2));
 		mLength = newLength;
@@ -2143,29 +2548,17 @@ export namespace cave
 			size_t newCapacity = GetSufficientCapacity<ALIGNED_BYTE>(newLength);
 			if (newCapacity - 1 >= newLength + 1)
 			{
-				SetCapacity(newCapacity - 1);
-			}
-			else
-			{
-				SetCapacity((newCapacity - 1) << 1);
-			}
-		}
-
-		if (count < count2)
-		{
-			for (size_t i = mLength + 1; i > pos + count; --i)
-			{
-				mString[i - 1 + count2 - count] = mString[i - 1];
-			}
-		}
-		else
-		{
-			for (size_t i = pos + count; i < mLength + 1; ++i)
-			{
-				mString[i - count + count2] = mString[i];
+				SetCapacity(newCapacity - 1);
+			}
+			else
+			{
+				SetCapacity((newCapacity - 1) << 1);
 			}
 		}
 
+		// shift the tail, null character included, to its new place
+		Memory::Memmove(&mString[pos + count2], &mString[pos + count], mLength + 1 - pos - count);
+
 		Memory::Memcpy(&mString[pos], cStr, Math::GetMinSizeType(mCapacity - pos, count2));
 		//strncpy_s(&mString[pos], mCapacity - pos, cStr, count2);
 
@@ -2229,20 +2622,8 @@ export namespace cave
 			}
 		}
 
-		if (count < count2)
-		{
-			for (size_t i = mLength + 1; i > pos + count; --i)
-			{
-				mString[i - 1 + count2 - count] = mString[i - 1];
-			}
-		}
-		else
-		{
-			for (size_t i = pos + count; i < mLength + 1; ++i)
-			{
-				mString[i - count + count2] = mString[i];
-			}
-		}
+		// shift the tail, null character included, to its new place
+		Memory::Memmove(&mString[pos + count2], &mString[pos + count], mLength + 1 - pos - count);
 
 		Memory::Memset(&mString[pos], ch, count2);
 		mLength = newLength;
@@ -2328,10 +2709,10 @@ export namespace cave
 			if (newLength + 1 > mCapacity)
 			{
 				size_t newCapacity = GetSufficientCapacity<ALIGNED_BYTE>(newLength);
-				char* newString = reinterpret_cast<char*>(mPool->Allocate(newCapacity * sizeof(char)));
+				char* newString = allocate(newCapacity);
 				strncpy_s(newString, newCapacity, mString, mLength);
 				Memory::Memset(&newString[mLength], '\0', newCapacity - mLength);
-				mPool->Deallocate(mString, mCapacity * sizeof(char));
+				deallocate(mString, mCapacity);
 				mString = newString;
 				mCapacity = newCapacity;
 			}
@@ -2356,7 +2737,7 @@ export namespace cave
 	 */
 	constexpr size_t String::GetIndexOf(const String& str) const noexcept
 	{
-		return GetIndexOf(str.mString, 0ul);
+		return GetIndexOf(str.mString, 0ul, str.mLength);
 	}
 
 	/**
@@ -2371,7 +2752,7 @@ export namespace cave
 	 */
 	constexpr size_t String::GetIndexOf(const String& str, size_t pos) const noexcept
 	{
-		return GetIndexOf(str.mString, pos);
+		return GetIndexOf(str.mString, pos, str.mLength);
 	}
 
 	/**
@@ -2387,47 +2768,18 @@ export namespace cave
 	 */
 	constexpr size_t String::GetIndexOf(const char* s, size_t pos, size_t count) const
 	{
-		if (s == nullptr)
+		if (s == nullptr || pos > mLength)
 		{
 			return NPOS;
 		}
 
-		char* temp = &mString[pos];
-		size_t index = pos;
-
-		while (index - pos < count)
+		size_t index = StringSearch::Find(&mString[pos], mLength - pos, s, count);
+		if (index == StringSearch::NOT_FOUND)
 		{
-			size_t counter = index - pos;
-			const char* checkS = s;
-			// Find first index of mString that either is NULL or is same to first character of s
-			for (; counter < count && *temp != '\0' && *temp != *checkS; ++temp, ++index)
-			{
-			}
-
-			// Fail. No identical first letter character
-			if (*temp == '\0')
-			{
-				return NPOS;
-			}
-
-			// Check whether s and rest of characters of mString resembles
-			++temp;
-			++checkS;
-			++counter;
-			for (; counter < count && *temp != '\0' && *temp == *checkS; ++temp, ++checkS, ++counter)
-			{
-			}
-
-			// Success. Resembles
-			if (*checkS == '\0')
-			{
-				return index;
-			}
-
-			++index;
+			return NPOS;
 		}
 
-		return NPOS;
+		return pos + index;
 	}
 
 	/**
@@ -2463,6 +2815,35 @@ export namespace cave
 		return GetIndexOf(s, pos, Strlen(s));
 	}
 
+	/**
+	 *
+	 * @brief (3) Find characters in the string
+	 * @details Finds the first substring equal to the characters of view.
+	 * 			Search begins at 0.
+	 * @param view characters to search for
+	 * @return Position of the first character of the found substring or npos if no such substring is found.
+	 *
+	 */
+	constexpr size_t String::GetIndexOf(StringView view) const
+	{
+		return GetIndexOf(view.GetData(), 0ul, view.GetLength());
+	}
+
+	/**
+	 *
+	 * @brief (3) Find characters in the string
+	 * @details Finds the first substring equal to the characters of view.
+	 * 			Search begins at pos, i.e. the found substring must not begin in a position preceding pos.
+	 * @param view characters to search for
+	 * @param pos position at which to start the search
+	 * @return Position of the first character of the found substring or npos if no such substring is found.
+	 *
+	 */
+	constexpr size_t String::GetIndexOf(StringView view, size_t pos) const
+	{
+		return GetIndexOf(view.GetData(), pos, view.GetLength());
+	}
+
 	/**
 	 *
 	 * @brief (4) Find characters in the string
@@ -2489,15 +2870,7 @@ export namespace cave
 	 */
 	constexpr size_t String::GetIndexOf(char ch, size_t pos) const
 	{
-		for (size_t i = pos; i < mLength; ++i)
-		{
-			if (mString[i] == ch)
-			{
-				return i;
-			}
-		}
-
-		return NPOS;
+		return GetIndexOf(&ch, pos, 1ul);
 	}
 
 	/**
@@ -2559,66 +2932,24 @@ export namespace cave
 	 */
 	constexpr size_t String::GetLastIndexOf(const char* s, size_t pos, size_t count) const
 	{
-		if (s == nullptr)
+		if (s == nullptr || count > mLength)
 		{
 			return NPOS;
 		}
 
-		if (*s == '\0')
+		// the match may not begin after pos, so everything past pos + count is out of reach
+		if (pos > mLength - count)
 		{
-			if (mLength > 0)
-			{
-				return mLength;
-			}
-
-			return 0;
+			pos = mLength - count;
 		}
 
-		if (*mString == '\0')
+		size_t index = StringSearch::FindLast(mString, pos + count, s, count);
+		if (index == StringSearch::NOT_FOUND)
 		{
 			return NPOS;
 		}
 
-		if (pos == NPOS || pos >= mLength - 1)
-		{
-			pos = mLength - 1;
-		}
-
-		char* temp = mString + pos;
-		size_t index = pos;
-
-		while (true)
-		{
-			const char* checkS = s;
-			size_t counter = 0;
-			// Find last index of mString that either is first character or is same to first character of s
-			for (; temp != (mString - 1) && *temp != *checkS; --temp, --index)
-			{
-			}
-
-			// Fail. No identical character
-			if (temp == (mString - 1))
-			{
-				return NPOS;
-			}
-
-			char* firstCharacter = temp;
-			// Check whether s and rest of characters of mString resembles
-			for (; counter < count && *firstCharacter != '\0' && *firstCharacter == *checkS; ++firstCharacter, ++checkS, ++counter)
-			{
-			}
-
-			// Success. Resembles
-			if (*checkS == '\0')
-			{
-				return index;
-			}
-
-			--temp;
-			--index;
-		}
-
-		return NPOS;
+		return index;
 	}
 
 	/**
@@ -2705,20 +3036,7 @@ export namespace cave
 	 */
 	constexpr size_t String::GetLastIndexOf(char ch, size_t pos) const
 	{
-		if (pos == NPOS)
-		{
-			pos = 0;
-		}
-
-		for (size_t i = mLength; i > pos; --i)
-		{
-			if (mString[i - 1] == ch)
-			{
-				return i - 1;
-			}
-		}
-
-		return NPOS;
+		return GetLastIndexOf(&ch, pos, 1ul);
 	}
 
 	/**
@@ -4602,28 +4920,255 @@ export namespace cave
 		}
 #endif
 
-		return eResult::CAVE_OK;
+		return eResult::CAVE_OK;
+	}
+
+	constexpr size_t Strlen(const char* str)
+	{
+		if (str == nullptr)
+		{
+			return 0;
+		}
+
+		size_t size = 0ul;
+		while (str[size] != '\0')
+		{
+			++size;
+		}
+
+		return size;
+	}
+
+	int32_t Strcmp(const char* lhs, const char* rhs, size_t count)
+	{
+		return strncmp(lhs, rhs, count);
+	}
+
+	/**
+	 *
+	 * @brief Constructs an empty builder. Memory pool is obtained from the Core Memory Pool.
+	 *
+	 */
+	StringBuilder::StringBuilder() noexcept(noexcept(gCoreMemoryPool))
+		: StringBuilder(gCoreMemoryPool)
+	{
+	}
+
+	/**
+	 *
+	 * @brief Constructs an empty builder that spills over to pool and builds its strings from pool.
+	 *
+	 */
+	StringBuilder::StringBuilder(MemoryPool& pool) noexcept
+		: mPool(&pool)
+	{
+		mBuffer[0] = '\0';
+	}
+
+	StringBuilder::~StringBuilder()
+	{
+		if (mString != mBuffer)
+		{
+			mPool->Deallocate(mString, mCapacity * sizeof(char));
+		}
+	}
+
+	/**
+	 *
+	 * @brief Returns the characters appended so far as a null-terminated array
+	 * @details The pointer is invalidated by the next Append.
+	 *
+	 */
+	const char* StringBuilder::GetCString() const
+	{
+		return mString;
+	}
+
+	constexpr size_t StringBuilder::GetLength() const noexcept
+	{
+		return mLength;
+	}
+
+	constexpr size_t StringBuilder::GetCapacity() const noexcept
+	{
+		return mCapacity - 1ul;
+	}
+
+	/**
+	 *
+	 * @brief Reserves storage
+	 * @details Makes room for at least newCapacity characters, so that appending up to that many causes no reallocation.
+	 * @param newCapacity new capacity of the builder
+	 *
+	 */
+	void StringBuilder::SetCapacity(size_t newCapacity)
+	{
+		if (newCapacity > mLength)
+		{
+			reserveBack(newCapacity - mLength);
+		}
+	}
+
+	/**
+	 *
+	 * @brief Removes all characters but keeps the storage, so that the builder can be reused for the next string
+	 *
+	 */
+	void StringBuilder::Clear() noexcept
+	{
+		mLength = 0ul;
+		mString[0] = '\0';
+	}
+
+	StringBuilder& StringBuilder::Append(const String& str)
+	{
+		return Append(str.GetCString(), str.GetLength());
+	}
+
+	StringBuilder& StringBuilder::Append(const char* s)
+	{
+		assert(s != nullptr);
+
+		return Append(s, Strlen(s));
+	}
+
+	/**
+	 *
+	 * @brief Appends characters in the range <code>[s, s + count)</code>
+	 * @details s may point into this builder, e.g. <code>builder.Append(builder.GetCString(), n)</code>:
+	 * 			the characters are read at the same offset of the grown storage.
+	 * 			@n@n
+	 * 			Complexity: amortized linear in count
+	 *
+	 */
+	StringBuilder& StringBuilder::Append(const char* s, size_t count)
+	{
+		if (s >= mString && s < mString + mLength)
+		{
+			// reserveBack() may release the storage s points into
+			size_t offset = static_cast<size_t>(s - mString);
+			char* destination = reserveBack(count);
+			Memory::Memcpy(destination, &mString[offset], count);
+		}
+		else
+		{
+			Memory::Memcpy(reserveBack(count), s, count);
+		}
+		mLength += count;
+		mString[mLength] = '\0';
+
+		return *this;
+	}
+
+	StringBuilder& StringBuilder::Append(char ch)
+	{
+		return Append(1ul, ch);
+	}
+
+	StringBuilder& StringBuilder::Append(size_t count, char ch)
+	{
+		Memory::Memset(reserveBack(count), ch, count);
+		mLength += count;
+		mString[mLength] = '\0';
+
+		return *this;
+	}
+
+	/**
+	 *
+	 * @brief Appends the decimal representation of value, as std::sprintf(buf, "%d", value) would produce
+	 *
+	 */
+	StringBuilder& StringBuilder::Append(int32_t value)
+	{
+		return Append(static_cast<int64_t>(value));
+	}
+
+	StringBuilder& StringBuilder::Append(uint32_t value)
+	{
+		return Append(static_cast<uint64_t>(value));
+	}
+
+	StringBuilder& StringBuilder::Append(int64_t value)
+	{
+		if (value < 0)
+		{
+			Append('-');
+			// negate in unsigned arithmetic so that the minimum value does not overflow
+			return Append(0ull - static_cast<uint64_t>(value));
+		}
+
+		return Append(static_cast<uint64_t>(value));
+	}
+
+	StringBuilder& StringBuilder::Append(uint64_t value)
+	{
+		// 20 digits hold the largest uint64_t
+		char digits[20];
+		size_t count = 0ul;
+		do
+		{
+			digits[sizeof(digits) - 1ul - count] = static_cast<char>('0' + value % 10ull);
+			value /= 10ull;
+			++count;
+		} while (value != 0ull);
+
+		return Append(&digits[sizeof(digits) - count], count);
 	}
 
-	constexpr size_t Strlen(const char* str)
+	StringBuilder& StringBuilder::operator+=(const String& str)
 	{
-		if (str == nullptr)
-		{
-			return 0;
-		}
+		return Append(str);
+	}
 
-		size_t size = 0ul;
-		while (str[size] != '\0')
-		{
-			++size;
-		}
+	StringBuilder& StringBuilder::operator+=(const char* s)
+	{
+		return Append(s);
+	}
 
-		return size;
+	StringBuilder& StringBuilder::operator+=(char ch)
+	{
+		return Append(ch);
 	}
 
-	int32_t Strcmp(const char* lhs, const char* rhs, size_t count)
+	/**
+	 *
+	 * @brief Returns the concatenated string, allocated from the builder's memory pool
+	 *
+	 */
+	String StringBuilder::ToString() const
 	{
-		return strncmp(lhs, rhs, count);
+		return ToString(*mPool);
+	}
+
+	String StringBuilder::ToString(MemoryPool& pool) const
+	{
+		return String(mString, mLength, pool);
+	}
+
+	/**
+	 *
+	 * @brief Returns where count more characters can be written, growing the storage geometrically if needed
+	 *
+	 */
+	char* StringBuilder::reserveBack(size_t count)
+	{
+		size_t newLength = mLength + count;
+		if (newLength >= mCapacity)
+		{
+			size_t newCapacity = Math::GetMaxSizeType(mCapacity * 2ul, GetSufficientCapacity<String::ALIGNED_BYTE>(newLength));
+			char* newString = static_cast<char*>(mPool->Allocate(newCapacity * sizeof(char)));
+			Memory::Memcpy(newString, mString, mLength + 1ul);
+
+			if (mString != mBuffer)
+			{
+				mPool->Deallocate(mString, mCapacity * sizeof(char));
+			}
+			mString = newString;
+			mCapacity = newCapacity;
+		}
+
+		return &mString[mLength];
 	}
 
 	// Constructor
@@ -4653,8 +5198,8 @@ export namespace cave
 	WString::WString(MemoryPool& pool) noexcept
 		: mPool(&pool)
 		, mLength(0ul)
-		, mCapacity(ALIGNED_BYTE)
-		, mString(static_cast<wchar_t*>(mPool->Allocate(mCapacity * sizeof(wchar_t))))
+		, mCapacity(SSO_CAPACITY)
+		, mString(allocate(mCapacity))
 	{
 		Memory::WMemset(mString, L'\0', mCapacity);
 	}
@@ -4684,8 +5229,8 @@ export namespace cave
 	WString::WString(size_t count, wchar_t wCh, MemoryPool& pool)
 		: mPool(&pool)
 		, mLength(count)
-		, mCapacity(GetSufficientCapacity<ALIGNED_BYTE>(mLength))
-		, mString(static_cast<wchar_t*>(mPool->Allocate(mCapacity * sizeof(wchar_t))))
+		, mCapacity(getSufficientCapacity(mLength))
+		, mString(allocate(mCapacity))
 	{
 		Memory::WMemset(mString, wCh, mLength);
 		Memory::WMemset(&mString[mLength], L'\0', (mCapacity - mLength));
@@ -4758,7 +5303,7 @@ export namespace cave
 		: mPool(&pool)
 		, mLength(count)
 		, mCapacity(other.mCapacity)
-		, mString(static_cast<wchar_t*>(mPool->Allocate(mCapacity * sizeof(wchar_t))))
+		, mString(allocate(mCapacity))
 	{
 		assert(other.mString != nullptr);
 
@@ -4808,20 +5353,50 @@ export namespace cave
 	{
 		assert(wStr != nullptr);
 
-		mLength = count;
-		mCapacity = GetSufficientCapacity<ALIGNED_BYTE>(mLength);
-		mString = static_cast<wchar_t*>(mPool->Allocate(mCapacity * sizeof(wchar_t)));
-
-		if (count == NPOS || WStrlen(wStr) < count)
+		if (count == NPOS)
 		{
 			count = WStrlen(wStr);
 		}
 
-		// Copy wStr to mString
-		WStrcpy(mString, mCapacity, wStr, count);
+		mLength = count;
+		mCapacity = getSufficientCapacity(mLength);
+		mString = allocate(mCapacity);
+
+		// Copy wStr to mString, wStr need not be null-terminated
+		Memory::Memcpy(mString, wStr, count * sizeof(wchar_t));
 		Memory::WMemset(&mString[mLength], L'\0', (mCapacity - mLength));
 	}
 
+	/**
+	 *
+	 * @brief (4) Constructs the string with the wchar_tacters of view.
+	 * @details The view need not be null-terminated, it can contain null wchar_tacters.
+	 * 			Explicit, so that an allocation never happens behind a function taking a WString.
+	 * 			@n@n
+	 * 			Complexity: linear in view.GetLength()
+	 * @param view wchar_tacters to initialize the string with
+	 *
+	 */
+	WString::WString(WStringView view)
+		: WString(view.GetData(), view.GetLength(), gCoreMemoryPool)
+	{
+	}
+
+	/**
+	 *
+	 * @brief (4) Constructs the string with the wchar_tacters of view.
+	 * @details The view need not be null-terminated, it can contain null wchar_tacters.
+	 * 			@n@n
+	 * 			Complexity: linear in view.GetLength()
+	 * @param view wchar_tacters to initialize the string with
+	 * @param pool memory pool to use for all memory allocations of this string
+	 *
+	 */
+	WString::WString(WStringView view, MemoryPool& pool)
+		: WString(view.GetData(), view.GetLength(), pool)
+	{
+	}
+
 	/**
 	 *
 	 * @brief (5) Constructs the string with the contents initialized with a copy of the null-terminated wchar_tacter string pointed to by wStr.
@@ -4855,8 +5430,8 @@ export namespace cave
 
 		// Allocate Memory
 		mLength = WStrlen(wStr);
-		mCapacity = GetSufficientCapacity<ALIGNED_BYTE>(mLength);
-		mString = static_cast<wchar_t*>(mPool->Allocate(mCapacity * sizeof(wchar_t)));
+		mCapacity = getSufficientCapacity(mLength);
+		mString = allocate(mCapacity);
 
 		// Copy wStr to mString
 		WStrcpy(mString, mCapacity, wStr, mLength);
@@ -4896,8 +5471,8 @@ export namespace cave
 		{
 		}
 
-		mCapacity = GetSufficientCapacity<ALIGNED_BYTE>(mLength);
-		mString = static_cast<wchar_t*>(mPool->Allocate(mCapacity * sizeof(wchar_t)));
+		mCapacity = getSufficientCapacity(mLength);
+		mString = allocate(mCapacity);
 
 		Memory::WMemcpy(mString, first, mLength);
 		Memory::WMemset(&mString[mLength], L'\0', (mCapacity - mLength));
@@ -4918,7 +5493,7 @@ export namespace cave
 		, mCapacity(other.mCapacity)
 	{
 		assert(other.mPool != nullptr && other.mString != nullptr);
-		mString = static_cast<wchar_t*>(mPool->Allocate((mCapacity) * sizeof(wchar_t)));
+		mString = allocate(mCapacity);
 		WStrcpy(mString, mCapacity, other.mString, mLength);
 		Memory::WMemset(&mString[mLength], L'\0', (mCapacity - mLength));
 	}
@@ -4939,7 +5514,7 @@ export namespace cave
 		, mCapacity(other.mCapacity)
 	{
 		assert(other.mString != nullptr);
-		mString = static_cast<wchar_t*>(mPool->Allocate((mCapacity) * sizeof(wchar_t)));
+		mString = allocate(mCapacity);
 		WStrcpy(mString, mCapacity, other.mString, mLength);
 		Memory::WMemset(&mString[mLength], L'\0', (mCapacity - mLength));
 	}
@@ -4962,6 +5537,12 @@ export namespace cave
 	{
 		assert(other.mPool != nullptr && other.mString != nullptr);
 
+		if (other.mString == other.mBuffer)
+		{
+			Memory::Memcpy(mBuffer, other.mBuffer, mCapacity * sizeof(wchar_t));
+			mString = mBuffer;
+		}
+
 		other.mPool = nullptr;
 		other.mLength = 0ul;
 		other.mCapacity = 0ul;
@@ -4989,6 +5570,12 @@ export namespace cave
 	{
 		assert(other.mString != nullptr);
 
+		if (other.mString == other.mBuffer)
+		{
+			Memory::Memcpy(mBuffer, other.mBuffer, mCapacity * sizeof(wchar_t));
+			mString = mBuffer;
+		}
+
 		other.mPool = nullptr;
 		other.mLength = 0ul;
 		other.mCapacity = 0ul;
@@ -4997,6 +5584,41 @@ export namespace cave
 		other.~WString();
 	}
 
+	/**
+	 *
+	 * @brief Returns the capacity needed to store length characters and the null character
+	 * @details Strings that fit in the in-place buffer use SSO_CAPACITY, longer ones are rounded up to ALIGNED_BYTE.
+	 *
+	 */
+	constexpr size_t WString::getSufficientCapacity(size_t length)
+	{
+		return length < SSO_CAPACITY ? SSO_CAPACITY : GetSufficientCapacity<ALIGNED_BYTE>(length);
+	}
+
+	/**
+	 *
+	 * @brief Returns storage for capacity characters
+	 * @details The in-place buffer is used if capacity fits in it, the memory pool otherwise.
+	 *
+	 */
+	wchar_t* WString::allocate(size_t capacity)
+	{
+		if (capacity <= SSO_CAPACITY)
+		{
+			return mBuffer;
+		}
+
+		return static_cast<wchar_t*>(mPool->Allocate(capacity * sizeof(wchar_t)));
+	}
+
+	void WString::deallocate(wchar_t* string, size_t capacity)
+	{
+		if (string != mBuffer)
+		{
+			mPool->Deallocate(string, capacity * sizeof(wchar_t));
+		}
+	}
+
 	/**
 	 *
 	 * @brief destroys the string, deallocating internal storage if used
@@ -5006,7 +5628,7 @@ export namespace cave
 	{
 		if (mString != nullptr)
 		{
-			mPool->Deallocate(mString, mCapacity * sizeof(wchar_t));
+			deallocate(mString, mCapacity);
 			mString = nullptr;
 		}
 
@@ -5034,11 +5656,11 @@ export namespace cave
 
 			if (mCapacity < wStr.mLength + 1)
 			{
-				mPool->Deallocate(mString, mCapacity * sizeof(wchar_t));
+				deallocate(mString, mCapacity);
 
-				mCapacity = GetSufficientCapacity<ALIGNED_BYTE>(wStr.mLength);
+				mCapacity = getSufficientCapacity(wStr.mLength);
 
-				mString = static_cast<wchar_t*>(mPool->Allocate(mCapacity * sizeof(wchar_t)));
+				mString = allocate(mCapacity);
 			}
 
 			mLength = wStr.mLength;
@@ -5069,13 +5691,19 @@ export namespace cave
 
 			if (mString != nullptr)
 			{
-				mPool->Deallocate(mString, mCapacity * sizeof(wchar_t));
+				deallocate(mString, mCapacity);
 			}
 
 			mLength = wStr.mLength;
 			mCapacity = wStr.mCapacity;
 			mString = wStr.mString;
 
+			if (wStr.mString == wStr.mBuffer)
+			{
+				Memory::Memcpy(mBuffer, wStr.mBuffer, mCapacity * sizeof(wchar_t));
+				mString = mBuffer;
+			}
+
 			wStr.mPool = nullptr;
 			wStr.mLength = 0ul;
 			wStr.mCapacity = 0ul;
@@ -5107,11 +5735,11 @@ export namespace cave
 
 			if (mCapacity < sLength + 1)
 			{
-				mPool->Deallocate(mString, mCapacity * sizeof(wchar_t));
+				deallocate(mString, mCapacity);
 
-				mCapacity = GetSufficientCapacity<ALIGNED_BYTE>(sLength);
+				mCapacity = getSufficientCapacity(sLength);
 
-				mString = static_cast<wchar_t*>(mPool->Allocate(mCapacity * sizeof(wchar_t)));
+				mString = allocate(mCapacity);
 			}
 
 			Memory::WMemset(mString, L'\0', mLength);
@@ -5122,6 +5750,47 @@ export namespace cave
 		return *this;
 	}
 
+	/**
+	 *
+	 * @brief (3) Assigns values to the string
+	 * @details Replaces the contents with the wchar_tacters of view, which may point into this string.
+	 * 			@n@n
+	 * 			Complexity: linear in size of <code>view</code>
+	 * @param view wchar_tacters to initialize the string with
+	 * @return *this
+	 *
+	 */
+	WString& WString::operator=(WStringView view)
+	{
+		size_t length = view.GetLength();
+
+		if (mCapacity < length + 1)
+		{
+			// copy before releasing the old storage, view may point into it
+			size_t capacity = getSufficientCapacity(length);
+			wchar_t* wStr = allocate(capacity);
+			Memory::Memmove(wStr, view.GetData(), length * sizeof(wchar_t));
+			Memory::WMemset(&wStr[length], L'\0', capacity - length);
+
+			deallocate(mString, mCapacity);
+			mString = wStr;
+			mCapacity = capacity;
+		}
+		else
+		{
+			Memory::Memmove(mString, view.GetData(), length * sizeof(wchar_t));
+			if (length < mLength)
+			{
+				Memory::WMemset(&mString[length], L'\0', mLength - length);
+			}
+			mString[length] = L'\0';
+		}
+
+		mLength = length;
+
+		return *this;
+	}
+
 	/**
 	 *
 	 * @brief (4) Assigns values to the string
@@ -5288,6 +5957,19 @@ export namespace cave
 		return mString;
 	}
 
+	/**
+	 *
+	 * @brief Returns a view of the contents
+	 * @details The view is invalidated by anything that invalidates GetCString().
+	 * 			@n@n
+	 * 			Complexity: constant
+	 *
+	 */
+	WString::operator WStringView() const noexcept
+	{
+		return WStringView(mString, mLength);
+	}
+
 	// Capacity
 
 	/**
@@ -5349,11 +6031,11 @@ export namespace cave
 		++newCapacity;
 		if (newCapacity > mCapacity)
 		{
-			wchar_t* newString = reinterpret_cast<wchar_t*>(mPool->Allocate(newCapacity * sizeof(wchar_t)));
+			wchar_t* newString = allocate(newCapacity);
 			WStrcpy(newString, newCapacity, mString, mLength);
 			Memory::WMemset(&newString[mLength], L'\0', (newCapacity - mLength));
 
-			mPool->Deallocate(mString, mCapacity * sizeof(wchar_t));
+			deallocate(mString, mCapacity);
 			mCapacity = newCapacity;
 			mString = newString;
 		}
@@ -5385,13 +6067,13 @@ export namespace cave
 	 */
 	constexpr void WString::Shrink()
 	{
-		size_t fitCapacity = GetSufficientCapacity<ALIGNED_BYTE>(mLength);
+		size_t fitCapacity = getSufficientCapacity(mLength);
 		if (mCapacity != fitCapacity)
 		{
-			wchar_t* newString = static_cast<wchar_t*>(mPool->Allocate(fitCapacity * sizeof(wchar_t)));
+			wchar_t* newString = allocate(fitCapacity);
 			WStrcpy(newString, fitCapacity, mString, mLength);
 			Memory::WMemset(&newString[mLength], L'\0', (fitCapacity - mLength));
-			mPool->Deallocate(mString, mCapacity * sizeof(wchar_t));
+			deallocate(mString, mCapacity);
 			mCapacity = fitCapacity;
 			mString = newString;
 		}
@@ -5439,11 +6121,11 @@ export namespace cave
 #else
 			size_t newCapacity = GetSufficientCapacity<ALIGNED_BYTE>(newLength);
 #endif
-			wchar_t* newString = static_cast<wchar_t*>(mPool->Allocate(newCapacity * sizeof(wchar_t)));
+			wchar_t* newString = allocate(newCapacity);
 			WStrcpy(newString, newCapacity, mString, mLength);
 			Memory::WMemset(&newString[mLength], L'\0', (newCapacity - mLength));
 
-			mPool->Deallocate(mString, mCapacity * sizeof(wchar_t));
+			deallocate(mString, mCapacity);
 			mString = newString;
 			mCapacity = newCapacity;
 		}
@@ -5505,11 +6187,11 @@ export namespace cave
 #else
 			size_t newCapacity = GetSufficientCapacity<ALIGNED_BYTE>(newLength);
 #endif
-			wchar_t* newString = static_cast<wchar_t*>(mPool->Allocate(newCapacity * sizeof(wchar_t)));
+			wchar_t* newString = allocate(newCapacity);
 			WStrcpy(newString, newCapacity, mString, mLength);
 			Memory::WMemset(&newString[mLength], L'\0', (newCapacity - mLength));
 
-			mPool->Deallocate(mString, mCapacity * sizeof(wchar_t));
+			deallocate(mString, mCapacity);
 			mString = newString;
 			mCapacity = newCapacity;
 		}
@@ -5548,11 +6230,11 @@ export namespace cave
 #else
 			size_t newCapacity = GetSufficientCapacity<ALIGNED_BYTE>(newLength);
 #endif
-			wchar_t* newString = static_cast<wchar_t*>(mPool->Allocate(newCapacity * sizeof(wchar_t)));
+			wchar_t* newString = allocate(newCapacity);
 			WStrcpy(newString, newCapacity, mString, mLength);
 			Memory::WMemset(&newString[mLength], L'\0', (mCapacity - mLength));
 
-			mPool->Deallocate(mString, mCapacity * sizeof(wchar_t));
+			deallocate(mString, mCapacity);
 			mString = newString;
 			mCapacity = newCapacity;
 		}
@@ -5609,11 +6291,11 @@ export namespace cave
 #else
 			size_t newCapacity = GetSufficientCapacity<ALIGNED_BYTE>(newLength);
 #endif
-			wchar_t* newString = static_cast<wchar_t*>(mPool->Allocate(newCapacity * sizeof(wchar_t)));
+			wchar_t* newString = allocate(newCapacity);
 			WStrcpy(newString, newCapacity, mString, mLength);
 			Memory::WMemset(&newString[mLength], L'\0', (mCapacity - mLength));
 
-			mPool->Deallocate(mString, mCapacity * sizeof(wchar_t));
+			deallocate(mString, mCapacity);
 			mString = newString;
 			mCapacity = newCapacity;
 		}
@@ -5693,12 +6375,12 @@ export namespace cave
 #else
 			size_t newCapacity = GetSufficientCapacity<ALIGNED_BYTE>(newLength);
 #endif
-			wchar_t* newString = static_cast<wchar_t*>(mPool->Allocate(newCapacity * sizeof(wchar_t)));
+			wchar_t* newString = allocate(newCapacity);
 
 			// Copy wStr to mString
 			WStrcpy(newString, newCapacity, mString, mLength);
 			Memory::WMemset(&newString[mLength], L'\0', (newCapacity - newLength));
-			mPool->Deallocate(mString, mCapacity * sizeof(wchar_t));
+			deallocate(mString, mCapacity);
 			mString = newString;
 			mLength = newLength;
 			mCapacity = newCapacity;
@@ -6536,10 +7218,10 @@ export namespace cave
 			if (newLength + 1 > mCapacity)
 			{
 				size_t newCapacity = GetSufficientCapacity<ALIGNED_BYTE>(newLength);
-				wchar_t* newString = reinterpret_cast<wchar_t*>(mPool->Allocate(newCapacity * sizeof(wchar_t)));
+				wchar_t* newString = allocate(newCapacity);
 				WStrcpy(newString, newCapacity, mString, mLength);
 				Memory::WMemset(&newString[mLength], L'\0', newCapacity - mLength);
-				mPool->Deallocate(mString, mCapacity * sizeof(wchar_t));
+				deallocate(mString, mCapacity);
 				mString = newString;
 				mCapacity = newCapacity;
 			}
@@ -8727,23 +9409,131 @@ export namespace cave
 
 	wchar_t* CStringToWCStringMalloc(const char* str, MemoryPool& pool)
 	{
-		wchar_t* wideStr = nullptr;
-		int64_t convertResult = static_cast<int64_t>(MultiByteToWideChar(CP_UTF8, 0, str, static_cast<int>(Strlen(str)), nullptr, 0));
-		if (convertResult <= 0)
+		const size_t length = Strlen(str);
+		const size_t capacity = GetSufficientCapacity<WString::ALIGNED_BYTE>(GetWideLengthFromUtf8(str, length));
+		wchar_t* wideStr = reinterpret_cast<wchar_t*>(pool.Allocate(sizeof(wchar_t) * capacity));
+
+		const UnicodeResult converted = ConvertUtf8ToWide(str, length, wideStr);
+		if (converted.Error != eUnicodeError::NONE)
+		{
+			LOGEF(eLogChannel::CORE_STRING, "Error occurred: Failure to convert its message text using CStringToWCStringMalloc: invalid UTF-8 at byte %llu", static_cast<unsigned long long>(converted.Count));
+			pool.Deallocate(wideStr, sizeof(wchar_t) * capacity);
+
+			return nullptr;
+		}
+		wideStr[converted.Count] = L'\0';
+
+		return wideStr;
+	}
+
+	/**
+	 *
+	 * @brief Converts UTF-8 to WString
+	 * @details The result is allocated once, at its final size.
+	 * 			Invalid UTF-8 is logged and results in an empty string.
+	 * 			@n@n
+	 * 			Complexity: linear in utf8.GetLength()
+	 * @param utf8 UTF-8 encoded characters, not necessarily null-terminated
+	 * @return The UTF-16 (UTF-32 where wchar_t has 32 bits) encoded string
+	 *
+	 */
+	WString ToWString(StringView utf8)
+	{
+		return ToWString(utf8, gCoreMemoryPool);
+	}
+
+	/**
+	 *
+	 * @brief Converts UTF-8 to WString
+	 * @details The result is allocated once, at its final size.
+	 * 			Invalid UTF-8 is logged and results in an empty string.
+	 * 			@n@n
+	 * 			Complexity: linear in utf8.GetLength()
+	 * @param utf8 UTF-8 encoded characters, not necessarily null-terminated
+	 * @param pool memory pool to use for all memory allocations of the result
+	 * @return The UTF-16 (UTF-32 where wchar_t has 32 bits) encoded string
+	 *
+	 */
+	WString ToWString(StringView utf8, MemoryPool& pool)
+	{
+		WString result(pool);
+
+		const size_t length = GetWideLengthFromUtf8(utf8.GetData(), utf8.GetLength());
+		if (length + 1ul > result.mCapacity)
+		{
+			result.deallocate(result.mString, result.mCapacity);
+			result.mCapacity = WString::getSufficientCapacity(length);
+			result.mString = result.allocate(result.mCapacity);
+		}
+
+		const UnicodeResult converted = ConvertUtf8ToWide(utf8.GetData(), utf8.GetLength(), result.mString);
+		if (converted.Error != eUnicodeError::NONE)
 		{
-			LOGEF(eLogChannel::CORE_STRING, "Error occurred: Failure to convert its message text using CStringToWCStringMalloc: convertResult=%ld", convertResult);
+			LOGEF(eLogChannel::CORE_STRING, "Error occurred: Failure to convert to WString: invalid UTF-8 at byte %llu", static_cast<unsigned long long>(converted.Count));
+			result.mLength = 0ul;
 		}
 		else
 		{
-			wideStr = reinterpret_cast<wchar_t*>(pool.Allocate(sizeof(wchar_t) * GetSufficientCapacity<WString::ALIGNED_BYTE>(static_cast<size_t>(convertResult))));
-			convertResult = MultiByteToWideChar(CP_UTF8, 0, str, static_cast<int>(Strlen(str)), wideStr, static_cast<int>(convertResult));
-			if (convertResult <= 0)
-			{
-				LOGEF(eLogChannel::CORE_STRING, "Error occurred: Failure to convert its message text using CStringToWCStringMalloc: convertResult=%ld", convertResult);
-			}
+			result.mLength = converted.Count;
 		}
+		Memory::WMemset(&result.mString[result.mLength], L'\0', result.mCapacity - result.mLength);
 
-		return wideStr;
+		return result;
+	}
+
+	/**
+	 *
+	 * @brief Converts a wide string to UTF-8
+	 * @details The result is allocated once, at its final size.
+	 * 			Unpaired surrogates are logged and result in an empty string.
+	 * 			@n@n
+	 * 			Complexity: linear in wide.GetLength()
+	 * @param wide UTF-16 (UTF-32 where wchar_t has 32 bits) encoded characters, not necessarily null-terminated
+	 * @return The UTF-8 encoded string
+	 *
+	 */
+	String ToString(WStringView wide)
+	{
+		return ToString(wide, gCoreMemoryPool);
+	}
+
+	/**
+	 *
+	 * @brief Converts a wide string to UTF-8
+	 * @details The result is allocated once, at its final size.
+	 * 			Unpaired surrogates are logged and result in an empty string.
+	 * 			@n@n
+	 * 			Complexity: linear in wide.GetLength()
+	 * @param wide UTF-16 (UTF-32 where wchar_t has 32 bits) encoded characters, not necessarily null-terminated
+	 * @param pool memory pool to use for all memory allocations of the result
+	 * @return The UTF-8 encoded string
+	 *
+	 */
+	String ToString(WStringView wide, MemoryPool& pool)
+	{
+		String result(pool);
+
+		const size_t length = GetUtf8LengthFromWide(wide.GetData(), wide.GetLength());
+		if (length + 1ul > result.mCapacity)
+		{
+			result.deallocate(result.mString, result.mCapacity);
+			result.mCapacity = String::getSufficientCapacity(length);
+			result.mString = result.allocate(result.mCapacity);
+		}
+
+		const UnicodeResult converted = ConvertWideToUtf8(wide.GetData(), wide.GetLength(), result.mString);
+		if (converted.Error != eUnicodeError::NONE)
+		{
+			LOGEF(eLogChannel::CORE_STRING, "Error occurred: Failure to convert to String: unpaired surrogate at %llu", static_cast<unsigned long long>(converted.Count));
+			result.mLength = 0ul;
+		}
+		else
+		{
+			result.mLength = converted.Count;
+		}
+		Memory::Memset(&result.mString[result.mLength], '\0', result.mCapacity - result.mLength);
+
+		return result;
 	}
 
 	/**
@@ -8889,6 +9679,11 @@ export namespace cave
 		void StringToFloat();
 		void ToString();
 		void CStringToWCStringMalloc();
+		void SmallString();
+		void GeometricGrowth();
+		void Builder();
+		void View();
+		void Transcode();
 
 		void Main()
 		{
@@ -8925,10 +9720,214 @@ export namespace cave
 			StringToFloat();
 			ToString();
 			CStringToWCStringMalloc();
+			SmallString();
+			GeometricGrowth();
+			Builder();
+			View();
+			Transcode();
 			/*
 			*/
 		}
 
+		void SmallString()
+		{
+			MemoryPool pool(1024ul);
+			size_t const freeSize = pool.GetFreeMemorySize();
+
+			{
+				// tag and animation names never touch the pool
+				String empty(pool);
+				String tag("Player", pool);
+				String name("idle_animation_left_01", pool);
+				String copy(name, pool);
+				String moved(std::move(copy), pool);
+				assert(pool.GetFreeMemorySize() == freeSize);
+				assert(moved == "idle_animation_left_01");
+
+				String assigned(pool);
+				assigned = std::move(tag);
+				assert(assigned == "Player");
+
+				name += "_with_a_long_suffix";
+				assert(pool.GetFreeMemorySize() < freeSize);
+				assert(name == "idle_animation_left_01_with_a_long_suffix");
+
+				name.Clear();
+				name.Shrink();
+				assert(name.GetCapacity() == String::SSO_CAPACITY - 1ul);
+			}
+
+			assert(pool.GetFreeMemorySize() == freeSize);
+			LOGD(eLogChannel::CORE_STRING, "Small string optimization TEST SUCCESS");
+		}
+
+		void GeometricGrowth()
+		{
+			String s;
+			size_t capacity = s.GetCapacity();
+			size_t reallocationCount = 0ul;
+			for (size_t i = 0ul; i < 4096ul; ++i)
+			{
+				s.PushBack(static_cast<char>('a' + i % 26ul));
+				if (s.GetCapacity() != capacity)
+				{
+					assert(s.GetCapacity() >= 2ul * capacity);
+					capacity = s.GetCapacity();
+					++reallocationCount;
+				}
+			}
+			assert(s.GetLength() == 4096ul && s[4095] == static_cast<char>('a' + 4095ul % 26ul));
+			assert(reallocationCount <= 8ul);
+			assert(s.GetCString()[4096] == '\0');
+
+			String pieces;
+			for (size_t i = 0ul; i < 100ul; ++i)
+			{
+				pieces += "ab";
+				pieces += 'c';
+			}
+			assert(pieces.GetLength() == 300ul && pieces.StartsWith("abcabc") && pieces.EndsWith("abc"));
+
+			// appending a string to itself grows from the old storage
+			pieces.Append(pieces);
+			assert(pieces.GetLength() == 600ul && pieces.GetIndexOf("abc", 298ul) == 300ul);
+
+			LOGD(eLogChannel::CORE_STRING, "geometric growth TEST SUCCESS");
+		}
+
+		void Builder()
+		{
+			MemoryPool pool(8192ul);
+			size_t const freeSize = pool.GetFreeMemorySize();
+
+			{
+				StringBuilder builder(pool);
+				builder.Append("Core/String/").Append("D/").Append("String.ixx").Append('/').Append("Builder").Append("/line:").Append(42).Append(" :\t").Append(String("built"));
+				assert(strcmp(builder.GetCString(), "Core/String/D/String.ixx/Builder/line:42 :\tbuilt") == 0);
+				// log lines fit in place, the builder itself never touches the pool
+				assert(pool.GetFreeMemorySize() == freeSize);
+
+				String line = builder.ToString();
+				assert(line == "Core/String/D/String.ixx/Builder/line:42 :\tbuilt");
+				// sized exactly, not grown
+				assert(line.GetCapacity() < line.GetLength() + String::ALIGNED_BYTE);
+
+				builder.Clear();
+				builder += "min ";
+				builder.Append(static_cast<int64_t>(INT64_MIN)).Append(' ').Append(UINT64_MAX).Append(' ').Append(0).Append(' ').Append(-7);
+				assert(strcmp(builder.GetCString(), "min -9223372036854775808 18446744073709551615 0 -7") == 0);
+
+				builder.Clear();
+				builder.Append(3ul * StringBuilder::INLINE_CAPACITY, '#');
+				assert(builder.GetLength() == 3ul * StringBuilder::INLINE_CAPACITY);
+				assert(builder.GetCapacity() >= builder.GetLength());
+				String spilled = builder.ToString();
+				assert(spilled.GetLength() == 3ul * StringBuilder::INLINE_CAPACITY && spilled.EndsWith("###"));
+
+				// appending the builder to itself reads from the storage it is growing out of, in place and in the pool
+				builder.Clear();
+				builder.Append("abc");
+				for (size_t i = 0ul; i < 10ul; ++i)
+				{
+					builder.Append(builder.GetCString(), builder.GetLength());
+				}
+				assert(builder.GetLength() == 3ul * 1024ul);
+				for (size_t i = 0ul; i < builder.GetLength(); i += 3ul)
+				{
+					assert(strncmp(builder.GetCString() + i, "abc", 3ul) == 0);
+				}
+			}
+			assert(pool.GetFreeMemorySize() == freeSize);
+
+			LOGD(eLogChannel::CORE_STRING, "StringBuilder TEST SUCCESS");
+		}
+
+		void View()
+		{
+			MemoryPool pool(1024ul);
+			size_t const freeSize = pool.GetFreeMemorySize();
+
+			{
+				const char* path = "Resource/Textures/Cave/wall_0042.png";
+				StringView view(path);
+				assert(view.GetLength() == Strlen(path) && view.StartsWith("Resource/") && view.EndsWith(".png"));
+
+				// not null-terminated
+				StringView folder = view.GetSubstring(18ul, 4ul);
+				assert(folder == "Cave" && folder != "Cav" && folder.GetSubstring(2ul) == "ve");
+				assert(view.GetSubstring(100ul).IsEmpty());
+
+				String s(folder, pool);
+				assert(s.GetLength() == 4ul && s == "Cave");
+
+				s.Append(view.GetSubstring(22ul, 10ul));
+				assert(s == "Cave/wall_0042");
+				s += StringView("!!!", 1ul);
+				assert(s == "Cave/wall_0042!");
+
+				StringView sView = s;
+				assert(sView.GetData() == s.GetCString() && sView.GetLength() == s.GetLength());
+				assert(s.StartsWith(folder) && s.EndsWith(StringView("42!")) && s.Contains(StringView("wall_0042", 4ul)));
+				assert(s.GetIndexOf(StringView("wall")) == 5ul && s.GetIndexOf(StringView("wall"), 6ul) == String::NPOS);
+
+				// assigning a view into the string itself
+				s = sView.GetSubstring(5ul, 4ul);
+				assert(s == "wall" && s.GetLength() == 4ul);
+				s = view;
+				assert(s == path);
+
+				assert(GetStringHash("Idle", 4ul) == StringView("Idle and more", 4ul).GetHash());
+				static_assert(HashedStringView(StringView("Idle", 4ul)).GetHash() == GetStringHash("Idle", 4ul));
+			}
+
+			{
+				WString w(WStringView(L"wide view", 4ul), pool);
+				assert(w == L"wide");
+				WStringView wView = w;
+				assert(wView == L"wide" && wView.GetLength() == 4ul);
+				w = WStringView(L"narrower than the buffer");
+				assert(w == L"narrower than the buffer");
+			}
+			assert(pool.GetFreeMemorySize() == freeSize);
+
+			LOGD(eLogChannel::CORE_STRING, "StringView TEST SUCCESS");
+		}
+
+		void Transcode()
+		{
+			MemoryPool pool(2048ul);
+			size_t const freeSize = pool.GetFreeMemorySize();
+
+			{
+				// "Cave " U+B3D9 U+AD74 ", " U+C548 U+B155
+				const char* utf8 = "Cave \xEB\x8F\x99\xEA\xB5\xB4, \xEC\x95\x88\xEB\x85\x95";
+				WString wide = ToWString(utf8, pool);
+				assert(wide.GetLength() == 11ul && wide == L"Cave \uB3D9\uAD74, \uC548\uB155");
+				String narrow = ToString(wide, pool);
+				assert(narrow.GetLength() == Strlen(utf8) && narrow == utf8);
+
+				// past the in-place buffers
+				StringBuilder builder(pool);
+				for (size_t i = 0ul; i < 8ul; ++i)
+				{
+					builder.Append(utf8);
+				}
+				String longNarrow = builder.ToString(pool);
+				WString longWide = ToWString(longNarrow, pool);
+				assert(longWide.GetLength() == 8ul * wide.GetLength() && longWide.StartsWith(wide) && longWide.EndsWith(wide));
+				assert(ToString(longWide, pool) == longNarrow);
+
+				assert(ToWString(StringView("\xC3(", 2ul), pool).IsEmpty());
+
+				wchar_t* wCString = CStringToWCStringMalloc(utf8, pool);
+				assert(WStrcmp(wCString, wide.GetCString(), wide.GetLength() + 1ul) == 0);
+				pool.Deallocate(wCString, sizeof(wchar_t) * GetSufficientCapacity<WString::ALIGNED_BYTE>(WStrlen(wCString)));
+			}
+			assert(pool.GetFreeMemorySize() == freeSize);
+
+			LOGD(eLogChannel::CORE_STRING, "Transcode TEST SUCCESS");
+		}
+
 		void Constructor()
 		{
 			{
@@ -9127,18 +10126,21 @@ export namespace cave
 		void GetCapacity()
 		{
 			String s{ "Exemplar" };
-			assert(s.GetCapacity() == 15ul);
+			assert(s.GetCapacity() == String::SSO_CAPACITY - 1ul);
 
 			s += " is an example string.";
 			assert(s.GetCapacity() == 31ul);
 
+			s += " It no longer fits.";
+			assert(s.GetCapacity() == 63ul);
+
 			LOGD(eLogChannel::CORE_STRING, "size_t GetCapacity() TEST SUCCESS");
 		}
 
 		void Shrink()
 		{
 			String s;
-			assert(s.GetCapacity() == String::ALIGNED_BYTE - 1ul);
+			assert(s.GetCapacity() == String::SSO_CAPACITY - 1ul);
 			assert(s.GetLength() == 0ul);
 
 			for (int i = 0; i < 42; i++)
@@ -9154,7 +10156,7 @@ export namespace cave
 			assert(s.GetLength() == 0ul);
 
 			s.Shrink();
-			assert(s.GetCapacity() == String::ALIGNED_BYTE - 1ul);
+			assert(s.GetCapacity() == String::SSO_CAPACITY - 1ul);
 			assert(s.GetLength() == 0ul);
 
 			LOGD(eLogChannel::CORE_STRING, "void Shrink() TEST SUCCESS");
@@ -9295,6 +10297,14 @@ export namespace cave
 			assert(!helloWorld.Contains(String("goodbye")));
 			assert(helloWorld.Contains('w'));
 			assert(!helloWorld.Contains('x'));
+			assert(helloWorld.Contains(""));
+
+			// long enough for the vectorized search, needle straddling a 16 and a 32 character block
+			String logLine = String("[2021-06-14 12:34:56.789][CORE_STRING][Error] TextureManager failed to load wall.png");
+			assert(logLine.Contains("[Error]"));
+			assert(logLine.Contains("wall.png"));
+			assert(!logLine.Contains("[Debug]"));
+			assert(!logLine.Contains("wall.png!"));
 
 			LOGD(eLogChannel::CORE_STRING, "bool Contains TEST SUCCESS");
 		}
@@ -9461,6 +10471,20 @@ export namespace cave
 			n = s.GetIndexOf('q');
 			assert(n == String::NPOS);
 			LOGD(eLogChannel::CORE_STRING, "size_t GetIndexOf(char ch, size_t pos) TEST SUCCESS");
+
+			// every start position of a long string, across the vectorized blocks and the tail
+			String const path = "C:/Projects/Darkest-Cave/Resource/Textures/Cave/wall_0042.png";
+			for (size_t i = 0ul; i + 4ul <= path.GetLength(); ++i)
+			{
+				n = path.GetIndexOf(&path.GetCString()[i], 0ul, 4ul);
+				assert(n <= i && strncmp(&path.GetCString()[n], &path.GetCString()[i], 4ul) == 0);
+			}
+			assert(path.GetIndexOf("Cave") == 20ul);
+			assert(path.GetIndexOf("Cave", 21ul) == 43ul);
+			assert(path.GetIndexOf("png", path.GetLength()) == String::NPOS);
+			assert(path.GetIndexOf("", 7ul) == 7ul);
+			assert(path.GetIndexOf('/', 48ul) == String::NPOS);
+			LOGD(eLogChannel::CORE_STRING, "size_t GetIndexOf(const char* s, size_t pos, size_t count) TEST SUCCESS");
 		}
 
 		void GetLastIndexOf()
@@ -9494,6 +10518,14 @@ export namespace cave
 			n = s.GetLastIndexOf('q');
 			assert(n == String::NPOS);
 
+			String const path = "C:/Projects/Darkest-Cave/Resource/Textures/Cave/wall_0042.png";
+			assert(path.GetLastIndexOf("Cave") == 43ul);
+			assert(path.GetLastIndexOf("Cave", 42ul) == 20ul);
+			assert(path.GetLastIndexOf("Cave", 18ul) == String::NPOS);
+			assert(path.GetLastIndexOf('/') == 47ul);
+			assert(path.GetLastIndexOf('/', 46ul) == 42ul);
+			assert(path.GetLastIndexOf(".png") == path.GetLength() - 4ul);
+
 			LOGD(eLogChannel::CORE_STRING, "size_t GetIndexOf(char ch, size_t pos) TEST SUCCESS");
 		}
 
@@ -10108,7 +11140,7 @@ export namespace cave
 		void Shrink()
 		{
 			WString wStr;
-			assert(wStr.GetCapacity() == WString::ALIGNED_BYTE - 1ul);
+			assert(wStr.GetCapacity() == WString::SSO_CAPACITY - 1ul);
 			assert(wStr.GetLength() == 0ul);
 
 			for (int i = 0; i < 42; i++)
@@ -10124,7 +11156,7 @@ export namespace cave
 			assert(wStr.GetLength() == 0ul);
 
 			wStr.Shrink();
-			assert(wStr.GetCapacity() == WString::ALIGNED_BYTE - 1ul);
+			assert(wStr.GetCapacity() == WString::SSO_CAPACITY - 1ul);
 			assert(wStr.GetLength() == 0ul);
 
 			WLOGD(eLogChannel::CORE_STRING, L"void Shrink() TEST SUCCESS");
@@ -0,0 +1,182 @@
+/*!
+ * Copyright (c) 2021 SWTube. All rights reserved.
+ * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
+ */
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <type_traits>
+
+#include "CoreTypes.h"
+
+namespace cave
+{
+	/*
+	 * 32-bit FNV-1a hash of the code units in [s, s + length).
+	 */
+	template <typename T>
+	constexpr uint32_t GetStringHash(const T* s, size_t length)
+	{
+		uint32_t hash = 2166136261u;
+		for (size_t i = 0; i < length; ++i)
+		{
+			hash ^= static_cast<uint32_t>(static_cast<std::make_unsigned_t<T>>(s[i]));
+			hash *= 16777619u;
+		}
+
+		return hash;
+	}
+
+	/**
+	 *
+	 * @brief Non-owning view of a contiguous character sequence
+	 * @details A pointer and a length, nothing else. Passing a view never allocates or copies the characters,
+	 * 			so it is the parameter type for functions that only read a string.
+	 * 			The sequence does not have to be null-terminated, and it has to outlive the view.
+	 * 			@n@n
+	 * 			Converts implicitly from null-terminated arrays, std::basic_string, String and WString.
+	 *
+	 */
+	template <typename T>
+	class BasicStringView final
+	{
+	public:
+		constexpr BasicStringView() noexcept = default;
+
+		constexpr BasicStringView(const T* s) noexcept
+			: mString(s)
+			, mLength(s != nullptr ? std::char_traits<T>::length(s) : 0ul)
+		{
+		}
+
+		constexpr BasicStringView(const T* s, size_t length) noexcept
+			: mString(s)
+			, mLength(length)
+		{
+		}
+
+		constexpr BasicStringView(const std::basic_string<T>& s) noexcept
+			: mString(s.data())
+			, mLength(s.length())
+		{
+		}
+
+		constexpr const T* GetData() const noexcept
+		{
+			return mString;
+		}
+
+		constexpr size_t GetLength() const noexcept
+		{
+			return mLength;
+		}
+
+		[[nodiscard]] constexpr bool IsEmpty() const noexcept
+		{
+			return mLength == 0ul;
+		}
+
+		constexpr const T& operator[](size_t pos) const
+		{
+			return mString[pos];
+		}
+
+		/*
+		 * View of [pos, pos + count), clamped to the end of this view.
+		 */
+		constexpr BasicStringView GetSubstring(size_t pos, size_t count = NPOS) const
+		{
+			if (pos > mLength)
+			{
+				pos = mLength;
+			}
+
+			return BasicStringView(mString + pos, count < mLength - pos ? count : mLength - pos);
+		}
+
+		constexpr bool StartsWith(BasicStringView prefix) const
+		{
+			return mLength >= prefix.mLength && std::char_traits<T>::compare(mString, prefix.mString, prefix.mLength) == 0;
+		}
+
+		constexpr bool EndsWith(BasicStringView suffix) const
+		{
+			return mLength >= suffix.mLength && std::char_traits<T>::compare(mString + mLength - suffix.mLength, suffix.mString, suffix.mLength) == 0;
+		}
+
+		constexpr uint32_t GetHash() const
+		{
+			return GetStringHash(mString, mLength);
+		}
+
+		friend constexpr bool operator==(BasicStringView lhs, BasicStringView rhs)
+		{
+			return lhs.mLength == rhs.mLength && std::char_traits<T>::compare(lhs.mString, rhs.mString, lhs.mLength) == 0;
+		}
+
+		friend constexpr bool operator!=(BasicStringView lhs, BasicStringView rhs)
+		{
+			return !(lhs == rhs);
+		}
+
+		static constexpr size_t NPOS = static_cast<size_t>(-1);
+
+	private:
+		const T* mString = nullptr;
+		size_t mLength = 0ul;
+	};
+
+	using StringView = BasicStringView<char>;
+	using WStringView = BasicStringView<wchar_t>;
+
+	/**
+	 *
+	 * @brief StringView carrying its hash
+	 * @details The hash is computed once, at compile time for constant views, so a key that is looked up
+	 * 			in several tables (e.g. the world, then a level) is hashed only once.
+	 *
+	 */
+	class HashedStringView final
+	{
+	public:
+		constexpr HashedStringView(StringView view) noexcept
+			: mView(view)
+			, mHash(view.GetHash())
+		{
+		}
+
+		constexpr StringView GetView() const noexcept
+		{
+			return mView;
+		}
+
+		constexpr uint32_t GetHash() const noexcept
+		{
+			return mHash;
+		}
+
+	private:
+		StringView mView;
+		uint32_t mHash;
+	};
+}
+
+template <typename T>
+struct std::hash<cave::BasicStringView<T>>
+{
+	size_t operator()(cave::BasicStringView<T> view) const noexcept
+	{
+		return static_cast<size_t>(view.GetHash());
+	}
+};
+
+template <>
+struct std::hash<cave::HashedStringView>
+{
+	size_t operator()(const cave::HashedStringView& view) const noexcept
+	{
+		return static_cast<size_t>(view.GetHash());
+	}
+};
@@ -0,0 +1,1329 @@
+/*!
+ * Copyright (c) 2021 SWTube. All rights reserved.
+ * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
+ */
+
+module;
+
+#include <bit>
+
+#include "CoreTypes.h"
+
+#include "Assertion/Assert.h"
+#include "Debug/Log.h"
+
+#ifdef CAVE_BUILD_DEBUG
+#include <random>
+#include <string>
+#endif // CAVE_BUILD_DEBUG
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+	#define CAVE_UNICODE_SSE 1
+	#include <emmintrin.h>
+	#if defined(__AVX2__)
+		#define CAVE_UNICODE_AVX2 1
+		#include <immintrin.h>
+	#else
+		#define CAVE_UNICODE_AVX2 0
+	#endif
+#else
+	#define CAVE_UNICODE_SSE 0
+	#define CAVE_UNICODE_AVX2 0
+#endif
+
+export module cave.Core.String.Unicode;
+
+/*
+ * UTF-8, UTF-16 and UTF-32 validation and transcoding.
+ *
+ * Lengths are in code units. Every function takes a pointer and a length, the input need not be null-terminated
+ * and no output is null-terminated.
+ * ASCII is copied 16 or 32 characters at a time, and with AVX2 UTF-8 is validated 32 bytes at a time with the
+ * lookup algorithm of Keiser and Lemire (simdjson, simdutf). Everything else falls back to scalar code.
+ */
+export namespace cave
+{
+	enum class eUnicodeError : uint8_t
+	{
+		NONE,
+		HEADER,			// UTF-8 byte that can never start a sequence (0xF8 to 0xFF)
+		TOO_SHORT,		// UTF-8 sequence missing continuation bytes
+		TOO_LONG,		// UTF-8 continuation byte without a leading byte
+		OVERLONG,		// UTF-8 sequence longer than needed for its code point
+		TOO_LARGE,		// code point above U+10FFFF
+		SURROGATE,		// encoded surrogate in UTF-8 or UTF-32, unpaired surrogate in UTF-16
+	};
+
+	struct UnicodeResult
+	{
+		eUnicodeError Error;
+		// number of code units validated or written on success, position of the error in the input otherwise
+		size_t Count;
+	};
+
+	UnicodeResult ValidateUtf8(const char* s, size_t length);
+	UnicodeResult ValidateUtf16(const char16_t* s, size_t length);
+	UnicodeResult ValidateUtf32(const char32_t* s, size_t length);
+
+	/*
+	 * Output lengths, exact for valid input and an upper bound of what the Convert functions write for invalid input.
+	 */
+	size_t GetUtf16LengthFromUtf8(const char* s, size_t length);
+	size_t GetUtf32LengthFromUtf8(const char* s, size_t length);
+	size_t GetUtf8LengthFromUtf16(const char16_t* s, size_t length);
+	size_t GetUtf32LengthFromUtf16(const char16_t* s, size_t length);
+	size_t GetUtf8LengthFromUtf32(const char32_t* s, size_t length);
+	size_t GetUtf16LengthFromUtf32(const char32_t* s, size_t length);
+
+	/*
+	 * Validating conversions. out has to hold the output length reported by the matching Get*Length function.
+	 */
+	UnicodeResult ConvertUtf8ToUtf16(const char* s, size_t length, char16_t* out);
+	UnicodeResult ConvertUtf8ToUtf32(const char* s, size_t length, char32_t* out);
+	UnicodeResult ConvertUtf16ToUtf8(const char16_t* s, size_t length, char* out);
+	UnicodeResult ConvertUtf16ToUtf32(const char16_t* s, size_t length, char32_t* out);
+	UnicodeResult ConvertUtf32ToUtf8(const char32_t* s, size_t length, char* out);
+	UnicodeResult ConvertUtf32ToUtf16(const char32_t* s, size_t length, char16_t* out);
+
+	/*
+	 * wchar_t is UTF-16 on Windows and UTF-32 elsewhere, these pick the matching conversion.
+	 */
+	size_t GetWideLengthFromUtf8(const char* s, size_t length);
+	size_t GetUtf8LengthFromWide(const wchar_t* s, size_t length);
+	UnicodeResult ConvertUtf8ToWide(const char* s, size_t length, wchar_t* out);
+	UnicodeResult ConvertWideToUtf8(const wchar_t* s, size_t length, char* out);
+
+	FORCEINLINE bool IsValidUtf8(const char* s, size_t length)
+	{
+		return ValidateUtf8(s, length).Error == eUnicodeError::NONE;
+	}
+
+	FORCEINLINE bool IsValidUtf16(const char16_t* s, size_t length)
+	{
+		return ValidateUtf16(s, length).Error == eUnicodeError::NONE;
+	}
+
+	FORCEINLINE bool IsValidUtf32(const char32_t* s, size_t length)
+	{
+		return ValidateUtf32(s, length).Error == eUnicodeError::NONE;
+	}
+
+#ifdef CAVE_BUILD_DEBUG
+	namespace UnicodeTest
+	{
+		void Main();
+	}
+#endif // CAVE_BUILD_DEBUG
+}
+
+namespace cave
+{
+	namespace Utf
+	{
+		FORCEINLINE constexpr bool IsSurrogate(char32_t codePoint)
+		{
+			return (codePoint & 0xFFFFF800u) == 0xD800u;
+		}
+
+		/*
+		 * Decodes the sequence at s, length > 0. On success codePoint and size are set.
+		 */
+		FORCEINLINE eUnicodeError DecodeUtf8(const uint8_t* s, size_t length, char32_t& codePoint, size_t& size)
+		{
+			const uint8_t lead = s[0];
+			if (lead < 0x80u)
+			{
+				codePoint = lead;
+				size = 1ul;
+				return eUnicodeError::NONE;
+			}
+
+			if (lead < 0xC0u)
+			{
+				return eUnicodeError::TOO_LONG;
+			}
+
+			if (lead < 0xE0u)
+			{
+				if (length < 2ul || (s[1] & 0xC0u) != 0x80u)
+				{
+					return eUnicodeError::TOO_SHORT;
+				}
+				if (lead < 0xC2u)
+				{
+					return eUnicodeError::OVERLONG;
+				}
+
+				codePoint = (static_cast<char32_t>(lead & 0x1Fu) << 6) | (s[1] & 0x3Fu);
+				size = 2ul;
+				return eUnicodeError::NONE;
+			}
+
+			if (lead < 0xF0u)
+			{
+				if (length < 3ul || (s[1] & 0xC0u) != 0x80u || (s[2] & 0xC0u) != 0x80u)
+				{
+					return eUnicodeError::TOO_SHORT;
+				}
+
+				codePoint = (static_cast<char32_t>(lead & 0x0Fu) << 12) | (static_cast<char32_t>(s[1] & 0x3Fu) << 6) | (s[2] & 0x3Fu);
+				if (codePoint < 0x800u)
+				{
+					return eUnicodeError::OVERLONG;
+				}
+				if (IsSurrogate(codePoint))
+				{
+					return eUnicodeError::SURROGATE;
+				}
+
+				size = 3ul;
+				return eUnicodeError::NONE;
+			}
+
+			if (lead < 0xF8u)
+			{
+				if (length < 4ul || (s[1] & 0xC0u) != 0x80u || (s[2] & 0xC0u) != 0x80u || (s[3] & 0xC0u) != 0x80u)
+				{
+					return eUnicodeError::TOO_SHORT;
+				}
+
+				codePoint = (static_cast<char32_t>(lead & 0x07u) << 18) | (static_cast<char32_t>(s[1] & 0x3Fu) << 12)
+					| (static_cast<char32_t>(s[2] & 0x3Fu) << 6) | (s[3] & 0x3Fu);
+				if (codePoint < 0x10000u)
+				{
+					return eUnicodeError::OVERLONG;
+				}
+				if (codePoint > 0x10FFFFu)
+				{
+					return eUnicodeError::TOO_LARGE;
+				}
+
+				size = 4ul;
+				return eUnicodeError::NONE;
+			}
+
+			return eUnicodeError::HEADER;
+		}
+
+		/*
+		 * Writes a valid code point, returns the number of bytes written.
+		 */
+		FORCEINLINE size_t EncodeUtf8(char32_t codePoint, char* out)
+		{
+			if (codePoint < 0x80u)
+			{
+				out[0] = static_cast<char>(codePoint);
+				return 1ul;
+			}
+
+			if (codePoint < 0x800u)
+			{
+				out[0] = static_cast<char>(0xC0u | (codePoint >> 6));
+				out[1] = static_cast<char>(0x80u | (codePoint & 0x3Fu));
+				return 2ul;
+			}
+
+			if (codePoint < 0x10000u)
+			{
+				out[0] = static_cast<char>(0xE0u | (codePoint >> 12));
+				out[1] = static_cast<char>(0x80u | ((codePoint >> 6) & 0x3Fu));
+				out[2] = static_cast<char>(0x80u | (codePoint & 0x3Fu));
+				return 3ul;
+			}
+
+			out[0] = static_cast<char>(0xF0u | (codePoint >> 18));
+			out[1] = static_cast<char>(0x80u | ((codePoint >> 12) & 0x3Fu));
+			out[2] = static_cast<char>(0x80u | ((codePoint >> 6) & 0x3Fu));
+			out[3] = static_cast<char>(0x80u | (codePoint & 0x3Fu));
+			return 4ul;
+		}
+
+		FORCEINLINE size_t EncodeUtf16(char32_t codePoint, char16_t* out)
+		{
+			if (codePoint < 0x10000u)
+			{
+				out[0] = static_cast<char16_t>(codePoint);
+				return 1ul;
+			}
+
+			codePoint -= 0x10000u;
+			out[0] = static_cast<char16_t>(0xD800u | (codePoint >> 10));
+			out[1] = static_cast<char16_t>(0xDC00u | (codePoint & 0x3FFu));
+			return 2ul;
+		}
+
+		/*
+		 * Decodes the UTF-16 at s, length > 0. On success codePoint and size are set.
+		 */
+		FORCEINLINE eUnicodeError DecodeUtf16(const char16_t* s, size_t length, char32_t& codePoint, size_t& size)
+		{
+			const char32_t unit = s[0];
+			if (!IsSurrogate(unit))
+			{
+				codePoint = unit;
+				size = 1ul;
+				return eUnicodeError::NONE;
+			}
+
+			if (unit >= 0xDC00u || length < 2ul || (s[1] & 0xFC00u) != 0xDC00u)
+			{
+				return eUnicodeError::SURROGATE;
+			}
+
+			codePoint = 0x10000u + ((unit - 0xD800u) << 10) + (s[1] - 0xDC00u);
+			size = 2ul;
+			return eUnicodeError::NONE;
+		}
+
+		FORCEINLINE eUnicodeError CheckUtf32(char32_t codePoint)
+		{
+			if (codePoint > 0x10FFFFu)
+			{
+				return eUnicodeError::TOO_LARGE;
+			}
+			if (IsSurrogate(codePoint))
+			{
+				return eUnicodeError::SURROGATE;
+			}
+
+			return eUnicodeError::NONE;
+		}
+
+		/*
+		 * Copies the ASCII prefix of s to out, widening or narrowing it. Returns the length of the prefix.
+		 */
+		size_t CopyAscii(const uint8_t* s, size_t length, char16_t* out)
+		{
+			size_t i = 0ul;
+#if CAVE_UNICODE_SSE
+			const __m128i zero = _mm_setzero_si128();
+			for (; i + 16ul <= length; i += 16ul)
+			{
+				const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+				if (_mm_movemask_epi8(bytes) != 0)
+				{
+					break;
+				}
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_unpacklo_epi8(bytes, zero));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 8ul), _mm_unpackhi_epi8(bytes, zero));
+			}
+#endif
+			for (; i < length && s[i] < 0x80u; ++i)
+			{
+				out[i] = static_cast<char16_t>(s[i]);
+			}
+
+			return i;
+		}
+
+		size_t CopyAscii(const uint8_t* s, size_t length, char32_t* out)
+		{
+			size_t i = 0ul;
+#if CAVE_UNICODE_SSE
+			const __m128i zero = _mm_setzero_si128();
+			for (; i + 16ul <= length; i += 16ul)
+			{
+				const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+				if (_mm_movemask_epi8(bytes) != 0)
+				{
+					break;
+				}
+
+				const __m128i low = _mm_unpacklo_epi8(bytes, zero);
+				const __m128i high = _mm_unpackhi_epi8(bytes, zero);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_unpacklo_epi16(low, zero));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 4ul), _mm_unpackhi_epi16(low, zero));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 8ul), _mm_unpacklo_epi16(high, zero));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 12ul), _mm_unpackhi_epi16(high, zero));
+			}
+#endif
+			for (; i < length && s[i] < 0x80u; ++i)
+			{
+				out[i] = static_cast<char32_t>(s[i]);
+			}
+
+			return i;
+		}
+
+		size_t CopyAscii(const char16_t* s, size_t length, char* out)
+		{
+			size_t i = 0ul;
+#if CAVE_UNICODE_SSE
+			const __m128i nonAscii = _mm_set1_epi16(static_cast<int16_t>(0xFF80u));
+			for (; i + 16ul <= length; i += 16ul)
+			{
+				const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+				const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + 8ul));
+				if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(_mm_or_si128(low, high), nonAscii), _mm_setzero_si128())) != 0xFFFF)
+				{
+					break;
+				}
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(low, high));
+			}
+#endif
+			for (; i < length && s[i] < 0x80u; ++i)
+			{
+				out[i] = static_cast<char>(s[i]);
+			}
+
+			return i;
+		}
+
+		size_t CopyAscii(const char32_t* s, size_t length, char* out)
+		{
+			size_t i = 0ul;
+#if CAVE_UNICODE_SSE
+			const __m128i nonAscii = _mm_set1_epi32(static_cast<int32_t>(0xFFFFFF80u));
+			for (; i + 16ul <= length; i += 16ul)
+			{
+				const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+				const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + 4ul));
+				const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + 8ul));
+				const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + 12ul));
+				const __m128i any = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+				if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(any, nonAscii), _mm_setzero_si128())) != 0xFFFF)
+				{
+					break;
+				}
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+			}
+#endif
+			for (; i < length && s[i] < 0x80u; ++i)
+			{
+				out[i] = static_cast<char>(s[i]);
+			}
+
+			return i;
+		}
+
+		/*
+		 * Length of the ASCII prefix of s.
+		 */
+		size_t GetAsciiLength(const uint8_t* s, size_t length)
+		{
+			size_t i = 0ul;
+#if CAVE_UNICODE_AVX2
+			for (; i + 32ul <= length; i += 32ul)
+			{
+				const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i))));
+				if (mask != 0u)
+				{
+					return i + static_cast<size_t>(std::countr_zero(mask));
+				}
+			}
+#endif
+#if CAVE_UNICODE_SSE
+			for (; i + 16ul <= length; i += 16ul)
+			{
+				const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i))));
+				if (mask != 0u)
+				{
+					return i + static_cast<size_t>(std::countr_zero(mask));
+				}
+			}
+#endif
+			for (; i < length && s[i] < 0x80u; ++i)
+			{
+			}
+
+			return i;
+		}
+
+		UnicodeResult ValidateUtf8Scalar(const uint8_t* s, size_t length)
+		{
+			size_t i = 0ul;
+			while (i < length)
+			{
+				i += GetAsciiLength(s + i, length - i);
+
+				while (i < length && s[i] >= 0x80u)
+				{
+					char32_t codePoint;
+					size_t size;
+					const eUnicodeError error = DecodeUtf8(s + i, length - i, codePoint, size);
+					if (error != eUnicodeError::NONE)
+					{
+						return { error, i };
+					}
+
+					i += size;
+				}
+			}
+
+			return { eUnicodeError::NONE, length };
+		}
+
+#if CAVE_UNICODE_AVX2
+		/*
+		 * Keiser-Lemire lookup validation. Every byte is classified by the high nibble of the previous byte,
+		 * the low nibble of the previous byte and the high nibble of the byte itself,
+		 * an error bit survives the three table lookups only if all three agree on it.
+		 */
+		constexpr uint8_t TOO_SHORT_BIT = 1u << 0;
+		constexpr uint8_t TOO_LONG_BIT = 1u << 1;
+		constexpr uint8_t OVERLONG_3_BIT = 1u << 2;
+		constexpr uint8_t TOO_LARGE_BIT = 1u << 3;
+		constexpr uint8_t SURROGATE_BIT = 1u << 4;
+		constexpr uint8_t OVERLONG_2_BIT = 1u << 5;
+		constexpr uint8_t TOO_LARGE_1000_BIT = 1u << 6;
+		constexpr uint8_t OVERLONG_4_BIT = 1u << 6;
+		constexpr uint8_t TWO_CONTS_BIT = 1u << 7;
+		constexpr uint8_t CARRY_BITS = TOO_SHORT_BIT | TOO_LONG_BIT | TWO_CONTS_BIT;
+
+		template <int N>
+		FORCEINLINE __m256i GetPrevious(__m256i input, __m256i previousInput)
+		{
+			return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(previousInput, input, 0x21), 16 - N);
+		}
+
+		FORCEINLINE __m256i GetHighNibbles(__m256i bytes)
+		{
+			return _mm256_and_si256(_mm256_srli_epi16(bytes, 4), _mm256_set1_epi8(0x0F));
+		}
+
+		FORCEINLINE __m256i Lookup(__m256i nibbles, __m256i table)
+		{
+			return _mm256_shuffle_epi8(table, nibbles);
+		}
+
+		FORCEINLINE __m256i MakeTable(uint8_t b0, uint8_t b1, uint8_t b2, uint8_t b3, uint8_t b4, uint8_t b5, uint8_t b6, uint8_t b7
+			, uint8_t b8, uint8_t b9, uint8_t b10, uint8_t b11, uint8_t b12, uint8_t b13, uint8_t b14, uint8_t b15)
+		{
+			return _mm256_setr_epi8(static_cast<char>(b0), static_cast<char>(b1), static_cast<char>(b2), static_cast<char>(b3)
+				, static_cast<char>(b4), static_cast<char>(b5), static_cast<char>(b6), static_cast<char>(b7)
+				, static_cast<char>(b8), static_cast<char>(b9), static_cast<char>(b10), static_cast<char>(b11)
+				, static_cast<char>(b12), static_cast<char>(b13), static_cast<char>(b14), static_cast<char>(b15)
+				, static_cast<char>(b0), static_cast<char>(b1), static_cast<char>(b2), static_cast<char>(b3)
+				, static_cast<char>(b4), static_cast<char>(b5), static_cast<char>(b6), static_cast<char>(b7)
+				, static_cast<char>(b8), static_cast<char>(b9), static_cast<char>(b10), static_cast<char>(b11)
+				, static_cast<char>(b12), static_cast<char>(b13), static_cast<char>(b14), static_cast<char>(b15));
+		}
+
+		FORCEINLINE __m256i CheckSpecialCases(__m256i input, __m256i previous1)
+		{
+			const __m256i byte1High = Lookup(GetHighNibbles(previous1), MakeTable(
+				// 0_______ ________, ASCII followed by anything
+				TOO_LONG_BIT, TOO_LONG_BIT, TOO_LONG_BIT, TOO_LONG_BIT,
+				TOO_LONG_BIT, TOO_LONG_BIT, TOO_LONG_BIT, TOO_LONG_BIT,
+				// 10______ ________, continuation
+				TWO_CONTS_BIT, TWO_CONTS_BIT, TWO_CONTS_BIT, TWO_CONTS_BIT,
+				// 1100____ ________, two byte lead
+				TOO_SHORT_BIT | OVERLONG_2_BIT,
+				// 1101____ ________, two byte lead
+				TOO_SHORT_BIT,
+				// 1110____ ________, three byte lead
+				TOO_SHORT_BIT | OVERLONG_3_BIT | SURROGATE_BIT,
+				// 1111____ ________, four byte lead
+				TOO_SHORT_BIT | TOO_LARGE_BIT | TOO_LARGE_1000_BIT | OVERLONG_4_BIT));
+
+			const __m256i byte1Low = Lookup(_mm256_and_si256(previous1, _mm256_set1_epi8(0x0F)), MakeTable(
+				// ____0000 ________
+				CARRY_BITS | OVERLONG_3_BIT | OVERLONG_2_BIT | OVERLONG_4_BIT,
+				// ____0001 ________
+				CARRY_BITS | OVERLONG_2_BIT,
+				// ____001_ ________
+				CARRY_BITS,
+				CARRY_BITS,
+				// ____0100 ________
+				CARRY_BITS | TOO_LARGE_BIT,
+				// ____0101 ________
+				CARRY_BITS | TOO_LARGE_BIT | TOO_LARGE_1000_BIT,
+				// ____011_ ________
+				CARRY_BITS | TOO_LARGE_BIT | TOO_LARGE_1000_BIT,
+				CARRY_BITS | TOO_LARGE_BIT | TOO_LARGE_1000_BIT,
+				// ____1___ ________
+				CARRY_BITS | TOO_LARGE_BIT | TOO_LARGE_1000_BIT,
+				CARRY_BITS | TOO_LARGE_BIT | TOO_LARGE_1000_BIT,
+				CARRY_BITS | TOO_LARGE_BIT | TOO_LARGE_1000_BIT,
+				CARRY_BITS | TOO_LARGE_BIT | TOO_LARGE_1000_BIT,
+				CARRY_BITS | TOO_LARGE_BIT | TOO_LARGE_1000_BIT,
+				// ____1101 ________
+				CARRY_BITS | TOO_LARGE_BIT | TOO_LARGE_1000_BIT | SURROGATE_BIT,
+				CARRY_BITS | TOO_LARGE_BIT | TOO_LARGE_1000_BIT,
+				CARRY_BITS | TOO_LARGE_BIT | TOO_LARGE_1000_BIT));
+
+			const __m256i byte2High = Lookup(GetHighNibbles(input), MakeTable(
+				// ________ 0_______, ASCII
+				TOO_SHORT_BIT, TOO_SHORT_BIT, TOO_SHORT_BIT, TOO_SHORT_BIT,
+				TOO_SHORT_BIT, TOO_SHORT_BIT, TOO_SHORT_BIT, TOO_SHORT_BIT,
+				// ________ 1000____
+				TOO_LONG_BIT | OVERLONG_2_BIT | TWO_CONTS_BIT | OVERLONG_3_BIT | TOO_LARGE_1000_BIT | OVERLONG_4_BIT,
+				// ________ 1001____
+				TOO_LONG_BIT | OVERLONG_2_BIT | TWO_CONTS_BIT | OVERLONG_3_BIT | TOO_LARGE_BIT,
+				// ________ 101_____
+				TOO_LONG_BIT | OVERLONG_2_BIT | TWO_CONTS_BIT | SURROGATE_BIT | TOO_LARGE_BIT,
+				TOO_LONG_BIT | OVERLONG_2_BIT | TWO_CONTS_BIT | SURROGATE_BIT | TOO_LARGE_BIT,
+				// ________ 11______, lead
+				TOO_SHORT_BIT, TOO_SHORT_BIT, TOO_SHORT_BIT, TOO_SHORT_BIT));
+
+			return _mm256_and_si256(_mm256_and_si256(byte1High, byte1Low), byte2High);
+		}
+
+		FORCEINLINE __m256i CheckMultibyteLengths(__m256i input, __m256i previousInput, __m256i specialCases)
+		{
+			// only bytes two and three after a three or four byte lead end up with the high bit set
+			const __m256i isThirdByte = _mm256_subs_epu8(GetPrevious<2>(input, previousInput), _mm256_set1_epi8(static_cast<char>(0xE0u - 0x80u)));
+			const __m256i isFourthByte = _mm256_subs_epu8(GetPrevious<3>(input, previousInput), _mm256_set1_epi8(static_cast<char>(0xF0u - 0x80u)));
+			const __m256i mustBeContinuation = _mm256_and_si256(_mm256_or_si256(isThirdByte, isFourthByte), _mm256_set1_epi8(static_cast<char>(0x80u)));
+
+			return _mm256_xor_si256(mustBeContinuation, specialCases);
+		}
+
+		/*
+		 * Non-zero if the block ends inside a sequence.
+		 */
+		FORCEINLINE __m256i GetIncomplete(__m256i input)
+		{
+			const __m256i maxValue = _mm256_setr_epi8(
+				-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+				-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+				, static_cast<char>(0xF0u - 1u), static_cast<char>(0xE0u - 1u), static_cast<char>(0xC0u - 1u));
+
+			return _mm256_subs_epu8(input, maxValue);
+		}
+
+		bool IsValidUtf8Avx2(const uint8_t* s, size_t length)
+		{
+			__m256i error = _mm256_setzero_si256();
+			__m256i previousInput = _mm256_setzero_si256();
+			__m256i previousIncomplete = _mm256_setzero_si256();
+
+			auto checkBlock = [&](__m256i input)
+				{
+					if (_mm256_movemask_epi8(input) == 0)
+					{
+						// ASCII can't finish what the previous block started
+						error = _mm256_or_si256(error, previousIncomplete);
+						previousIncomplete = _mm256_setzero_si256();
+					}
+					else
+					{
+						const __m256i specialCases = CheckSpecialCases(input, GetPrevious<1>(input, previousInput));
+						error = _mm256_or_si256(error, CheckMultibyteLengths(input, previousInput, specialCases));
+						previousIncomplete = GetIncomplete(input);
+					}
+					previousInput = input;
+				};
+
+			size_t i = 0ul;
+			for (; i + 32ul <= length; i += 32ul)
+			{
+				checkBlock(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i)));
+			}
+
+			// the tail is padded with ASCII, which also flags a sequence left incomplete at the end
+			alignas(32) uint8_t tail[32] = {};
+			for (size_t j = 0ul; i + j < length; ++j)
+			{
+				tail[j] = s[i + j];
+			}
+			checkBlock(_mm256_load_si256(reinterpret_cast<const __m256i*>(tail)));
+
+			return _mm256_testz_si256(error, error) != 0;
+		}
+#endif
+	}
+
+	/**
+	 *
+	 * @brief Checks that [s, s + length) is well-formed UTF-8
+	 * @details Rejects overlong forms, surrogates and code points above U+10FFFF.
+	 * 			@n@n
+	 * 			Complexity: linear in length
+	 * @return NONE and length if valid, otherwise the error and the position of the offending sequence
+	 *
+	 */
+	UnicodeResult ValidateUtf8(const char* s, size_t length)
+	{
+		assert(s != nullptr || length == 0ul);
+
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(s);
+#if CAVE_UNICODE_AVX2
+		if (Utf::IsValidUtf8Avx2(bytes, length))
+		{
+			return { eUnicodeError::NONE, length };
+		}
+#endif
+
+		// the lookup only says whether there is an error, the scalar pass finds where
+		return Utf::ValidateUtf8Scalar(bytes, length);
+	}
+
+	/**
+	 *
+	 * @brief Checks that [s, s + length) is well-formed UTF-16
+	 * @details Every high surrogate has to be followed by a low surrogate and every low surrogate preceded by a high one.
+	 * 			@n@n
+	 * 			Complexity: linear in length
+	 * @return NONE and length if valid, otherwise SURROGATE and the position of the unpaired surrogate
+	 *
+	 */
+	UnicodeResult ValidateUtf16(const char16_t* s, size_t length)
+	{
+		assert(s != nullptr || length == 0ul);
+
+#if CAVE_UNICODE_SSE
+		const __m128i surrogateMask = _mm_set1_epi16(static_cast<int16_t>(0xF800u));
+		const __m128i surrogate = _mm_set1_epi16(static_cast<int16_t>(0xD800u));
+#endif
+		size_t i = 0ul;
+		while (i < length)
+		{
+#if CAVE_UNICODE_SSE
+			for (; i + 8ul <= length; i += 8ul)
+			{
+				const __m128i units = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+				if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(units, surrogateMask), surrogate)) != 0)
+				{
+					break;
+				}
+			}
+#endif
+			const size_t end = i + 8ul < length ? i + 8ul : length;
+			while (i < end)
+			{
+				char32_t codePoint;
+				size_t size;
+				if (Utf::DecodeUtf16(s + i, length - i, codePoint, size) != eUnicodeError::NONE)
+				{
+					return { eUnicodeError::SURROGATE, i };
+				}
+
+				i += size;
+			}
+		}
+
+		return { eUnicodeError::NONE, length };
+	}
+
+	/**
+	 *
+	 * @brief Checks that [s, s + length) is well-formed UTF-32
+	 * @details Rejects surrogates and code points above U+10FFFF.
+	 * 			@n@n
+	 * 			Complexity: linear in length
+	 * @return NONE and length if valid, otherwise the error and the position of the offending code point
+	 *
+	 */
+	UnicodeResult ValidateUtf32(const char32_t* s, size_t length)
+	{
+		assert(s != nullptr || length == 0ul);
+
+		size_t i = 0ul;
+#if CAVE_UNICODE_SSE
+		const __m128i sign = _mm_set1_epi32(static_cast<int32_t>(0x80000000u));
+		const __m128i maxCodePoint = _mm_set1_epi32(static_cast<int32_t>(0x10FFFFu ^ 0x80000000u));
+		const __m128i surrogateMask = _mm_set1_epi32(static_cast<int32_t>(0xFFFFF800u));
+		const __m128i surrogate = _mm_set1_epi32(static_cast<int32_t>(0xD800u));
+		for (; i + 4ul <= length; i += 4ul)
+		{
+			const __m128i codePoints = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+			const __m128i tooLarge = _mm_cmpgt_epi32(_mm_xor_si128(codePoints, sign), maxCodePoint);
+			const __m128i isSurrogate = _mm_cmpeq_epi32(_mm_and_si128(codePoints, surrogateMask), surrogate);
+			if (_mm_movemask_epi8(_mm_or_si128(tooLarge, isSurrogate)) != 0)
+			{
+				break;
+			}
+		}
+#endif
+		for (; i < length; ++i)
+		{
+			const eUnicodeError error = Utf::CheckUtf32(s[i]);
+			if (error != eUnicodeError::NONE)
+			{
+				return { error, i };
+			}
+		}
+
+		return { eUnicodeError::NONE, length };
+	}
+
+	/**
+	 *
+	 * @brief Number of UTF-16 code units needed for the UTF-8 in [s, s + length)
+	 * @details Every byte that is not a continuation byte starts a code point, four byte sequences need a surrogate pair.
+	 * 			@n@n
+	 * 			Complexity: linear in length
+	 *
+	 */
+	size_t GetUtf16LengthFromUtf8(const char* s, size_t length)
+	{
+		size_t count = 0ul;
+		size_t i = 0ul;
+#if CAVE_UNICODE_SSE
+		const __m128i lastContinuation = _mm_set1_epi8(static_cast<char>(0xBFu));
+		const __m128i beforeFourByteLead = _mm_set1_epi8(static_cast<char>(0xEFu));
+		for (; i + 16ul <= length; i += 16ul)
+		{
+			const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+			// signed compares: continuation bytes are -128 to -65, four byte leads -16 to -1
+			const uint32_t starts = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(bytes, lastContinuation)));
+			const uint32_t fourByteLeads = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpgt_epi8(bytes, beforeFourByteLead), bytes)));
+			count += static_cast<size_t>(std::popcount(starts) + std::popcount(fourByteLeads));
+		}
+#endif
+		for (; i < length; ++i)
+		{
+			const uint8_t byte = static_cast<uint8_t>(s[i]);
+			count += ((byte & 0xC0u) != 0x80u) + (byte >= 0xF0u);
+		}
+
+		return count;
+	}
+
+	/**
+	 *
+	 * @brief Number of code points in the UTF-8 in [s, s + length)
+	 * @details Complexity: linear in length
+	 *
+	 */
+	size_t GetUtf32LengthFromUtf8(const char* s, size_t length)
+	{
+		size_t count = 0ul;
+		size_t i = 0ul;
+#if CAVE_UNICODE_SSE
+		const __m128i lastContinuation = _mm_set1_epi8(static_cast<char>(0xBFu));
+		for (; i + 16ul <= length; i += 16ul)
+		{
+			const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+			count += static_cast<size_t>(std::popcount(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(bytes, lastContinuation)))));
+		}
+#endif
+		for (; i < length; ++i)
+		{
+			count += (static_cast<uint8_t>(s[i]) & 0xC0u) != 0x80u;
+		}
+
+		return count;
+	}
+
+	/**
+	 *
+	 * @brief Number of UTF-8 bytes needed for the UTF-16 in [s, s + length)
+	 * @details Each half of a surrogate pair counts two bytes.
+	 * 			@n@n
+	 * 			Complexity: linear in length
+	 *
+	 */
+	size_t GetUtf8LengthFromUtf16(const char16_t* s, size_t length)
+	{
+		size_t count = 0ul;
+		size_t i = 0ul;
+#if CAVE_UNICODE_SSE
+		// unsigned compares through the sign bias
+		const __m128i sign = _mm_set1_epi16(static_cast<int16_t>(0x8000u));
+		const __m128i below80 = _mm_set1_epi16(static_cast<int16_t>(0x7Fu ^ 0x8000u));
+		const __m128i below800 = _mm_set1_epi16(static_cast<int16_t>(0x7FFu ^ 0x8000u));
+		const __m128i surrogateMask = _mm_set1_epi16(static_cast<int16_t>(0xF800u));
+		const __m128i surrogate = _mm_set1_epi16(static_cast<int16_t>(0xD800u));
+		for (; i + 8ul <= length; i += 8ul)
+		{
+			const __m128i units = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+			const __m128i biased = _mm_xor_si128(units, sign);
+			const __m128i twoOrMore = _mm_cmpgt_epi16(biased, below80);
+			const __m128i three = _mm_andnot_si128(_mm_cmpeq_epi16(_mm_and_si128(units, surrogateMask), surrogate), _mm_cmpgt_epi16(biased, below800));
+			// two mask bits per unit
+			count += 8ul + static_cast<size_t>((std::popcount(static_cast<uint32_t>(_mm_movemask_epi8(twoOrMore)))
+				+ std::popcount(static_cast<uint32_t>(_mm_movemask_epi8(three)))) / 2);
+		}
+#endif
+		for (; i < length; ++i)
+		{
+			const char32_t unit = s[i];
+			count += 1ul + (unit >= 0x80u) + (unit >= 0x800u && !Utf::IsSurrogate(unit));
+		}
+
+		return count;
+	}
+
+	/**
+	 *
+	 * @brief Number of code points in the UTF-16 in [s, s + length)
+	 * @details Complexity: linear in length
+	 *
+	 */
+	size_t GetUtf32LengthFromUtf16(const char16_t* s, size_t length)
+	{
+		size_t count = 0ul;
+		for (size_t i = 0ul; i < length; ++i)
+		{
+			count += (s[i] & 0xFC00u) != 0xDC00u;
+		}
+
+		return count;
+	}
+
+	/**
+	 *
+	 * @brief Number of UTF-8 bytes needed for the code points in [s, s + length)
+	 * @details Complexity: linear in length
+	 *
+	 */
+	size_t GetUtf8LengthFromUtf32(const char32_t* s, size_t length)
+	{
+		size_t count = 0ul;
+		for (size_t i = 0ul; i < length; ++i)
+		{
+			const char32_t codePoint = s[i];
+			count += 1ul + (codePoint >= 0x80u) + (codePoint >= 0x800u) + (codePoint >= 0x10000u);
+		}
+
+		return count;
+	}
+
+	/**
+	 *
+	 * @brief Number of UTF-16 code units needed for the code points in [s, s + length)
+	 * @details Complexity: linear in length
+	 *
+	 */
+	size_t GetUtf16LengthFromUtf32(const char32_t* s, size_t length)
+	{
+		size_t count = length;
+		for (size_t i = 0ul; i < length; ++i)
+		{
+			count += s[i] >= 0x10000u;
+		}
+
+		return count;
+	}
+
+	/**
+	 *
+	 * @brief Converts the UTF-8 in [s, s + length) to UTF-16
+	 * @details Runs of ASCII are widened 16 bytes at a time.
+	 * 			@n@n
+	 * 			Complexity: linear in length
+	 * @param out has to hold GetUtf16LengthFromUtf8(s, length) code units
+	 * @return NONE and the number of code units written, or the error and its position in s
+	 *
+	 */
+	UnicodeResult ConvertUtf8ToUtf16(const char* s, size_t length, char16_t* out)
+	{
+		assert((s != nullptr && out != nullptr) || length == 0ul);
+
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(s);
+		size_t i = 0ul;
+		size_t written = 0ul;
+		while (i < length)
+		{
+			const size_t asciiLength = Utf::CopyAscii(bytes + i, length - i, out + written);
+			i += asciiLength;
+			written += asciiLength;
+
+			while (i < length && bytes[i] >= 0x80u)
+			{
+				char32_t codePoint;
+				size_t size;
+				const eUnicodeError error = Utf::DecodeUtf8(bytes + i, length - i, codePoint, size);
+				if (error != eUnicodeError::NONE)
+				{
+					return { error, i };
+				}
+
+				written += Utf::EncodeUtf16(codePoint, out + written);
+				i += size;
+			}
+		}
+
+		return { eUnicodeError::NONE, written };
+	}
+
+	/**
+	 *
+	 * @brief Converts the UTF-8 in [s, s + length) to UTF-32
+	 * @details Runs of ASCII are widened 16 bytes at a time.
+	 * 			@n@n
+	 * 			Complexity: linear in length
+	 * @param out has to hold GetUtf32LengthFromUtf8(s, length) code points
+	 * @return NONE and the number of code points written, or the error and its position in s
+	 *
+	 */
+	UnicodeResult ConvertUtf8ToUtf32(const char* s, size_t length, char32_t* out)
+	{
+		assert((s != nullptr && out != nullptr) || length == 0ul);
+
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(s);
+		size_t i = 0ul;
+		size_t written = 0ul;
+		while (i < length)
+		{
+			const size_t asciiLength = Utf::CopyAscii(bytes + i, length - i, out + written);
+			i += asciiLength;
+			written += asciiLength;
+
+			while (i < length && bytes[i] >= 0x80u)
+			{
+				size_t size;
+				const eUnicodeError error = Utf::DecodeUtf8(bytes + i, length - i, out[written], size);
+				if (error != eUnicodeError::NONE)
+				{
+					return { error, i };
+				}
+
+				++written;
+				i += size;
+			}
+		}
+
+		return { eUnicodeError::NONE, written };
+	}
+
+	/**
+	 *
+	 * @brief Converts the UTF-16 in [s, s + length) to UTF-8
+	 * @details Runs of ASCII are narrowed 16 code units at a time.
+	 * 			@n@n
+	 * 			Complexity: linear in length
+	 * @param out has to hold GetUtf8LengthFromUtf16(s, length) bytes
+	 * @return NONE and the number of bytes written, or SURROGATE and the position of the unpaired surrogate in s
+	 *
+	 */
+	UnicodeResult ConvertUtf16ToUtf8(const char16_t* s, size_t length, char* out)
+	{
+		assert((s != nullptr && out != nullptr) || length == 0ul);
+
+		size_t i = 0ul;
+		size_t written = 0ul;
+		while (i < length)
+		{
+			const size_t asciiLength = Utf::CopyAscii(s + i, length - i, out + written);
+			i += asciiLength;
+			written += asciiLength;
+
+			while (i < length && s[i] >= 0x80u)
+			{
+				char32_t codePoint;
+				size_t size;
+				const eUnicodeError error = Utf::DecodeUtf16(s + i, length - i, codePoint, size);
+				if (error != eUnicodeError::NONE)
+				{
+					return { error, i };
+				}
+
+				written += Utf::EncodeUtf8(codePoint, out + written);
+				i += size;
+			}
+		}
+
+		return { eUnicodeError::NONE, written };
+	}
+
+	/**
+	 *
+	 * @brief Converts the UTF-16 in [s, s + length) to UTF-32
+	 * @details Complexity: linear in length
+	 * @param out has to hold GetUtf32LengthFromUtf16(s, length) code points
+	 * @return NONE and the number of code points written, or SURROGATE and the position of the unpaired surrogate in s
+	 *
+	 */
+	UnicodeResult ConvertUtf16ToUtf32(const char16_t* s, size_t length, char32_t* out)
+	{
+		assert((s != nullptr && out != nullptr) || length == 0ul);
+
+		size_t i = 0ul;
+		size_t written = 0ul;
+		while (i < length)
+		{
+			size_t size;
+			const eUnicodeError error = Utf::DecodeUtf16(s + i, length - i, out[written], size);
+			if (error != eUnicodeError::NONE)
+			{
+				return { error, i };
+			}
+
+			++written;
+			i += size;
+		}
+
+		return { eUnicodeError::NONE, written };
+	}
+
+	/**
+	 *
+	 * @brief Converts the code points in [s, s + length) to UTF-8
+	 * @details Runs of ASCII are narrowed 16 code points at a time.
+	 * 			@n@n
+	 * 			Complexity: linear in length
+	 * @param out has to hold GetUtf8LengthFromUtf32(s, length) bytes
+	 * @return NONE and the number of bytes written, or the error and the position of the offending code point in s
+	 *
+	 */
+	UnicodeResult ConvertUtf32ToUtf8(const char32_t* s, size_t length, char* out)
+	{
+		assert((s != nullptr && out != nullptr) || length == 0ul);
+
+		size_t i = 0ul;
+		size_t written = 0ul;
+		while (i < length)
+		{
+			const size_t asciiLength = Utf::CopyAscii(s + i, length - i, out + written);
+			i += asciiLength;
+			written += asciiLength;
+
+			for (; i < length && s[i] >= 0x80u; ++i)
+			{
+				const eUnicodeError error = Utf::CheckUtf32(s[i]);
+				if (error != eUnicodeError::NONE)
+				{
+					return { error, i };
+				}
+
+				written += Utf::EncodeUtf8(s[i], out + written);
+			}
+		}
+
+		return { eUnicodeError::NONE, written };
+	}
+
+	/**
+	 *
+	 * @brief Converts the code points in [s, s + length) to UTF-16
+	 * @details Complexity: linear in length
+	 * @param out has to hold GetUtf16LengthFromUtf32(s, length) code units
+	 * @return NONE and the number of code units written, or the error and the position of the offending code point in s
+	 *
+	 */
+	UnicodeResult ConvertUtf32ToUtf16(const char32_t* s, size_t length, char16_t* out)
+	{
+		assert((s != nullptr && out != nullptr) || length == 0ul);
+
+		size_t written = 0ul;
+		for (size_t i = 0ul; i < length; ++i)
+		{
+			const eUnicodeError error = Utf::CheckUtf32(s[i]);
+			if (error != eUnicodeError::NONE)
+			{
+				return { error, i };
+			}
+
+			written += Utf::EncodeUtf16(s[i], out + written);
+		}
+
+		return { eUnicodeError::NONE, written };
+	}
+
+	size_t GetWideLengthFromUtf8(const char* s, size_t length)
+	{
+		if constexpr (sizeof(wchar_t) == sizeof(char16_t))
+		{
+			return GetUtf16LengthFromUtf8(s, length);
+		}
+		else
+		{
+			return GetUtf32LengthFromUtf8(s, length);
+		}
+	}
+
+	size_t GetUtf8LengthFromWide(const wchar_t* s, size_t length)
+	{
+		if constexpr (sizeof(wchar_t) == sizeof(char16_t))
+		{
+			return GetUtf8LengthFromUtf16(reinterpret_cast<const char16_t*>(s), length);
+		}
+		else
+		{
+			return GetUtf8LengthFromUtf32(reinterpret_cast<const char32_t*>(s), length);
+		}
+	}
+
+	UnicodeResult ConvertUtf8ToWide(const char* s, size_t length, wchar_t* out)
+	{
+		if constexpr (sizeof(wchar_t) == sizeof(char16_t))
+		{
+			return ConvertUtf8ToUtf16(s, length, reinterpret_cast<char16_t*>(out));
+		}
+		else
+		{
+			return ConvertUtf8ToUtf32(s, length, reinterpret_cast<char32_t*>(out));
+		}
+	}
+
+	UnicodeResult ConvertWideToUtf8(const wchar_t* s, size_t length, char* out)
+	{
+		if constexpr (sizeof(wchar_t) == sizeof(char16_t))
+		{
+			return ConvertUtf16ToUtf8(reinterpret_cast<const char16_t*>(s), length, out);
+		}
+		else
+		{
+			return ConvertUtf32ToUtf8(reinterpret_cast<const char32_t*>(s), length, out);
+		}
+	}
+
+#ifdef CAVE_BUILD_DEBUG
+	namespace UnicodeTest
+	{
+		void Valid();
+		void Invalid();
+		void Random();
+
+		// "Cave " U+B3D9 U+AD74 " " U+1F525 ", " U+C548 U+B155
+		constexpr const char* MIXED_UTF8 = "Cave \xEB\x8F\x99\xEA\xB5\xB4 \xF0\x9F\x94\xA5, \xEC\x95\x88\xEB\x85\x95";
+		constexpr const char16_t* MIXED_UTF16 = u"Cave \uB3D9\uAD74 \U0001F525, \uC548\uB155";
+		constexpr const char32_t* MIXED_UTF32 = U"Cave \uB3D9\uAD74 \U0001F525, \uC548\uB155";
+
+		void Main()
+		{
+			LOGD(eLogChannel::CORE_STRING, "======Unicode Test======");
+			Valid();
+			Invalid();
+			Random();
+			LOGD(eLogChannel::CORE_STRING, "======Unicode Test Success======");
+		}
+
+		void Valid()
+		{
+			// long enough for every SIMD path, with sequences straddling the block boundaries
+			std::string utf8;
+			std::u16string utf16;
+			std::u32string utf32;
+			for (size_t i = 0ul; i < 24ul; ++i)
+			{
+				utf8.append(i, 'x').append(MIXED_UTF8);
+				utf16.append(i, u'x').append(MIXED_UTF16);
+				utf32.append(i, U'x').append(MIXED_UTF32);
+			}
+
+			assert(ValidateUtf8(utf8.data(), utf8.size()).Count == utf8.size() && IsValidUtf8(utf8.data(), utf8.size()));
+			assert(IsValidUtf16(utf16.data(), utf16.size()) && IsValidUtf32(utf32.data(), utf32.size()));
+
+			assert(GetUtf16LengthFromUtf8(utf8.data(), utf8.size()) == utf16.size());
+			assert(GetUtf32LengthFromUtf8(utf8.data(), utf8.size()) == utf32.size());
+			assert(GetUtf8LengthFromUtf16(utf16.data(), utf16.size()) == utf8.size());
+			assert(GetUtf32LengthFromUtf16(utf16.data(), utf16.size()) == utf32.size());
+			assert(GetUtf8LengthFromUtf32(utf32.data(), utf32.size()) == utf8.size());
+			assert(GetUtf16LengthFromUtf32(utf32.data(), utf32.size()) == utf16.size());
+
+			std::string toUtf8(utf8.size(), '\0');
+			std::u16string toUtf16(utf16.size(), u'\0');
+			std::u32string toUtf32(utf32.size(), U'\0');
+
+			assert(ConvertUtf8ToUtf16(utf8.data(), utf8.size(), toUtf16.data()).Count == utf16.size() && toUtf16 == utf16);
+			assert(ConvertUtf8ToUtf32(utf8.data(), utf8.size(), toUtf32.data()).Count == utf32.size() && toUtf32 == utf32);
+			assert(ConvertUtf16ToUtf8(utf16.data(), utf16.size(), toUtf8.data()).Count == utf8.size() && toUtf8 == utf8);
+			toUtf8.assign(utf8.size(), '\0');
+			assert(ConvertUtf32ToUtf8(utf32.data(), utf32.size(), toUtf8.data()).Count == utf8.size() && toUtf8 == utf8);
+			toUtf16.assign(utf16.size(), u'\0');
+			assert(ConvertUtf32ToUtf16(utf32.data(), utf32.size(), toUtf16.data()).Count == utf16.size() && toUtf16 == utf16);
+			toUtf32.assign(utf32.size(), U'\0');
+			assert(ConvertUtf16ToUtf32(utf16.data(), utf16.size(), toUtf32.data()).Count == utf32.size() && toUtf32 == utf32);
+
+			std::wstring wide(GetWideLengthFromUtf8(utf8.data(), utf8.size()), L'\0');
+			assert(ConvertUtf8ToWide(utf8.data(), utf8.size(), wide.data()).Count == wide.size());
+			toUtf8.assign(GetUtf8LengthFromWide(wide.data(), wide.size()), '\0');
+			assert(ConvertWideToUtf8(wide.data(), wide.size(), toUtf8.data()).Count == utf8.size() && toUtf8 == utf8);
+
+			assert(IsValidUtf8("", 0ul) && ConvertUtf8ToUtf16("", 0ul, nullptr).Count == 0ul);
+
+			LOGD(eLogChannel::CORE_STRING, "Valid TEST SUCCESS");
+		}
+
+		void Invalid()
+		{
+			struct Case
+			{
+				const char* Bytes;
+				eUnicodeError Error;
+			};
+
+			const Case cases[] = {
+				{ "\xFF", eUnicodeError::HEADER },
+				{ "\xE3\x81", eUnicodeError::TOO_SHORT },
+				{ "\xC3(", eUnicodeError::TOO_SHORT },
+				{ "\x80", eUnicodeError::TOO_LONG },
+				{ "\xC3\xA9\xA9", eUnicodeError::TOO_LONG },
+				{ "\xC0\xAF", eUnicodeError::OVERLONG },
+				{ "\xE0\x80\xAF", eUnicodeError::OVERLONG },
+				{ "\xF0\x80\x80\xAF", eUnicodeError::OVERLONG },
+				{ "\xF4\x90\x80\x80", eUnicodeError::TOO_LARGE },
+				{ "\xED\xA0\x80", eUnicodeError::SURROGATE },
+			};
+
+			for (const Case& c : cases)
+			{
+				// at the start, and after enough ASCII to land in the second SIMD block
+				for (size_t prefix : { 0ul, 30ul, 45ul })
+				{
+					std::string bytes(prefix, 'a');
+					bytes.append(c.Bytes).append(prefix, 'b');
+
+					const UnicodeResult result = ValidateUtf8(bytes.data(), bytes.size());
+					assert(result.Error == c.Error);
+					assert(result.Count >= prefix && result.Count < prefix + 3ul);
+
+					std::u16string utf16(GetUtf16LengthFromUtf8(bytes.data(), bytes.size()), u'\0');
+					const UnicodeResult converted = ConvertUtf8ToUtf16(bytes.data(), bytes.size(), utf16.data());
+					assert(converted.Error == result.Error && converted.Count == result.Count);
+				}
+			}
+
+			const char16_t loneHigh[] = { u'a', 0xD800u, u'b' };
+			const char16_t loneLow[] = { u'a', u'b', 0xDC00u };
+			const char16_t swapped[] = { 0xDC00u, 0xD800u };
+			assert(ValidateUtf16(loneHigh, 3ul).Error == eUnicodeError::SURROGATE && ValidateUtf16(loneHigh, 3ul).Count == 1ul);
+			assert(ValidateUtf16(loneLow, 3ul).Count == 2ul);
+			assert(ValidateUtf16(swapped, 2ul).Count == 0ul);
+			assert(ValidateUtf16(loneHigh, 2ul).Error == eUnicodeError::SURROGATE);
+
+			const char32_t tooLarge[] = { U'a', U'b', U'c', U'd', U'e', 0x110000u };
+			const char32_t surrogate[] = { U'a', 0xDFFFu };
+			assert(ValidateUtf32(tooLarge, 6ul).Error == eUnicodeError::TOO_LARGE && ValidateUtf32(tooLarge, 6ul).Count == 5ul);
+			assert(ValidateUtf32(surrogate, 2ul).Error == eUnicodeError::SURROGATE);
+
+			char out[16];
+			assert(ConvertUtf32ToUtf8(surrogate, 2ul, out).Count == 1ul);
+			assert(ConvertUtf16ToUtf8(loneLow, 3ul, out).Error == eUnicodeError::SURROGATE);
+
+			LOGD(eLogChannel::CORE_STRING, "Invalid TEST SUCCESS");
+		}
+
+		void Random()
+		{
+			// pieces chosen so that random concatenations hit every error near every block boundary
+			const char* const pieces[] = {
+				"a", "Cave dialogue ", "\xC3\xA9", "\xEB\x8F\x99", "\xF0\x9F\x94\xA5", "\xEF\xBF\xBF", "\xF4\x8F\xBF\xBF",
+				"\x80", "\xC3", "\xE0\xA0", "\xF0\x9F", "\xC1\xBF", "\xE0\x9F\xBF", "\xED\xBF\xBF", "\xF4\x90\x80\x80", "\xF8", "\xFE"
+			};
+			constexpr size_t PIECE_COUNT = sizeof(pieces) / sizeof(pieces[0]);
+
+			std::mt19937 engine(0xCA7Eu);
+			std::uniform_int_distribution<size_t> pieceCount(0ul, 40ul);
+			std::uniform_int_distribution<size_t> piece(0ul, PIECE_COUNT - 1ul);
+			std::bernoulli_distribution valid(0.5);
+
+			for (size_t round = 0ul; round < 20000ul; ++round)
+			{
+				std::string bytes;
+				const size_t count = pieceCount(engine);
+				const bool isValid = valid(engine);
+				for (size_t i = 0ul; i < count; ++i)
+				{
+					// pieces past the first seven are broken on their own
+					bytes.append(pieces[isValid ? piece(engine) % 7ul : piece(engine)]);
+				}
+
+				const UnicodeResult expected = Utf::ValidateUtf8Scalar(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size());
+#if CAVE_UNICODE_AVX2
+				assert(Utf::IsValidUtf8Avx2(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size()) == (expected.Error == eUnicodeError::NONE));
+#endif
+				const UnicodeResult result = ValidateUtf8(bytes.data(), bytes.size());
+				assert(result.Error == expected.Error && result.Count == expected.Count);
+
+				if (result.Error == eUnicodeError::NONE)
+				{
+					std::u16string utf16(GetUtf16LengthFromUtf8(bytes.data(), bytes.size()), u'\0');
+					assert(ConvertUtf8ToUtf16(bytes.data(), bytes.size(), utf16.data()).Count == utf16.size());
+					std::string back(GetUtf8LengthFromUtf16(utf16.data(), utf16.size()), '\0');
+					assert(ConvertUtf16ToUtf8(utf16.data(), utf16.size(), back.data()).Count == bytes.size() && back == bytes);
+				}
+			}
+
+			LOGD(eLogChannel::CORE_STRING, "Random TEST SUCCESS");
+		}
+	}
+#endif // CAVE_BUILD_DEBUG
+}
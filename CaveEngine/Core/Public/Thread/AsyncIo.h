@@ -0,0 +1,251 @@
+/*!
+ * Copyright (c) 2021 SWTube. All rights reserved.
+ * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "CoreTypes.h"
+#include "Thread/JobSystem.h"
+#include "Thread/Synchronization.h"
+#include "Thread/Task.h"
+
+namespace cave
+{
+	// reads leave their queues highest priority first
+	enum class eIoPriority
+	{
+		HIGH,
+		NORMAL,
+		LOW,
+	};
+
+	constexpr uint32_t IO_PRIORITY_COUNT = 3u;
+
+	/*A file opened for reading through AsyncIo. Reads of it may still run on other threads, it has to outlive them.*/
+	class AsyncFile final
+	{
+	public:
+		AsyncFile() = default;
+		AsyncFile(const AsyncFile&) = delete;
+		AsyncFile& operator=(const AsyncFile&) = delete;
+
+		~AsyncFile()
+		{
+			Close();
+		}
+
+		/*false if the file cannot be opened.*/
+		bool Open(const char* path);
+		void Close();
+
+		bool IsOpen() const
+		{
+			return mHandle != INVALID_HANDLE;
+		}
+
+		/*Bytes in the file when it was opened.*/
+		uint64_t GetSize() const
+		{
+			return mSize;
+		}
+
+	private:
+		friend class AsyncIo;
+		friend class IoRequest;
+
+		// a file descriptor, or a HANDLE on Windows, whose invalid value is -1 too
+		static constexpr intptr_t INVALID_HANDLE = -1;
+
+		intptr_t mHandle = INVALID_HANDLE;
+		uint64_t mSize = 0ull;
+	};
+
+	/*
+	 * One read, owned by the caller and handed to AsyncIo::Read(). It must neither move nor be destroyed before it is done,
+	 * nor its buffer. A read that reaches the end of the file stops there, GetByteCount() tells how far it got.
+	 */
+	class IoRequest final
+	{
+	public:
+		IoRequest() = default;
+		IoRequest(const IoRequest&) = delete;
+		IoRequest& operator=(const IoRequest&) = delete;
+
+		bool IsDone() const
+		{
+			return mbDone.load(std::memory_order_acquire);
+		}
+
+		/*true once every byte asked for was read.*/
+		bool IsSucceeded() const
+		{
+			return IsDone() && mError == 0 && mByteCount == mSize;
+		}
+
+		size_t GetByteCount() const
+		{
+			return mByteCount;
+		}
+
+		/*errno, or GetLastError() on Windows, of a read that failed. 0 otherwise.*/
+		int32_t GetError() const
+		{
+			return mError;
+		}
+
+	private:
+		friend class AsyncIo;
+
+		intptr_t mHandle = AsyncFile::INVALID_HANDLE;
+		unsigned char* mBuffer = nullptr;
+		size_t mSize = 0ul;
+		uint64_t mOffset = 0ull;
+		JobCounter* mCounter = nullptr;
+		// next in its priority queue
+		IoRequest* mNext = nullptr;
+
+		size_t mByteCount = 0ul;
+		int32_t mError = 0;
+		std::atomic<bool> mbDone = true;
+	};
+
+	class IoReadAwaiter;
+
+	/**
+	 *
+	 * @brief Reads files in the background, so that loading overlaps with simulation
+	 * @details On Linux the reads go through an io_uring: a single I/O thread hands every read queued since it last looked
+	 * 			to the kernel in one system call, keeps up to RING_QUEUE_DEPTH of them in flight and completes them as they finish.
+	 * 			Where io_uring is missing or refused, on Windows or in a sandbox, a few threads pread() instead,
+	 * 			ReadFile() at an offset on Windows.
+	 * 			@n@n
+	 * 			Reads wait in a queue per eIoPriority and leave it highest first, so what the next frame needs overtakes streamed level data.
+	 * 			They go straight into the buffer of the caller, pool or arena memory: nothing is copied or allocated per read.
+	 * 			A finished read releases the JobCounter it was given, jobs Wait() for it and Tasks co_await it.
+	 * 			@n@n
+	 * 			<code>IoRequest request; io.Read(request, file, buffer, file.GetSize(), 0ull, eIoPriority::HIGH, &counter); jobSystem.Wait(counter);</code>
+	 *
+	 */
+	class AsyncIo final
+	{
+	public:
+		/*threadCount threads read when io_uring cannot be used, 0 for DEFAULT_IO_THREAD_COUNT.*/
+		explicit AsyncIo(uint32_t threadCount = 0u);
+		AsyncIo(const AsyncIo&) = delete;
+		AsyncIo& operator=(const AsyncIo&) = delete;
+		/*Finishes every read queued before.*/
+		~AsyncIo();
+
+		/*
+		 * Queues a read of size bytes at offset of file into buffer. Adds one to counter, which it takes away once the read is done.
+		 * A request with a counter is waited for through the counter, IsDone() may be seen before the counter is released.
+		 */
+		void Read(IoRequest& request, const AsyncFile& file, void* buffer, size_t size, uint64_t offset = 0ull
+			, eIoPriority priority = eIoPriority::NORMAL, JobCounter* counter = nullptr);
+
+		/*co_await io.ReadAsync(file, buffer, size); resumes on a worker once the read is done, true if every byte was read.*/
+		IoReadAwaiter ReadAsync(const AsyncFile& file, void* buffer, size_t size, uint64_t offset = 0ull, eIoPriority priority = eIoPriority::NORMAL);
+
+		/*false when the threads pread() instead.*/
+		bool IsUsingIoUring() const
+		{
+			return mRing != nullptr;
+		}
+
+	private:
+		class Ring;
+
+		// a byte count the kernel takes in one read, larger reads are split
+		static constexpr size_t MAX_READ_SIZE = 1ul << 30ul;
+		// reads an io_uring keeps in flight
+		static constexpr uint32_t RING_QUEUE_DEPTH = 64u;
+		static constexpr uint32_t DEFAULT_IO_THREAD_COUNT = 2u;
+
+		void push(IoRequest& request, eIoPriority priority);
+		/*The oldest request of the highest priority, null if none is queued.*/
+		IoRequest* pop();
+		static void readBlocking(IoRequest& request);
+		static void complete(IoRequest& request);
+		void runRing();
+		void runThread(uint32_t index);
+
+		std::unique_ptr<Ring> mRing;
+		std::vector<std::thread> mThreads;
+
+		Mutex mQueueMutex;
+		IoRequest* mHeads[IO_PRIORITY_COUNT] = { nullptr, };
+		IoRequest* mTails[IO_PRIORITY_COUNT] = { nullptr, };
+		// counts queued reads for the threads that pread(), plus one per thread once stopping
+		Semaphore mQueuedSemaphore;
+		std::atomic<bool> mbStopRequested = false;
+	};
+
+	/*What AsyncIo::ReadAsync() returns, the read is queued once the awaiting Task suspends.*/
+	class IoReadAwaiter
+	{
+	public:
+		IoReadAwaiter(AsyncIo& io, const AsyncFile& file, void* buffer, size_t size, uint64_t offset, eIoPriority priority)
+			: mIo(io)
+			, mFile(file)
+			, mBuffer(buffer)
+			, mSize(size)
+			, mOffset(offset)
+			, mPriority(priority)
+		{
+		}
+
+		bool await_ready() const noexcept
+		{
+			return false;
+		}
+
+		template <typename Promise>
+		bool await_suspend(std::coroutine_handle<Promise> awaiting) noexcept
+		{
+			static_assert(std::is_base_of_v<TaskPromiseBase, Promise>, "only a Task can co_await a read");
+
+			mWaiter.System = awaiting.promise().GetJobSystem();
+			mWaiter.Handle = awaiting;
+			mIo.Read(mRequest, mFile, mBuffer, mSize, mOffset, mPriority, &mCounter);
+
+			// a read that is done already does not suspend
+			return mCounter.addWaiter(mWaiter);
+		}
+
+		bool await_resume() const noexcept
+		{
+			return mRequest.IsSucceeded();
+		}
+
+	private:
+		AsyncIo& mIo;
+		const AsyncFile& mFile;
+		void* mBuffer;
+		size_t mSize;
+		uint64_t mOffset;
+		eIoPriority mPriority;
+		IoRequest mRequest;
+		JobCounter mCounter;
+		JobCounter::Waiter mWaiter;
+	};
+
+	inline IoReadAwaiter AsyncIo::ReadAsync(const AsyncFile& file, void* buffer, size_t size, uint64_t offset, eIoPriority priority)
+	{
+		return IoReadAwaiter(*this, file, buffer, size, offset, priority);
+	}
+
+#ifdef CAVE_BUILD_DEBUG
+	namespace AsyncIoTest
+	{
+		void Main();
+	}
+#endif
+}
@@ -0,0 +1,298 @@
+/*!
+ * Copyright (c) 2021 SWTube. All rights reserved.
+ * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+
+#include "CoreTypes.h"
+#include "Thread/Synchronization.h"
+
+namespace cave
+{
+	/**
+	 *
+	 * @brief Epoch-based reclamation, frees what writers unlinked once no reader can still see it
+	 * @details Readers wrap their lookups in an EpochGuard, which publishes the epoch the thread reads in and takes no lock.
+	 * 			A writer unlinks an object from a shared structure and hands it to Retire() instead of freeing it.
+	 * 			The global epoch only moves on once every thread inside a guard has seen the current one,
+	 * 			so an object retired in epoch e is freed once the epoch reached e + 2: every reader that could have seen it has left.
+	 * 			@n@n
+	 * 			Readers must not block inside a guard, a guard that is never left keeps every retired object alive.
+	 * 			Retired objects are freed by whichever thread retires or collects next, deleters must be fine with that.
+	 *
+	 */
+	class Epoch final
+	{
+	public:
+		using Deleter = void (*)(void* object, void* context);
+
+		Epoch() = delete;
+		Epoch(const Epoch&) = delete;
+		Epoch& operator=(const Epoch&) = delete;
+
+		/*deleter(object, context) runs once no reader can hold object any more.*/
+		static void Retire(void* object, Deleter deleter, void* context = nullptr);
+
+		template <typename T>
+		static void Retire(T* object)
+		{
+			Retire(object, [](void* retired, void*) { delete static_cast<T*>(retired); });
+		}
+
+		/*Frees what no reader can see. false if retired objects are left, readers still hold them.*/
+		static bool Collect();
+		/*Waits for every reader that is inside a guard now to leave it, then frees everything retired so far.
+		Must not be called inside a guard.*/
+		static void Synchronize();
+
+	private:
+		friend class EpochGuard;
+
+		static void enter();
+		static void leave();
+	};
+
+	/*Lookups into epoch-protected structures happen while one is alive. Nests.*/
+	class EpochGuard final
+	{
+	public:
+		EpochGuard()
+		{
+			Epoch::enter();
+		}
+
+		~EpochGuard()
+		{
+			Epoch::leave();
+		}
+
+		EpochGuard(const EpochGuard&) = delete;
+		EpochGuard& operator=(const EpochGuard&) = delete;
+	};
+
+	/**
+	 *
+	 * @brief Hash map whose lookups never take a lock
+	 * @details Separate chaining over a bucket array of atomic heads. Writers take a Mutex, link new nodes in front of a chain
+	 * 			and unlink removed ones with a single store, so a reader walking a chain sees a node either before or after.
+	 * 			Removed nodes are retired through Epoch. When the map outgrows its buckets, a writer copies the nodes into a larger
+	 * 			table, publishes it and retires the old one whole, readers still in the old table finish walking it.
+	 * 			@n@n
+	 * 			Meant for registries that are read every frame and written by loaders: Key and Value are copied out of a lookup,
+	 * 			a pointer Value stays valid only as long as the writer that removes it retires it through Epoch too
+	 * 			and the reader is inside an EpochGuard.
+	 *
+	 */
+	template <typename Key, typename Value, typename Hasher = std::hash<Key>>
+	class EpochHashMap final
+	{
+	public:
+		explicit EpochHashMap(size_t bucketCount = DEFAULT_BUCKET_COUNT)
+			: mTable(createTable(bucketCount))
+		{
+		}
+
+		EpochHashMap(const EpochHashMap&) = delete;
+		EpochHashMap& operator=(const EpochHashMap&) = delete;
+
+		/*No reader may be left, retired tables and nodes are not waited for.*/
+		~EpochHashMap()
+		{
+			deleteTable(mTable.load(std::memory_order_relaxed), nullptr);
+		}
+
+		bool Find(const Key& key, Value& outValue) const
+		{
+			EpochGuard guard;
+
+			const Node* node = findNode(*mTable.load(std::memory_order_acquire), key);
+			if (node == nullptr)
+			{
+				return false;
+			}
+
+			outValue = node->Data;
+			return true;
+		}
+
+		bool Contains(const Key& key) const
+		{
+			EpochGuard guard;
+
+			return findNode(*mTable.load(std::memory_order_acquire), key) != nullptr;
+		}
+
+		/*false if key is already in the map, which is then unchanged.*/
+		bool Insert(const Key& key, const Value& value)
+		{
+			std::lock_guard<Mutex> lock(mWriteMutex);
+
+			Table* table = mTable.load(std::memory_order_relaxed);
+			if (findNode(*table, key) != nullptr)
+			{
+				return false;
+			}
+
+			if (mSize + 1ul > table->Mask + 1ul)
+			{
+				table = grow(*table);
+			}
+
+			std::atomic<Node*>& head = table->Buckets[Hasher()(key) & table->Mask];
+			head.store(new Node{ key, value, head.load(std::memory_order_relaxed) }, std::memory_order_release);
+			++mSize;
+
+			return true;
+		}
+
+		/*false if key is not in the map.*/
+		bool Remove(const Key& key, Value& outValue)
+		{
+			std::lock_guard<Mutex> lock(mWriteMutex);
+
+			Table* table = mTable.load(std::memory_order_relaxed);
+			std::atomic<Node*>* link = &table->Buckets[Hasher()(key) & table->Mask];
+			for (Node* node = link->load(std::memory_order_relaxed); node != nullptr; node = link->load(std::memory_order_relaxed))
+			{
+				if (node->DataKey == key)
+				{
+					// readers on node still find the rest of the chain through its Next,
+					// seq_cst so that the unlink is visible before Retire() reads the epoch
+					link->store(node->Next.load(std::memory_order_relaxed), std::memory_order_seq_cst);
+					outValue = node->Data;
+					--mSize;
+					Epoch::Retire(node);
+
+					return true;
+				}
+
+				link = &node->Next;
+			}
+
+			return false;
+		}
+
+		/*Visits a snapshot, the entries a writer adds meanwhile may or may not be visited.*/
+		template <typename Function>
+		void ForEach(Function&& function) const
+		{
+			EpochGuard guard;
+
+			const Table& table = *mTable.load(std::memory_order_acquire);
+			for (size_t i = 0ul; i <= table.Mask; ++i)
+			{
+				for (const Node* node = table.Buckets[i].load(std::memory_order_acquire); node != nullptr; node = node->Next.load(std::memory_order_acquire))
+				{
+					function(node->DataKey, node->Data);
+				}
+			}
+		}
+
+		size_t GetSize() const
+		{
+			std::lock_guard<Mutex> lock(mWriteMutex);
+
+			return mSize;
+		}
+
+	private:
+		static constexpr size_t DEFAULT_BUCKET_COUNT = 64ul;
+
+		struct Node
+		{
+			const Key DataKey;
+			const Value Data;
+			std::atomic<Node*> Next;
+		};
+
+		struct Table
+		{
+			size_t Mask;
+			std::unique_ptr<std::atomic<Node*>[]> Buckets;
+		};
+
+		static Table* createTable(size_t bucketCount)
+		{
+			size_t powerOfTwo = 1ul;
+			while (powerOfTwo < bucketCount)
+			{
+				powerOfTwo <<= 1ul;
+			}
+
+			Table* table = new Table{ powerOfTwo - 1ul, std::make_unique<std::atomic<Node*>[]>(powerOfTwo) };
+			for (size_t i = 0ul; i < powerOfTwo; ++i)
+			{
+				table->Buckets[i].store(nullptr, std::memory_order_relaxed);
+			}
+
+			return table;
+		}
+
+		static void deleteTable(void* object, void*)
+		{
+			Table* table = static_cast<Table*>(object);
+			for (size_t i = 0ul; i <= table->Mask; ++i)
+			{
+				Node* node = table->Buckets[i].load(std::memory_order_relaxed);
+				while (node != nullptr)
+				{
+					Node* next = node->Next.load(std::memory_order_relaxed);
+					delete node;
+					node = next;
+				}
+			}
+
+			delete table;
+		}
+
+		static const Node* findNode(const Table& table, const Key& key)
+		{
+			for (const Node* node = table.Buckets[Hasher()(key) & table.Mask].load(std::memory_order_acquire); node != nullptr; node = node->Next.load(std::memory_order_acquire))
+			{
+				if (node->DataKey == key)
+				{
+					return node;
+				}
+			}
+
+			return nullptr;
+		}
+
+		Table* grow(Table& oldTable)
+		{
+			// the old nodes are copied, not moved: a reader may still be walking their chains
+			Table* table = createTable((oldTable.Mask + 1ul) * 2ul);
+			for (size_t i = 0ul; i <= oldTable.Mask; ++i)
+			{
+				for (Node* node = oldTable.Buckets[i].load(std::memory_order_relaxed); node != nullptr; node = node->Next.load(std::memory_order_relaxed))
+				{
+					std::atomic<Node*>& head = table->Buckets[Hasher()(node->DataKey) & table->Mask];
+					head.store(new Node{ node->DataKey, node->Data, head.load(std::memory_order_relaxed) }, std::memory_order_relaxed);
+				}
+			}
+
+			mTable.store(table, std::memory_order_seq_cst);
+			Epoch::Retire(&oldTable, deleteTable);
+
+			return table;
+		}
+
+		std::atomic<Table*> mTable;
+		mutable Mutex mWriteMutex;
+		size_t mSize = 0ul;
+	};
+
+#ifdef CAVE_BUILD_DEBUG
+	namespace EpochTest
+	{
+		void Main();
+	}
+#endif
+}
@@ -0,0 +1,275 @@
+/*!
+ * Copyright (c) 2021 SWTube. All rights reserved.
+ * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "CoreTypes.h"
+
+namespace cave
+{
+	// bytes of captures a job carries inline, a larger callable has to capture a pointer to its data instead
+	constexpr size_t JOB_DATA_SIZE = 40ul;
+	// jobs a thread can have queued at once before Run() has to wait for one of them to start
+	constexpr size_t JOB_POOL_SIZE = 4096ul;
+
+	class JobSystem;
+
+	/**
+	 *
+	 * @brief Counts the unfinished jobs of a group
+	 * @details Passed to JobSystem::Run, which adds one, and to JobSystem::Wait, which returns once it is back to zero.
+	 * 			Can be reused once it reached zero.
+	 * 			@n@n
+	 * 			A coroutine can co_await it instead, it is resumed on a worker once the count reaches zero.
+	 * 			The counter has to outlive the coroutines that wait for it.
+	 *
+	 */
+	class JobCounter final
+	{
+	public:
+		JobCounter() = default;
+		JobCounter(const JobCounter&) = delete;
+		JobCounter& operator=(const JobCounter&) = delete;
+
+		bool IsDone() const
+		{
+			return mCount.load(std::memory_order_acquire) == 0u;
+		}
+
+	private:
+		friend class JobSystem;
+		friend class JobCounterAwaiter;
+		friend class IoReadAwaiter;
+		friend class AsyncIo;
+		friend class TaskPromiseBase;
+		template <typename T>
+		friend class Task;
+
+		// a suspended coroutine, lives in its frame
+		struct Waiter
+		{
+			Waiter* Next;
+			JobSystem* System;
+			std::coroutine_handle<> Handle;
+		};
+
+		// the count shares its word with two flags, so that the job that takes it to zero
+		// only touches the counter again when a coroutine waits for it
+		static constexpr uint32_t COUNT_MASK = (1u << 30u) - 1u;
+		static constexpr uint32_t WAITER_FLAG = 1u << 30u;
+		static constexpr uint32_t LOCK_FLAG = 1u << 31u;
+
+		void add()
+		{
+			mCount.fetch_add(1u, std::memory_order_relaxed);
+		}
+
+		void release();
+		/*false if the count is already zero, the waiter is then not queued.*/
+		bool addWaiter(Waiter& waiter);
+		void resumeWaiters();
+
+		std::atomic<uint32_t> mCount = 0u;
+		// guarded by LOCK_FLAG
+		Waiter* mWaiters = nullptr;
+	};
+
+	/*
+	 * One cache line: the callable is constructed in place in mData, so submitting a job never allocates.
+	 */
+	class alignas(64) Job final
+	{
+	private:
+		friend class JobSystem;
+
+		using Function = void (*)(Job& job);
+
+		Function mFunction = nullptr;
+		JobCounter* mCounter = nullptr;
+		// set from allocation until the job has started, its slot is not reused before
+		std::atomic<bool> mbPending = false;
+		alignas(8) unsigned char mData[JOB_DATA_SIZE];
+	};
+
+	static_assert(sizeof(Job) == 64ul);
+
+	/**
+	 *
+	 * @brief Work-stealing job scheduler
+	 * @details Every worker owns a Chase-Lev deque: it pushes and pops the jobs it spawns at the bottom, without
+	 * 			a lock or a compare-and-swap on the common path, and idle workers steal the oldest job from the top of another.
+	 * 			Jobs from other threads go through a shared bounded queue.
+	 * 			@n@n
+	 * 			Jobs live in a ring of JOB_POOL_SIZE per submitting thread and carry their callable inline,
+	 * 			so Run() never allocates. A thread with that many jobs still queued runs other jobs until a slot is free.
+	 * 			The JobSystem owns the rings, a thread that is not a worker hands its ring back when it exits,
+	 * 			so its jobs may still be queued then and the next thread to submit reuses the ring.
+	 * 			@n@n
+	 * 			An idle worker keeps looking for work for a while before it parks on a futex,
+	 * 			Run() only makes a system call when some worker is parked.
+	 * 			Wait() runs other jobs instead of blocking, so jobs may wait for the jobs they spawn.
+	 * 			Workers are named "CaveWorker <n>" for debuggers and profilers.
+	 * 			@n@n
+	 * 			<code>JobCounter counter; jobSystem.Run([&]() { update(chunk); }, &counter); jobSystem.Wait(counter);</code>
+	 *
+	 */
+	class JobSystem final
+	{
+	public:
+		JobSystem() = delete;
+		/*
+		 * 0 starts a worker per physical core but one, which is left to the thread that calls Wait().
+		 * bPinWorkers keeps every worker on a processor of its own, see CpuTopology.
+		 */
+		JobSystem(uint32_t workerCount, bool bPinWorkers = false);
+		JobSystem(const JobSystem&) = delete;
+		~JobSystem();
+		JobSystem& operator=(const JobSystem&) = delete;
+
+		/*Queues function() to run on some worker. Adds one to counter, which it takes away once function returned.*/
+		template <typename Function>
+		void Run(Function&& function, JobCounter* counter = nullptr);
+		/*Runs queued jobs until counter reaches zero.*/
+		void Wait(JobCounter& counter);
+		/*Calls function(begin, end) on subranges of [0, count) of at most grainSize elements, spread over the workers,
+		and returns once all of them returned.*/
+		template <typename Function>
+		void ParallelFor(size_t count, size_t grainSize, Function&& function);
+
+		uint32_t GetWorkerCount() const
+		{
+			return mWorkerCount;
+		}
+
+	private:
+		class Worker;
+		class SharedQueue;
+		class JobPool;
+		class SubmitterPools;
+		struct SubmitterSlot;
+
+		template <typename Function>
+		struct ParallelForRange
+		{
+			Function* Body;
+			size_t GrainSize;
+			JobCounter Counter;
+		};
+
+		template <typename Range>
+		void splitRange(Range& range, size_t begin, size_t end);
+
+		Job* allocateJob();
+		JobPool& getSubmitterPool();
+		void submit(Job* job);
+		void execute(Job* job);
+		Job* findJob(Worker* worker);
+		bool hasJob() const;
+		bool tryRunJob();
+		void run(Worker* worker);
+		void park();
+		void wakeWorker();
+		Worker* getCurrentWorker() const;
+
+		// the worker of the calling thread, null on threads that are not workers of any JobSystem
+		static thread_local Worker* msCurrentWorker;
+		// the pool the calling thread submits through when it is not a worker of the JobSystem
+		static thread_local SubmitterSlot msSubmitterSlot;
+
+		uint32_t mWorkerCount;
+		bool mbPinWorkers;
+		std::unique_ptr<Worker[]> mWorkers;
+		std::unique_ptr<SharedQueue> mSharedQueue;
+		std::unique_ptr<SubmitterPools> mSubmitterPools;
+		// tells this JobSystem from one constructed later at the same address
+		uint64_t mSerial;
+
+		alignas(64) std::atomic<uint32_t> mSleeperCount = 0u;
+		std::atomic<uint32_t> mWakeEpoch = 0u;
+		std::atomic<bool> mbStopRequested = false;
+	};
+
+	template <typename Function>
+	void JobSystem::Run(Function&& function, JobCounter* counter)
+	{
+		using Callable = std::decay_t<Function>;
+		static_assert(sizeof(Callable) <= JOB_DATA_SIZE, "the job captures too much, capture a pointer to the data instead");
+		static_assert(alignof(Callable) <= 8ul);
+
+		Job* job = allocateJob();
+		new (job->mData) Callable(std::forward<Function>(function));
+		job->mFunction = [](Job& runningJob)
+			{
+				// moved out first, so that the slot is free again while the job runs and waits for others
+				Callable* storedCallable = std::launder(reinterpret_cast<Callable*>(runningJob.mData));
+				Callable callable(std::move(*storedCallable));
+				storedCallable->~Callable();
+				runningJob.mbPending.store(false, std::memory_order_release);
+
+				callable();
+			};
+		job->mCounter = counter;
+		if (counter != nullptr)
+		{
+			counter->add();
+		}
+
+		submit(job);
+	}
+
+	template <typename Function>
+	void JobSystem::ParallelFor(size_t count, size_t grainSize, Function&& function)
+	{
+		if (grainSize == 0ul)
+		{
+			grainSize = 1ul;
+		}
+
+		if (count <= grainSize)
+		{
+			if (count > 0ul)
+			{
+				function(0ul, count);
+			}
+			return;
+		}
+
+		ParallelForRange<std::remove_reference_t<Function>> range{ &function, grainSize, {} };
+		splitRange(range, 0ul, count);
+		Wait(range.Counter);
+	}
+
+	template <typename Range>
+	void JobSystem::splitRange(Range& range, size_t begin, size_t end)
+	{
+		// hands the upper half to another worker, which splits it further, so no single thread spawns every chunk
+		while (end - begin > range.GrainSize)
+		{
+			const size_t middle = begin + (end - begin) / 2ul;
+			Run([this, &range, middle, end]()
+				{
+					splitRange(range, middle, end);
+				}, &range.Counter);
+			end = middle;
+		}
+
+		(*range.Body)(begin, end);
+	}
+
+#ifdef CAVE_BUILD_DEBUG
+	namespace JobSystemTest
+	{
+		void Main();
+	}
+#endif
+}
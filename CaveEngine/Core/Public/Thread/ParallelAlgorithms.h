@@ -0,0 +1,420 @@
+/*!
+ * Copyright (c) 2021 SWTube. All rights reserved.
+ * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "CoreTypes.h"
+#include "Thread/JobSystem.h"
+
+/*
+ * Data-parallel algorithms on top of JobSystem::ParallelFor: sort, reduce, scan and stream compaction.
+ *
+ * Every algorithm takes a JobSystem* and runs on the calling thread alone when it is null or the input fits in one chunk,
+ * so the same call serves small arrays and the single-threaded fallback.
+ * Reduce and scan with std::plus on float, int32_t and uint32_t run SSE2 kernels on every chunk,
+ * which add in a different order than a plain loop: float results may differ in the last bits.
+ */
+namespace cave
+{
+	// elements a job reduces, scans or partitions at once
+	constexpr size_t PARALLEL_ALGORITHM_GRAIN_SIZE = 16384ul;
+	// keys a job histograms and scatters in one radix pass
+	constexpr size_t RADIX_SORT_GRAIN_SIZE = 32768ul;
+	// elements a job sorts before the sorted runs are merged, and outputs of a merge a job writes
+	constexpr size_t MERGE_SORT_GRAIN_SIZE = 8192ul;
+
+	/*Single-threaded SIMD kernels the parallel versions run on every chunk. The scans return the last sum, offset included.*/
+	float Sum(const float* data, size_t count);
+	int32_t Sum(const int32_t* data, size_t count);
+	uint32_t Sum(const uint32_t* data, size_t count);
+	float InclusiveScan(const float* input, float* output, size_t count, float offset);
+	int32_t InclusiveScan(const int32_t* input, int32_t* output, size_t count, int32_t offset);
+	uint32_t InclusiveScan(const uint32_t* input, uint32_t* output, size_t count, uint32_t offset);
+	float ExclusiveScan(const float* input, float* output, size_t count, float offset);
+	int32_t ExclusiveScan(const int32_t* input, int32_t* output, size_t count, int32_t offset);
+	uint32_t ExclusiveScan(const uint32_t* input, uint32_t* output, size_t count, uint32_t offset);
+
+	namespace ParallelAlgorithms
+	{
+		template <typename T, typename Operation>
+		constexpr bool IS_SIMD_SUM = (std::is_same_v<Operation, std::plus<T>> || std::is_same_v<Operation, std::plus<>>)
+			&& (std::is_same_v<T, float> || std::is_same_v<T, int32_t> || std::is_same_v<T, uint32_t>);
+
+		/*Calls function(chunk, begin, end) for every chunk of grainSize elements of [0, count).*/
+		template <typename Function>
+		void ForEachChunk(JobSystem* jobSystem, size_t count, size_t grainSize, Function&& function)
+		{
+			const size_t chunkCount = (count + grainSize - 1ul) / grainSize;
+			auto runChunks = [&function, count, grainSize](size_t firstChunk, size_t lastChunk)
+				{
+					for (size_t chunk = firstChunk; chunk < lastChunk; ++chunk)
+					{
+						function(chunk, chunk * grainSize, std::min((chunk + 1ul) * grainSize, count));
+					}
+				};
+
+			if (jobSystem == nullptr || chunkCount <= 1ul)
+			{
+				runChunks(0ul, chunkCount);
+				return;
+			}
+
+			// ParallelFor halves ranges anywhere, chunks keep their boundaries at multiples of grainSize
+			jobSystem->ParallelFor(chunkCount, 1ul, runChunks);
+		}
+
+		template <typename T, typename Operation>
+		T ReduceRange(const T* data, size_t count, T initial, Operation& operation)
+		{
+			if constexpr (IS_SIMD_SUM<T, Operation>)
+			{
+				return initial + Sum(data, count);
+			}
+			else
+			{
+				T value = initial;
+				for (size_t i = 0ul; i < count; ++i)
+				{
+					value = operation(value, data[i]);
+				}
+				return value;
+			}
+		}
+
+		template <typename T, typename Operation>
+		T ScanRange(const T* input, T* output, size_t count, T offset, Operation& operation, bool bInclusive)
+		{
+			if constexpr (IS_SIMD_SUM<T, Operation>)
+			{
+				return bInclusive ? InclusiveScan(input, output, count, offset) : ExclusiveScan(input, output, count, offset);
+			}
+			else
+			{
+				// reads before it writes, so input may be output
+				T value = offset;
+				for (size_t i = 0ul; i < count; ++i)
+				{
+					const T element = input[i];
+					if (!bInclusive)
+					{
+						output[i] = value;
+					}
+					value = operation(value, element);
+					if (bInclusive)
+					{
+						output[i] = value;
+					}
+				}
+				return value;
+			}
+		}
+
+		template <typename T, typename Operation>
+		void Scan(JobSystem* jobSystem, const T* input, T* output, size_t count, T offset, Operation& operation, bool bInclusive)
+		{
+			const size_t chunkCount = (count + PARALLEL_ALGORITHM_GRAIN_SIZE - 1ul) / PARALLEL_ALGORITHM_GRAIN_SIZE;
+			if (jobSystem == nullptr || chunkCount <= 1ul)
+			{
+				ScanRange(input, output, count, offset, operation, bInclusive);
+				return;
+			}
+
+			// the total of every chunk but the last, then every chunk scans from the totals of the chunks before it.
+			// a total starts from the chunk's first element, an operation need not have an identity
+			std::vector<T> chunkOffsets(chunkCount, offset);
+			ForEachChunk(jobSystem, (chunkCount - 1ul) * PARALLEL_ALGORITHM_GRAIN_SIZE, PARALLEL_ALGORITHM_GRAIN_SIZE, [&](size_t chunk, size_t begin, size_t end)
+				{
+					chunkOffsets[chunk + 1ul] = ReduceRange(input + begin + 1ul, end - begin - 1ul, input[begin], operation);
+				});
+
+			for (size_t chunk = 1ul; chunk < chunkCount; ++chunk)
+			{
+				chunkOffsets[chunk] = operation(chunkOffsets[chunk - 1ul], chunkOffsets[chunk]);
+			}
+
+			ForEachChunk(jobSystem, count, PARALLEL_ALGORITHM_GRAIN_SIZE, [&](size_t chunk, size_t begin, size_t end)
+				{
+					ScanRange(input + begin, output + begin, end - begin, chunkOffsets[chunk], operation, bInclusive);
+				});
+		}
+
+		/*Elements the first diagonal elements of the stable merge of a and b take from a.*/
+		template <typename T, typename Compare>
+		size_t FindMergeSplit(const T* a, size_t aCount, const T* b, size_t bCount, size_t diagonal, Compare& compare)
+		{
+			size_t low = diagonal > bCount ? diagonal - bCount : 0ul;
+			size_t high = std::min(diagonal, aCount);
+			while (low < high)
+			{
+				const size_t middle = low + (high - low) / 2ul;
+				// a goes first on ties
+				if (!compare(b[diagonal - middle - 1ul], a[middle]))
+				{
+					low = middle + 1ul;
+				}
+				else
+				{
+					high = middle;
+				}
+			}
+
+			return low;
+		}
+
+		/*
+		 * The runs of width starting at pairBegin and pairBegin + width, merged into one of twice the width.
+		 * width is a multiple of MERGE_SORT_GRAIN_SIZE, so no output chunk of a merge pass spans two pairs.
+		 */
+		template <typename T>
+		struct MergePair
+		{
+			T* A;
+			T* B;
+			size_t ACount;
+			size_t BCount;
+			size_t Begin;
+
+			MergePair(T* source, size_t count, size_t width, size_t position)
+			{
+				Begin = position / (width * 2ul) * (width * 2ul);
+				const size_t middle = std::min(Begin + width, count);
+				A = source + Begin;
+				B = source + middle;
+				ACount = middle - Begin;
+				BCount = std::min(Begin + width * 2ul, count) - middle;
+			}
+		};
+	}
+
+	/*initial op data[0] op ... op data[count - 1] for an associative operation.*/
+	template <typename T, typename Operation = std::plus<T>>
+	T ParallelReduce(JobSystem* jobSystem, const T* data, size_t count, T initial, Operation operation = Operation())
+	{
+		const size_t chunkCount = (count + PARALLEL_ALGORITHM_GRAIN_SIZE - 1ul) / PARALLEL_ALGORITHM_GRAIN_SIZE;
+		if (jobSystem == nullptr || chunkCount <= 1ul)
+		{
+			return ParallelAlgorithms::ReduceRange(data, count, initial, operation);
+		}
+
+		// chunks fold from their first element, initial goes in once
+		std::vector<T> partials(chunkCount, initial);
+		ParallelAlgorithms::ForEachChunk(jobSystem, count, PARALLEL_ALGORITHM_GRAIN_SIZE, [&](size_t chunk, size_t begin, size_t end)
+			{
+				partials[chunk] = ParallelAlgorithms::ReduceRange(data + begin + 1ul, end - begin - 1ul, data[begin], operation);
+			});
+
+		return ParallelAlgorithms::ReduceRange(partials.data(), chunkCount, initial, operation);
+	}
+
+	/*output[i] = offset op input[0] op ... op input[i]. input may be output.*/
+	template <typename T, typename Operation = std::plus<T>>
+	void ParallelInclusiveScan(JobSystem* jobSystem, const T* input, T* output, size_t count, T offset, Operation operation = Operation())
+	{
+		ParallelAlgorithms::Scan(jobSystem, input, output, count, offset, operation, true);
+	}
+
+	/*output[i] = offset op input[0] op ... op input[i - 1], output[0] = offset. input may be output.*/
+	template <typename T, typename Operation = std::plus<T>>
+	void ParallelExclusiveScan(JobSystem* jobSystem, const T* input, T* output, size_t count, T offset, Operation operation = Operation())
+	{
+		ParallelAlgorithms::Scan(jobSystem, input, output, count, offset, operation, false);
+	}
+
+	/*
+	 * Stream compaction: copies the elements predicate keeps to the front of output and the others behind them,
+	 * both in their input order, and returns how many were kept. input and output must not overlap.
+	 */
+	template <typename T, typename Predicate>
+	size_t ParallelPartition(JobSystem* jobSystem, const T* input, T* output, size_t count, Predicate predicate)
+	{
+		const size_t chunkCount = (count + PARALLEL_ALGORITHM_GRAIN_SIZE - 1ul) / PARALLEL_ALGORITHM_GRAIN_SIZE;
+
+		// the predicate runs once, culling tests are not cheap
+		std::vector<uint8_t> flags(count);
+		std::vector<size_t> keptOffsets(chunkCount + 1ul, 0ul);
+		ParallelAlgorithms::ForEachChunk(jobSystem, count, PARALLEL_ALGORITHM_GRAIN_SIZE, [&](size_t chunk, size_t begin, size_t end)
+			{
+				size_t keptCount = 0ul;
+				for (size_t i = begin; i < end; ++i)
+				{
+					flags[i] = predicate(input[i]) ? 1u : 0u;
+					keptCount += flags[i];
+				}
+				keptOffsets[chunk + 1ul] = keptCount;
+			});
+
+		for (size_t chunk = 0ul; chunk < chunkCount; ++chunk)
+		{
+			keptOffsets[chunk + 1ul] += keptOffsets[chunk];
+		}
+		const size_t totalKeptCount = keptOffsets[chunkCount];
+
+		ParallelAlgorithms::ForEachChunk(jobSystem, count, PARALLEL_ALGORITHM_GRAIN_SIZE, [&](size_t chunk, size_t begin, size_t end)
+			{
+				size_t kept = keptOffsets[chunk];
+				size_t rejected = totalKeptCount + begin - keptOffsets[chunk];
+				for (size_t i = begin; i < end; ++i)
+				{
+					// no branch on the predicate
+					const size_t flag = flags[i];
+					output[flag != 0u ? kept : rejected] = input[i];
+					kept += flag;
+					rejected += 1ul - flag;
+				}
+			});
+
+		return totalKeptCount;
+	}
+
+	/*
+	 * LSD radix sort of unsigned integer keys, a byte per pass. Every pass histograms the chunks in parallel,
+	 * turns the histograms into the offset every chunk writes each byte value at, and scatters the chunks in parallel.
+	 * Passes on a byte all keys share are skipped, so small keys in wide types cost little.
+	 */
+	template <typename Key>
+	void ParallelRadixSort(JobSystem* jobSystem, Key* keys, size_t count)
+	{
+		static_assert(std::is_unsigned_v<Key>, "radix sort orders unsigned integer keys");
+
+		constexpr size_t RADIX = 256ul;
+		if (count < 2ul)
+		{
+			return;
+		}
+
+		const size_t chunkCount = (count + RADIX_SORT_GRAIN_SIZE - 1ul) / RADIX_SORT_GRAIN_SIZE;
+		std::vector<Key> buffer(count);
+		// chunk-major: histograms[chunk * RADIX + digit]
+		std::vector<size_t> histograms(chunkCount * RADIX);
+		Key* source = keys;
+		Key* destination = buffer.data();
+
+		for (uint32_t shift = 0u; shift < sizeof(Key) * 8u; shift += 8u)
+		{
+			ParallelAlgorithms::ForEachChunk(jobSystem, count, RADIX_SORT_GRAIN_SIZE, [&](size_t chunk, size_t begin, size_t end)
+				{
+					size_t* histogram = &histograms[chunk * RADIX];
+					std::fill(histogram, histogram + RADIX, 0ul);
+					for (size_t i = begin; i < end; ++i)
+					{
+						++histogram[(source[i] >> shift) & (RADIX - 1ul)];
+					}
+				});
+
+			// a digit's keys land after the smaller digits, and within a digit after the keys of the chunks before
+			size_t offset = 0ul;
+			bool bSkip = false;
+			for (size_t digit = 0ul; digit < RADIX; ++digit)
+			{
+				size_t digitCount = 0ul;
+				for (size_t chunk = 0ul; chunk < chunkCount; ++chunk)
+				{
+					size_t& slot = histograms[chunk * RADIX + digit];
+					const size_t chunkDigitCount = slot;
+					slot = offset;
+					offset += chunkDigitCount;
+					digitCount += chunkDigitCount;
+				}
+				bSkip = bSkip || digitCount == count;
+			}
+			if (bSkip)
+			{
+				continue;
+			}
+
+			ParallelAlgorithms::ForEachChunk(jobSystem, count, RADIX_SORT_GRAIN_SIZE, [&](size_t chunk, size_t begin, size_t end)
+				{
+					size_t* offsets = &histograms[chunk * RADIX];
+					for (size_t i = begin; i < end; ++i)
+					{
+						const Key key = source[i];
+						destination[offsets[(key >> shift) & (RADIX - 1ul)]++] = key;
+					}
+				});
+
+			std::swap(source, destination);
+		}
+
+		if (source != keys)
+		{
+			ParallelAlgorithms::ForEachChunk(jobSystem, count, RADIX_SORT_GRAIN_SIZE, [&](size_t, size_t begin, size_t end)
+				{
+					std::copy(source + begin, source + end, keys + begin);
+				});
+		}
+	}
+
+	/*
+	 * Stable sort for any key: the chunks are sorted in parallel, then merged pairwise, a pass per doubling of the run length.
+	 * Every pass splits its output evenly over the jobs by binary search along the merge path,
+	 * so the last passes, which merge a few long runs, keep every worker busy too.
+	 * T has to be default constructible and movable.
+	 */
+	template <typename T, typename Compare = std::less<>>
+	void ParallelMergeSort(JobSystem* jobSystem, T* data, size_t count, Compare compare = Compare())
+	{
+		if (jobSystem == nullptr || count <= MERGE_SORT_GRAIN_SIZE)
+		{
+			std::stable_sort(data, data + count, compare);
+			return;
+		}
+
+		ParallelAlgorithms::ForEachChunk(jobSystem, count, MERGE_SORT_GRAIN_SIZE, [&](size_t, size_t begin, size_t end)
+			{
+				std::stable_sort(data + begin, data + end, compare);
+			});
+
+		std::vector<T> buffer(count);
+		std::vector<size_t> splits((count + MERGE_SORT_GRAIN_SIZE - 1ul) / MERGE_SORT_GRAIN_SIZE);
+		T* source = data;
+		T* destination = buffer.data();
+		for (size_t width = MERGE_SORT_GRAIN_SIZE; width < count; width *= 2ul)
+		{
+			// every chunk finds where its output starts before any moves elements out from under the search of another
+			ParallelAlgorithms::ForEachChunk(jobSystem, count, MERGE_SORT_GRAIN_SIZE, [&](size_t chunk, size_t begin, size_t)
+				{
+					const ParallelAlgorithms::MergePair<T> pair(source, count, width, begin);
+					splits[chunk] = ParallelAlgorithms::FindMergeSplit(pair.A, pair.ACount, pair.B, pair.BCount, begin - pair.Begin, compare);
+				});
+
+			ParallelAlgorithms::ForEachChunk(jobSystem, count, MERGE_SORT_GRAIN_SIZE, [&](size_t chunk, size_t begin, size_t end)
+				{
+					const ParallelAlgorithms::MergePair<T> pair(source, count, width, begin);
+					const size_t first = begin - pair.Begin;
+					const size_t last = end - pair.Begin;
+					const size_t aFirst = splits[chunk];
+					const size_t aLast = last == pair.ACount + pair.BCount ? pair.ACount : splits[chunk + 1ul];
+
+					std::merge(std::make_move_iterator(pair.A + aFirst), std::make_move_iterator(pair.A + aLast),
+						std::make_move_iterator(pair.B + (first - aFirst)), std::make_move_iterator(pair.B + (last - aLast)),
+						destination + begin, compare);
+				});
+
+			std::swap(source, destination);
+		}
+
+		if (source != data)
+		{
+			ParallelAlgorithms::ForEachChunk(jobSystem, count, MERGE_SORT_GRAIN_SIZE, [&](size_t, size_t begin, size_t end)
+				{
+					std::move(source + begin, source + end, data + begin);
+				});
+		}
+	}
+
+#ifdef CAVE_BUILD_DEBUG
+	namespace ParallelAlgorithmsTest
+	{
+		void Main();
+	}
+#endif
+}
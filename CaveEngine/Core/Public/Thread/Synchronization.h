@@ -0,0 +1,297 @@
+/*!
+ * Copyright (c) 2021 SWTube. All rights reserved.
+ * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+#include "CoreTypes.h"
+
+namespace cave
+{
+	/**
+	 *
+	 * @brief Mutex that spins for a while before it sleeps on a futex
+	 * @details Locking and unlocking an uncontended mutex is one atomic operation each.
+	 * 			A contended lock spins first, most critical sections in a frame are shorter than a sleep and a wake-up,
+	 * 			then sleeps on a futex (WaitOnAddress on Windows). Unlock() only makes a system call when some thread sleeps.
+	 * 			@n@n
+	 * 			Not recursive. lock(), try_lock() and unlock() let std::lock_guard and std::unique_lock use it.
+	 *
+	 */
+	class Mutex final
+	{
+	public:
+		Mutex() = default;
+		Mutex(const Mutex&) = delete;
+		Mutex& operator=(const Mutex&) = delete;
+
+		void Lock()
+		{
+			uint32_t expected = UNLOCKED;
+			if (!mState.compare_exchange_strong(expected, LOCKED, std::memory_order_acquire, std::memory_order_relaxed))
+			{
+				lockSlow();
+			}
+		}
+
+		bool TryLock()
+		{
+			uint32_t expected = UNLOCKED;
+			return mState.compare_exchange_strong(expected, LOCKED, std::memory_order_acquire, std::memory_order_relaxed);
+		}
+
+		void Unlock()
+		{
+			if (mState.exchange(UNLOCKED, std::memory_order_release) == CONTENDED)
+			{
+				wakeOne();
+			}
+		}
+
+		void lock()
+		{
+			Lock();
+		}
+
+		bool try_lock()
+		{
+			return TryLock();
+		}
+
+		void unlock()
+		{
+			Unlock();
+		}
+
+	private:
+		// CONTENDED: locked, and some thread may be asleep waiting for it
+		static constexpr uint32_t UNLOCKED = 0u;
+		static constexpr uint32_t LOCKED = 1u;
+		static constexpr uint32_t CONTENDED = 2u;
+
+		void lockSlow();
+		void wakeOne();
+
+		std::atomic<uint32_t> mState = UNLOCKED;
+	};
+
+	enum class eEventReset
+	{
+		// Wait() consumes the signal, one waiter gets through per Signal()
+		AUTO,
+		// stays signaled and lets every waiter through until Reset()
+		MANUAL,
+	};
+
+	/**
+	 *
+	 * @brief Signal another thread waits for
+	 * @details Signal() without a waiter is a store and a load, with waiters it wakes them through the futex.
+	 * 			Wait() spins briefly before it sleeps, so a handoff between two busy threads does not reach the kernel.
+	 *
+	 */
+	class Event final
+	{
+	public:
+		explicit Event(eEventReset reset, bool bSignaled = false)
+			: mState(bSignaled ? 1u : 0u)
+			, mbManualReset(reset == eEventReset::MANUAL)
+		{
+		}
+
+		Event(const Event&) = delete;
+		Event& operator=(const Event&) = delete;
+
+		void Signal();
+
+		void Reset()
+		{
+			mState.store(0u, std::memory_order_relaxed);
+		}
+
+		bool IsSignaled() const
+		{
+			return mState.load(std::memory_order_acquire) != 0u;
+		}
+
+		void Wait()
+		{
+			if (!tryConsume())
+			{
+				wait(-1);
+			}
+		}
+
+		/*false if the event was not signaled before the timeout.*/
+		template <typename Rep, typename Period>
+		bool WaitFor(std::chrono::duration<Rep, Period> timeout)
+		{
+			return tryConsume() || wait(std::chrono::duration_cast<std::chrono::nanoseconds>(timeout).count());
+		}
+
+	private:
+		bool tryConsume()
+		{
+			if (mbManualReset)
+			{
+				return mState.load(std::memory_order_acquire) != 0u;
+			}
+
+			uint32_t expected = 1u;
+			return mState.compare_exchange_strong(expected, 0u, std::memory_order_acquire, std::memory_order_relaxed);
+		}
+
+		/*Negative nanoseconds wait forever.*/
+		bool wait(int64_t nanoseconds);
+
+		std::atomic<uint32_t> mState;
+		std::atomic<uint32_t> mWaiterCount = 0u;
+		const bool mbManualReset;
+	};
+
+	/**
+	 *
+	 * @brief Counting semaphore
+	 * @details Acquire() takes one from the count, waiting while it is zero, Release() adds to it and wakes as many waiters.
+	 * 			Same spin-then-futex waiting as Event.
+	 *
+	 */
+	class Semaphore final
+	{
+	public:
+		explicit Semaphore(uint32_t count = 0u)
+			: mCount(count)
+		{
+		}
+
+		Semaphore(const Semaphore&) = delete;
+		Semaphore& operator=(const Semaphore&) = delete;
+
+		void Acquire()
+		{
+			if (!TryAcquire())
+			{
+				acquire(-1);
+			}
+		}
+
+		bool TryAcquire()
+		{
+			uint32_t count = mCount.load(std::memory_order_relaxed);
+			while (count != 0u)
+			{
+				if (mCount.compare_exchange_weak(count, count - 1u, std::memory_order_acquire, std::memory_order_relaxed))
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		/*false if nothing was released before the timeout.*/
+		template <typename Rep, typename Period>
+		bool TryAcquireFor(std::chrono::duration<Rep, Period> timeout)
+		{
+			return TryAcquire() || acquire(std::chrono::duration_cast<std::chrono::nanoseconds>(timeout).count());
+		}
+
+		void Release(uint32_t count = 1u);
+
+	private:
+		bool acquire(int64_t nanoseconds);
+
+		std::atomic<uint32_t> mCount;
+		std::atomic<uint32_t> mWaiterCount = 0u;
+	};
+
+	/**
+	 *
+	 * @brief Reader-writer spinlock for short critical sections
+	 * @details Any number of readers or one writer. A writer that waits keeps new readers out, so writers are not starved.
+	 * 			Waiting threads back off exponentially, from a single pause up to yielding their time slice,
+	 * 			so a few spinning threads don't flood the cache line the holder needs.
+	 * 			Never sleeps: only for sections of a few hundred cycles, use Mutex for longer ones.
+	 * 			@n@n
+	 * 			lock(), unlock(), lock_shared() and unlock_shared() let std::lock_guard and std::shared_lock use it.
+	 *
+	 */
+	class RwSpinLock final
+	{
+	public:
+		RwSpinLock() = default;
+		RwSpinLock(const RwSpinLock&) = delete;
+		RwSpinLock& operator=(const RwSpinLock&) = delete;
+
+		void Lock()
+		{
+			uint32_t expected = 0u;
+			if (!mState.compare_exchange_weak(expected, WRITER, std::memory_order_acquire, std::memory_order_relaxed))
+			{
+				lockSlow();
+			}
+		}
+
+		void Unlock()
+		{
+			// keeps the WRITER_WAITING another writer may have set meanwhile
+			mState.fetch_sub(WRITER, std::memory_order_release);
+		}
+
+		void LockShared()
+		{
+			uint32_t state = mState.load(std::memory_order_relaxed);
+			if ((state & (WRITER | WRITER_WAITING)) != 0u
+				|| !mState.compare_exchange_weak(state, state + 1u, std::memory_order_acquire, std::memory_order_relaxed))
+			{
+				lockSharedSlow();
+			}
+		}
+
+		void UnlockShared()
+		{
+			mState.fetch_sub(1u, std::memory_order_release);
+		}
+
+		void lock()
+		{
+			Lock();
+		}
+
+		void unlock()
+		{
+			Unlock();
+		}
+
+		void lock_shared()
+		{
+			LockShared();
+		}
+
+		void unlock_shared()
+		{
+			UnlockShared();
+		}
+
+	private:
+		// the low bits count the readers
+		static constexpr uint32_t WRITER = 1u << 31u;
+		static constexpr uint32_t WRITER_WAITING = 1u << 30u;
+
+		void lockSlow();
+		void lockSharedSlow();
+
+		std::atomic<uint32_t> mState = 0u;
+	};
+
+#ifdef CAVE_BUILD_DEBUG
+	namespace SynchronizationTest
+	{
+		void Main();
+	}
+#endif
+}
@@ -0,0 +1,399 @@
+/*!
+ * Copyright (c) 2021 SWTube. All rights reserved.
+ * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
+ */
+
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "CoreTypes.h"
+#include "Assertion/Assert.h"
+#include "Thread/JobSystem.h"
+
+namespace cave
+{
+	template <typename T>
+	class Task;
+
+	/*Coroutine frames come from per-thread free lists of a few size classes, so starting a Task rarely allocates.*/
+	void* AllocateTaskFrame(size_t size);
+	void DeallocateTaskFrame(void* frame, size_t size);
+
+	/*
+	 * What every Task<T>::promise_type shares: the JobSystem the coroutine resumes on,
+	 * and what to do once it returned, either resume the coroutine that awaits it or release the counter it was started with.
+	 */
+	class TaskPromiseBase
+	{
+	public:
+		class FinalAwaiter
+		{
+		public:
+			bool await_ready() const noexcept
+			{
+				return false;
+			}
+
+			template <typename Promise>
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+			{
+				TaskPromiseBase& promise = handle.promise();
+				if (promise.mContinuation)
+				{
+					return promise.mContinuation;
+				}
+
+				// the owner may destroy the frame as soon as the counter is released
+				JobCounter* counter = promise.mCounter;
+				if (counter != nullptr)
+				{
+					counter->release();
+				}
+
+				return std::noop_coroutine();
+			}
+
+			void await_resume() const noexcept
+			{
+			}
+		};
+
+		static void* operator new(size_t size)
+		{
+			return AllocateTaskFrame(size);
+		}
+
+		static void operator delete(void* frame, size_t size)
+		{
+			DeallocateTaskFrame(frame, size);
+		}
+
+		std::suspend_always initial_suspend() const noexcept
+		{
+			return {};
+		}
+
+		FinalAwaiter final_suspend() const noexcept
+		{
+			return {};
+		}
+
+		void unhandled_exception() const noexcept
+		{
+			std::terminate();
+		}
+
+		JobSystem* GetJobSystem() const
+		{
+			return mJobSystem;
+		}
+
+	private:
+		template <typename T>
+		friend class Task;
+
+		JobSystem* mJobSystem = nullptr;
+		std::coroutine_handle<> mContinuation;
+		JobCounter* mCounter = nullptr;
+	};
+
+	template <typename T>
+	class TaskPromise : public TaskPromiseBase
+	{
+	public:
+		Task<T> get_return_object();
+
+		template <typename Value>
+		void return_value(Value&& value)
+		{
+			mResult.emplace(std::forward<Value>(value));
+		}
+
+		T& GetResult()
+		{
+			assert(mResult.has_value());
+			return *mResult;
+		}
+
+	private:
+		std::optional<T> mResult;
+	};
+
+	template <>
+	class TaskPromise<void> : public TaskPromiseBase
+	{
+	public:
+		Task<void> get_return_object();
+
+		void return_void() const
+		{
+		}
+
+		void GetResult() const
+		{
+		}
+	};
+
+	/**
+	 *
+	 * @brief Coroutine that runs on a JobSystem
+	 * @details A task does nothing until it is started with Start() or awaited by another task.
+	 * 			co_await on a task runs it right away on the same worker and resumes the awaiting task once it returned.
+	 * 			co_await on a JobCounter or on AsyncIo::ReadAsync() suspends without blocking the worker
+	 * 			and resumes on some worker once the jobs or the read finished.
+	 * 			@n@n
+	 * 			The task object owns the coroutine frame and has to outlive it.
+	 * 			@n@n
+	 * 			<code>Task<Texture*> load(AsyncIo& io, AsyncFile& file, void* data) { co_await io.ReadAsync(file, data, file.GetSize()); co_return decode(data); }</code>
+	 *
+	 */
+	template <typename T = void>
+	class [[nodiscard]] Task final
+	{
+	public:
+		using promise_type = TaskPromise<T>;
+
+		class Awaiter
+		{
+		public:
+			explicit Awaiter(std::coroutine_handle<promise_type> handle)
+				: mHandle(handle)
+			{
+			}
+
+			bool await_ready() const noexcept
+			{
+				return mHandle.done();
+			}
+
+			// symmetric transfer: the awaiting coroutine jumps into this one without growing the stack
+			template <typename Promise>
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> awaiting) noexcept
+			{
+				static_assert(std::is_base_of_v<TaskPromiseBase, Promise>, "only a Task can co_await a Task");
+
+				promise_type& promise = mHandle.promise();
+				promise.mJobSystem = awaiting.promise().GetJobSystem();
+				promise.mContinuation = awaiting;
+
+				return mHandle;
+			}
+
+			decltype(auto) await_resume()
+			{
+				if constexpr (std::is_void_v<T>)
+				{
+					return;
+				}
+				else
+				{
+					return std::move(mHandle.promise().GetResult());
+				}
+			}
+
+		private:
+			std::coroutine_handle<promise_type> mHandle;
+		};
+
+		Task() = default;
+
+		explicit Task(std::coroutine_handle<promise_type> handle)
+			: mHandle(handle)
+		{
+		}
+
+		Task(const Task&) = delete;
+
+		Task(Task&& other) noexcept
+			: mHandle(std::exchange(other.mHandle, nullptr))
+		{
+		}
+
+		~Task()
+		{
+			if (mHandle)
+			{
+				mHandle.destroy();
+			}
+		}
+
+		Task& operator=(const Task&) = delete;
+
+		Task& operator=(Task&& other) noexcept
+		{
+			if (this != &other)
+			{
+				if (mHandle)
+				{
+					mHandle.destroy();
+				}
+				mHandle = std::exchange(other.mHandle, nullptr);
+			}
+
+			return *this;
+		}
+
+		/*Queues the task on jobSystem. Adds one to counter, which it takes away once the task returned.*/
+		void Start(JobSystem& jobSystem, JobCounter* counter = nullptr)
+		{
+			assert(mHandle && !mHandle.done());
+
+			promise_type& promise = mHandle.promise();
+			promise.mJobSystem = &jobSystem;
+			promise.mCounter = counter;
+			if (counter != nullptr)
+			{
+				counter->add();
+			}
+
+			std::coroutine_handle<promise_type> handle = mHandle;
+			jobSystem.Run([handle]()
+				{
+					handle.resume();
+				});
+		}
+
+		bool IsDone() const
+		{
+			return !mHandle || mHandle.done();
+		}
+
+		/*Only once IsDone().*/
+		decltype(auto) GetResult()
+		{
+			assert(mHandle && mHandle.done());
+
+			return mHandle.promise().GetResult();
+		}
+
+		Awaiter operator co_await() && noexcept
+		{
+			assert(mHandle);
+
+			return Awaiter(mHandle);
+		}
+
+		Awaiter operator co_await() & noexcept
+		{
+			assert(mHandle);
+
+			return Awaiter(mHandle);
+		}
+
+	private:
+		std::coroutine_handle<promise_type> mHandle;
+	};
+
+	template <typename T>
+	Task<T> TaskPromise<T>::get_return_object()
+	{
+		return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+	}
+
+	inline Task<void> TaskPromise<void>::get_return_object()
+	{
+		return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+	}
+
+	/*co_await counter; resumes on a worker once the count is zero, right away if it already is.*/
+	class JobCounterAwaiter
+	{
+	public:
+		explicit JobCounterAwaiter(JobCounter& counter)
+			: mCounter(counter)
+		{
+		}
+
+		bool await_ready() const noexcept
+		{
+			return mCounter.IsDone();
+		}
+
+		template <typename Promise>
+		bool await_suspend(std::coroutine_handle<Promise> awaiting) noexcept
+		{
+			static_assert(std::is_base_of_v<TaskPromiseBase, Promise>, "only a Task can co_await a JobCounter");
+
+			mWaiter.System = awaiting.promise().GetJobSystem();
+			mWaiter.Handle = awaiting;
+
+			return mCounter.addWaiter(mWaiter);
+		}
+
+		void await_resume() const noexcept
+		{
+		}
+
+	private:
+		JobCounter& mCounter;
+		JobCounter::Waiter mWaiter;
+	};
+
+	inline JobCounterAwaiter operator co_await(JobCounter& counter) noexcept
+	{
+		return JobCounterAwaiter(counter);
+	}
+
+	/*
+	 * co_await ReadFileAsync(path, data); reads the whole file on a worker and resumes there, true if it could be read.
+	 * A stopgap for callers without an AsyncIo: the read blocks the worker it runs on, co_await AsyncIo::ReadAsync() instead.
+	 */
+	class FileReadAwaiter
+	{
+	public:
+		FileReadAwaiter(const char* path, std::vector<unsigned char>& outData)
+			: mPath(path)
+			, mData(outData)
+		{
+		}
+
+		bool await_ready() const noexcept
+		{
+			return false;
+		}
+
+		template <typename Promise>
+		void await_suspend(std::coroutine_handle<Promise> awaiting) noexcept
+		{
+			static_assert(std::is_base_of_v<TaskPromiseBase, Promise>, "only a Task can co_await a file read");
+
+			FileReadAwaiter* awaiter = this;
+			std::coroutine_handle<> handle = awaiting;
+			awaiting.promise().GetJobSystem()->Run([awaiter, handle]()
+				{
+					awaiter->mbRead = awaiter->read();
+					handle.resume();
+				});
+		}
+
+		bool await_resume() const noexcept
+		{
+			return mbRead;
+		}
+
+	private:
+		bool read();
+
+		const char* mPath;
+		std::vector<unsigned char>& mData;
+		bool mbRead = false;
+	};
+
+	inline FileReadAwaiter ReadFileAsync(const char* path, std::vector<unsigned char>& outData)
+	{
+		return FileReadAwaiter(path, outData);
+	}
+
+#ifdef CAVE_BUILD_DEBUG
+	namespace TaskTest
+	{
+		void Main();
+	}
+#endif
+}
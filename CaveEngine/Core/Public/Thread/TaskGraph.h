@@ -0,0 +1,94 @@
+/*!
+ * Copyright (c) 2021 SWTube. All rights reserved.
+ * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "CoreTypes.h"
+#include "Assertion/Assert.h"
+
+namespace cave
+{
+	class JobCounter;
+	class JobSystem;
+
+	/**
+	 *
+	 * @brief Tasks with dependencies, run on a JobSystem
+	 * @details Built once and run every frame: a task starts once every task it depends on returned.
+	 * 			Each task counts its unfinished dependencies, the task that takes the count to zero
+	 * 			runs it next as its continuation, handing any other successor that became ready to the JobSystem.
+	 * 			@n@n
+	 * 			A task may itself call JobSystem::ParallelFor, the worker helps with it instead of blocking.
+	 * 			@n@n
+	 * 			<code>uint32_t scripts = graph.AddTask(updateScripts); uint32_t sprites = graph.AddTask(buildSprites);
+	 * 			graph.AddDependency(scripts, sprites); graph.Run(jobSystem);</code>
+	 *
+	 */
+	class TaskGraph final
+	{
+	public:
+		TaskGraph() = default;
+		TaskGraph(const TaskGraph&) = delete;
+		~TaskGraph() = default;
+		TaskGraph& operator=(const TaskGraph&) = delete;
+
+		/*Returns the index other tasks refer to this one by.*/
+		template <typename Function>
+		uint32_t AddTask(Function&& function);
+		/*successor starts only after predecessor returned.*/
+		void AddDependency(uint32_t predecessor, uint32_t successor);
+		/*Runs every task once and returns when all of them returned. The graph must not have cycles.*/
+		void Run(JobSystem& jobSystem);
+		void Clear();
+
+		uint32_t GetTaskCount() const
+		{
+			return static_cast<uint32_t>(mTasks.size());
+		}
+
+	private:
+		struct Task
+		{
+			std::function<void()> Function;
+			std::vector<uint32_t> Successors;
+			uint32_t DependencyCount = 0u;
+		};
+
+		void runTask(uint32_t index);
+		bool isAcyclic() const;
+
+		std::vector<Task> mTasks;
+		// what is left of each DependencyCount in the current Run()
+		std::unique_ptr<std::atomic<uint32_t>[]> mRemainingCounts;
+		uint32_t mRemainingCountSize = 0u;
+
+		JobSystem* mJobSystem = nullptr;
+		JobCounter* mCounter = nullptr;
+	};
+
+	template <typename Function>
+	uint32_t TaskGraph::AddTask(Function&& function)
+	{
+		assert(mJobSystem == nullptr);
+
+		Task& task = mTasks.emplace_back();
+		task.Function = std::forward<Function>(function);
+
+		return static_cast<uint32_t>(mTasks.size() - 1ul);
+	}
+
+#ifdef CAVE_BUILD_DEBUG
+	namespace TaskGraphTest
+	{
+		void Main();
+	}
+#endif
+}
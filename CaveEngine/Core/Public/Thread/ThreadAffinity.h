@@ -0,0 +1,98 @@
+/*!
+ * Copyright (c) 2021 SWTube. All rights reserved.
+ * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "CoreTypes.h"
+
+namespace cave
+{
+	enum class eThreadRole
+	{
+		GAME,
+		RENDER,
+		AUDIO,
+		WORKER,
+	};
+
+	/**
+	 *
+	 * @brief The logical processors the process may run on, grouped by physical core
+	 * @details Detected once: on Linux from sched_getaffinity and /sys/devices/system/cpu/cpu<N>/topology,
+	 * 			on Windows from GetProcessAffinityMask and GetLogicalProcessorInformation.
+	 * 			Without topology information every logical processor counts as a core of its own.
+	 * 			@n@n
+	 * 			Threads are placed one per physical core before any core gets a second one,
+	 * 			so SMT siblings only share a core once every core is busy.
+	 * 			The game thread gets the first core and workers the following ones,
+	 * 			the render and audio threads, which mostly wait on devices, the SMT siblings of the first cores if there are any.
+	 *
+	 */
+	class CpuTopology final
+	{
+	public:
+		struct Core
+		{
+			uint32_t PackageId;
+			uint32_t CoreId;
+			std::vector<uint32_t> Processors;
+		};
+
+		CpuTopology(const CpuTopology&) = delete;
+		CpuTopology& operator=(const CpuTopology&) = delete;
+
+		static const CpuTopology& Get();
+
+		uint32_t GetProcessorCount() const
+		{
+			return static_cast<uint32_t>(mPlacement.size());
+		}
+
+		uint32_t GetCoreCount() const
+		{
+			return static_cast<uint32_t>(mCores.size());
+		}
+
+		uint32_t GetPackageCount() const
+		{
+			return mPackageCount;
+		}
+
+		const std::vector<Core>& GetCores() const
+		{
+			return mCores;
+		}
+
+		/*A worker per physical core but the one of the game thread, which helps out while it waits, at least one.*/
+		uint32_t GetDefaultWorkerCount() const;
+		/*Logical processor the index-th thread of role is pinned to.*/
+		uint32_t GetProcessor(eThreadRole role, uint32_t index = 0u) const;
+
+	private:
+		CpuTopology();
+
+		void detect();
+
+		std::vector<Core> mCores;
+		// one processor of every core, then the second of every core that has one, and so on
+		std::vector<uint32_t> mPlacement;
+		uint32_t mPackageCount = 1u;
+	};
+
+	/*Shows up in debuggers, profilers and top -H. Longer names are cut to the 15 characters Linux keeps, Windows before 10 1607 keeps none.*/
+	void SetCurrentThreadName(const char* name);
+	/*false if the OS refused, the thread then keeps running anywhere.*/
+	bool PinCurrentThread(uint32_t processor);
+	bool PinCurrentThread(eThreadRole role, uint32_t index = 0u);
+
+#ifdef CAVE_BUILD_DEBUG
+	namespace ThreadAffinityTest
+	{
+		void Main();
+	}
+#endif
+}
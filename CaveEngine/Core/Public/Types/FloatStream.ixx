@@ -0,0 +1,1224 @@
+/*!
+ * Copyright (c) 2021 SWTube. All rights reserved.
+ * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
+ */
+
+module;
+
+#include <cmath>
+
+#include "CoreTypes.h"
+
+#include "Assertion/Assert.h"
+#include "CoreGlobals.h"
+#include "Debug/Log.h"
+#include "Memory/MemoryPool.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+	#define CAVE_STREAM_SSE 1
+	#include <emmintrin.h>
+	#if defined(__AVX__)
+		#define CAVE_STREAM_AVX 1
+		#include <immintrin.h>
+	#else
+		#define CAVE_STREAM_AVX 0
+	#endif
+#else
+	#define CAVE_STREAM_SSE 0
+	#define CAVE_STREAM_AVX 0
+#endif
+
+export module cave.Core.Types.FloatStream;
+
+import cave.Core.Memory.Memory;
+import cave.Core.Types.Float;
+import cave.Core.Types.Vertex;
+
+namespace cave
+{
+	static_assert(sizeof(Float2) == 2 * sizeof(float), "Float2 streams are transposed as packed floats");
+	static_assert(sizeof(Float3) == 3 * sizeof(float), "Float3 streams are transposed as packed floats");
+	static_assert(sizeof(VertexT) == 5 * sizeof(float), "VertexT streams are transposed as packed floats");
+
+	/*
+	 * Kernels over plain float arrays. They do not require aligned pointers, but run fastest on the
+	 * component arrays of the streams below, which are aligned to FLOAT_STREAM_ALIGNMENT.
+	 */
+	export void StreamAdd(float* destination, const float* source, size_t count);
+	export void StreamScale(float* destination, float scale, size_t count);
+	export void StreamLerp(float* destination, const float* from, const float* to, float t, size_t count);
+
+	export constexpr size_t FLOAT_STREAM_ALIGNMENT = 32ul;
+
+	/**
+	 *
+	 * @brief Structure-of-arrays storage for COMPONENT_COUNT float components
+	 * @details Every component lives in its own contiguous, FLOAT_STREAM_ALIGNMENT aligned array,
+	 * 			so batch math runs at full SIMD width. All components share one allocation from the memory pool.
+	 *
+	 */
+	template <size_t COMPONENT_COUNT>
+	class FloatStreamBase
+	{
+	public:
+		FloatStreamBase(size_t capacity, MemoryPool& pool);
+		FloatStreamBase(const FloatStreamBase& other);
+		FloatStreamBase(FloatStreamBase&& other);
+		~FloatStreamBase();
+		FloatStreamBase& operator=(const FloatStreamBase& other);
+		FloatStreamBase& operator=(FloatStreamBase&& other);
+
+		// Capacity
+		[[nodiscard]] bool IsEmpty() const;
+		size_t GetSize() const;
+		size_t GetCapacity() const;
+		void SetCapacity(size_t capacity);
+		void Resize(size_t size);
+		void Clear();
+
+		// Component Access
+		float* GetComponent(size_t component);
+		const float* GetComponent(size_t component) const;
+
+		// Batch Operations
+		void Add(const FloatStreamBase& other);
+		void Scale(float scale);
+		void Lerp(const FloatStreamBase& from, const FloatStreamBase& to, float t);
+
+		static constexpr size_t INITIAL_CAPACITY = 16ul;
+	protected:
+		void grow();
+
+		MemoryPool* mPool = nullptr;
+		size_t mSize = 0ul;
+		size_t mCapacity = 0ul;
+		void* mRawData = nullptr;
+		float* mData = nullptr;
+
+	private:
+		static constexpr size_t FLOATS_PER_ALIGNMENT = FLOAT_STREAM_ALIGNMENT / sizeof(float);
+
+		static size_t getAlignedCapacity(size_t capacity);
+		static size_t getAllocationSize(size_t capacity);
+		void allocate(size_t capacity);
+		void deallocate();
+	};
+
+	/**
+	 *
+	 * @brief Structure-of-arrays stream of Float2
+	 * @details X and Y are stored in separate arrays. LoadFrom and StoreTo transpose from and to an array of Float2.
+	 *
+	 */
+	export class Float2Stream final : public FloatStreamBase<2>
+	{
+	public:
+		Float2Stream();
+		Float2Stream(MemoryPool& pool);
+		Float2Stream(size_t capacity);
+		Float2Stream(size_t capacity, MemoryPool& pool);
+
+		// Element Access
+		Float2 Get(size_t index) const;
+		void Set(size_t index, const Float2& value);
+		float* GetX();
+		float* GetY();
+		const float* GetX() const;
+		const float* GetY() const;
+
+		// Modifiers
+		void PushBack(const Float2& value);
+
+		// Transposition
+		void LoadFrom(const Float2* in, size_t count);
+		void StoreTo(Float2* out) const;
+	};
+
+	/**
+	 *
+	 * @brief Structure-of-arrays stream of Float3
+	 * @details X, Y and Z are stored in separate arrays. LoadFrom and StoreTo transpose from and to an array of Float3.
+	 *
+	 */
+	export class Float3Stream final : public FloatStreamBase<3>
+	{
+	public:
+		Float3Stream();
+		Float3Stream(MemoryPool& pool);
+		Float3Stream(size_t capacity);
+		Float3Stream(size_t capacity, MemoryPool& pool);
+
+		// Element Access
+		Float3 Get(size_t index) const;
+		void Set(size_t index, const Float3& value);
+		float* GetX();
+		float* GetY();
+		float* GetZ();
+		const float* GetX() const;
+		const float* GetY() const;
+		const float* GetZ() const;
+
+		// Modifiers
+		void PushBack(const Float3& value);
+
+		// Transposition
+		void LoadFrom(const Float3* in, size_t count);
+		void StoreTo(Float3* out) const;
+	};
+
+	/**
+	 *
+	 * @brief Structure-of-arrays stream of VertexT
+	 * @details Positions and texture coordinates are kept as separate streams, so vertex generation can transform them in batches.
+	 * 			StoreTo writes the interleaved VertexT layout that the vertex buffers expect.
+	 *
+	 */
+	export class VertexTStream final
+	{
+	public:
+		VertexTStream();
+		VertexTStream(MemoryPool& pool);
+		VertexTStream(size_t capacity);
+		VertexTStream(size_t capacity, MemoryPool& pool);
+
+		// Element Access
+		Float3Stream& GetPositions();
+		const Float3Stream& GetPositions() const;
+		Float2Stream& GetTexCoords();
+		const Float2Stream& GetTexCoords() const;
+
+		// Capacity
+		[[nodiscard]] bool IsEmpty() const;
+		size_t GetSize() const;
+		void SetCapacity(size_t capacity);
+		void Resize(size_t size);
+		void Clear();
+
+		// Modifiers
+		void PushBack(const VertexT& vertex);
+
+		// Transposition
+		void LoadFrom(const VertexT* in, size_t count);
+		void StoreTo(VertexT* out) const;
+
+	private:
+		Float3Stream mPositions;
+		Float2Stream mTexCoords;
+	};
+
+	/*
+	 *
+	 * Kernels
+	 *
+	 */
+
+	void StreamAdd(float* destination, const float* source, size_t count)
+	{
+		size_t i = 0ul;
+#if CAVE_STREAM_AVX
+		for (; i + 8ul <= count; i += 8ul)
+		{
+			_mm256_storeu_ps(destination + i, _mm256_add_ps(_mm256_loadu_ps(destination + i), _mm256_loadu_ps(source + i)));
+		}
+#endif
+#if CAVE_STREAM_SSE
+		for (; i + 4ul <= count; i += 4ul)
+		{
+			_mm_storeu_ps(destination + i, _mm_add_ps(_mm_loadu_ps(destination + i), _mm_loadu_ps(source + i)));
+		}
+#endif
+		for (; i < count; ++i)
+		{
+			destination[i] += source[i];
+		}
+	}
+
+	void StreamScale(float* destination, float scale, size_t count)
+	{
+		size_t i = 0ul;
+#if CAVE_STREAM_AVX
+		__m256 scale8 = _mm256_set1_ps(scale);
+		for (; i + 8ul <= count; i += 8ul)
+		{
+			_mm256_storeu_ps(destination + i, _mm256_mul_ps(_mm256_loadu_ps(destination + i), scale8));
+		}
+#endif
+#if CAVE_STREAM_SSE
+		__m128 scale4 = _mm_set1_ps(scale);
+		for (; i + 4ul <= count; i += 4ul)
+		{
+			_mm_storeu_ps(destination + i, _mm_mul_ps(_mm_loadu_ps(destination + i), scale4));
+		}
+#endif
+		for (; i < count; ++i)
+		{
+			destination[i] *= scale;
+		}
+	}
+
+	/*
+	 * destination = from + (to - from) * t, destination may alias from or to
+	 */
+	void StreamLerp(float* destination, const float* from, const float* to, float t, size_t count)
+	{
+		size_t i = 0ul;
+#if CAVE_STREAM_AVX
+		__m256 t8 = _mm256_set1_ps(t);
+		for (; i + 8ul <= count; i += 8ul)
+		{
+			__m256 a = _mm256_loadu_ps(from + i);
+			__m256 b = _mm256_loadu_ps(to + i);
+			_mm256_storeu_ps(destination + i, _mm256_add_ps(a, _mm256_mul_ps(_mm256_sub_ps(b, a), t8)));
+		}
+#endif
+#if CAVE_STREAM_SSE
+		__m128 t4 = _mm_set1_ps(t);
+		for (; i + 4ul <= count; i += 4ul)
+		{
+			__m128 a = _mm_loadu_ps(from + i);
+			__m128 b = _mm_loadu_ps(to + i);
+			_mm_storeu_ps(destination + i, _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), t4)));
+		}
+#endif
+		for (; i < count; ++i)
+		{
+			destination[i] = from[i] + (to[i] - from[i]) * t;
+		}
+	}
+
+	/*
+	 *
+	 * FloatStreamBase Implement
+	 *
+	 */
+
+	template <size_t COMPONENT_COUNT>
+	FloatStreamBase<COMPONENT_COUNT>::FloatStreamBase(size_t capacity, MemoryPool& pool)
+		: mPool(&pool)
+	{
+		allocate(capacity > 0ul ? capacity : INITIAL_CAPACITY);
+	}
+
+	template <size_t COMPONENT_COUNT>
+	FloatStreamBase<COMPONENT_COUNT>::FloatStreamBase(const FloatStreamBase& other)
+		: mPool(other.mPool)
+		, mSize(other.mSize)
+	{
+		// a moved-from source has no storage left
+		allocate(other.mCapacity > 0ul ? other.mCapacity : INITIAL_CAPACITY);
+		for (size_t component = 0ul; component < COMPONENT_COUNT; ++component)
+		{
+			Memory::Memcpy(GetComponent(component), other.GetComponent(component), sizeof(float) * mSize);
+		}
+	}
+
+	template <size_t COMPONENT_COUNT>
+	FloatStreamBase<COMPONENT_COUNT>::FloatStreamBase(FloatStreamBase&& other)
+		: mPool(other.mPool)
+		, mSize(other.mSize)
+		, mCapacity(other.mCapacity)
+		, mRawData(other.mRawData)
+		, mData(other.mData)
+	{
+		other.mSize = 0ul;
+		other.mCapacity = 0ul;
+		other.mRawData = nullptr;
+		other.mData = nullptr;
+	}
+
+	template <size_t COMPONENT_COUNT>
+	FloatStreamBase<COMPONENT_COUNT>::~FloatStreamBase()
+	{
+		deallocate();
+		mPool = nullptr;
+	}
+
+	template <size_t COMPONENT_COUNT>
+	FloatStreamBase<COMPONENT_COUNT>& FloatStreamBase<COMPONENT_COUNT>::operator=(const FloatStreamBase& other)
+	{
+		if (this != &other)
+		{
+			if (mCapacity < other.mSize)
+			{
+				deallocate();
+				allocate(other.mCapacity);
+			}
+
+			mSize = other.mSize;
+			for (size_t component = 0ul; component < COMPONENT_COUNT; ++component)
+			{
+				Memory::Memcpy(GetComponent(component), other.GetComponent(component), sizeof(float) * mSize);
+			}
+		}
+
+		return *this;
+	}
+
+	template <size_t COMPONENT_COUNT>
+	FloatStreamBase<COMPONENT_COUNT>& FloatStreamBase<COMPONENT_COUNT>::operator=(FloatStreamBase&& other)
+	{
+		if (this != &other)
+		{
+			deallocate();
+
+			mPool = other.mPool;
+			mSize = other.mSize;
+			mCapacity = other.mCapacity;
+			mRawData = other.mRawData;
+			mData = other.mData;
+
+			other.mSize = 0ul;
+			other.mCapacity = 0ul;
+			other.mRawData = nullptr;
+			other.mData = nullptr;
+		}
+
+		return *this;
+	}
+
+	template <size_t COMPONENT_COUNT>
+	[[nodiscard]] bool FloatStreamBase<COMPONENT_COUNT>::IsEmpty() const
+	{
+		return mSize == 0ul;
+	}
+
+	template <size_t COMPONENT_COUNT>
+	size_t FloatStreamBase<COMPONENT_COUNT>::GetSize() const
+	{
+		return mSize;
+	}
+
+	template <size_t COMPONENT_COUNT>
+	size_t FloatStreamBase<COMPONENT_COUNT>::GetCapacity() const
+	{
+		return mCapacity;
+	}
+
+	/**
+	 *
+	 * @brief Reserves storage
+	 * @details If capacity is greater than the current GetCapacity(), every component is moved to a new allocation.
+	 * 			All component pointers are invalidated in that case.
+	 *
+	 */
+	template <size_t COMPONENT_COUNT>
+	void FloatStreamBase<COMPONENT_COUNT>::SetCapacity(size_t capacity)
+	{
+		if (capacity <= mCapacity)
+		{
+			return;
+		}
+
+		void* oldRawData = mRawData;
+		float* oldData = mData;
+		size_t oldCapacity = mCapacity;
+
+		allocate(capacity);
+		for (size_t component = 0ul; component < COMPONENT_COUNT; ++component)
+		{
+			Memory::Memcpy(GetComponent(component), oldData + component * oldCapacity, sizeof(float) * mSize);
+		}
+
+		if (oldRawData != nullptr)
+		{
+			mPool->Deallocate(oldRawData, getAllocationSize(oldCapacity));
+		}
+	}
+
+	/**
+	 *
+	 * @brief Changes the number of elements stored
+	 * @details New elements are zero-initialized.
+	 *
+	 */
+	template <size_t COMPONENT_COUNT>
+	void FloatStreamBase<COMPONENT_COUNT>::Resize(size_t size)
+	{
+		SetCapacity(size);
+
+		if (size > mSize)
+		{
+			for (size_t component = 0ul; component < COMPONENT_COUNT; ++component)
+			{
+				Memory::Memset(GetComponent(component) + mSize, 0, sizeof(float) * (size - mSize));
+			}
+		}
+
+		mSize = size;
+	}
+
+	template <size_t COMPONENT_COUNT>
+	void FloatStreamBase<COMPONENT_COUNT>::Clear()
+	{
+		mSize = 0ul;
+	}
+
+	template <size_t COMPONENT_COUNT>
+	float* FloatStreamBase<COMPONENT_COUNT>::GetComponent(size_t component)
+	{
+		assert(component < COMPONENT_COUNT);
+
+		return mData + component * mCapacity;
+	}
+
+	template <size_t COMPONENT_COUNT>
+	const float* FloatStreamBase<COMPONENT_COUNT>::GetComponent(size_t component) const
+	{
+		assert(component < COMPONENT_COUNT);
+
+		return mData + component * mCapacity;
+	}
+
+	/**
+	 *
+	 * @brief Adds other element-wise
+	 * @details Both streams need to have the same size.
+	 * 			@n@n
+	 * 			Complexity: linear in the size of the stream
+	 *
+	 */
+	template <size_t COMPONENT_COUNT>
+	void FloatStreamBase<COMPONENT_COUNT>::Add(const FloatStreamBase& other)
+	{
+		assert(mSize == other.mSize);
+
+		for (size_t component = 0ul; component < COMPONENT_COUNT; ++component)
+		{
+			StreamAdd(GetComponent(component), other.GetComponent(component), mSize);
+		}
+	}
+
+	template <size_t COMPONENT_COUNT>
+	void FloatStreamBase<COMPONENT_COUNT>::Scale(float scale)
+	{
+		for (size_t component = 0ul; component < COMPONENT_COUNT; ++component)
+		{
+			StreamScale(GetComponent(component), scale, mSize);
+		}
+	}
+
+	/**
+	 *
+	 * @brief Replaces the contents with the linear interpolation of from and to
+	 * @details from and to need to have the same size, *this is resized to it. *this may be from or to.
+	 * 			@n@n
+	 * 			Complexity: linear in the size of the streams
+	 *
+	 */
+	template <size_t COMPONENT_COUNT>
+	void FloatStreamBase<COMPONENT_COUNT>::Lerp(const FloatStreamBase& from, const FloatStreamBase& to, float t)
+	{
+		assert(from.mSize == to.mSize);
+
+		Resize(from.mSize);
+		for (size_t component = 0ul; component < COMPONENT_COUNT; ++component)
+		{
+			StreamLerp(GetComponent(component), from.GetComponent(component), to.GetComponent(component), t, mSize);
+		}
+	}
+
+	template <size_t COMPONENT_COUNT>
+	void FloatStreamBase<COMPONENT_COUNT>::grow()
+	{
+#if CAPACITY_INCREASE_MODE == CAPACITY_INCREASE_MODE_DOUBLE
+		// a moved-from stream has no capacity to double
+		SetCapacity(mCapacity > 0ul ? mCapacity * 2ul : INITIAL_CAPACITY);
+#else
+		SetCapacity(mCapacity + mCapacity / 2ul + FLOATS_PER_ALIGNMENT);
+#endif
+	}
+
+	template <size_t COMPONENT_COUNT>
+	size_t FloatStreamBase<COMPONENT_COUNT>::getAlignedCapacity(size_t capacity)
+	{
+		return (capacity + FLOATS_PER_ALIGNMENT - 1ul) / FLOATS_PER_ALIGNMENT * FLOATS_PER_ALIGNMENT;
+	}
+
+	template <size_t COMPONENT_COUNT>
+	size_t FloatStreamBase<COMPONENT_COUNT>::getAllocationSize(size_t capacity)
+	{
+		return sizeof(float) * COMPONENT_COUNT * capacity + FLOAT_STREAM_ALIGNMENT;
+	}
+
+	template <size_t COMPONENT_COUNT>
+	void FloatStreamBase<COMPONENT_COUNT>::allocate(size_t capacity)
+	{
+		// the capacity is a multiple of the alignment so every component array starts aligned
+		mCapacity = getAlignedCapacity(capacity);
+		mRawData = mPool->Allocate(getAllocationSize(mCapacity));
+
+		uintptr_t address = reinterpret_cast<uintptr_t>(mRawData);
+		address = (address + FLOAT_STREAM_ALIGNMENT - 1ul) & ~(static_cast<uintptr_t>(FLOAT_STREAM_ALIGNMENT) - 1ul);
+		mData = reinterpret_cast<float*>(address);
+	}
+
+	template <size_t COMPONENT_COUNT>
+	void FloatStreamBase<COMPONENT_COUNT>::deallocate()
+	{
+		if (mRawData != nullptr)
+		{
+			mPool->Deallocate(mRawData, getAllocationSize(mCapacity));
+		}
+
+		mRawData = nullptr;
+		mData = nullptr;
+		mSize = 0ul;
+		mCapacity = 0ul;
+	}
+
+	/*
+	 *
+	 * Float2Stream Implement
+	 *
+	 */
+
+	Float2Stream::Float2Stream()
+		: Float2Stream(INITIAL_CAPACITY, gCoreMemoryPool)
+	{
+	}
+
+	Float2Stream::Float2Stream(MemoryPool& pool)
+		: Float2Stream(INITIAL_CAPACITY, pool)
+	{
+	}
+
+	Float2Stream::Float2Stream(size_t capacity)
+		: Float2Stream(capacity, gCoreMemoryPool)
+	{
+	}
+
+	Float2Stream::Float2Stream(size_t capacity, MemoryPool& pool)
+		: FloatStreamBase<2>(capacity, pool)
+	{
+	}
+
+	Float2 Float2Stream::Get(size_t index) const
+	{
+		assert(index < mSize);
+
+		return Float2(GetX()[index], GetY()[index]);
+	}
+
+	void Float2Stream::Set(size_t index, const Float2& value)
+	{
+		assert(index < mSize);
+
+		GetX()[index] = value.X;
+		GetY()[index] = value.Y;
+	}
+
+	float* Float2Stream::GetX()
+	{
+		return GetComponent(0);
+	}
+
+	float* Float2Stream::GetY()
+	{
+		return GetComponent(1);
+	}
+
+	const float* Float2Stream::GetX() const
+	{
+		return GetComponent(0);
+	}
+
+	const float* Float2Stream::GetY() const
+	{
+		return GetComponent(1);
+	}
+
+	void Float2Stream::PushBack(const Float2& value)
+	{
+		if (mSize >= mCapacity)
+		{
+			grow();
+		}
+
+		++mSize;
+		Set(mSize - 1ul, value);
+	}
+
+	/**
+	 *
+	 * @brief Replaces the contents with count elements of an array of Float2
+	 * @details Transposes x0 y0 x1 y1 ... into the X and Y arrays, four elements per iteration with SSE2.
+	 *
+	 */
+	void Float2Stream::LoadFrom(const Float2* in, size_t count)
+	{
+		assert(count == 0ul || in != nullptr);
+
+		Resize(count);
+
+		const float* source = reinterpret_cast<const float*>(in);
+		float* x = GetX();
+		float* y = GetY();
+		size_t i = 0ul;
+#if CAVE_STREAM_SSE
+		for (; i + 4ul <= count; i += 4ul)
+		{
+			__m128 a = _mm_loadu_ps(source + i * 2ul);
+			__m128 b = _mm_loadu_ps(source + i * 2ul + 4ul);
+			_mm_storeu_ps(x + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+			_mm_storeu_ps(y + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+		}
+#endif
+		for (; i < count; ++i)
+		{
+			x[i] = in[i].X;
+			y[i] = in[i].Y;
+		}
+	}
+
+	/**
+	 *
+	 * @brief Writes every element to an array of Float2
+	 * @details out needs room for GetSize() elements.
+	 *
+	 */
+	void Float2Stream::StoreTo(Float2* out) const
+	{
+		assert(mSize == 0ul || out != nullptr);
+
+		float* destination = reinterpret_cast<float*>(out);
+		const float* x = GetX();
+		const float* y = GetY();
+		size_t i = 0ul;
+#if CAVE_STREAM_SSE
+		for (; i + 4ul <= mSize; i += 4ul)
+		{
+			__m128 xs = _mm_loadu_ps(x + i);
+			__m128 ys = _mm_loadu_ps(y + i);
+			_mm_storeu_ps(destination + i * 2ul, _mm_unpacklo_ps(xs, ys));
+			_mm_storeu_ps(destination + i * 2ul + 4ul, _mm_unpackhi_ps(xs, ys));
+		}
+#endif
+		for (; i < mSize; ++i)
+		{
+			out[i].X = x[i];
+			out[i].Y = y[i];
+		}
+	}
+
+	/*
+	 *
+	 * Float3Stream Implement
+	 *
+	 */
+
+	Float3Stream::Float3Stream()
+		: Float3Stream(INITIAL_CAPACITY, gCoreMemoryPool)
+	{
+	}
+
+	Float3Stream::Float3Stream(MemoryPool& pool)
+		: Float3Stream(INITIAL_CAPACITY, pool)
+	{
+	}
+
+	Float3Stream::Float3Stream(size_t capacity)
+		: Float3Stream(capacity, gCoreMemoryPool)
+	{
+	}
+
+	Float3Stream::Float3Stream(size_t capacity, MemoryPool& pool)
+		: FloatStreamBase<3>(capacity, pool)
+	{
+	}
+
+	Float3 Float3Stream::Get(size_t index) const
+	{
+		assert(index < mSize);
+
+		return Float3(GetX()[index], GetY()[index], GetZ()[index]);
+	}
+
+	void Float3Stream::Set(size_t index, const Float3& value)
+	{
+		assert(index < mSize);
+
+		GetX()[index] = value.X;
+		GetY()[index] = value.Y;
+		GetZ()[index] = value.Z;
+	}
+
+	float* Float3Stream::GetX()
+	{
+		return GetComponent(0);
+	}
+
+	float* Float3Stream::GetY()
+	{
+		return GetComponent(1);
+	}
+
+	float* Float3Stream::GetZ()
+	{
+		return GetComponent(2);
+	}
+
+	const float* Float3Stream::GetX() const
+	{
+		return GetComponent(0);
+	}
+
+	const float* Float3Stream::GetY() const
+	{
+		return GetComponent(1);
+	}
+
+	const float* Float3Stream::GetZ() const
+	{
+		return GetComponent(2);
+	}
+
+	void Float3Stream::PushBack(const Float3& value)
+	{
+		if (mSize >= mCapacity)
+		{
+			grow();
+		}
+
+		++mSize;
+		Set(mSize - 1ul, value);
+	}
+
+	/**
+	 *
+	 * @brief Replaces the contents with count elements of an array of Float3
+	 * @details Transposes x0 y0 z0 x1 ... into the X, Y and Z arrays, four elements per iteration with SSE2.
+	 *
+	 */
+	void Float3Stream::LoadFrom(const Float3* in, size_t count)
+	{
+		assert(count == 0ul || in != nullptr);
+
+		Resize(count);
+
+		const float* source = reinterpret_cast<const float*>(in);
+		float* x = GetX();
+		float* y = GetY();
+		float* z = GetZ();
+		size_t i = 0ul;
+#if CAVE_STREAM_SSE
+		for (; i + 4ul <= count; i += 4ul)
+		{
+			// x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3
+			__m128 a = _mm_loadu_ps(source + i * 3ul);
+			__m128 b = _mm_loadu_ps(source + i * 3ul + 4ul);
+			__m128 c = _mm_loadu_ps(source + i * 3ul + 8ul);
+
+			_mm_storeu_ps(x + i, _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0)));
+			_mm_storeu_ps(y + i, _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+			_mm_storeu_ps(z + i, _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0)));
+		}
+#endif
+		for (; i < count; ++i)
+		{
+			x[i] = in[i].X;
+			y[i] = in[i].Y;
+			z[i] = in[i].Z;
+		}
+	}
+
+	/**
+	 *
+	 * @brief Writes every element to an array of Float3
+	 * @details out needs room for GetSize() elements.
+	 *
+	 */
+	void Float3Stream::StoreTo(Float3* out) const
+	{
+		assert(mSize == 0ul || out != nullptr);
+
+		float* destination = reinterpret_cast<float*>(out);
+		const float* x = GetX();
+		const float* y = GetY();
+		const float* z = GetZ();
+		size_t i = 0ul;
+#if CAVE_STREAM_SSE
+		for (; i + 4ul <= mSize; i += 4ul)
+		{
+			__m128 xs = _mm_loadu_ps(x + i);
+			__m128 ys = _mm_loadu_ps(y + i);
+			__m128 zs = _mm_loadu_ps(z + i);
+
+			_mm_storeu_ps(destination + i * 3ul, _mm_shuffle_ps(_mm_shuffle_ps(xs, ys, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(zs, xs, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0)));
+			_mm_storeu_ps(destination + i * 3ul + 4ul, _mm_shuffle_ps(_mm_shuffle_ps(ys, zs, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(xs, ys, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0)));
+			_mm_storeu_ps(destination + i * 3ul + 8ul, _mm_shuffle_ps(_mm_shuffle_ps(zs, xs, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(ys, zs, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+		}
+#endif
+		for (; i < mSize; ++i)
+		{
+			out[i].X = x[i];
+			out[i].Y = y[i];
+			out[i].Z = z[i];
+		}
+	}
+
+	/*
+	 *
+	 * VertexTStream Implement
+	 *
+	 */
+
+	VertexTStream::VertexTStream()
+		: VertexTStream(Float3Stream::INITIAL_CAPACITY, gCoreMemoryPool)
+	{
+	}
+
+	VertexTStream::VertexTStream(MemoryPool& pool)
+		: VertexTStream(Float3Stream::INITIAL_CAPACITY, pool)
+	{
+	}
+
+	VertexTStream::VertexTStream(size_t capacity)
+		: VertexTStream(capacity, gCoreMemoryPool)
+	{
+	}
+
+	VertexTStream::VertexTStream(size_t capacity, MemoryPool& pool)
+		: mPositions(capacity, pool)
+		, mTexCoords(capacity, pool)
+	{
+	}
+
+	Float3Stream& VertexTStream::GetPositions()
+	{
+		return mPositions;
+	}
+
+	const Float3Stream& VertexTStream::GetPositions() const
+	{
+		return mPositions;
+	}
+
+	Float2Stream& VertexTStream::GetTexCoords()
+	{
+		return mTexCoords;
+	}
+
+	const Float2Stream& VertexTStream::GetTexCoords() const
+	{
+		return mTexCoords;
+	}
+
+	[[nodiscard]] bool VertexTStream::IsEmpty() const
+	{
+		return mPositions.IsEmpty();
+	}
+
+	size_t VertexTStream::GetSize() const
+	{
+		assert(mPositions.GetSize() == mTexCoords.GetSize());
+
+		return mPositions.GetSize();
+	}
+
+	void VertexTStream::SetCapacity(size_t capacity)
+	{
+		mPositions.SetCapacity(capacity);
+		mTexCoords.SetCapacity(capacity);
+	}
+
+	void VertexTStream::Resize(size_t size)
+	{
+		mPositions.Resize(size);
+		mTexCoords.Resize(size);
+	}
+
+	void VertexTStream::Clear()
+	{
+		mPositions.Clear();
+		mTexCoords.Clear();
+	}
+
+	void VertexTStream::PushBack(const VertexT& vertex)
+	{
+		mPositions.PushBack(vertex.Position);
+		mTexCoords.PushBack(vertex.TexCoord);
+	}
+
+	/**
+	 *
+	 * @brief Replaces the contents with count vertices
+	 * @details VertexT interleaves five floats. With SSE2 four vertices are loaded as five vectors,
+	 * 			shuffled into x y z u rows that are transposed like a matrix, and v is gathered on its own.
+	 *
+	 */
+	void VertexTStream::LoadFrom(const VertexT* in, size_t count)
+	{
+		assert(count == 0ul || in != nullptr);
+
+		Resize(count);
+
+		const float* source = reinterpret_cast<const float*>(in);
+		float* x = mPositions.GetX();
+		float* y = mPositions.GetY();
+		float* z = mPositions.GetZ();
+		float* u = mTexCoords.GetX();
+		float* v = mTexCoords.GetY();
+		size_t i = 0ul;
+#if CAVE_STREAM_SSE
+		for (; i + 4ul <= count; i += 4ul)
+		{
+			// x0 y0 z0 u0 | v0 x1 y1 z1 | u1 v1 x2 y2 | z2 u2 v2 x3 | y3 z3 u3 v3
+			__m128 a = _mm_loadu_ps(source + i * 5ul);
+			__m128 b = _mm_loadu_ps(source + i * 5ul + 4ul);
+			__m128 c = _mm_loadu_ps(source + i * 5ul + 8ul);
+			__m128 d = _mm_loadu_ps(source + i * 5ul + 12ul);
+			__m128 e = _mm_loadu_ps(source + i * 5ul + 16ul);
+
+			__m128 row0 = a;
+			__m128 row1 = _mm_shuffle_ps(b, _mm_shuffle_ps(b, c, _MM_SHUFFLE(0, 0, 3, 3)), _MM_SHUFFLE(2, 0, 2, 1));
+			__m128 row2 = _mm_shuffle_ps(c, d, _MM_SHUFFLE(1, 0, 3, 2));
+			__m128 row3 = _mm_shuffle_ps(_mm_shuffle_ps(d, e, _MM_SHUFFLE(0, 0, 3, 3)), e, _MM_SHUFFLE(2, 1, 2, 0));
+			_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+			_mm_storeu_ps(x + i, row0);
+			_mm_storeu_ps(y + i, row1);
+			_mm_storeu_ps(z + i, row2);
+			_mm_storeu_ps(u + i, row3);
+			_mm_storeu_ps(v + i, _mm_shuffle_ps(_mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 0, 0)), _mm_shuffle_ps(d, e, _MM_SHUFFLE(3, 3, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0)));
+		}
+#endif
+		for (; i < count; ++i)
+		{
+			x[i] = in[i].Position.X;
+			y[i] = in[i].Position.Y;
+			z[i] = in[i].Position.Z;
+			u[i] = in[i].TexCoord.X;
+			v[i] = in[i].TexCoord.Y;
+		}
+	}
+
+	/**
+	 *
+	 * @brief Writes every vertex in the interleaved VertexT layout
+	 * @details out needs room for GetSize() vertices, e.g. a mapped vertex buffer. The inverse of LoadFrom with SSE2.
+	 *
+	 */
+	void VertexTStream::StoreTo(VertexT* out) const
+	{
+		size_t size = GetSize();
+		assert(size == 0ul || out != nullptr);
+
+		float* destination = reinterpret_cast<float*>(out);
+		const float* x = mPositions.GetX();
+		const float* y = mPositions.GetY();
+		const float* z = mPositions.GetZ();
+		const float* u = mTexCoords.GetX();
+		const float* v = mTexCoords.GetY();
+		size_t i = 0ul;
+#if CAVE_STREAM_SSE
+		for (; i + 4ul <= size; i += 4ul)
+		{
+			__m128 row0 = _mm_loadu_ps(x + i);
+			__m128 row1 = _mm_loadu_ps(y + i);
+			__m128 row2 = _mm_loadu_ps(z + i);
+			__m128 row3 = _mm_loadu_ps(u + i);
+			__m128 vs = _mm_loadu_ps(v + i);
+			_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+			_mm_storeu_ps(destination + i * 5ul, row0);
+			_mm_storeu_ps(destination + i * 5ul + 4ul, _mm_move_ss(_mm_shuffle_ps(row1, row1, _MM_SHUFFLE(2, 1, 0, 0)), vs));
+			_mm_storeu_ps(destination + i * 5ul + 8ul, _mm_shuffle_ps(_mm_shuffle_ps(row1, vs, _MM_SHUFFLE(1, 1, 3, 3)), row2, _MM_SHUFFLE(1, 0, 2, 0)));
+			_mm_storeu_ps(destination + i * 5ul + 12ul, _mm_shuffle_ps(row2, _mm_shuffle_ps(vs, row3, _MM_SHUFFLE(0, 0, 2, 2)), _MM_SHUFFLE(2, 0, 3, 2)));
+			_mm_storeu_ps(destination + i * 5ul + 16ul, _mm_shuffle_ps(row3, _mm_shuffle_ps(row3, vs, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 1)));
+		}
+#endif
+		for (; i < size; ++i)
+		{
+			out[i].Position.X = x[i];
+			out[i].Position.Y = y[i];
+			out[i].Position.Z = z[i];
+			out[i].TexCoord.X = u[i];
+			out[i].TexCoord.Y = v[i];
+		}
+	}
+
+#ifdef CAVE_BUILD_DEBUG
+	export namespace FloatStreamTest
+	{
+		// DECLARATIONS
+
+		void Main();
+
+		void Kernels();
+		void Transposition();
+		void Vertices();
+		void PushAfterMove();
+
+		// DEFINITIONS
+		void Main()
+		{
+			LOGD(eLogChannel::CORE_CONTAINER, "======FloatStream Test======");
+			Kernels();
+			Transposition();
+			Vertices();
+			PushAfterMove();
+			LOGD(eLogChannel::CORE_CONTAINER, "======FloatStream Test Success======");
+		}
+
+		void Kernels()
+		{
+			LOGD(eLogChannel::CORE_CONTAINER, "====Kernels Test====");
+			{
+				MemoryPool tempPool(4096);
+				Float2Stream from(tempPool);
+				Float2Stream to(tempPool);
+				for (size_t i = 0; i < 37; ++i)
+				{
+					from.PushBack(Float2(static_cast<float>(i), -static_cast<float>(i)));
+					to.PushBack(Float2(static_cast<float>(i) * 3.0f, 1.0f));
+				}
+
+				assert(reinterpret_cast<uintptr_t>(from.GetX()) % FLOAT_STREAM_ALIGNMENT == 0);
+				assert(reinterpret_cast<uintptr_t>(from.GetY()) % FLOAT_STREAM_ALIGNMENT == 0);
+
+				Float2Stream halfway(tempPool);
+				halfway.Lerp(from, to, 0.5f);
+				for (size_t i = 0; i < 37; ++i)
+				{
+					assert(halfway.Get(i).X == static_cast<float>(i) * 2.0f);
+					assert(halfway.Get(i).Y == (1.0f - static_cast<float>(i)) * 0.5f);
+				}
+
+				halfway.Add(from);
+				halfway.Scale(2.0f);
+				for (size_t i = 0; i < 37; ++i)
+				{
+					assert(halfway.Get(i).X == static_cast<float>(i) * 6.0f);
+				}
+			}
+		}
+
+		void Transposition()
+		{
+			LOGD(eLogChannel::CORE_CONTAINER, "====Transposition Test====");
+			{
+				Float3 points[13];
+				Float3 result[13];
+				for (size_t i = 0; i < 13; ++i)
+				{
+					points[i] = Float3(static_cast<float>(i), static_cast<float>(i) + 0.25f, static_cast<float>(i) + 0.5f);
+				}
+
+				Float3Stream stream;
+				stream.LoadFrom(points, 13);
+				assert(stream.GetSize() == 13ul);
+				for (size_t i = 0; i < 13; ++i)
+				{
+					assert(stream.GetX()[i] == points[i].X && stream.GetY()[i] == points[i].Y && stream.GetZ()[i] == points[i].Z);
+				}
+
+				stream.StoreTo(result);
+				for (size_t i = 0; i < 13; ++i)
+				{
+					assert(result[i] == points[i]);
+				}
+
+				Float2 coords[9];
+				Float2 coordsResult[9];
+				for (size_t i = 0; i < 9; ++i)
+				{
+					coords[i] = Float2(static_cast<float>(i), static_cast<float>(i) * 2.0f);
+				}
+
+				Float2Stream coordStream;
+				coordStream.LoadFrom(coords, 9);
+				coordStream.StoreTo(coordsResult);
+				for (size_t i = 0; i < 9; ++i)
+				{
+					assert(coordsResult[i].X == coords[i].X && coordsResult[i].Y == coords[i].Y);
+				}
+			}
+		}
+
+		void Vertices()
+		{
+			LOGD(eLogChannel::CORE_CONTAINER, "====VertexTStream Test====");
+			{
+				VertexT quad[4] = {
+					VertexT(-1.0f,  1.0f, 0.0f,	0.0f, 0.0f),
+					VertexT(1.0f,  1.0f, 0.0f,	1.0f, 0.0f),
+					VertexT(1.0f, -1.0f, 0.0f,	1.0f, 1.0f),
+					VertexT(-1.0f, -1.0f, 0.0f,	0.0f, 1.0f),
+				};
+
+				VertexTStream stream;
+				stream.LoadFrom(quad, 4);
+				stream.GetPositions().Scale(10.0f);
+
+				VertexT result[4];
+				stream.StoreTo(result);
+				for (size_t i = 0; i < 4; ++i)
+				{
+					assert(result[i].Position.X == quad[i].Position.X * 10.0f);
+					assert(result[i].Position.Y == quad[i].Position.Y * 10.0f);
+					assert(result[i].TexCoord.X == quad[i].TexCoord.X && result[i].TexCoord.Y == quad[i].TexCoord.Y);
+				}
+			}
+
+			{
+				// two transposed blocks and a remainder
+				VertexT vertices[11];
+				for (size_t i = 0; i < 11; ++i)
+				{
+					float base = static_cast<float>(i * 5);
+					vertices[i] = VertexT(base, base + 1.0f, base + 2.0f, base + 3.0f, base + 4.0f);
+				}
+
+				VertexTStream stream;
+				stream.LoadFrom(vertices, 11);
+				for (size_t i = 0; i < 11; ++i)
+				{
+					assert(stream.GetPositions().GetX()[i] == static_cast<float>(i * 5));
+					assert(stream.GetPositions().GetZ()[i] == static_cast<float>(i * 5 + 2));
+					assert(stream.GetTexCoords().GetY()[i] == static_cast<float>(i * 5 + 4));
+				}
+
+				VertexT result[11];
+				stream.StoreTo(result);
+				for (size_t i = 0; i < 11; ++i)
+				{
+					assert(result[i].Position == vertices[i].Position);
+					assert(result[i].TexCoord.X == vertices[i].TexCoord.X && result[i].TexCoord.Y == vertices[i].TexCoord.Y);
+				}
+			}
+		}
+
+		void PushAfterMove()
+		{
+			LOGD(eLogChannel::CORE_CONTAINER, "====Push After Move Test====");
+			{
+				Float3Stream stream0;
+				stream0.PushBack(Float3(1.0f, 2.0f, 3.0f));
+				Float3Stream stream1(std::move(stream0));
+				assert(stream0.GetCapacity() == 0ul);
+
+				// the moved-from stream grows again, past its initial capacity
+				for (size_t i = 0; i < 40; ++i)
+				{
+					stream0.PushBack(Float3(static_cast<float>(i), 0.5f, -static_cast<float>(i)));
+				}
+				assert(stream0.GetSize() == 40ul);
+				for (size_t i = 0; i < 40; ++i)
+				{
+					assert(stream0.Get(i).X == static_cast<float>(i) && stream0.Get(i).Z == -static_cast<float>(i));
+				}
+
+				// so does a copy of a moved-from stream
+				Float2Stream stream2;
+				Float2Stream stream3(std::move(stream2));
+				Float2Stream stream4(stream2);
+				for (size_t i = 0; i < 40; ++i)
+				{
+					stream4.PushBack(Float2(static_cast<float>(i), 1.0f));
+				}
+				assert(stream4.GetSize() == 40ul && stream4.Get(39).X == 39.0f);
+			}
+		}
+	}
+#endif
+}
@@ -4,6 +4,7 @@
  */
 
 #include "GenericEngine.h"
+#include "Thread/JobSystem.h"
 
 namespace cave
 {
@@ -30,6 +31,12 @@ namespace cave
 			mWindow = nullptr;
 		}
 
+		if (mJobSystem != nullptr)
+		{
+			delete mJobSystem;
+			mJobSystem = nullptr;
+		}
+
 		if (mPool != &gCoreMemoryPool)
 		{
 			delete mPool;
@@ -45,4 +52,9 @@ namespace cave
 	{
 		return mRenderer;
 	}
+
+	JobSystem* GenericEngine::GetJobSystem()
+	{
+		return mJobSystem;
+	}
 }
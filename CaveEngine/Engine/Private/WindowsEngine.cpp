@@ -4,6 +4,8 @@
  */
 
 #include "WindowsEngine.h"
+#include "Thread/JobSystem.h"
+#include "Thread/ThreadAffinity.h"
 
 import Sprite;
 import AnimatedSprite;
@@ -19,6 +21,9 @@ namespace cave
 	{
 		eResult result = eResult::CAVE_OK;
 
+		// the game thread also renders
+		SetCurrentThreadName("CaveGame");
+
 		mWindow = reinterpret_cast<Window*>(mPool->Allocate(sizeof(Window)));
 		new(mWindow) Window(screenWidth, screenHeight, L"Test", msInstance, StaticWindowProc);
 
@@ -27,6 +32,11 @@ namespace cave
 		new(mRenderer) Renderer();
 
 		mRenderer->Init(mWindow);
+
+		// a worker per physical core but one, the game thread joins in while it waits.
+		// Cache line aligned, so it comes from new rather than the pool
+		mJobSystem = new JobSystem(0u);
+		mRenderer->SetJobSystem(mJobSystem);
 		
 		return result;
 	}
@@ -35,6 +45,7 @@ namespace cave
 	{
 		if (mRenderer != nullptr)
 		{
+			mRenderer->SetJobSystem(nullptr);
 			mRenderer->Destroy();
 			mPool->Deallocate(mRenderer, sizeof(Renderer));
 		}
@@ -43,6 +54,13 @@ namespace cave
 		{
 			mPool->Deallocate(mWindow, sizeof(Window));
 		}
+
+		if (mJobSystem != nullptr)
+		{
+			// runs the jobs still queued before the workers stop
+			delete mJobSystem;
+			mJobSystem = nullptr;
+		}
 	}
 
 	eResult WindowsEngine::Run()
@@ -20,6 +20,8 @@ import Renderer;
 
 namespace cave
 {
+	class JobSystem;
+
 	class GenericEngine
 	{
 	public:
@@ -35,10 +37,13 @@ namespace cave
 		virtual eResult Run() = 0;
 
 		virtual Renderer* GetRenderer();
+		/*The workers the frame is spread over, a World updates its game objects with it.*/
+		JobSystem* GetJobSystem();
 	protected:
 		MemoryPool* mPool = nullptr;
 		Renderer* mRenderer = nullptr;
 		Window* mWindow = nullptr;
+		JobSystem* mJobSystem = nullptr;
 
 		static const wchar_t* msWindowClassName;
 	};
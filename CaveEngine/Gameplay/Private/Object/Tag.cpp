@@ -2,16 +2,13 @@
  * Copyright (c) 2021 SWTube. All rights reserved.
  * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
  */
-#include <cassert>
-#include "xhash.h"
-
 #include "Object/Tag.h"
 
 namespace cave
 {
-	Tag::Tag(std::string& name) :
+	Tag::Tag(Name name) :
 		mName(name),
-		mCompareSeed(std::hash<std::string>{}(mName))
+		mCompareSeed(name.GetId())
 	{
 
 	}
@@ -21,7 +18,7 @@ namespace cave
 
 	}
 
-	std::string& Tag::GetName()
+	Name Tag::GetName() const
 	{
 		return mName;
 	}
@@ -2,9 +2,12 @@
  * Copyright (c) 2021 SWTube. All rights reserved.
  * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
  */
+#include <mutex>
+
 #ifdef CAVE_BUILD_DEBUG
 #include <random>
 #include <iostream>
+#include <thread>
 #endif // CAVE_BUILD_DEBUG
 
 
@@ -16,7 +19,8 @@
 namespace cave
 {
 	MemoryPool* TagPool::mMemoryPool = nullptr;
-	std::unordered_map<std::string, Tag*> TagPool::mTags;
+	Mutex TagPool::mMemoryPoolMutex;
+	EpochHashMap<Name, Tag*> TagPool::mTags;
 
 	TagPool::~TagPool()
 	{
@@ -32,72 +36,108 @@ namespace cave
 	{
 		assert(IsValid());
 
-		
+		// the removed tags go back to the pool before it goes away
+		Epoch::Synchronize();
 		mMemoryPool = nullptr;
 	}
 
-	void TagPool::AddTag(std::string& name)
+	void TagPool::AddTag(Name name)
 	{
 		assert(IsValid());
 
+		if (mTags.Contains(name))
+		{
+			return;
+		}
+
+		// another thread may have added it meanwhile
 		Tag* tag = createTag(name);
-		mTags[name] = tag;
+		if (!mTags.Insert(name, tag))
+		{
+			destroyTag(tag);
+		}
+	}
+
+	void TagPool::AddTag(StringView name)
+	{
+		AddTag(Name(name));
 	}
 
 	void TagPool::AddTag(const char* name)
 	{
-		assert(IsValid());
-		
-		std::string convertedName(name);
+		AddTag(Name(name));
 	}
 
-	void TagPool::RemoveTag(std::string& name)
+	void TagPool::RemoveTag(Name name)
 	{
 		assert(IsValid());
 
-		auto iter = mTags.find(name);
-
-		if (iter != mTags.end())
+		Tag* tag = nullptr;
+		if (mTags.Remove(name, tag))
 		{
-			iter->second = nullptr;
-			mMemoryPool->Deallocate(iter->second, sizeof(Tag));
+			// a reader may still hold it
+			Epoch::Retire(tag, [](void* object, void*)
+				{
+					destroyTag(static_cast<Tag*>(object));
+				});
 		}
 	}
 
-	void TagPool::RemoveTag(const char* name)
+	void TagPool::RemoveTag(StringView name)
 	{
-		assert(IsValid());
+		RemoveTag(Name::Find(name));
+	}
 
-		std::string convertedName(name);
+	void TagPool::RemoveTag(const char* name)
+	{
+		RemoveTag(Name::Find(name));
 	}
 
-	Tag* TagPool::FindTagByName(std::string& name)
+	Tag* TagPool::FindTagByName(Name name)
 	{
 		assert(IsValid());
 
-		auto iter = mTags.find(name);
+		Tag* tag = nullptr;
+		mTags.Find(name, tag);
+
+		return tag;
+	}
 
-		return iter != mTags.end() ? iter->second : nullptr;
+	// Lookups by string never intern, a string that was never interned can't be a tag
+	Tag* TagPool::FindTagByName(StringView name)
+	{
+		return FindTagByName(Name::Find(name));
 	}
 
 	Tag* TagPool::FindTagByName(const char* name)
+	{
+		return FindTagByName(Name::Find(name));
+	}
+
+	Tag* TagPool::createTag(Name name)
 	{
 		assert(IsValid());
 
-		std::string convertedName(name);
-		auto iter = mTags.find(convertedName);
+		void* memory = nullptr;
+		{
+			std::lock_guard<Mutex> lock(mMemoryPoolMutex);
+			memory = mMemoryPool->Allocate(sizeof(Tag));
+		}
+
+		Tag* tag = new(memory) Tag(name);
+		assert(tag != nullptr);
 
-		return iter != mTags.end() ? iter->second : nullptr;
+		return tag;
 	}
 
-	Tag* TagPool::createTag(std::string& name)
+	void TagPool::destroyTag(Tag* tag)
 	{
 		assert(IsValid());
 
-		Tag* tag = new(reinterpret_cast<Tag*>(mMemoryPool->Allocate(sizeof(Tag)))) Tag(name);
-		assert(tag != nullptr);
+		tag->~Tag();
 
-		return tag;
+		std::lock_guard<Mutex> lock(mMemoryPoolMutex);
+		mMemoryPool->Deallocate(tag, sizeof(Tag));
 	}
 	
 	bool TagPool::IsValid()
@@ -108,10 +148,10 @@ namespace cave
 #ifdef CAVE_BUILD_DEBUG
 	void TagPool::PrintElement()
 	{
-		for (auto begin = mTags.begin(); begin != mTags.end(); ++begin)
-		{
-			std::cout << (begin->second) << std::endl;
-		}
+		mTags.ForEach([](Name name, Tag*)
+			{
+				std::cout << name.GetCString() << std::endl;
+			});
 	}
 #endif //CAVE_BUILD_DEBUG
 
@@ -149,7 +189,12 @@ namespace cave
 				vec.push_back(tmp);
 
 				TagPool::AddTag(tmp);
-				assert(TagPool::FindTagByName(tmp) != nullptr);
+				{
+					// the tag can't be freed under the guard
+					EpochGuard guard;
+					Tag* tag = TagPool::FindTagByName(tmp);
+					assert(tag != nullptr && tag->GetName() == Name::Find(tmp.c_str()));
+				}
 
 				delete str;
 			}
@@ -161,6 +206,49 @@ namespace cave
 				TagPool::RemoveTag(vec[i]);
 				assert(TagPool::FindTagByName(vec[i]) == nullptr);
 			}
+
+			TagPool::ShutDown();
+
+			{
+				// loaders add and remove tags while this thread reads them, removed tags go back to the pool meanwhile.
+				// Retired tags wait for two epochs, the pool has room for a few hundred of them
+				MemoryPool loaderPool(16384ul);
+				TagPool::Init(loaderPool);
+
+				const char* names[] = { "Player", "Enemy", "Item", "Wall" };
+				std::atomic<uint32_t> finishedCount = 0u;
+				std::thread loaders[2];
+				for (size_t i = 0; i < 2; ++i)
+				{
+					loaders[i] = std::thread([&names, &finishedCount, i]()
+						{
+							for (size_t round = 0; round < 2000; ++round)
+							{
+								const char* name = names[(round + i) % 4];
+								TagPool::AddTag(name);
+								TagPool::RemoveTag(name);
+							}
+							finishedCount.fetch_add(1u);
+						});
+				}
+
+				while (finishedCount.load() < 2u)
+				{
+					EpochGuard guard;
+					for (const char* name : names)
+					{
+						Tag* tag = TagPool::FindTagByName(name);
+						assert(tag == nullptr || tag->GetName() == Name::Find(name));
+					}
+				}
+
+				for (std::thread& loader : loaders)
+				{
+					loader.join();
+				}
+
+				TagPool::ShutDown();
+			}
 		}
 	}
 #endif // CAVE_BUILD_DEBUG
@@ -3,8 +3,77 @@
  * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
  */
 #include "World/Level.h"
+#include "Object/GameObject.h"
 
 namespace cave
 {
+	void Level::AddGameObject(GameObject& gameObject)
+	{
+		if (gameObject.IsActive())
+		{
+			mActiveGameObjectIds.emplace(Name(gameObject.GetName()), mActiveGameObjects.Insert(&gameObject));
+		}
+		else
+		{
+			mDeactiveGameObjectIds.emplace(Name(gameObject.GetName()), mDeactiveGameObjects.Insert(&gameObject));
+		}
+	}
 
-}
\ No newline at end of file
+	// removes one of the game objects of that name, an active one first
+	void Level::RemoveGameObject(Name name)
+	{
+		auto iter = mActiveGameObjectIds.find(name);
+		if (iter != mActiveGameObjectIds.end())
+		{
+			mActiveGameObjects.Erase(iter->second);
+			mActiveGameObjectIds.erase(iter);
+			return;
+		}
+
+		iter = mDeactiveGameObjectIds.find(name);
+		if (iter != mDeactiveGameObjectIds.end())
+		{
+			mDeactiveGameObjects.Erase(iter->second);
+			mDeactiveGameObjectIds.erase(iter);
+		}
+	}
+
+	void Level::RemoveGameObject(StringView name)
+	{
+		RemoveGameObject(Name::Find(name));
+	}
+
+	void Level::RemoveGameObject(const char* name)
+	{
+		RemoveGameObject(Name::Find(name));
+	}
+
+	GameObject* Level::FindGameObjectByName(Name name)
+	{
+		auto iter = mActiveGameObjectIds.find(name);
+
+		return iter != mActiveGameObjectIds.end() ? static_cast<GameObject*>(mActiveGameObjects.Find(iter->second)) : nullptr;
+	}
+
+	void Level::GatherActiveGameObjects(std::vector<GameObject*>& gameObjects) const
+	{
+		// a game object deactivated since it was added is still in mActiveGameObjects
+		for (void* const gameObject : mActiveGameObjects)
+		{
+			if (static_cast<GameObject*>(gameObject)->IsActive())
+			{
+				gameObjects.push_back(static_cast<GameObject*>(gameObject));
+			}
+		}
+	}
+
+	GameObject* Level::FindGameObjectByName(StringView name)
+	{
+		return FindGameObjectByName(Name::Find(name));
+	}
+
+	GameObject* Level::FindGameObjectByName(const char* name)
+	{
+		return FindGameObjectByName(Name::Find(name));
+	}
+}
@@ -2,4 +2,142 @@
  * Copyright (c) 2021 SWTube. All rights reserved.
  * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
  */
-#include "World/World.h"
\ No newline at end of file
+#include <algorithm>
+
+#include "World/World.h"
+#include "World/Level.h"
+#include "Object/GameObject.h"
+#include "Thread/JobSystem.h"
+
+namespace cave
+{
+	namespace
+	{
+		// game objects a job updates the scripts of, a script update is too small to be a job of its own
+		constexpr size_t SCRIPT_GRAIN_SIZE = 64ul;
+	}
+
+	void World::AddGameObject(GameObject& gameObject)
+	{
+		const SlotId id = mGameObjects.Insert(&gameObject);
+		mGameObjectIds.emplace(Name(gameObject.GetName()), id);
+	}
+
+	// removes one of the game objects of that name, the one FindGameObjectByName() returns
+	void World::RemoveGameObject(Name name)
+	{
+		auto iter = mGameObjectIds.find(name);
+		if (iter == mGameObjectIds.end())
+		{
+			return;
+		}
+
+		mGameObjects.Erase(iter->second);
+		mGameObjectIds.erase(iter);
+	}
+
+	void World::RemoveGameObject(StringView name)
+	{
+		RemoveGameObject(Name::Find(name));
+	}
+
+	void World::RemoveGameObject(const char* name)
+	{
+		RemoveGameObject(Name::Find(name));
+	}
+
+	GameObject* World::FindGameObjectByName(Name name)
+	{
+		auto iter = mGameObjectIds.find(name);
+
+		return iter != mGameObjectIds.end() ? static_cast<GameObject*>(mGameObjects.Find(iter->second)) : nullptr;
+	}
+
+	// Lookups by string never intern, a string that was never interned can't name a game object
+	GameObject* World::FindGameObjectByName(StringView name)
+	{
+		return FindGameObjectByName(Name::Find(name));
+	}
+
+	GameObject* World::FindGameObjectByName(const char* name)
+	{
+		return FindGameObjectByName(Name::Find(name));
+	}
+
+	void World::UpdateGameObjectInWorld(JobSystem& jobSystem)
+	{
+		mUpdatedLevels.clear();
+		for (auto& [name, level] : mLevels)
+		{
+			mUpdatedLevels.push_back(level);
+		}
+
+		// the gathers read mUpdatedLevels by position, so only a new level count needs a new graph
+		if (mUpdateGraph.GetTaskCount() != mUpdatedLevels.size() + 2ul)
+		{
+			mUpdateGraph.Clear();
+			buildUpdateGraph();
+		}
+
+		mJobSystem = &jobSystem;
+		mUpdateGraph.Run(jobSystem);
+		mJobSystem = nullptr;
+	}
+
+	void World::buildUpdateGraph()
+	{
+		const size_t gatherCount = mUpdatedLevels.size() + 1ul;
+		mUpdatedGameObjects.resize(gatherCount);
+		mUpdatedGameObjectOffsets.resize(gatherCount + 1ul);
+
+		const uint32_t updateScripts = mUpdateGraph.AddTask([this]()
+			{
+				size_t count = 0ul;
+				for (size_t i = 0ul; i < mUpdatedGameObjects.size(); ++i)
+				{
+					mUpdatedGameObjectOffsets[i] = count;
+					count += mUpdatedGameObjects[i].size();
+				}
+				mUpdatedGameObjectOffsets.back() = count;
+
+				mJobSystem->ParallelFor(count, SCRIPT_GRAIN_SIZE, [this](size_t begin, size_t end)
+					{
+						// the last list starting at or before begin, which skips the empty ones
+						size_t list = std::upper_bound(mUpdatedGameObjectOffsets.begin(), mUpdatedGameObjectOffsets.end(), begin) - mUpdatedGameObjectOffsets.begin() - 1ul;
+						for (size_t i = begin; i < end; ++i)
+						{
+							while (i == mUpdatedGameObjectOffsets[list + 1ul])
+							{
+								++list;
+							}
+
+							mUpdatedGameObjects[list][i - mUpdatedGameObjectOffsets[list]]->UpdateScripts();
+						}
+					});
+			});
+
+		const uint32_t gatherWorld = mUpdateGraph.AddTask([this]()
+			{
+				std::vector<GameObject*>& gameObjects = mUpdatedGameObjects[0];
+				gameObjects.clear();
+				for (void* gameObject : mGameObjects)
+				{
+					if (static_cast<GameObject*>(gameObject)->IsActive())
+					{
+						gameObjects.push_back(static_cast<GameObject*>(gameObject));
+					}
+				}
+			});
+		mUpdateGraph.AddDependency(gatherWorld, updateScripts);
+
+		for (size_t i = 1ul; i < gatherCount; ++i)
+		{
+			const uint32_t gatherLevel = mUpdateGraph.AddTask([this, i]()
+				{
+					mUpdatedGameObjects[i].clear();
+					mUpdatedLevels[i - 1ul]->GatherActiveGameObjects(mUpdatedGameObjects[i]);
+				});
+			mUpdateGraph.AddDependency(gatherLevel, updateScripts);
+		}
+	}
+}
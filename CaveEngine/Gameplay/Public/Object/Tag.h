@@ -4,9 +4,8 @@
  */
 #pragma once
 
-#include <string>
-
 #include "CoreTypes.h"
+#include "String/Name.h"
 
 namespace cave
 {
@@ -32,11 +31,11 @@ namespace cave
 			return lhs.mCompareSeed < rhs.mCompareSeed;
 		}
 
-		std::string& GetName();
+		Name GetName() const;
 
 	private:
 		Tag() = delete;
-		Tag(std::string& name);
+		Tag(Name name);
 		Tag(const Tag& other) = delete;
 		Tag(Tag&& other) = delete;
 
@@ -44,8 +43,8 @@ namespace cave
 		Tag& operator=(const Tag&& other) = delete;
 
 	private:
-		std::string mName;
+		Name mName;
 		/*Used only compare tag.*/
-		size_t mCompareSeed;
+		uint32_t mCompareSeed;
 	};
 }
\ No newline at end of file
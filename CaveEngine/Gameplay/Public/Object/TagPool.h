@@ -5,15 +5,21 @@
 #pragma once
 
 #include <string>
-#include <unordered_map>
 
 #include "CoreTypes.h"
+#include "String/Name.h"
+#include "Thread/Epoch.h"
 
 namespace cave
 {
 	class Tag;
 	class MemoryPool;
 
+	/*
+	 * Lookups never take a lock: loader threads may add and remove tags while the game and render threads look them up.
+	 * A removed tag is freed once no thread inside an EpochGuard can still use it.
+	 * The memory pool is TagPool's alone from Init() to ShutDown(), it serializes every access to it.
+	 */
 	class TagPool final
 	{
 	public:
@@ -26,13 +32,17 @@ namespace cave
 		static void Init(MemoryPool& memoryPool);
 		static void ShutDown();
 
-		static void AddTag(std::string& name);
+		static void AddTag(Name name);
+		static void AddTag(StringView name);
 		static void AddTag(const char* name);
 
-		static void RemoveTag(std::string& name);
+		static void RemoveTag(Name name);
+		static void RemoveTag(StringView name);
 		static void RemoveTag(const char* name);
 
-		static Tag* FindTagByName(std::string& name);
+		/*The tag stays valid while the caller is inside an EpochGuard, a tag removed meanwhile is freed once it leaves.*/
+		static Tag* FindTagByName(Name name);
+		static Tag* FindTagByName(StringView name);
 		static Tag* FindTagByName(const char* name);
 
 		static bool IsValid();
@@ -42,11 +52,14 @@ namespace cave
 #endif // CAVE_BULID_DEBUG
 
 	private:
-		static Tag* createTag(std::string& name);
+		static Tag* createTag(Name name);
+		static void destroyTag(Tag* tag);
 
 	private:
 		static MemoryPool* mMemoryPool;
-		static std::unordered_map<std::string, Tag*> mTags;
+		// removed tags are freed on whichever thread collects next, while loader threads add others
+		static Mutex mMemoryPoolMutex;
+		static EpochHashMap<Name, Tag*> mTags;
 	};
 
 #ifdef CAVE_BUILD_DEBUG
@@ -4,8 +4,14 @@
  */
 #pragma once
 
+#include <string>
+#include <vector>
 #include <unordered_map>
 
+#include "String/Name.h"
+
+import cave.Core.Containers.SlotMap;
+
 namespace cave
 {
 	class GameObject;
@@ -24,25 +30,34 @@ namespace cave
 		Level& operator=(Level&&) = delete;
 
 		void AddGameObject(GameObject& gameObject);
-		void RemoveGameObject(std::string& name);
+		void RemoveGameObject(Name name);
+		void RemoveGameObject(StringView name);
 		void RemoveGameObject(const char* name);
 
-		GameObject* FindGameObjectByName(std::string& name);
+		GameObject* FindGameObjectByName(Name name);
+		GameObject* FindGameObjectByName(StringView name);
 		GameObject* FindGameObjectByName(const char* name);
-		std::vector<GameObject*>& FindGameObjectsByName(std::string& name);
+		std::vector<GameObject*>& FindGameObjectsByName(StringView name);
 		std::vector<GameObject*>& FindGameObjectsByName(const char* name);
 
-		GameObject* FindGameObjectByTag(std::string& tag);
+		GameObject* FindGameObjectByTag(StringView tag);
 		GameObject* FindGameObjectByTag(const char* tag);
-		std::vector<GameObject*>& FindGameObjectsByTag(std::string& tag);
+		std::vector<GameObject*>& FindGameObjectsByTag(StringView tag);
 		std::vector<GameObject*>& FindGameObjectsByTag(const char* tag);
 
+		/*Appends the active game objects to gameObjects.*/
+		void GatherActiveGameObjects(std::vector<GameObject*>& gameObjects) const;
+
 		void UpdateGameObjectInLevel();
 		void UpdateAllGameObjectInLevel();
 
 	private:
-		std::unordered_multimap<std::string, GameObject*> mActiveGameObjects;
-		std::unordered_multimap<std::string, GameObject*> mDeactiveGameObjects;
+		// GameObject*, packed so that the update walks them linearly
+		SlotMap mActiveGameObjects;
+		SlotMap mDeactiveGameObjects;
+		// where the game objects of each name are in mActiveGameObjects and mDeactiveGameObjects
+		std::unordered_multimap<Name, SlotId> mActiveGameObjectIds;
+		std::unordered_multimap<Name, SlotId> mDeactiveGameObjectIds;
 		/*Read only.*/
 		std::unordered_multimap<Tag*, GameObject*> mGameObjectsSortByTag;
 
@@ -4,13 +4,20 @@
  */
 #pragma once
 
+#include <string>
 #include <vector>
 #include <unordered_map>
 
+#include "String/Name.h"
+#include "Thread/TaskGraph.h"
+
+import cave.Core.Containers.SlotMap;
+
 namespace cave
 {
 	class Tag;
 	class GameObject;
+	class JobSystem;
 	class Level;
 
 	class World final
@@ -25,36 +32,56 @@ namespace cave
 		World& operator=(World&&) = delete;
 
 		void AddLevel(Level& level);
-		void RemoveLevel(std::string& name);
+		void RemoveLevel(Name name);
+		void RemoveLevel(StringView name);
 		void RemoveLevel(const char* name);
 
 		void AddGameObject(GameObject& gameObject);
-		void RemoveGameObject(std::string& name);
+		void RemoveGameObject(Name name);
+		void RemoveGameObject(StringView name);
 		void RemoveGameObject(const char* name);
 
-		Level* FindLevelByName(std::string& name);
+		Level* FindLevelByName(Name name);
+		Level* FindLevelByName(StringView name);
 		Level* FindLevelByName(const char* name);
 
-		GameObject* FindGameObjectByName(std::string& name);
+		GameObject* FindGameObjectByName(Name name);
+		GameObject* FindGameObjectByName(StringView name);
 		GameObject* FindGameObjectByName(const char* name);
-		std::vector<GameObject*>& FindGameObjectsByName(std::string& name);
+		std::vector<GameObject*>& FindGameObjectsByName(StringView name);
 		std::vector<GameObject*>& FindGameObjectsByName(const char* name);
 
-		GameObject* FindGameObjectByTag(std::string& tag);
+		GameObject* FindGameObjectByTag(StringView tag);
 		GameObject* FindGameObjectByTag(const char* tag);
-		std::vector<GameObject*>& FindGameObjectsByTag(std::string& tag);
+		std::vector<GameObject*>& FindGameObjectsByTag(StringView tag);
 		std::vector<GameObject*>& FindGameObjectsByTag(const char* tag);
 
-		void UpdateGameObjectInWorld();
+		/*Runs the scripts of the active game objects of the World and its levels, spread over the workers of jobSystem.*/
+		void UpdateGameObjectInWorld(JobSystem& jobSystem);
 		void UpdateAllGameObjectInWorld();
 
 	private:
-		std::unordered_map<std::string, Level*> mLevels;
-		/*Read only.*/
-		std::unordered_multimap<std::string, GameObject*> mGameObjects;
+		void buildUpdateGraph();
+
+	private:
+		std::unordered_map<Name, Level*> mLevels;
+		/*Read only. GameObject*, packed so that the update walks them linearly.*/
+		SlotMap mGameObjects;
+		// where the game objects of each name are in mGameObjects
+		std::unordered_multimap<Name, SlotId> mGameObjectIds;
 		/*Read only.*/
 		std::unordered_multimap<Tag*, GameObject*> mGameObjectsSortByTag;
 
 		Level* mCurrentLevel;
+
+		// one gather for the World and one per level, all feeding the script update
+		TaskGraph mUpdateGraph;
+		JobSystem* mJobSystem = nullptr;
+		// the levels the gathers read, by position
+		std::vector<Level*> mUpdatedLevels;
+		// the active game objects of each gather, the World's first and then one list per level
+		std::vector<std::vector<GameObject*>> mUpdatedGameObjects;
+		// where each list starts in the range the script update splits, with the total last
+		std::vector<size_t> mUpdatedGameObjectOffsets;
 	};
 }
\ No newline at end of file
@@ -3,10 +3,13 @@
  * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
  */
 module;
+#include <algorithm>
 #include <string>
+#include <vector>
 #include "GraphicsApiPch.h"
 #include "CoreGlobals.h"
 #include "CoreTypes.h"
+#include "Thread/JobSystem.h"
 //#include "Texture/Texture.h"
 
 export module Renderer;
@@ -45,11 +48,15 @@ namespace cave
 		bool CaptureScreenShot();
 		bool WindowShouldClose();
 		DeviceResources* GetDeviceResources() const;
+		/*Spreads building the vertex data of a frame over the workers of jobSystem, null builds it on the calling thread.*/
+		void SetJobSystem(JobSystem* jobSystem);
 
 	private:
 		void drawText(TextCommand* command);
 	private:
 		static constexpr size_t RENDERER_MEMORY_SIZE = 1024ul * 1024ul * 10ul;
+		// sprites a job copies the vertices of
+		static constexpr size_t SPRITE_GRAIN_SIZE = 256ul;
 		MemoryPool* mPool = nullptr;
 
 		Camera* mCamera = nullptr;
@@ -68,6 +75,11 @@ namespace cave
 		IDWriteTextFormat* mTextFormat = nullptr;
 		
 		Shader* mShader = nullptr;
+
+		JobSystem* mJobSystem = nullptr;
+		// kept between frames so that their capacity is reused
+		std::vector<SpriteCommand*> mSpriteCommands;
+		std::vector<VertexT> mVertexData;
 	};
 
 	Renderer::Renderer()
@@ -132,6 +144,11 @@ namespace cave
 		return mDeviceResources;
 	}
 
+	void Renderer::SetJobSystem(JobSystem* jobSystem)
+	{
+		mJobSystem = jobSystem;
+	}
+
 
 
 	eResult Renderer::Init(Window* window)
@@ -211,24 +228,37 @@ namespace cave
 
 		//}
 		mDeviceResources->GetD2DRenderTarget()->BeginDraw();
-		std::vector<VertexT> vertexData;
 		std::vector<RenderCommand*> commands = RenderQueue::GetInstance().GetRenderQueue();
-		uint32_t spriteCount = 0;
+		mSpriteCommands.clear();
 		for (RenderCommand* command : commands) 
 		{
 			if (command->type == RenderCommand::eType::SPRITE_COMMAND)
 			{
-				SpriteCommand* sc = reinterpret_cast<SpriteCommand*>(command);
-				for (unsigned int i = 0; i < 4; i++)
-				{
-					vertexData.push_back(sc->vertexData[i]);
-				}
-				spriteCount++;
+				mSpriteCommands.push_back(reinterpret_cast<SpriteCommand*>(command));
 			}
 
 		}
 
-		if(!vertexData.empty()) mBufferManager->UpdateVertexBuffer(vertexData.data(), spriteCount);
+		// every sprite owns 4 vertices at a known offset, so the copies don't depend on each other
+		uint32_t spriteCount = static_cast<uint32_t>(mSpriteCommands.size());
+		mVertexData.resize(spriteCount * 4ul);
+		auto copyVertices = [this](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; ++i)
+				{
+					std::copy(mSpriteCommands[i]->vertexData, mSpriteCommands[i]->vertexData + 4, &mVertexData[i * 4ul]);
+				}
+			};
+		if (mJobSystem != nullptr)
+		{
+			mJobSystem->ParallelFor(mSpriteCommands.size(), SPRITE_GRAIN_SIZE, copyVertices);
+		}
+		else
+		{
+			copyVertices(0ul, mSpriteCommands.size());
+		}
+
+		if(!mVertexData.empty()) mBufferManager->UpdateVertexBuffer(mVertexData.data(), spriteCount);
 
 		spriteCount = 0;
 		for (RenderCommand* command : commands)
@@ -12,6 +12,7 @@ module;
 
 #include "CoreTypes.h"
 #include "CoreGlobals.h"
+#include "String/Name.h"
 //#include "Texture/Texture.h"
 
 export module AnimatedSprite;
@@ -73,9 +74,9 @@ namespace cave {
 	{
 	public:
 		AnimatedSprite() = default;
-		AnimatedSprite(std::string name, Animation animation);
-		AnimatedSprite(std::string name, const std::filesystem::path& filename, uint32_t column, uint32_t row, float duration, bool isLoof = true);
-		AnimatedSprite(std::string name, MultiTexture* texture, uint32_t frame, const float duration, bool isLoof);
+		AnimatedSprite(Name name, Animation animation);
+		AnimatedSprite(Name name, const std::filesystem::path& filename, uint32_t column, uint32_t row, float duration, bool isLoof = true);
+		AnimatedSprite(Name name, MultiTexture* texture, uint32_t frame, const float duration, bool isLoof);
 		AnimatedSprite(const AnimatedSprite& other);
 		AnimatedSprite(AnimatedSprite&& other);
 		AnimatedSprite& operator=(const AnimatedSprite& other);
@@ -86,22 +87,22 @@ namespace cave {
 
 
 	public:
-		void AddAnim(std::string name, Animation animation);
-		void AddAnimByMultiTexture(std::string name, const std::filesystem::path& filename, uint32_t column, uint32_t row, float duration, bool isLoof = true);
+		void AddAnim(Name name, Animation animation);
+		void AddAnimByMultiTexture(Name name, const std::filesystem::path& filename, uint32_t column, uint32_t row, float duration, bool isLoof = true);
 
 		/*
 		̹ ϴ ִϸ̼  Ӱ,  , ӵ Ͽ  ο ִϸ̼ ߰. 
 		*/
-		void AddAnimWithExistAnim(std::string animName, std::string existAnimName, uint32_t start, uint32_t end, float duration, bool isLoof = true);
+		void AddAnimWithExistAnim(Name animName, Name existAnimName, uint32_t start, uint32_t end, float duration, bool isLoof = true);
 
 
-		void SetAnimFrame(std::string animName, uint32_t start, uint32_t end);
+		void SetAnimFrame(Name animName, uint32_t start, uint32_t end);
 
-		void SetCurAnim(std::string animName);
+		void SetCurAnim(Name animName);
 		
 		constexpr void SetIsPlaying(bool isPlaying);
 		
-		const std::string& GetCurAnim() const;
+		Name GetCurAnim() const;
 	
 	protected:
 		void update() override;
@@ -110,37 +111,40 @@ namespace cave {
 		bool mbIsPlaying = false;
 		float mTotalElapsed = 0.0f;
 		float tempElapsed = 0.016f; // (ӽ)Ʈ  
-		std::string mAnimName = "";
-		std::unordered_map<std::string, Animation> mAnimations;
+		Name mAnimName;
+		std::unordered_map<Name, Animation> mAnimations;
 
 	};
 
-	AnimatedSprite::AnimatedSprite(std::string name, Animation animation) 
+	AnimatedSprite::AnimatedSprite(Name name, Animation animation) 
 		:Sprite(animation.texture)
 		, mAnimName(name)
 	{
 		AddAnim(name, animation);
-		mAnimations[name].texture->GetUVCoordsByFrame(mAnimations[name].curFrames, mStartTextureCoord, mEndTextureCoord);
+		Animation& curAnimation = mAnimations[name];
+		curAnimation.texture->GetUVCoordsByFrame(curAnimation.curFrames, mStartTextureCoord, mEndTextureCoord);
 	}
 
-	AnimatedSprite::AnimatedSprite(std::string name, MultiTexture* texture, uint32_t frame, const float duration, bool isLoof) 
+	AnimatedSprite::AnimatedSprite(Name name, MultiTexture* texture, uint32_t frame, const float duration, bool isLoof) 
 		:Sprite(texture)
 		, mAnimName(name)
 	{
 		mbIsPlaying = true;
 		Animation newAnim(texture, 0,frame, duration, isLoof);
 		AddAnim(name, newAnim);
-		mAnimations[name].texture->GetUVCoordsByFrame(mAnimations[name].curFrames, mStartTextureCoord, mEndTextureCoord);
+		Animation& curAnimation = mAnimations[name];
+		curAnimation.texture->GetUVCoordsByFrame(curAnimation.curFrames, mStartTextureCoord, mEndTextureCoord);
 	}
 
-	AnimatedSprite::AnimatedSprite(std::string name, const std::filesystem::path& filename, uint32_t column, uint32_t row, float duration, bool isLoof)
+	AnimatedSprite::AnimatedSprite(Name name, const std::filesystem::path& filename, uint32_t column, uint32_t row, float duration, bool isLoof)
 		:Sprite(TextureManager::GetInstance().GetOrAddMultiTexture(filename, column,row))
 		, mAnimName(name)
 	{
 		mbIsPlaying = true;
 		Animation newAnim(reinterpret_cast<MultiTexture*>(mTexture), 0, column * row -1, duration, isLoof);
 		AddAnim(name, newAnim);
-		mAnimations[name].texture->GetUVCoordsByFrame(mAnimations[name].curFrames, mStartTextureCoord, mEndTextureCoord);
+		Animation& curAnimation = mAnimations[name];
+		curAnimation.texture->GetUVCoordsByFrame(curAnimation.curFrames, mStartTextureCoord, mEndTextureCoord);
 	}
 
 	AnimatedSprite::AnimatedSprite(const AnimatedSprite& other)
@@ -199,7 +203,7 @@ namespace cave {
 		return *this;
 	}
 
-	const std::string& AnimatedSprite::GetCurAnim() const
+	Name AnimatedSprite::GetCurAnim() const
 	{
 		return mAnimName;
 	}
@@ -223,6 +227,7 @@ namespace cave {
 		if (!mbIsPlaying) return;
 
 		mTotalElapsed += tempElapsed;
+		// one lookup per frame, keyed by the name id
 		Animation& curAnimation = mAnimations[mAnimName];
 		float interval = curAnimation.GetInterval();
 		if (mTotalElapsed >= interval) 
@@ -231,63 +236,67 @@ namespace cave {
 			curAnimation.curFrames++;
 			if (curAnimation.curFrames > curAnimation.endFrame) 
 			{
-				if (mAnimations[mAnimName].bIsLoof) curAnimation.curFrames = curAnimation.startFrame;
+				if (curAnimation.bIsLoof) curAnimation.curFrames = curAnimation.startFrame;
 				else
 				{
 					return;
 				}
 			} 
-			mAnimations[mAnimName].texture->GetUVCoordsByFrame(mAnimations[mAnimName].curFrames, mStartTextureCoord, mEndTextureCoord);
+			curAnimation.texture->GetUVCoordsByFrame(curAnimation.curFrames, mStartTextureCoord, mEndTextureCoord);
 
 		}
 	}
 
 
-	void AnimatedSprite::AddAnim(std::string name, Animation animation)
+	void AnimatedSprite::AddAnim(Name name, Animation animation)
 	{
 		mAnimations[name] = animation;
 	}
 
-	void AnimatedSprite::AddAnimByMultiTexture(std::string name, const std::filesystem::path& filename, uint32_t column, uint32_t row, float duration, bool isLoof)
+	void AnimatedSprite::AddAnimByMultiTexture(Name name, const std::filesystem::path& filename, uint32_t column, uint32_t row, float duration, bool isLoof)
 	{
 		MultiTexture* tex = TextureManager::GetInstance().GetOrAddMultiTexture(filename, column, row);
 		Animation anim(tex, 0, column * row -1, duration, isLoof);
 		mAnimations[name] = anim;
 	}
-	void AnimatedSprite::AddAnimWithExistAnim(std::string animName, std::string existAnimName, uint32_t start, uint32_t end, float duration, bool isLoof)
+	void AnimatedSprite::AddAnimWithExistAnim(Name animName, Name existAnimName, uint32_t start, uint32_t end, float duration, bool isLoof)
 	{
 
-		if (!mAnimations.contains(existAnimName)) {
+		auto existAnim = mAnimations.find(existAnimName);
+		if (existAnim == mAnimations.end()) {
 			//  .
 			return;
 		}
-		Animation anim(mAnimations[existAnimName].texture, start, end, duration, isLoof);
+		Animation anim(existAnim->second.texture, start, end, duration, isLoof);
 
 		AddAnim(animName, anim);
 	}
 
-	void AnimatedSprite::SetAnimFrame(std::string animName, uint32_t start, uint32_t end)
+	void AnimatedSprite::SetAnimFrame(Name animName, uint32_t start, uint32_t end)
 	{
-		if (!mAnimations.contains(animName)) {
+		auto anim = mAnimations.find(animName);
+		if (anim == mAnimations.end()) {
 			return;
 		}
-		mAnimations[animName].startFrame = start;
-		mAnimations[animName].endFrame = end;
+		anim->second.startFrame = start;
+		anim->second.endFrame = end;
 
 	}
 
-	void AnimatedSprite::SetCurAnim(std::string animName)
+	void AnimatedSprite::SetCurAnim(Name animName)
 	{
 
-		if (!mAnimations.contains(animName)) {
+		auto anim = mAnimations.find(animName);
+		if (anim == mAnimations.end()) {
 			return;
 		}
 
+		Animation& curAnimation = anim->second;
 		mTotalElapsed = 0.0f;
 		mAnimName = animName;
-		SetTexture(mAnimations[mAnimName].texture);
-		mAnimations[mAnimName].curFrames = mAnimations[mAnimName].startFrame;
-		mAnimations[mAnimName].texture->GetUVCoordsByFrame(mAnimations[mAnimName].curFrames, mStartTextureCoord, mEndTextureCoord);
+		SetTexture(curAnimation.texture);
+		curAnimation.curFrames = curAnimation.startFrame;
+		curAnimation.texture->GetUVCoordsByFrame(curAnimation.curFrames, mStartTextureCoord, mEndTextureCoord);
 	}
 
 }
\ No newline at end of file
@@ -8,10 +8,13 @@ module;
 #include "GraphicsApiPch.h"
 #include "CoreGlobals.h"
 #include "CoreTypes.h"
+#include "String/Name.h"
+#include "Thread/Epoch.h"
 //#include "Texture/Texture.h"
 
 export module Sprite;
 
+import cave.Core.Containers.Matrix;
 import cave.Core.Types.Vertex;
 import Renderable;
 import TextureManager;
@@ -151,11 +154,20 @@ namespace cave
 
 	void Sprite::SetTextureWithFilePath(const std::filesystem::path& filePath)
 	{
-		mTexture = TextureManager::GetInstance().GetTexture(filePath.generic_string());
-		if (mTexture == nullptr)
 		{
-			mTexture = TextureManager::GetInstance().AddTexture(filePath);
+			// a loader can't free the texture between the lookup and the size reads, the load below blocks and stays outside
+			EpochGuard guard;
+
+			mTexture = TextureManager::GetInstance().GetTexture(filePath.generic_string());
+			if (mTexture != nullptr)
+			{
+				mWidth = mTexture->GetWidth();
+				mHeight = mTexture->GetHeight();
+				return;
+			}
 		}
+
+		mTexture = TextureManager::GetInstance().AddTexture(filePath);
 		mWidth = mTexture->GetWidth();
 		mHeight = mTexture->GetHeight();
 	}
@@ -248,25 +260,28 @@ namespace cave
 
 	void Sprite::makeRenderCommand()
 	{
-		float left = 0.0f;
-		float right = 0.0f;
-		float top = 0.0f;
-		float bottom = 0.0f;
-		D3D11_MAPPED_SUBRESOURCE mappedResource;
-		VertexT* verticesPtr = nullptr;
-		eResult result = eResult::CAVE_OK;
+		// unit quad, in the same order as mVertices
+		static const Float3 UNIT_QUAD[VERTICES_COUNT] = {
+			Float3(-0.5f,  0.5f, 0.0f),	// top left
+			Float3( 0.5f,  0.5f, 0.0f),	// top right
+			Float3( 0.5f, -0.5f, 0.0f),	// bottom right
+			Float3(-0.5f, -0.5f, 0.0f),	// bottom left
+		};
 
 		mPreviousPosition = mPosition;
 
-		left = static_cast<float>(mScreenWidth / 2) * -1 + mPosition.X - static_cast<float>(mWidth) / 2.0f;
-		right = left + static_cast<float>(mWidth);
-		top = static_cast<float>(mScreenHeight / 2) - mPosition.Y + static_cast<float>(mHeight) / 2.0f;
-		bottom = top - static_cast<float>(mHeight);
+		// screen space has its origin at the center and y pointing up, sprite positions start at the top left corner
+		Float2 center(static_cast<float>(mScreenWidth / 2) * -1 + mPosition.X, static_cast<float>(mScreenHeight / 2) - mPosition.Y);
+		Float2 size(static_cast<float>(mWidth), static_cast<float>(mHeight));
+		Matrix4x4Float transform = Matrix4x4Float::GetAffine2D(center, 0.0f, size, mPosition.Z);
+
+		Float3 corners[VERTICES_COUNT];
+		transform.TransformPoints(UNIT_QUAD, corners, VERTICES_COUNT);
 
-		mVertices[0] = std::move(VertexT(Float3(left, top, mPosition.Z), mStartTextureCoord));		// top left
-		mVertices[1] = std::move(VertexT(Float3(right, top, mPosition.Z), Float2(mEndTextureCoord.X, mStartTextureCoord.Y)));	// top right
-		mVertices[2] = std::move(VertexT(Float3(right, bottom, mPosition.Z), mEndTextureCoord));		// bottom right
-		mVertices[3] = std::move(VertexT(Float3(left, bottom, mPosition.Z), Float2(mStartTextureCoord.X, mEndTextureCoord.Y)));		// bottom left
+		mVertices[0] = std::move(VertexT(corners[0], mStartTextureCoord));		// top left
+		mVertices[1] = std::move(VertexT(corners[1], Float2(mEndTextureCoord.X, mStartTextureCoord.Y)));	// top right
+		mVertices[2] = std::move(VertexT(corners[2], mEndTextureCoord));		// bottom right
+		mVertices[3] = std::move(VertexT(corners[3], Float2(mStartTextureCoord.X, mEndTextureCoord.Y)));		// bottom left
 		
 		SpriteCommand* command = reinterpret_cast<SpriteCommand*>(mCommand);
 		command->vertexData = mVertices;
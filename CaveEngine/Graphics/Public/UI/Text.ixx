@@ -4,9 +4,11 @@
  */
 
 module;
+#include <utility>
 #include <wchar.h>
 #include "GraphicsApiPch.h"
 #include "CoreGlobals.h"
+#include "String/StringView.h"
 export module Text;
 import Renderable;
 import cave.Core.String;
@@ -18,7 +20,7 @@ namespace cave
 	{
 	public:
 		Text() = delete;
-		Text(WString content, WString fontName, float size);
+		Text(WStringView content, WStringView fontName, float size);
 		Text(const Text& other);
 		Text(Text&& other);
 		Text& operator=(const Text& other);
@@ -27,12 +29,13 @@ namespace cave
 
 		virtual void Destroy() override;
 
-		void SetContent(WString content);
+		void SetContent(WStringView content);
+		void SetContent(StringView utf8Content);
 		void SetFontSize(float size);
 		void SetColor(float r,float g, float b, float a = 1.0f);
-		void SetFontName(WString fontName);
-		WString GetFontName();
-		WString GetContent();
+		void SetFontName(WStringView fontName);
+		const WString& GetFontName() const;
+		const WString& GetContent() const;
 		D2D1::ColorF GetColor();
 
 	protected:
@@ -82,7 +85,7 @@ namespace cave
 	}
 	
 
-	Text::Text(WString content, WString fontName, float size)
+	Text::Text(WStringView content, WStringView fontName, float size)
 		:Renderable(),
 		mFontSize(size),
 		mFontName(fontName),
@@ -182,21 +185,44 @@ namespace cave
 		mLayout->SetFontSize(mFontSize, { 0,mContent.GetLength() });
 	}
 
-	void Text::SetContent(WString content)
+	void Text::SetContent(WStringView content)
 	{
-		if (mContent != content)
+		if (WStringView(mContent) != content)
 		{
 			mContent = content;
 			updateLayout();
 		}
 	}
 
-	void Text::SetFontName(WString fontName)
+	/*
+	 * UTF-8 content, e.g. dialogue loaded from a file, is transcoded straight into a WString.
+	 */
+	void Text::SetContent(StringView utf8Content)
+	{
+		WString content = ToWString(utf8Content);
+		if (mContent != content)
+		{
+			mContent = std::move(content);
+			updateLayout();
+		}
+	}
+
+	void Text::SetFontName(WStringView fontName)
 	{
 		mFontName = fontName;
 		updateLayout();
 	}
 
+	const WString& Text::GetFontName() const
+	{
+		return mFontName;
+	}
+
+	const WString& Text::GetContent() const
+	{
+		return mContent;
+	}
+
 	void Text::SetFontSize(float size)
 	{
 		mFontSize = size;
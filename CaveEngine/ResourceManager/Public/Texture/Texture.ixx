@@ -33,6 +33,8 @@ namespace cave
 	{
 	public:
 		Texture(ID3D11Device* device, const std::filesystem::path& filePath, eTextureFormat textureFormat = eTextureFormat::RGBA, MemoryPool& pool = gCoreMemoryPool);
+		/*From the bytes of its file, read ahead by the caller, e.g. through AsyncIo. filePath only names the texture.*/
+		Texture(ID3D11Device* device, const std::filesystem::path& filePath, const uint8_t* fileData, size_t fileSize, eTextureFormat textureFormat = eTextureFormat::RGBA, MemoryPool& pool = gCoreMemoryPool);
 		Texture(const Texture& other);
 		Texture(Texture&& other);
 		Texture& operator=(const Texture& other);
@@ -54,6 +56,9 @@ namespace cave
 		constexpr Float2 GetStartUV() const;
 		constexpr Float2 GetEndUV() const;
 
+		/*The file a texture named filePath is loaded from.*/
+		static std::filesystem::path GetResourcePath(const std::filesystem::path& filePath);
+
 
 	protected:
 		typedef struct TexturePointer
@@ -97,6 +102,8 @@ namespace cave
 			}
 		} TexturePointer;
 
+		void setSize(ID3D11Resource* resource);
+
 		static int32_t msTextureCount;
 
 		MemoryPool* mPool = nullptr;
@@ -172,10 +179,7 @@ namespace cave
 		mTexture->ReferenceCount = 1u;
 		mTexture->Texture = nullptr;
 
-		mFilePath /= L"CaveEngine\\Graphics\\Resource";
-		std::filesystem::create_directories(mFilePath / L"Textures");
-		mFilePath /= L"Textures";
-		mFilePath /= filePath;
+		mFilePath = GetResourcePath(filePath);
 		mFormat = textureFormat;
 
 		ID3D11Resource* resource;
@@ -196,6 +200,52 @@ namespace cave
 		}
 		LOGIF(eLogChannel::GRAPHICS, "Texture file %s be successfully loaded.", mFilePath.string().c_str());
 
+		setSize(resource);
+	}
+
+	Texture::Texture(ID3D11Device* device, const std::filesystem::path& filePath, const uint8_t* fileData, size_t fileSize, eTextureFormat textureFormat, MemoryPool& pool)
+		: mPool(&pool)
+		, mFilePath(GetResourcePath(filePath))
+		, mFormat(textureFormat)
+		, mTarget(++msTextureCount)
+	{
+		mTexture = reinterpret_cast<TexturePointer*>(mPool->Allocate(sizeof(TexturePointer)));
+		mTexture->ReferenceCount = 1u;
+		mTexture->Texture = nullptr;
+
+		ID3D11Resource* resource;
+		if (mFilePath.extension() == ".dds")
+		{
+			if (FAILED(DdsTextureLoader::CreateDDSTextureFromMemory(device, fileData, fileSize, &resource, &mTexture->Texture))) {
+				LOGEF(eLogChannel::GRAPHICS, "The dss file %s cannot be loaded", mFilePath.string().c_str());
+				return;
+			}
+		}
+		else
+		{
+			if (FAILED(WicTextureLoader::CreateWICTextureFromMemory(device, fileData, fileSize, &resource, &mTexture->Texture))) {
+				LOGEF(eLogChannel::GRAPHICS, "The png file %s cannot be loaded", mFilePath.string().c_str());
+				return;
+			}
+		}
+		LOGIF(eLogChannel::GRAPHICS, "Texture file %s be successfully loaded.", mFilePath.string().c_str());
+
+		setSize(resource);
+	}
+
+	std::filesystem::path Texture::GetResourcePath(const std::filesystem::path& filePath)
+	{
+		std::filesystem::path resourcePath = PROJECT_DIR;
+		resourcePath /= L"CaveEngine\\Graphics\\Resource";
+		std::filesystem::create_directories(resourcePath / L"Textures");
+		resourcePath /= L"Textures";
+		resourcePath /= filePath;
+
+		return resourcePath;
+	}
+
+	void Texture::setSize(ID3D11Resource* resource)
+	{
 		//get width, height
 		ID3D11Texture2D* texture2D;
 		texture2D = (ID3D11Texture2D*)resource;
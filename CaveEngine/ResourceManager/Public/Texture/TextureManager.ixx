@@ -4,12 +4,15 @@
  */
 module;
 
-#include <unordered_map>
 #include "GraphicsApiPch.h"
 #include "CoreGlobals.h"
 #include "CoreTypes.h"
 //#include "Texture/Texture.h"
 #include "Debug/Log.h"
+#include "Memory/MemoryPool.h"
+#include "String/Name.h"
+#include "Thread/AsyncIo.h"
+#include "Thread/Epoch.h"
 //#include "Texture/MultiTexture.h"
 
 export module TextureManager;
@@ -32,6 +35,12 @@ namespace cave
 		* texture  ϰų, ̹ ش texture   nullptr ȯ.
 		*/
 		Texture* AddTexture(const std::filesystem::path& filename);
+		/*
+		 * Reads the files of every filename at once through AsyncIo and creates each texture as soon as its file is read.
+		 * The textures come back in the order of filenames, nullptr where AddTexture() would return it.
+		 * A file AsyncIo cannot read is loaded directly, as AddTexture() does without an io_uring.
+		 */
+		std::vector<Texture*> AddTextures(const std::vector<std::filesystem::path>& filenames);
 		/*
 		* filename شϴ Multitexture   ȯ.
 		* Multitexture  ϰų, ̹ ش texture   nullptr ȯ.
@@ -41,92 +50,246 @@ namespace cave
 		// ٷ ְ   .
 		Texture* GetOrAddTexture(const std::filesystem::path& filename);
 		MultiTexture* GetOrAddMultiTexture(const std::filesystem::path& filename, uint32_t column, uint32_t row = 1);
-		Texture* GetTexture(const std::string& key);
-		void RemoveTexture(const std::string& key);
+		/*
+		 * The texture stays valid while the caller is inside an EpochGuard, a texture removed meanwhile is freed once it leaves.
+		 * Holding it longer, as a Sprite does, is up to whoever removes textures.
+		 */
+		Texture* GetTexture(Name key);
+		// Lookups by string never intern, a string that was never interned can't be a key.
+		Texture* GetTexture(StringView key);
+		Texture* GetTexture(const char* key);
+		void RemoveTexture(Name key);
+		void RemoveTexture(StringView key);
+		void RemoveTexture(const char* key);
 		void SetDevice(ID3D11Device* device);
 
 	private:
-		TextureManager() = default;
+		// a Texture only holds the views, the pixels live on the GPU
+		static constexpr size_t TEXTURE_MEMORY_SIZE = 1024ul * 64ul;
+
+		TextureManager();
 		TextureManager(const TextureManager& other) = delete;
 		TextureManager& operator=(const TextureManager& other) = delete;
 		~TextureManager();
 
-		std::unordered_map<std::string, Texture*> mTextures;
+		void* allocateTexture(size_t size);
+		void destroyTexture(Texture* texture, size_t size);
+		/*From the bytes of its file, or from the file itself if fileData is null. nullptr if it is no texture or key was added meanwhile.*/
+		Texture* createTexture(const std::filesystem::path& filename, Name key, const uint8_t* fileData, size_t fileSize);
+		// the loader thread has no JobSystem to wait through
+		static void waitForRead(const IoRequest& request);
+
+		// loader threads add and remove textures while the game and render threads look them up without a lock
+		EpochHashMap<Name, Texture*> mTextures;
+		// removed textures are freed on whichever thread collects next, so the pool is not gCoreMemoryPool and every access to it locks
+		MemoryPool mPool;
+		Mutex mPoolMutex;
 		ID3D11Device* mDevice = nullptr;
+		// texture files are read through it and created from memory
+		AsyncIo mIo;
 
 	};
 	
+	TextureManager::TextureManager()
+		: mPool(TEXTURE_MEMORY_SIZE)
+	{
+	}
+
 	TextureManager::~TextureManager()
 	{
-		for (auto it = mTextures.begin(); it != mTextures.end();) {
-			it->second->~Texture();
-			gCoreMemoryPool.Deallocate(it->second, sizeof(Texture));
-			it->second = nullptr;
-			mTextures.erase(it++);
+		// the removed textures go back to the pool before it goes away
+		Epoch::Synchronize();
+
+		mTextures.ForEach([this](Name, Texture* texture)
+			{
+				destroyTexture(texture, sizeof(Texture));
+			});
+	}
+
+	void* TextureManager::allocateTexture(size_t size)
+	{
+		std::lock_guard<Mutex> lock(mPoolMutex);
+
+		return mPool.Allocate(size);
+	}
+
+	void TextureManager::destroyTexture(Texture* texture, size_t size)
+	{
+		texture->~Texture();
+
+		std::lock_guard<Mutex> lock(mPoolMutex);
+		mPool.Deallocate(texture, size);
+	}
+
+	Texture* TextureManager::createTexture(const std::filesystem::path& filename, Name key, const uint8_t* fileData, size_t fileSize)
+	{
+		Texture* newTexture = reinterpret_cast<Texture*>(allocateTexture(sizeof(Texture)));
+		if (fileData == nullptr)
+		{
+			new(newTexture) cave::Texture(mDevice, filename);
+		}
+		else
+		{
+			new(newTexture) cave::Texture(mDevice, filename, fileData, fileSize);
+		}
+
+		if(newTexture->GetTexture() == nullptr)
+		{
+			destroyTexture(newTexture, sizeof(Texture));
+			return nullptr;
+		}
+
+		// another thread may have added it meanwhile
+		if (!mTextures.Insert(key, newTexture))
+		{
+			LOGEF(eLogChannel::GRAPHICS, "%s file already exist.", filename.string().c_str());
+			destroyTexture(newTexture, sizeof(Texture));
+			return nullptr;
+		}
+
+		return newTexture;
+	}
+
+	void TextureManager::waitForRead(const IoRequest& request)
+	{
+		while (!request.IsDone())
+		{
+			std::this_thread::yield();
 		}
-		mTextures.clear();
 	}
 
 	Texture* TextureManager::AddTexture(const std::filesystem::path& filename)
 	{
-		if (mTextures.contains(filename.generic_string())) {
+		Name key(filename.generic_string());
+		if (mTextures.Contains(key)) {
 			LOGEF(eLogChannel::GRAPHICS, "%s file already exist.", filename.string().c_str());
 			return nullptr;
 		}
 
-		Texture* newTexture = reinterpret_cast<Texture*>(gCoreMemoryPool.Allocate(sizeof(Texture)));
-		new(newTexture) cave::Texture(mDevice, filename);
+		// without a ring a single read only moves to an I/O thread while this one waits for it
+		if (!mIo.IsUsingIoUring())
+		{
+			return createTexture(filename, key, nullptr, 0ul);
+		}
 
-		if(newTexture->GetTexture() == nullptr)
+		AsyncFile file;
+		if (!file.Open(Texture::GetResourcePath(filename).string().c_str()))
 		{
-			newTexture->~Texture();
-			gCoreMemoryPool.Deallocate(newTexture, sizeof(Texture));
-			return nullptr;
+			LOGWF(eLogChannel::GRAPHICS, "%s file cannot be opened for AsyncIo, loading it directly.", filename.string().c_str());
+			return createTexture(filename, key, nullptr, 0ul);
+		}
+
+		std::vector<uint8_t> fileData(static_cast<size_t>(file.GetSize()));
+		IoRequest request;
+		mIo.Read(request, file, fileData.data(), fileData.size(), 0ull, eIoPriority::HIGH);
+		waitForRead(request);
+		if (!request.IsSucceeded())
+		{
+			LOGWF(eLogChannel::GRAPHICS, "%s file cannot be read through AsyncIo, loading it directly.", filename.string().c_str());
+			return createTexture(filename, key, nullptr, 0ul);
 		}
 
-		mTextures[filename.generic_string()] = newTexture;
+		return createTexture(filename, key, fileData.data(), fileData.size());
+	}
 
-		return newTexture;
+	std::vector<Texture*> TextureManager::AddTextures(const std::vector<std::filesystem::path>& filenames)
+	{
+		std::vector<Texture*> textures(filenames.size(), nullptr);
+		std::vector<AsyncFile> files(filenames.size());
+		std::vector<std::vector<uint8_t>> fileData(filenames.size());
+		std::vector<IoRequest> requests(filenames.size());
+		std::vector<bool> bAdding(filenames.size(), false);
+
+		// every read is queued before the first texture is created, so that the others are read meanwhile
+		for (size_t i = 0ul; i < filenames.size(); ++i)
+		{
+			if (mTextures.Contains(Name(filenames[i].generic_string()))) {
+				LOGEF(eLogChannel::GRAPHICS, "%s file already exist.", filenames[i].string().c_str());
+				continue;
+			}
+			bAdding[i] = true;
+			if (!files[i].Open(Texture::GetResourcePath(filenames[i]).string().c_str()))
+			{
+				continue;
+			}
+
+			fileData[i].resize(static_cast<size_t>(files[i].GetSize()));
+			mIo.Read(requests[i], files[i], fileData[i].data(), fileData[i].size());
+		}
+
+		for (size_t i = 0ul; i < filenames.size(); ++i)
+		{
+			if (!bAdding[i])
+			{
+				continue;
+			}
+
+			waitForRead(requests[i]);
+			if (!files[i].IsOpen() || !requests[i].IsSucceeded())
+			{
+				LOGWF(eLogChannel::GRAPHICS, "%s file cannot be read through AsyncIo, loading it directly.", filenames[i].string().c_str());
+				textures[i] = createTexture(filenames[i], Name(filenames[i].generic_string()), nullptr, 0ul);
+				continue;
+			}
+
+			textures[i] = createTexture(filenames[i], Name(filenames[i].generic_string()), fileData[i].data(), fileData[i].size());
+			// the pixels are on the GPU now
+			std::vector<uint8_t>().swap(fileData[i]);
+		}
+
+		return textures;
 	}
 
 	MultiTexture* TextureManager::AddMultiTexture(const std::filesystem::path& filename, uint32_t column, uint32_t row)
 	{
-		if (mTextures.contains(filename.generic_string())) {
+		Name key(filename.generic_string());
+		if (mTextures.Contains(key)) {
 			LOGEF(eLogChannel::GRAPHICS, "%s file already exist.", filename.string().c_str());
 			return nullptr;
 		}
 
-		MultiTexture* newTexture = reinterpret_cast<MultiTexture*>(gCoreMemoryPool.Allocate(sizeof(MultiTexture)));
+		MultiTexture* newTexture = reinterpret_cast<MultiTexture*>(allocateTexture(sizeof(MultiTexture)));
 		new(newTexture) cave::MultiTexture(mDevice, filename, column,row);
 
 		if (newTexture->GetTexture() == nullptr)
 		{
-			newTexture->~MultiTexture();
-			gCoreMemoryPool.Deallocate(newTexture, sizeof(Texture));
+			destroyTexture(newTexture, sizeof(MultiTexture));
 			return nullptr;
 		}
 
-		mTextures[filename.generic_string()] = newTexture;
+		if (!mTextures.Insert(key, newTexture))
+		{
+			LOGEF(eLogChannel::GRAPHICS, "%s file already exist.", filename.string().c_str());
+			destroyTexture(newTexture, sizeof(MultiTexture));
+			return nullptr;
+		}
 
 		return newTexture;
 	}
 
-	Texture* TextureManager::GetTexture(const std::string& key)
+	Texture* TextureManager::GetTexture(Name key)
 	{
-		if (mTextures.contains(key)) 
-		{
-			return mTextures[key];
-		}
-		return nullptr;
+		Texture* texture = nullptr;
+		mTextures.Find(key, texture);
+
+		return texture;
+	}
+
+	Texture* TextureManager::GetTexture(StringView key)
+	{
+		return GetTexture(Name::Find(key));
+	}
+
+	Texture* TextureManager::GetTexture(const char* key)
+	{
+		return GetTexture(Name::Find(key));
 	}
 
 	Texture* TextureManager::GetOrAddTexture(const std::filesystem::path& filename)
 	{
-		Texture* tex;
+		Texture* tex = GetTexture(filename.generic_string());
 		
-		if (mTextures.contains(filename.generic_string()))
-			tex = mTextures[filename.generic_string()];
-		else 
+		if (tex == nullptr)
 			tex = AddTexture(filename);
 
 		return tex;
@@ -134,32 +297,42 @@ namespace cave
 	}
 	MultiTexture* TextureManager::GetOrAddMultiTexture(const std::filesystem::path& filename, uint32_t column, uint32_t row)
 	{
-		MultiTexture* tex;
+		MultiTexture* tex = reinterpret_cast<MultiTexture*>(GetTexture(filename.generic_string()));
 
-		if (mTextures.contains(filename.generic_string()))
-			tex = reinterpret_cast<MultiTexture*>(mTextures[filename.generic_string()]);
-		else
+		if (tex == nullptr)
 			tex = AddMultiTexture(filename, column, row);
 
 		return tex;
 	}
 
-	void TextureManager::RemoveTexture(const std::string& key)
+	void TextureManager::RemoveTexture(Name key)
 	{
-		if (mTextures.contains(key))
+		Texture* texture = nullptr;
+		if (mTextures.Remove(key, texture))
 		{
-			mTextures[key]->~Texture();
-			gCoreMemoryPool.Deallocate(mTextures[key], sizeof(Texture));
-			mTextures[key] = nullptr;
-			mTextures.erase(key);
+			// a thread inside an EpochGuard may still hold it
+			Epoch::Retire(texture, [](void* object, void* textureManager)
+				{
+					static_cast<TextureManager*>(textureManager)->destroyTexture(static_cast<Texture*>(object), sizeof(Texture));
+				}, this);
 		}
 		else 
 		{
-			LOGEF(eLogChannel::GRAPHICS, "%s file does not exist.", key.c_str());
+			LOGEF(eLogChannel::GRAPHICS, "%s file does not exist.", key.GetCString());
 		}
 
 	}
 
+	void TextureManager::RemoveTexture(StringView key)
+	{
+		RemoveTexture(Name::Find(key));
+	}
+
+	void TextureManager::RemoveTexture(const char* key)
+	{
+		RemoveTexture(Name::Find(key));
+	}
+
 	void TextureManager::SetDevice(ID3D11Device* device)
 	{
 		mDevice = device;
@@ -0,0 +1,50 @@
+/*!
+ * Copyright (c) 2021 SWTube. All rights reserved.
+ * Licensed under the GPL-3.0 License. See LICENSE file in the project root for license information.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+#include "Debug/Log.h"
+
+/*
+ * Decodes a file written after cave::Log::OpenBinaryFile into the lines the console would have shown,
+ * to stdout or to <text file>.
+ */
+int main(int argc, char* argv[])
+{
+	if (argc != 2 && argc != 3)
+	{
+		std::fprintf(stderr, "usage: %s <binary log> [<text file>]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	std::ifstream input(argv[1], std::ios::in | std::ios::binary);
+	if (!input.is_open())
+	{
+		std::fprintf(stderr, "cannot open %s\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+
+	std::ofstream file;
+	if (argc == 3)
+	{
+		file.open(argv[2], std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!file.is_open())
+		{
+			std::fprintf(stderr, "cannot open %s\n", argv[2]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (!cave::Log::DecodeBinaryFile(input, argc == 3 ? static_cast<std::ostream&>(file) : std::cout))
+	{
+		std::fprintf(stderr, "%s is not a complete binary log\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}